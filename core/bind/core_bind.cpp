@@ -2128,20 +2128,13 @@ bool _File::file_exists(StringView p_name) const {
 
 void _File::store_var(const Variant &p_var, bool p_full_objects) {
     ERR_FAIL_COND_MSG(!f, "File must be opened before use.");
-    int len;
-    Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-    ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
-
-    PoolVector<uint8_t> buff;
-    buff.resize(len);
-
-    PoolVector<uint8_t>::Write w = buff.write();
-    err = encode_variant(p_var, &w[0], len, p_full_objects);
+    Vector<uint8_t> buff;
+    VariantWriter writer(buff, 0, p_full_objects);
+    Error err = writer.write(p_var);
     ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
-    w.release();
 
-    store_32(len);
-    store_buffer(buff);
+    store_32(writer.get_position());
+    f->store_buffer(buff.data(), writer.get_position());
 }
 
 Variant _File::get_var(bool p_allow_objects) const {
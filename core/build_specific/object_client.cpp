@@ -32,6 +32,7 @@
 
 #include "object_private.h"
 #include "class_db.h"
+#include "core_string_names.h"
 #include "script_language.h"
 
 
@@ -86,8 +87,13 @@ Error Object::connect(const StringName& p_signal, const Callable& p_callable, ui
     if (p_flags & ObjectNS::CONNECT_REFERENCE_COUNTED) {
         slot.reference_count = 1;
     }
+    if (target.is_standard() && target.get_method() != CoreStringNames::get_singleton()->_free) {
+        // Scripted targets are re-checked on every emit, the bind is only used while there is no script instance.
+        slot.method = ClassDB::get_method(target_object->get_class_name(), target.get_method());
+    }
 
     s->second.slot_map[target] = eastl::move(slot);
+    s->second.rebuild();
 
     return OK;
 }
@@ -33,6 +33,7 @@
 #include "core/object_private.h"
 
 #include "core/class_db.h"
+#include "core/core_string_names.h"
 #include "core/script_language.h"
 
 Error Object::connect(const StringName& p_signal, const Callable& p_callable, uint32_t p_flags) {
@@ -90,8 +91,13 @@ Error Object::connect(const StringName& p_signal, const Callable& p_callable, ui
     if (p_flags & ObjectNS::CONNECT_REFERENCE_COUNTED) {
         slot.reference_count = 1;
     }
+    if (target.is_standard() && target.get_method() != CoreStringNames::get_singleton()->_free) {
+        // Scripted targets are re-checked on every emit, the bind is only used while there is no script instance.
+        slot.method = ClassDB::get_method(target_object->get_class_name(), target.get_method());
+    }
 
     s->second.slot_map.emplace(target,eastl::move(slot));
+    s->second.rebuild();
 
     return OK;
 }
@@ -94,6 +94,7 @@ static HashMap<StringName, MethodInfo> &class_signal_map(ClassDB_ClassInfo &ci)
     return ci.class_signal_map();
 }
 ClassDB_APIType ClassDB::current_api = API_CORE;
+SafeNumeric<uint32_t> ClassDB::method_generation {1};
 
 void ClassDB::set_current_api(ClassDB_APIType p_api) {
     current_api = p_api;
@@ -872,39 +873,7 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
     while (check) {
         auto iter = check->property_setget.find(p_property);
         if (iter != check->property_setget.end()) {
-            const ClassDB_PropertySetGet &psg(iter->second);
-            if (!psg.setter) {
-                if (r_valid) {
-                    *r_valid = false;
-                }
-                return true; // return true but do nothing
-            }
-
-            Callable::CallError ce;
-
-            if (psg.index >= 0) {
-                Variant index = psg.index;
-                const Variant *arg[2] = { &index, &p_value };
-                // p_object->call(psg.setter,arg,2,ce);
-                if (psg._setptr) {
-                    psg._setptr->call(p_object, arg, 2, ce);
-                } else {
-                    p_object->call(psg.setter, arg, 2, ce);
-                }
-
-            } else {
-                const Variant *arg[1] = { &p_value };
-                if (psg._setptr) {
-                    psg._setptr->call(p_object, arg, 1, ce);
-                } else {
-                    p_object->call(psg.setter, arg, 1, ce);
-                }
-            }
-
-            if (r_valid) {
-                *r_valid = ce.error == Callable::CallError::CALL_OK;
-            }
-
+            set_property(p_object, iter->second, p_value, r_valid);
             return true;
         }
 
@@ -921,25 +890,7 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
     while (check) {
         auto iter2 = check->property_setget.find(p_property);
         if (iter2 != check->property_setget.end()) {
-            const ClassDB_PropertySetGet &psg(iter2->second);
-            if (!psg.getter) {
-                return true; // return true but do nothing
-            }
-
-            if (psg.index >= 0) {
-                Variant index = psg.index;
-                const Variant *arg[1] = { &index };
-                Callable::CallError ce;
-                r_value = p_object->call(psg.getter, arg, 1, ce);
-
-            } else {
-                Callable::CallError ce;
-                if (psg._getptr) {
-                    r_value = psg._getptr->call(p_object, nullptr, 0, ce);
-                } else {
-                    r_value = p_object->call(psg.getter, nullptr, 0, ce);
-                }
-            }
+            get_property(p_object, iter2->second, r_value);
             return true;
         }
         auto iter = check->constant_map.find(p_property);
@@ -954,6 +905,76 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
     return false;
 }
 
+const ClassDB_PropertySetGet *ClassDB::get_property_setget(const StringName &p_class, const StringName &p_property) {
+    RWLockRead _rw_lockr_(classdb_lock);
+
+    auto iter = classes.find(p_class);
+    ClassDB_ClassInfo *check = iter != classes.end() ? &iter->second : nullptr;
+    while (check) {
+        auto iter2 = check->property_setget.find(p_property);
+        if (iter2 != check->property_setget.end()) {
+            return &iter2->second;
+        }
+        check = check->inherits_ptr;
+    }
+    return nullptr;
+}
+
+void ClassDB::set_property(Object *p_object, const ClassDB_PropertySetGet &psg, const Variant &p_value, bool *r_valid) {
+    if (!psg.setter) {
+        if (r_valid) {
+            *r_valid = false;
+        }
+        return; // do nothing
+    }
+
+    Callable::CallError ce;
+
+    if (psg.index >= 0) {
+        Variant index = psg.index;
+        const Variant *arg[2] = { &index, &p_value };
+        // p_object->call(psg.setter,arg,2,ce);
+        if (psg._setptr) {
+            psg._setptr->call(p_object, arg, 2, ce);
+        } else {
+            p_object->call(psg.setter, arg, 2, ce);
+        }
+
+    } else {
+        const Variant *arg[1] = { &p_value };
+        if (psg._setptr) {
+            psg._setptr->call(p_object, arg, 1, ce);
+        } else {
+            p_object->call(psg.setter, arg, 1, ce);
+        }
+    }
+
+    if (r_valid) {
+        *r_valid = ce.error == Callable::CallError::CALL_OK;
+    }
+}
+
+void ClassDB::get_property(Object *p_object, const ClassDB_PropertySetGet &psg, Variant &r_value) {
+    if (!psg.getter) {
+        return; // do nothing
+    }
+
+    if (psg.index >= 0) {
+        Variant index = psg.index;
+        const Variant *arg[1] = { &index };
+        Callable::CallError ce;
+        r_value = p_object->call(psg.getter, arg, 1, ce);
+
+    } else {
+        Callable::CallError ce;
+        if (psg._getptr) {
+            r_value = psg._getptr->call(p_object, nullptr, 0, ce);
+        } else {
+            r_value = p_object->call(psg.getter, nullptr, 0, ce);
+        }
+    }
+}
+
 int ClassDB::get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
     auto iter = classes.find(p_class);
     ClassDB_ClassInfo *type = iter != classes.end() ? &iter->second : nullptr;
@@ -1132,6 +1153,7 @@ MethodBind *ClassDB::bind_methodfi(
 #endif
 
     type->method_map[mdname] = p_bind;
+    method_generation.increment();
 
     Vector<Variant> defvals;
 
@@ -1316,6 +1338,7 @@ void ClassDB::cleanup_defaults() {
 void ClassDB::cleanup() {
     // OBJTYPE_LOCK; hah not here
     classes.clear();
+    method_generation.increment();
     resource_base_extensions.clear();
     compat_classes.clear();
 }
@@ -1340,6 +1363,7 @@ bool ClassDB::bind_helper(MethodBind *bind, const StringName &p_name) {
     auto iter = classes.find(StaticCString(bind->get_instance_class(), true));
     auto type = &iter->second;
     type->method_map[p_name] = bind;
+    method_generation.increment();
 #ifdef DEBUG_METHODS_ENABLED
     type->method_order.push_back(p_name);
 #endif
@@ -38,6 +38,7 @@
 #include "core/list.h"
 #include "core/method_info.h"
 #include "core/os/rw_lock.h"
+#include "core/safe_refcount.h"
 #include "EASTL/vector.h"
 
 #include <initializer_list>
@@ -171,6 +172,7 @@ public:
 #endif
 
     static ClassDB_APIType current_api;
+    static SafeNumeric<uint32_t> method_generation;
 
     static void _add_class2(const StringName &p_class, const StringName &p_inherits);
 
@@ -264,6 +266,10 @@ public:
     static void get_property_list(StringName p_class, Vector<PropertyInfo> *p_list, bool p_no_inheritance = false, const Object *p_validator = nullptr);
     static bool set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid = nullptr);
     static bool get_property(Object *p_object, const StringName &p_property, Variant &r_value);
+    // Resolved form of the above, the setget entry stays valid until cleanup().
+    static const ClassDB_PropertySetGet *get_property_setget(const StringName &p_class, const StringName &p_property);
+    static void set_property(Object *p_object, const ClassDB_PropertySetGet &p_setget, const Variant &p_value, bool *r_valid = nullptr);
+    static void get_property(Object *p_object, const ClassDB_PropertySetGet &p_setget, Variant &r_value);
     static bool has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance = false);
     static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
     static VariantType get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
@@ -275,6 +281,8 @@ public:
 
     static void get_method_list(const StringName& p_class, Vector<MethodInfo> *p_methods, bool p_no_inheritance = false, bool p_exclude_from_properties = false);
     static MethodBind *get_method(StringName p_class, StringName p_name);
+    // Changes whenever methods are bound or the class table is cleared, lookup caches compare against it.
+    static uint32_t get_method_generation() { return method_generation.get(); }
     static HashMap<StringName, MethodInfo> *get_signal_list(const StringName& p_class);
 
     static void add_virtual_method(const StringName &p_class, const MethodInfo &p_method);
@@ -1289,21 +1289,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
             for (int i = 0; i < len; i++) {
 
-                String utf8(data.get(i));
-
-                if (buf) {
-                    encode_uint32(utf8.length(), buf);
-                    buf += 4;
-                    memcpy(buf, utf8.data(), utf8.length());
-                    buf += utf8.length();
-                }
-
-                r_len += 4 + utf8.length() + 1;
-                while (r_len % 4) {
-                    r_len++; //pad
-                    if (buf)
-                        *(buf++) = 0;
-                }
+                _encode_string(data.get(i), buf, r_len);
             }
 
         } break;
@@ -1398,3 +1384,566 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
     return OK;
 }
+
+VariantWriter::VariantWriter(Vector<uint8_t> &r_buffer, int p_position, bool p_full_objects) :
+        buffer(r_buffer),
+        position(p_position),
+        full_objects(p_full_objects) {
+}
+
+// Leaves the calling function with ERR_OUT_OF_MEMORY once the message would grow past max_size.
+#define RESERVE_OR_FAIL(m_ptr, m_bytes)  \
+    uint8_t *m_ptr = _reserve(m_bytes); \
+    if (unlikely(!m_ptr))               \
+        return ERR_OUT_OF_MEMORY;
+
+uint8_t *VariantWriter::_reserve(int p_bytes) {
+
+    if (overflowed || p_bytes > max_size - position) {
+        // Checked before growing, so a capped buffer never gets bigger than max_size.
+        overflowed = true;
+        return nullptr;
+    }
+    int required = position + p_bytes;
+    if (required > int(buffer.size())) {
+        // Grow geometrically, the buffer is meant to be reused so it settles at the largest message size.
+        buffer.resize(M_MAX(required, MIN(int(buffer.size()) * 2, max_size)));
+    }
+    uint8_t *w = buffer.data() + position;
+    position = required;
+    return w;
+}
+
+Error VariantWriter::_write_string(StringView p_string) {
+
+    int len = int(p_string.size());
+    int pad = (4 - len % 4) % 4;
+    RESERVE_OR_FAIL(w, 4 + len + pad);
+    encode_uint32(len, w);
+    memcpy(w + 4, p_string.data(), len);
+    memset(w + 4 + len, 0, pad);
+    return OK;
+}
+
+const uint8_t *VariantWriter::get_data() const {
+    return buffer.data();
+}
+
+Error VariantWriter::write(const Variant &p_variant) {
+    return _write(p_variant, 0);
+}
+
+void VariantWriter::write_string(StringView p_string) {
+
+    uint8_t *w = _reserve(4);
+    if (!w)
+        return;
+    encode_uint32(uint32_t(VariantType::STRING), w);
+    _write_string(p_string);
+}
+
+void VariantWriter::write_array_header(int p_count) {
+
+    uint8_t *w = _reserve(8);
+    if (!w)
+        return;
+    encode_uint32(uint32_t(VariantType::ARRAY), w);
+    encode_uint32(p_count, w + 4);
+}
+
+void VariantWriter::write_dictionary_header(int p_count) {
+
+    uint8_t *w = _reserve(8);
+    if (!w)
+        return;
+    encode_uint32(uint32_t(VariantType::DICTIONARY), w);
+    encode_uint32(p_count, w + 4);
+}
+
+Error VariantWriter::_write(const Variant &p_variant, int p_depth) {
+    ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential inifite recursion detected. Bailing.");
+
+    // Header flags follow encode_variant() exactly, so both produce the same bytes.
+    const VariantType type = p_variant.get_type();
+    uint32_t flags = 0;
+
+    switch (type) {
+
+        case VariantType::INT: {
+            int64_t val = p_variant.as<int64_t>();
+            if (val > (int64_t)INT_MAX || val < (int64_t)INT_MIN) {
+                flags |= ENCODE_FLAG_64;
+            }
+        } break;
+        case VariantType::OBJECT: {
+            if (!p_variant.as<Object *>()) {
+                // Object is invalid, send a NULL instead.
+                RESERVE_OR_FAIL(w, 4);
+                encode_uint32((uint32_t)VariantType::NIL, w);
+                return OK;
+            }
+            if (!full_objects) {
+                flags |= ENCODE_FLAG_OBJECT_AS_ID;
+            }
+        } break;
+        default: {
+        }
+    }
+
+    RESERVE_OR_FAIL(header, 4);
+    encode_uint32(uint32_t(type) | flags, header);
+
+    switch (type) {
+
+        case VariantType::NIL:
+        case VariantType::_RID: {
+
+        } break;
+        case VariantType::BOOL: {
+
+            RESERVE_OR_FAIL(w, 4);
+            encode_uint32(p_variant.as<bool>(), w);
+        } break;
+        case VariantType::INT: {
+
+            if (flags & ENCODE_FLAG_64) {
+                RESERVE_OR_FAIL(w, 8);
+                encode_uint64(p_variant.as<int64_t>(), w);
+            } else {
+                RESERVE_OR_FAIL(w, 4);
+                encode_uint32(p_variant.as<int32_t>(), w);
+            }
+        } break;
+        case VariantType::FLOAT: {
+
+            RESERVE_OR_FAIL(w, 4);
+            encode_float(p_variant.as<float>(), w);
+        } break;
+        case VariantType::NODE_PATH: {
+
+            NodePath np = p_variant.as<NodePath>();
+            RESERVE_OR_FAIL(w, 12);
+            encode_uint32(uint32_t(np.get_name_count()) | 0x80000000, w); //for compatibility with the old format
+            encode_uint32(np.get_subname_count(), w + 4);
+            encode_uint32(np.is_absolute() ? 1 : 0, w + 8);
+
+            for (int i = 0; i < np.get_name_count(); i++) {
+                if (_write_string(np.get_name(i)) != OK)
+                    return ERR_OUT_OF_MEMORY;
+            }
+            for (int i = 0; i < np.get_subname_count(); i++) {
+                if (_write_string(np.get_subname(i)) != OK)
+                    return ERR_OUT_OF_MEMORY;
+            }
+        } break;
+        case VariantType::STRING:
+        case VariantType::STRING_NAME: {
+
+            if (_write_string(StringView(p_variant)) != OK)
+                return ERR_OUT_OF_MEMORY;
+        } break;
+        case VariantType::VECTOR2: {
+
+            Vector2 v2 = p_variant.as<Vector2>();
+            RESERVE_OR_FAIL(w, 2 * 4);
+            encode_float(v2.x, &w[0]);
+            encode_float(v2.y, &w[4]);
+        } break;
+        case VariantType::RECT2: {
+
+            Rect2 r2 = p_variant.as<Rect2>();
+            RESERVE_OR_FAIL(w, 4 * 4);
+            encode_float(r2.position.x, &w[0]);
+            encode_float(r2.position.y, &w[4]);
+            encode_float(r2.size.x, &w[8]);
+            encode_float(r2.size.y, &w[12]);
+        } break;
+        case VariantType::VECTOR3: {
+
+            Vector3 v3 = p_variant.as<Vector3>();
+            RESERVE_OR_FAIL(w, 3 * 4);
+            encode_float(v3.x, &w[0]);
+            encode_float(v3.y, &w[4]);
+            encode_float(v3.z, &w[8]);
+        } break;
+        case VariantType::TRANSFORM2D: {
+
+            Transform2D val = p_variant.as<Transform2D>();
+            RESERVE_OR_FAIL(w, 6 * 4);
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 2; j++) {
+                    memcpy(&w[(i * 2 + j) * 4], &val.elements[i][j], sizeof(float));
+                }
+            }
+        } break;
+        case VariantType::PLANE: {
+
+            Plane p = p_variant.as<Plane>();
+            RESERVE_OR_FAIL(w, 4 * 4);
+            encode_float(p.normal.x, &w[0]);
+            encode_float(p.normal.y, &w[4]);
+            encode_float(p.normal.z, &w[8]);
+            encode_float(p.d, &w[12]);
+        } break;
+        case VariantType::QUAT: {
+
+            Quat q = p_variant.as<Quat>();
+            RESERVE_OR_FAIL(w, 4 * 4);
+            encode_float(q.x, &w[0]);
+            encode_float(q.y, &w[4]);
+            encode_float(q.z, &w[8]);
+            encode_float(q.w, &w[12]);
+        } break;
+        case VariantType::AABB: {
+
+            AABB aabb = p_variant.as<AABB>();
+            RESERVE_OR_FAIL(w, 6 * 4);
+            encode_float(aabb.position.x, &w[0]);
+            encode_float(aabb.position.y, &w[4]);
+            encode_float(aabb.position.z, &w[8]);
+            encode_float(aabb.size.x, &w[12]);
+            encode_float(aabb.size.y, &w[16]);
+            encode_float(aabb.size.z, &w[20]);
+        } break;
+        case VariantType::BASIS: {
+
+            Basis val = p_variant.as<Basis>();
+            RESERVE_OR_FAIL(w, 9 * 4);
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    memcpy(&w[(i * 3 + j) * 4], &val.elements[i][j], sizeof(float));
+                }
+            }
+        } break;
+        case VariantType::TRANSFORM: {
+
+            Transform val = p_variant.as<Transform>();
+            RESERVE_OR_FAIL(w, 12 * 4);
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    memcpy(&w[(i * 3 + j) * 4], &val.basis.elements[i][j], sizeof(float));
+                }
+            }
+            encode_float(val.origin.x, &w[36]);
+            encode_float(val.origin.y, &w[40]);
+            encode_float(val.origin.z, &w[44]);
+        } break;
+        case VariantType::COLOR: {
+
+            Color c = p_variant.as<Color>();
+            RESERVE_OR_FAIL(w, 4 * 4);
+            encode_float(c.r, &w[0]);
+            encode_float(c.g, &w[4]);
+            encode_float(c.b, &w[8]);
+            encode_float(c.a, &w[12]);
+        } break;
+        case VariantType::OBJECT: {
+
+            Object *obj = p_variant.as<Object *>();
+            if (!full_objects) {
+                RESERVE_OR_FAIL(w, 8);
+                encode_uint64(entt::to_integral(obj->get_instance_id()), w);
+                break;
+            }
+
+            if (_write_string(StringView(obj->get_class())) != OK)
+                return ERR_OUT_OF_MEMORY;
+
+            Vector<PropertyInfo> props;
+            obj->get_property_list(&props);
+
+            int pc = 0;
+            for (const PropertyInfo &E : props) {
+                if (E.usage & PROPERTY_USAGE_STORAGE)
+                    pc++;
+            }
+            RESERVE_OR_FAIL(count, 4);
+            encode_uint32(pc, count);
+
+            for (const PropertyInfo &E : props) {
+
+                if (!(E.usage & PROPERTY_USAGE_STORAGE))
+                    continue;
+
+                if (_write_string(E.name) != OK)
+                    return ERR_OUT_OF_MEMORY;
+                Error err = _write(obj->get(E.name), p_depth + 1);
+                ERR_FAIL_COND_V(err, err);
+            }
+        } break;
+        case VariantType::DICTIONARY: {
+
+            Dictionary d = p_variant.as<Dictionary>();
+            RESERVE_OR_FAIL(count, 4);
+            encode_uint32(uint32_t(d.size()), count);
+
+            for (const auto &E : d.get_key_list()) {
+                const Variant *v = d.getptr(E);
+
+                Error err = _write(v ? Variant(E) : Variant("[Deleted Object]"), p_depth + 1);
+                ERR_FAIL_COND_V(err, err);
+                err = _write(v ? *v : Variant(), p_depth + 1);
+                ERR_FAIL_COND_V(err, err);
+            }
+        } break;
+        case VariantType::ARRAY: {
+
+            Array v = p_variant.as<Array>();
+            RESERVE_OR_FAIL(count, 4);
+            encode_uint32(uint32_t(v.size()), count);
+
+            for (int i = 0; i < v.size(); i++) {
+                Error err = _write(v.get(i), p_depth + 1);
+                ERR_FAIL_COND_V(err, err);
+            }
+        } break;
+        // arrays
+        case VariantType::POOL_BYTE_ARRAY: {
+
+            PoolVector<uint8_t> data = p_variant.as<PoolVector<uint8_t>>();
+            int datalen = data.size();
+            int pad = (4 - datalen % 4) % 4;
+
+            RESERVE_OR_FAIL(w, 4 + datalen + pad);
+            encode_uint32(datalen, w);
+            if (datalen) {
+                PoolVector<uint8_t>::Read r = data.read();
+                memcpy(w + 4, r.ptr(), datalen);
+            }
+            memset(w + 4 + datalen, 0, pad);
+        } break;
+        case VariantType::POOL_INT_ARRAY: {
+
+            PoolVector<int> data = p_variant.as<PoolVector<int>>();
+            int datalen = data.size();
+
+            RESERVE_OR_FAIL(w, 4 + datalen * 4);
+            encode_uint32(datalen, w);
+            w += 4;
+            PoolVector<int>::Read r = data.read();
+            for (int i = 0; i < datalen; i++) {
+                encode_uint32(r[i], &w[i * 4]);
+            }
+        } break;
+        case VariantType::POOL_FLOAT32_ARRAY: {
+
+            PoolVector<real_t> data = p_variant.as<PoolVector<real_t>>();
+            int datalen = data.size();
+
+            RESERVE_OR_FAIL(w, 4 + datalen * 4);
+            encode_uint32(datalen, w);
+            w += 4;
+            PoolVector<real_t>::Read r = data.read();
+            for (int i = 0; i < datalen; i++) {
+                encode_float(r[i], &w[i * 4]);
+            }
+        } break;
+        case VariantType::POOL_STRING_ARRAY: {
+
+            PoolVector<String> data = p_variant.as<PoolVector<String>>();
+            int datalen = data.size();
+
+            RESERVE_OR_FAIL(count, 4);
+            encode_uint32(datalen, count);
+            PoolVector<String>::Read r = data.read();
+            for (int i = 0; i < datalen; i++) {
+                if (_write_string(r[i]) != OK)
+                    return ERR_OUT_OF_MEMORY;
+            }
+        } break;
+        case VariantType::POOL_VECTOR2_ARRAY: {
+
+            PoolVector<Vector2> data = p_variant.as<PoolVector<Vector2>>();
+            int datalen = data.size();
+
+            RESERVE_OR_FAIL(w, 4 + datalen * 4 * 2);
+            encode_uint32(datalen, w);
+            w += 4;
+            PoolVector<Vector2>::Read r = data.read();
+            for (int i = 0; i < datalen; i++) {
+                encode_float(r[i].x, &w[0]);
+                encode_float(r[i].y, &w[4]);
+                w += 4 * 2;
+            }
+        } break;
+        case VariantType::POOL_VECTOR3_ARRAY: {
+
+            PoolVector<Vector3> data = p_variant.as<PoolVector<Vector3>>();
+            int datalen = data.size();
+
+            RESERVE_OR_FAIL(w, 4 + datalen * 4 * 3);
+            encode_uint32(datalen, w);
+            w += 4;
+            PoolVector<Vector3>::Read r = data.read();
+            for (int i = 0; i < datalen; i++) {
+                encode_float(r[i].x, &w[0]);
+                encode_float(r[i].y, &w[4]);
+                encode_float(r[i].z, &w[8]);
+                w += 4 * 3;
+            }
+        } break;
+        case VariantType::POOL_COLOR_ARRAY: {
+
+            PoolVector<Color> data = p_variant.as<PoolVector<Color>>();
+            int datalen = data.size();
+
+            RESERVE_OR_FAIL(w, 4 + datalen * 4 * 4);
+            encode_uint32(datalen, w);
+            w += 4;
+            PoolVector<Color>::Read r = data.read();
+            for (int i = 0; i < datalen; i++) {
+                encode_float(r[i].r, &w[0]);
+                encode_float(r[i].g, &w[4]);
+                encode_float(r[i].b, &w[8]);
+                encode_float(r[i].a, &w[12]);
+                w += 4 * 4;
+            }
+        } break;
+        default: {
+            ERR_FAIL_V(ERR_BUG);
+        }
+    }
+
+    return OK;
+}
+
+#undef RESERVE_OR_FAIL
+
+Vector2 PackedArrayView::get_vector2(int p_index) const {
+
+    const uint8_t *r = data + p_index * 4 * 2;
+    return Vector2(decode_float(r), decode_float(r + 4));
+}
+
+Vector3 PackedArrayView::get_vector3(int p_index) const {
+
+    const uint8_t *r = data + p_index * 4 * 3;
+    return Vector3(decode_float(r), decode_float(r + 4), decode_float(r + 8));
+}
+
+Color PackedArrayView::get_color(int p_index) const {
+
+    const uint8_t *r = data + p_index * 4 * 4;
+    return Color(decode_float(r), decode_float(r + 4), decode_float(r + 8), decode_float(r + 12));
+}
+
+VariantReader::VariantReader(const uint8_t *p_buffer, int p_length, bool p_allow_objects) :
+        buffer(p_buffer),
+        length(p_length),
+        allow_objects(p_allow_objects) {
+}
+
+Error VariantReader::peek_type(VariantType &r_type) const {
+
+    ERR_FAIL_COND_V(length - position < 4, ERR_FILE_EOF);
+    uint32_t type = decode_uint32(buffer + position) & ENCODE_MASK;
+    ERR_FAIL_COND_V(type >= uint32_t(VariantType::VARIANT_MAX), ERR_INVALID_DATA);
+    r_type = VariantType(type);
+    return OK;
+}
+
+Error VariantReader::_peek_header(VariantType &r_type, uint32_t &r_value) const {
+
+    Error err = peek_type(r_type);
+    if (err != OK) {
+        return err;
+    }
+    ERR_FAIL_COND_V(length - position < 8, ERR_FILE_EOF);
+    r_value = decode_uint32(buffer + position + 4);
+    return OK;
+}
+
+Error VariantReader::read(Variant &r_variant) {
+
+    int used = 0;
+    Error err = decode_variant(r_variant, buffer + position, length - position, &used, allow_objects);
+    if (err == OK) {
+        position += used;
+    }
+    return err;
+}
+
+Error VariantReader::read_string(StringView &r_string) {
+
+    VariantType type;
+    uint32_t len;
+    Error err = _peek_header(type, len);
+    if (err != OK) {
+        return err;
+    }
+    ERR_FAIL_COND_V(type != VariantType::STRING && type != VariantType::STRING_NAME, ERR_INVALID_DATA);
+    ERR_FAIL_COND_V(len > (1 << 24), ERR_INVALID_DATA);
+
+    uint32_t padded = (len + 3) & ~3U;
+    ERR_FAIL_COND_V(padded > uint32_t(length - position - 8), ERR_FILE_EOF);
+
+    r_string = StringView((const char *)buffer + position + 8, len);
+    position += 8 + padded;
+    return OK;
+}
+
+Error VariantReader::read_packed_array(PackedArrayView &r_view) {
+
+    VariantType type;
+    uint32_t count;
+    Error err = _peek_header(type, count);
+    if (err != OK) {
+        return err;
+    }
+
+    int element_size;
+    switch (type) {
+        case VariantType::POOL_BYTE_ARRAY: element_size = 1; break;
+        case VariantType::POOL_INT_ARRAY:
+        case VariantType::POOL_FLOAT32_ARRAY: element_size = 4; break;
+        case VariantType::POOL_VECTOR2_ARRAY: element_size = 4 * 2; break;
+        case VariantType::POOL_VECTOR3_ARRAY: element_size = 4 * 3; break;
+        case VariantType::POOL_COLOR_ARRAY: element_size = 4 * 4; break;
+        default: {
+            ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Not a packed array that can be viewed in place.");
+        }
+    }
+
+    uint32_t available = uint32_t(length - position - 8);
+    ERR_FAIL_COND_V(count > available / element_size, ERR_INVALID_DATA);
+
+    uint32_t size = count * element_size;
+    uint32_t padded = (size + 3) & ~3U; // Only byte arrays can end unaligned.
+    ERR_FAIL_COND_V(padded > available, ERR_FILE_EOF);
+
+    r_view.type = type;
+    r_view.count = int(count);
+    r_view.data = buffer + position + 8;
+    position += 8 + padded;
+    return OK;
+}
+
+Error VariantReader::read_array_header(int &r_count) {
+
+    VariantType type;
+    uint32_t count;
+    Error err = _peek_header(type, count);
+    if (err != OK) {
+        return err;
+    }
+    ERR_FAIL_COND_V(type != VariantType::ARRAY, ERR_INVALID_DATA);
+
+    r_count = int(count & 0x7FFFFFFF);
+    position += 8;
+    return OK;
+}
+
+Error VariantReader::read_dictionary_header(int &r_count) {
+
+    VariantType type;
+    uint32_t count;
+    Error err = _peek_header(type, count);
+    if (err != OK) {
+        return err;
+    }
+    ERR_FAIL_COND_V(type != VariantType::DICTIONARY, ERR_INVALID_DATA);
+
+    r_count = int(count & 0x7FFFFFFF);
+    position += 8;
+    return OK;
+}
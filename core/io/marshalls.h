@@ -30,9 +30,16 @@
 
 #pragma once
 #include "core/typedefs.h"
+#include "core/forward_decls.h"
+
+#include <climits>
 
 class Variant;
+struct Vector2;
+struct Vector3;
+struct Color;
 enum Error : int;
+enum class VariantType : int8_t;
 /**
  * Miscellaneous helpers for marshalling data types, and encoding
  * in an endian independent way
@@ -165,3 +172,92 @@ static inline double decode_double(const uint8_t *p_arr) {
 GODOT_EXPORT Error decode_variant(
         Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false);
 GODOT_EXPORT Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
+
+/**
+ * Single pass encoder producing the same bytes as encode_variant().
+ * Appends to a caller owned buffer which only grows, so keeping the buffer around between messages makes
+ * steady state encoding allocation free. Bytes past get_position() are left over from earlier use and are not
+ * part of the message.
+ */
+class GODOT_EXPORT VariantWriter {
+
+    Vector<uint8_t> &buffer;
+    int position;
+    int max_size = INT_MAX;
+    bool full_objects;
+    bool overflowed = false;
+
+    uint8_t *_reserve(int p_bytes);
+    Error _write_string(StringView p_string);
+    Error _write(const Variant &p_variant, int p_depth);
+
+public:
+    Error write(const Variant &p_variant);
+    //! Encode a STRING directly from a view, without building a Variant first.
+    void write_string(StringView p_string);
+    //! Start an ARRAY/DICTIONARY whose p_count elements (key/value pairs) follow through further writes.
+    void write_array_header(int p_count);
+    void write_dictionary_header(int p_count);
+
+    int get_position() const { return position; }
+    const uint8_t *get_data() const;
+    void reset(int p_position = 0) {
+        position = p_position;
+        overflowed = false;
+    }
+
+    //! Writes that would make the message longer than p_max_size bytes fail with ERR_OUT_OF_MEMORY, without growing the buffer.
+    //! Once that happened is_overflowed() is true and further writes are dropped until reset().
+    void set_max_size(int p_max_size) { max_size = p_max_size; }
+    bool is_overflowed() const { return overflowed; }
+
+    VariantWriter(Vector<uint8_t> &r_buffer, int p_position = 0, bool p_full_objects = false);
+};
+
+/**
+ * Packed array decoded in place by VariantReader. Elements are decoded on access, and the view points into
+ * the source buffer, so it is only valid as long as that buffer is.
+ */
+struct GODOT_EXPORT PackedArrayView {
+    const uint8_t *data = nullptr;
+    int count = 0;
+    VariantType type {};
+
+    uint8_t get_byte(int p_index) const { return data[p_index]; }
+    int32_t get_int(int p_index) const { return int32_t(decode_uint32(data + p_index * 4)); }
+    float get_float(int p_index) const { return decode_float(data + p_index * 4); }
+    Vector2 get_vector2(int p_index) const;
+    Vector3 get_vector3(int p_index) const;
+    Color get_color(int p_index) const;
+};
+
+/**
+ * Sequential decoder for the encode_variant() format.
+ * read() behaves like decode_variant(), while the typed readers hand out views into the buffer and container
+ * headers instead of materializing Strings, PoolVectors, Arrays or Dictionaries.
+ */
+class GODOT_EXPORT VariantReader {
+
+    const uint8_t *buffer;
+    int length;
+    int position = 0;
+    bool allow_objects;
+
+    Error _peek_header(VariantType &r_type, uint32_t &r_value) const;
+
+public:
+    Error peek_type(VariantType &r_type) const;
+    Error read(Variant &r_variant);
+    //! Accepts STRING and STRING_NAME; r_string points into the buffer.
+    Error read_string(StringView &r_string);
+    //! Accepts POOL_BYTE/INT/FLOAT32/VECTOR2/VECTOR3/COLOR_ARRAY.
+    Error read_packed_array(PackedArrayView &r_view);
+    //! Return the element count, the elements themselves follow and are read individually.
+    Error read_array_header(int &r_count);
+    Error read_dictionary_header(int &r_count);
+
+    int get_position() const { return position; }
+    bool is_at_end() const { return position >= length; }
+
+    VariantReader(const uint8_t *p_buffer, int p_length, bool p_allow_objects = false);
+};
@@ -31,6 +31,8 @@
 #include "multiplayer_api.h"
 
 #include "core/io/marshalls.h"
+#include "core/io/multiplayer_codec.h"
+#include "core/io/multiplayer_replicator.h"
 #include "core/callable_method_pointer.h"
 #include "core/method_bind.h"
 #include "scene/main/node.h"
@@ -256,6 +258,7 @@ _FORCE_INLINE_ bool _can_call_mode(Node *p_node, MultiplayerAPI_RPCMode mode, in
 
     return false;
 }
+
 } // end of anonymous namespace
 
 void MultiplayerAPI::poll() {
@@ -288,14 +291,21 @@ void MultiplayerAPI::poll() {
             break; // It's also possible that a packet or RPC caused a disconnection, so also check here.
         }
     }
+
+    if (network_peer && network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED) {
+        replicator->poll();
+    }
 }
 
 void MultiplayerAPI::clear() {
     connected_peers.clear();
     path_get_cache.clear();
     path_send_cache.clear();
+    path_send_ids.clear();
     packet_cache.clear();
+    rpc_args_cache.clear();
     last_send_cache_id = 1;
+    replicator->clear_peers();
 }
 
 
@@ -339,7 +349,7 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 #ifdef DEBUG_ENABLED
     m_debug_data->record_packet(p_packet_len);
 #endif
-    uint8_t packet_type = p_packet[0];
+    uint8_t packet_type = p_packet[0] & ~NETWORK_COMMAND_FLAG_NAME_ID;
 
     switch (packet_type) {
 
@@ -353,6 +363,16 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
             _process_confirm_path(p_from, p_packet, p_packet_len);
         } break;
 
+        case NETWORK_COMMAND_SIMPLIFY_NAME: {
+
+            _process_simplify_name(p_from, p_packet, p_packet_len);
+        } break;
+
+        case NETWORK_COMMAND_CONFIRM_NAME: {
+
+            _process_confirm_name(p_from, p_packet, p_packet_len);
+        } break;
+
         case NETWORK_COMMAND_REMOTE_CALL:
         case NETWORK_COMMAND_REMOTE_SET: {
 
@@ -362,25 +382,44 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 
             ERR_FAIL_COND_MSG(node == nullptr, "Invalid packet received. Requested node was not found.");
 
-            // Detect cstring end.
-            int len_end = 5;
-            for (; len_end < p_packet_len; len_end++) {
-                if (p_packet[len_end] == 0) {
-                    break;
+            StringName name;
+            int name_end;
+            if (p_packet[0] & NETWORK_COMMAND_FLAG_NAME_ID) {
+                // Name negotiated for this path, only sent along a cached path id.
+                ERR_FAIL_COND_MSG(p_packet_len < 7, "Invalid packet received. Size too small.");
+                uint32_t path_id = decode_uint32(&p_packet[1]);
+                ERR_FAIL_COND_MSG(path_id & 0x80000000, "Invalid packet received. Name id sent without a cached path.");
+
+                auto E = path_get_cache.find(p_from);
+                ERR_FAIL_COND_MSG(E == path_get_cache.end(), "Invalid packet received. Requests invalid peer cache.");
+                auto N = E->second.nodes.find(path_id);
+                ERR_FAIL_COND_MSG(N == E->second.nodes.end(), "Invalid packet received. Unabled to find requested cached node.");
+                auto F = N->second.names.find(decode_uint16(&p_packet[5]));
+                ERR_FAIL_COND_MSG(F == N->second.names.end(), "Invalid packet received. Unable to find requested cached name.");
+                name = F->second;
+                name_end = 7;
+            } else {
+                // Detect cstring end.
+                int len_end = 5;
+                for (; len_end < p_packet_len; len_end++) {
+                    if (p_packet[len_end] == 0) {
+                        break;
+                    }
                 }
-            }
 
-            ERR_FAIL_COND_MSG(len_end >= p_packet_len, "Invalid packet received. Size too small.");
+                ERR_FAIL_COND_MSG(len_end >= p_packet_len, "Invalid packet received. Size too small.");
 
-            StringName name(((const char *)&p_packet[5]));
+                name = StringName((const char *)&p_packet[5]);
+                name_end = len_end + 1;
+            }
 
             if (packet_type == NETWORK_COMMAND_REMOTE_CALL) {
 
-                _process_rpc(node, name, p_from, p_packet, p_packet_len, len_end + 1);
+                _process_rpc(node, name, p_from, p_packet, p_packet_len, name_end);
 
             } else {
 
-                _process_rset(node, name, p_from, p_packet, p_packet_len, len_end + 1);
+                _process_rset(node, name, p_from, p_packet, p_packet_len, name_end);
             }
 
         } break;
@@ -389,6 +428,16 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 
             _process_raw(p_from, p_packet, p_packet_len);
         } break;
+
+        case NETWORK_COMMAND_REPLICATE: {
+
+            replicator->process_snapshot(p_from, p_packet, p_packet_len);
+        } break;
+
+        case NETWORK_COMMAND_REPLICATE_ACK: {
+
+            replicator->process_ack(p_from, p_packet, p_packet_len);
+        } break;
     }
 }
 
@@ -469,7 +518,7 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const StringName &p_name, int p_
         ERR_FAIL_COND_MSG(p_offset >= p_packet_len, "Invalid packet received. Size too small.");
 
         int vlen;
-        Error err = decode_variant(args[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen, allow_object_decoding || network_peer->is_object_decoding_allowed());
+        Error err = MultiplayerCodec::decode_value(args[i], &p_packet[p_offset], p_packet_len - p_offset, vlen, allow_object_decoding || network_peer->is_object_decoding_allowed());
         ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RPC argument.");
 
         argp[i] = &args[i];
@@ -505,7 +554,8 @@ void MultiplayerAPI::_process_rset(Node *p_node, const StringName &p_name, int p
                                          ", master is " + ::to_string(p_node->get_network_master()) + ".");
 
     Variant value;
-    Error err = decode_variant(value, &p_packet[p_offset], p_packet_len - p_offset, nullptr, allow_object_decoding || network_peer->is_object_decoding_allowed());
+    int vlen;
+    Error err = MultiplayerCodec::decode_value(value, &p_packet[p_offset], p_packet_len - p_offset, vlen, allow_object_decoding || network_peer->is_object_decoding_allowed());
 
     ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RSET value.");
 
@@ -568,6 +618,47 @@ void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet,
     E->second = true;
 }
 
+void MultiplayerAPI::_process_simplify_name(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+    ERR_FAIL_COND_MSG(p_packet_len < 8, "Invalid packet received. Size too small.");
+    int path_id = decode_uint32(&p_packet[1]);
+    uint16_t name_id = decode_uint16(&p_packet[5]);
+
+    auto E = path_get_cache.find(p_from);
+    ERR_FAIL_COND_MSG(E == path_get_cache.end(), "Invalid packet received. Requests invalid peer cache.");
+    Map<int, PathGetCache::NodeInfo>::iterator F = E->second.nodes.find(path_id);
+    ERR_FAIL_COND_MSG(F == E->second.nodes.end(), "Invalid packet received. Name sent for a path which was not found in cache.");
+
+    F->second.names[name_id] = StringName(StringView((const char *)&p_packet[7], p_packet_len - 8));
+
+    // Send the ack.
+    uint8_t packet[7];
+    packet[0] = NETWORK_COMMAND_CONFIRM_NAME;
+    encode_uint32(path_id, &packet[1]);
+    encode_uint16(name_id, &packet[5]);
+
+    network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+    network_peer->set_target_peer(p_from);
+    network_peer->put_packet(packet, sizeof(packet));
+}
+
+void MultiplayerAPI::_process_confirm_name(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+    ERR_FAIL_COND_MSG(p_packet_len < 7, "Invalid packet received. Size too small.");
+    int path_id = decode_uint32(&p_packet[1]);
+    uint16_t name_id = decode_uint16(&p_packet[5]);
+
+    auto E = path_send_ids.find(path_id);
+    ERR_FAIL_COND_MSG(E == path_send_ids.end(), "Invalid packet received. Tries to confirm a name of a path which was not found in cache.");
+    PathSentCache &psc = path_send_cache[E->second];
+    ERR_FAIL_COND_MSG(name_id >= psc.name_list.size(), "Invalid packet received. Tries to confirm a name which was not found in cache.");
+
+    NameSentCache &nsc = psc.names[psc.name_list[name_id]];
+    Map<int, bool>::iterator F = nsc.confirmed_peers.find(p_from);
+    ERR_FAIL_COND_MSG(F == nsc.confirmed_peers.end(), "Invalid packet received. Source peer was not found in cache for the given name.");
+    F->second = true;
+}
+
 bool MultiplayerAPI::_send_confirm_path(const NodePath& p_path, PathSentCache *psc, int p_target) {
     bool has_all_peers = true;
     Vector<int> peers_to_add; // If one is missing, take note to add it.
@@ -618,6 +709,106 @@ bool MultiplayerAPI::_send_confirm_path(const NodePath& p_path, PathSentCache *p
     return has_all_peers;
 }
 
+bool MultiplayerAPI::_send_confirm_name(PathSentCache *psc, NameSentCache *nsc, const StringName &p_name, int p_target) {
+    bool has_all_peers = true;
+
+    for (int E : connected_peers) {
+
+        if (p_target < 0 && E == -p_target)
+            continue; // Continue, excluded.
+
+        if (p_target > 0 && E != p_target)
+            continue; // Continue, not for this peer.
+
+        Map<int, bool>::iterator P = psc->confirmed_peers.find(E);
+        if (P == psc->confirmed_peers.end() || !P->second) {
+            // The peer must know the path before it can store names for it.
+            has_all_peers = false;
+            continue;
+        }
+
+        Map<int, bool>::iterator F = nsc->confirmed_peers.find(E);
+        if (F != nsc->confirmed_peers.end()) {
+            has_all_peers = has_all_peers && F->second;
+            continue;
+        }
+
+        // Not sent yet, tell this peer which id the name will use.
+        StringView name(p_name);
+        Vector<uint8_t> packet;
+        packet.resize(1 + 4 + 2 + name.size() + 1);
+        packet[0] = NETWORK_COMMAND_SIMPLIFY_NAME;
+        encode_uint32(psc->id, &packet[1]);
+        encode_uint16(nsc->id, &packet[5]);
+        memcpy(&packet[7], name.data(), name.size());
+        packet[7 + name.size()] = 0;
+
+        network_peer->set_target_peer(E);
+        network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+        network_peer->put_packet(packet.data(), packet.size());
+
+        nsc->confirmed_peers.emplace(E, false);
+        has_all_peers = false;
+    }
+
+    return has_all_peers;
+}
+
+// Encodes the arguments once into rpc_args_cache, they are then copied into each packet variant.
+Error MultiplayerAPI::_encode_rpc_args(const Variant **p_arg, int p_argcount, bool p_set) {
+
+    const bool full_objects = allow_object_decoding || network_peer->is_object_decoding_allowed();
+    int ofs = 0;
+    if (!p_set) {
+        *MultiplayerCodec::reserve(rpc_args_cache, ofs, 1) = p_argcount;
+        ofs += 1;
+    }
+    for (int i = 0; i < p_argcount; i++) {
+        Error err = MultiplayerCodec::encode_value(*p_arg[i], rpc_args_cache, ofs, full_objects);
+        if (err != OK) {
+            return err;
+        }
+    }
+    rpc_args_cache.resize(ofs);
+    return OK;
+}
+
+// Builds a packet in packet_cache from the encoded arguments and returns its size. The name is sent as an id when
+// p_name_id isn't negative, and the path is appended when given (the target then holds its offset).
+int MultiplayerAPI::_make_rpc_packet(bool p_set, uint32_t p_target, const StringName &p_name, int p_name_id, const NodePath *p_path) {
+
+    uint8_t command = p_set ? NETWORK_COMMAND_REMOTE_SET : NETWORK_COMMAND_REMOTE_CALL;
+    int ofs = 5;
+    if (p_name_id >= 0) {
+        command |= NETWORK_COMMAND_FLAG_NAME_ID;
+        encode_uint16(p_name_id, MultiplayerCodec::reserve(packet_cache, ofs, 2));
+        ofs += 2;
+    } else {
+        StringView name(p_name);
+        uint8_t *w = MultiplayerCodec::reserve(packet_cache, ofs, name.size() + 1);
+        memcpy(w, name.data(), name.size());
+        w[name.size()] = 0;
+        ofs += name.size() + 1;
+    }
+
+    if (!rpc_args_cache.empty()) {
+        memcpy(MultiplayerCodec::reserve(packet_cache, ofs, rpc_args_cache.size()), rpc_args_cache.data(), rpc_args_cache.size());
+        ofs += rpc_args_cache.size();
+    }
+
+    if (p_path) {
+        p_target = 0x80000000 | ofs; // Offset to path and flag.
+        String pname(*p_path);
+        int path_len = encode_cstring(pname.data(), nullptr);
+        encode_cstring(pname.data(), MultiplayerCodec::reserve(packet_cache, ofs, path_len));
+        ofs += path_len;
+    }
+
+    packet_cache[0] = command;
+    encode_uint32(p_target, &packet_cache[1]);
+    return ofs;
+}
+
 void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount) {
 
     ERR_FAIL_COND_MSG(not network_peer, "Attempt to remote call/set when networking is not active in SceneTree.");
@@ -641,59 +832,27 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
     auto psc = path_send_cache.find(from_path);
     if (path_send_cache.end()==psc) {
         // Path is not cached, create.
-        psc = path_send_cache.emplace(eastl::make_pair(from_path, PathSentCache{{},last_send_cache_id++ })).first;
+        psc = path_send_cache.emplace(eastl::make_pair(from_path, PathSentCache{{},last_send_cache_id++,{},{} })).first;
+        path_send_ids[psc->second.id] = from_path;
     }
 
-    // Create base packet, lots of hardcode because it must be tight.
-
-    size_t ofs = 0;
-
-#define MAKE_ROOM(m_amount) \
-    if (packet_cache.size() < m_amount) packet_cache.resize(m_amount);
-
-    // Encode type.
-    MAKE_ROOM(1)
-    packet_cache[0] = p_set ? NETWORK_COMMAND_REMOTE_SET : NETWORK_COMMAND_REMOTE_CALL;
-    ofs += 1;
-
-    // Encode ID.
-    MAKE_ROOM(ofs + 4)
-    encode_uint32(psc->second.id, &packet_cache[ofs]);
-    ofs += 4;
-
-    // Encode function name.
-    String name(p_name);
-    int len = encode_cstring(name.data(), nullptr);
-    MAKE_ROOM(ofs + len)
-    encode_cstring(name.data(), &packet_cache[ofs]);
-    ofs += len;
-
-    if (p_set) {
-        // Set argument.
-        Error err = encode_variant(*p_arg[0], nullptr, len, allow_object_decoding || network_peer->is_object_decoding_allowed());
-        ERR_FAIL_COND_MSG(err != OK, "Unable to encode RSET value. THIS IS LIKELY A BUG IN THE ENGINE!");
-        MAKE_ROOM(ofs + len)
-        encode_variant(*p_arg[0], &packet_cache[ofs], len, allow_object_decoding || network_peer->is_object_decoding_allowed());
-        ofs += len;
-
-    } else {
-        // Call arguments.
-        MAKE_ROOM(ofs + 1)
-        packet_cache[ofs] = p_argcount;
-        ofs += 1;
-        for (int i = 0; i < p_argcount; i++) {
-            Error err = encode_variant(*p_arg[i], nullptr, len, allow_object_decoding || network_peer->is_object_decoding_allowed());
-            ERR_FAIL_COND_MSG(err != OK, "Unable to encode RPC argument. THIS IS LIKELY A BUG IN THE ENGINE!");
-            MAKE_ROOM(ofs + len)
-            encode_variant(*p_arg[i], &packet_cache[ofs], len, allow_object_decoding || network_peer->is_object_decoding_allowed());
-            ofs += len;
-        }
+    // See if the name is cached, ids are per path.
+    NameSentCache *nsc = nullptr;
+    auto N = psc->second.names.find(p_name);
+    if (N != psc->second.names.end()) {
+        nsc = &N->second;
+    } else if (psc->second.name_list.size() < UINT16_MAX) {
+        nsc = &psc->second.names[p_name];
+        nsc->id = psc->second.name_list.size();
+        psc->second.name_list.push_back(p_name);
     }
 
-    m_debug_data->record_rpc_call(ofs);
+    Error err = _encode_rpc_args(p_arg, p_argcount, p_set);
+    ERR_FAIL_COND_MSG(err != OK, "Unable to encode RPC argument. THIS IS LIKELY A BUG IN THE ENGINE!");
 
-    // See if all peers have cached path (is so, call can be fast).
+    // See if all peers have cached path and name (is so, call can be fast).
     bool has_all_peers = _send_confirm_path(from_path, &psc->second, p_to);
+    bool has_all_names = nsc && _send_confirm_name(&psc->second, nsc, p_name, p_to) && has_all_peers;
 
     // Take chance and set transfer mode, since all send methods will use it.
     network_peer->set_transfer_mode(p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
@@ -701,17 +860,13 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
     if (has_all_peers) {
 
         // They all have verified paths, so send fast.
+        int len = _make_rpc_packet(p_set, psc->second.id, p_name, has_all_names ? nsc->id : -1, nullptr);
+        m_debug_data->record_rpc_call(len);
         network_peer->set_target_peer(p_to); // To all of you.
-        network_peer->put_packet(packet_cache.data(), ofs); // A message with love.
+        network_peer->put_packet(packet_cache.data(), len); // A message with love.
     } else {
         // Not all verified path, so send one by one.
 
-        // Append path at the end, since we will need it for some packets.
-        String pname(from_path);
-        int path_len = encode_cstring(pname.data(), nullptr);
-        MAKE_ROOM(ofs + path_len)
-        encode_cstring(pname.data(), &(packet_cache[ofs]));
-
         for (int E : connected_peers) {
 
             if (p_to < 0 && E == -p_to)
@@ -725,15 +880,21 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 
             network_peer->set_target_peer(E); // To this one specifically.
 
+            int len;
             if (F->second) {
-                // This one confirmed path, so use id.
-                encode_uint32(psc->second.id, &packet_cache[1]);
-                network_peer->put_packet(packet_cache.data(), ofs);
+                // This one confirmed path, so use id. The name may be confirmed as well.
+                bool name_confirmed = false;
+                if (nsc) {
+                    Map<int, bool>::iterator G = nsc->confirmed_peers.find(E);
+                    name_confirmed = G != nsc->confirmed_peers.end() && G->second;
+                }
+                len = _make_rpc_packet(p_set, psc->second.id, p_name, name_confirmed ? nsc->id : -1, nullptr);
             } else {
                 // This one did not confirm path yet, so use entire path (sorry!).
-                encode_uint32(0x80000000 | ofs, &packet_cache[1]); // Offset to path and flag.
-                network_peer->put_packet(packet_cache.data(), ofs + path_len);
+                len = _make_rpc_packet(p_set, 0, p_name, -1, &from_path);
             }
+            m_debug_data->record_rpc_call(len);
+            network_peer->put_packet(packet_cache.data(), len);
         }
     }
 }
@@ -756,7 +917,11 @@ void MultiplayerAPI::_del_peer(int p_id) {
     for (const NodePath &E : keys) {
         auto psc = path_send_cache.find(E);
         psc->second.confirmed_peers.erase(p_id);
+        for (auto &N : psc->second.names) {
+            N.second.confirmed_peers.erase(p_id);
+        }
     }
+    replicator->remove_peer(p_id);
     emit_signal("network_peer_disconnected", p_id);
 }
 void MultiplayerAPI::_connected_to_server() {
@@ -909,7 +1074,7 @@ Error MultiplayerAPI::send_bytes(const PoolVector<uint8_t>& p_data, int p_to, Ne
     ERR_FAIL_COND_V_MSG(not network_peer, ERR_UNCONFIGURED, "Trying to send a raw packet while no network peer is active.");
     ERR_FAIL_COND_V_MSG(network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, ERR_UNCONFIGURED, "Trying to send a raw packet via a network peer which is not connected.");
 
-    MAKE_ROOM(p_data.size() + 1)
+    MultiplayerCodec::reserve(packet_cache, 0, p_data.size() + 1);
     PoolVector<uint8_t>::Read r = p_data.read();
     packet_cache[0] = NETWORK_COMMAND_RAW;
     memcpy(&packet_cache[1], &r[0], p_data.size());
@@ -979,6 +1144,38 @@ bool MultiplayerAPI::is_object_decoding_allowed() const {
     return allow_object_decoding;
 }
 
+Error MultiplayerAPI::add_replicated_node(Node *p_node, const Vector<String> &p_properties, float p_priority) {
+    return replicator->add_node(p_node, p_properties, p_priority);
+}
+
+void MultiplayerAPI::remove_replicated_node(Node *p_node) {
+    replicator->remove_node(p_node);
+}
+
+void MultiplayerAPI::set_replication_interest(int p_peer_id, const Vector3 &p_position, float p_radius) {
+    replicator->set_peer_interest(p_peer_id, p_position, p_radius);
+}
+
+void MultiplayerAPI::set_replication_cell_size(float p_size) {
+    replicator->set_cell_size(p_size);
+}
+
+float MultiplayerAPI::get_replication_cell_size() const {
+    return replicator->get_cell_size();
+}
+
+void MultiplayerAPI::set_replication_budget(int p_bytes) {
+    replicator->set_budget(p_bytes);
+}
+
+int MultiplayerAPI::get_replication_budget() const {
+    return replicator->get_budget();
+}
+
+int64_t MultiplayerAPI::get_replication_bytes_sent() const {
+    return replicator->get_bytes_sent();
+}
+
 void MultiplayerAPI::profiling_start() {
     m_debug_data->profiling_start();
 }
@@ -1023,9 +1220,19 @@ void MultiplayerAPI::_bind_methods() {
     SE_BIND_METHOD(MultiplayerAPI,is_refusing_new_network_connections);
     SE_BIND_METHOD(MultiplayerAPI,set_allow_object_decoding);
     SE_BIND_METHOD(MultiplayerAPI,is_object_decoding_allowed);
+    MethodBinder::bind_method(D_METHOD("add_replicated_node", {"node", "properties", "priority"}), &MultiplayerAPI::add_replicated_node, {DEFVAL(1.0f)});
+    SE_BIND_METHOD(MultiplayerAPI,remove_replicated_node);
+    SE_BIND_METHOD(MultiplayerAPI,set_replication_interest);
+    SE_BIND_METHOD(MultiplayerAPI,set_replication_cell_size);
+    SE_BIND_METHOD(MultiplayerAPI,get_replication_cell_size);
+    SE_BIND_METHOD(MultiplayerAPI,set_replication_budget);
+    SE_BIND_METHOD(MultiplayerAPI,get_replication_budget);
+    SE_BIND_METHOD(MultiplayerAPI,get_replication_bytes_sent);
 
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "refuse_new_network_connections"), "set_refuse_new_network_connections", "is_refusing_new_network_connections");
+    ADD_PROPERTY(PropertyInfo(VariantType::FLOAT, "replication_cell_size"), "set_replication_cell_size", "get_replication_cell_size");
+    ADD_PROPERTY(PropertyInfo(VariantType::INT, "replication_budget"), "set_replication_budget", "get_replication_budget");
     ADD_PROPERTY(PropertyInfo(VariantType::OBJECT, "network_peer", PropertyHint::ResourceType, "NetworkedMultiplayerPeer", 0), "set_network_peer", "get_network_peer");
     ADD_PROPERTY(PropertyInfo(VariantType::OBJECT, "root_node", PropertyHint::ResourceType, "Node", 0), "set_root_node", "get_root_node");
 
@@ -1058,10 +1265,12 @@ MultiplayerAPI::MultiplayerAPI() {
 #ifdef DEBUG_ENABLED
     m_debug_data = new DebugData;
 #endif
+    replicator = memnew(MultiplayerReplicator(this));
     clear();
 }
 
 MultiplayerAPI::~MultiplayerAPI() {
     delete m_debug_data;
     clear();
+    memdelete(replicator);
 }
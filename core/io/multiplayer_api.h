@@ -37,8 +37,10 @@
 #include "core/set.h"
 #include "core/string.h"
 #include "core/node_path.h"
+#include "core/math/vector3.h"
 
 class Node;
+class MultiplayerReplicator;
 
 enum MultiplayerAPI_NetworkCommands {
     NETWORK_COMMAND_REMOTE_CALL,
@@ -46,6 +48,14 @@ enum MultiplayerAPI_NetworkCommands {
     NETWORK_COMMAND_SIMPLIFY_PATH,
     NETWORK_COMMAND_CONFIRM_PATH,
     NETWORK_COMMAND_RAW,
+    NETWORK_COMMAND_SIMPLIFY_NAME,
+    NETWORK_COMMAND_CONFIRM_NAME,
+    NETWORK_COMMAND_REPLICATE,
+    NETWORK_COMMAND_REPLICATE_ACK,
+};
+// Set on the command byte of REMOTE_CALL/REMOTE_SET when the method or property is sent as a negotiated id.
+enum : uint8_t {
+    NETWORK_COMMAND_FLAG_NAME_ID = 0x80,
 };
 enum MultiplayerAPI_RPCMode : int8_t {
 
@@ -73,10 +83,18 @@ public:
         int outgoing_rset;
     };
 private:
+    //method/property names sent along a path, replaced by an id once a peer confirmed it
+    struct NameSentCache {
+        Map<int, bool> confirmed_peers;
+        uint16_t id;
+    };
+
     //path sent caches
     struct PathSentCache {
         Map<int, bool> confirmed_peers;
         int id;
+        HashMap<StringName, NameSentCache> names;
+        Vector<StringName> name_list; // by id
     };
 
     //path get caches
@@ -84,19 +102,24 @@ private:
         struct NodeInfo {
             NodePath path;
             GameEntity instance;
+            HashMap<uint16_t, StringName> names;
         };
 
         Map<int, NodeInfo> nodes;
     };
     class DebugData;
     DebugData *m_debug_data = nullptr;
+    friend class MultiplayerReplicator;
+    MultiplayerReplicator *replicator = nullptr;
     Ref<NetworkedMultiplayerPeer> network_peer;
     int rpc_sender_id;
     Set<int> connected_peers;
     HashMap<NodePath, PathSentCache, Hasher<NodePath> > path_send_cache;
+    HashMap<int, NodePath> path_send_ids;
     Map<int, PathGetCache> path_get_cache;
     int last_send_cache_id;
     Vector<uint8_t> packet_cache;
+    Vector<uint8_t> rpc_args_cache;
     Node *root_node;
     bool allow_object_decoding = false;
 
@@ -106,6 +129,8 @@ protected:
     void _process_packet(int p_from, const uint8_t *p_packet, int p_packet_len);
     void _process_simplify_path(int p_from, const uint8_t *p_packet, int p_packet_len);
     void _process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len);
+    void _process_simplify_name(int p_from, const uint8_t *p_packet, int p_packet_len);
+    void _process_confirm_name(int p_from, const uint8_t *p_packet, int p_packet_len);
     Node *_process_get_node(int p_from, const uint8_t *p_packet, int p_packet_len);
     void _process_rpc(Node *p_node, const StringName &p_name, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
     void _process_rset(Node *p_node, const StringName &p_name, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
@@ -113,6 +138,9 @@ protected:
 
     void _send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount);
     bool _send_confirm_path(const NodePath& p_path, PathSentCache *psc, int p_target);
+    bool _send_confirm_name(PathSentCache *psc, NameSentCache *nsc, const StringName &p_name, int p_target);
+    Error _encode_rpc_args(const Variant **p_arg, int p_argcount, bool p_set);
+    int _make_rpc_packet(bool p_set, uint32_t p_target, const StringName &p_name, int p_name_id, const NodePath *p_path);
 
 
 public:
@@ -149,6 +177,15 @@ public:
     void set_allow_object_decoding(bool p_enable);
     bool is_object_decoding_allowed() const;
 
+    Error add_replicated_node(Node *p_node, const Vector<String> &p_properties, float p_priority = 1.0f);
+    void remove_replicated_node(Node *p_node);
+    void set_replication_interest(int p_peer_id, const Vector3 &p_position, float p_radius);
+    void set_replication_cell_size(float p_size);
+    float get_replication_cell_size() const;
+    void set_replication_budget(int p_bytes);
+    int get_replication_budget() const;
+    int64_t get_replication_bytes_sent() const;
+
     void profiling_start();
     void profiling_end();
 
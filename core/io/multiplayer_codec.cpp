@@ -0,0 +1,246 @@
+/*************************************************************************/
+/*  multiplayer_codec.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "multiplayer_codec.h"
+
+#include "core/io/marshalls.h"
+#include "core/math/vector2.h"
+#include "core/math/vector3.h"
+#include "core/string.h"
+#include "core/variant.h"
+
+namespace MultiplayerCodec {
+
+namespace {
+// Values that don't get a tag of their own follow a TAG_VARIANT in the regular variant encoding.
+enum ValueTag : uint8_t {
+    TAG_VARIANT,
+    TAG_NIL,
+    TAG_FALSE,
+    TAG_TRUE,
+    TAG_INT8,
+    TAG_INT16,
+    TAG_INT32,
+    TAG_INT64,
+    TAG_FLOAT32,
+    TAG_FLOAT64,
+    TAG_VECTOR2,
+    TAG_VECTOR3,
+    TAG_STRING,
+};
+} // namespace
+
+uint8_t *reserve(Vector<uint8_t> &r_buffer, int p_ofs, int p_amount) {
+    if ((int)r_buffer.size() < p_ofs + p_amount) {
+        r_buffer.resize(M_MAX(p_ofs + p_amount, (int)r_buffer.size() * 2));
+    }
+    return &r_buffer[p_ofs];
+}
+
+int encode_varint(uint32_t p_value, uint8_t *r_buffer) {
+    int len = 0;
+    while (p_value >= 0x80) {
+        r_buffer[len++] = uint8_t(p_value | 0x80);
+        p_value >>= 7;
+    }
+    r_buffer[len++] = uint8_t(p_value);
+    return len;
+}
+
+Error decode_varint(const uint8_t *p_buffer, int p_len, uint32_t &r_value, int &r_len) {
+    r_value = 0;
+    for (int i = 0; i < 5; i++) {
+        ERR_FAIL_COND_V(i >= p_len, ERR_INVALID_DATA);
+        r_value |= uint32_t(p_buffer[i] & 0x7F) << (7 * i);
+        if (!(p_buffer[i] & 0x80)) {
+            r_len = i + 1;
+            return OK;
+        }
+    }
+    return ERR_INVALID_DATA;
+}
+
+Error encode_value(const Variant &p_value, Vector<uint8_t> &r_buffer, int &r_ofs, bool p_full_objects) {
+
+    switch (p_value.get_type()) {
+        case VariantType::NIL: {
+            *reserve(r_buffer, r_ofs, 1) = TAG_NIL;
+            r_ofs += 1;
+        } break;
+        case VariantType::BOOL: {
+            *reserve(r_buffer, r_ofs, 1) = p_value.as<bool>() ? TAG_TRUE : TAG_FALSE;
+            r_ofs += 1;
+        } break;
+        case VariantType::INT: {
+            int64_t val = p_value.as<int64_t>();
+            uint8_t *w = reserve(r_buffer, r_ofs, 9);
+            if (val >= INT8_MIN && val <= INT8_MAX) {
+                w[0] = TAG_INT8;
+                w[1] = uint8_t(int8_t(val));
+                r_ofs += 2;
+            } else if (val >= INT16_MIN && val <= INT16_MAX) {
+                w[0] = TAG_INT16;
+                r_ofs += 1 + encode_uint16(uint16_t(int16_t(val)), &w[1]);
+            } else if (val >= INT32_MIN && val <= INT32_MAX) {
+                w[0] = TAG_INT32;
+                r_ofs += 1 + encode_uint32(uint32_t(int32_t(val)), &w[1]);
+            } else {
+                w[0] = TAG_INT64;
+                r_ofs += 1 + encode_uint64(uint64_t(val), &w[1]);
+            }
+        } break;
+        case VariantType::FLOAT: {
+            double d = p_value.as<double>();
+            float f = float(d);
+            uint8_t *w = reserve(r_buffer, r_ofs, 9);
+            if (double(f) == d) {
+                w[0] = TAG_FLOAT32;
+                r_ofs += 1 + encode_float(f, &w[1]);
+            } else {
+                w[0] = TAG_FLOAT64;
+                r_ofs += 1 + encode_double(d, &w[1]);
+            }
+        } break;
+        case VariantType::VECTOR2: {
+            Vector2 v = p_value.as<Vector2>();
+            uint8_t *w = reserve(r_buffer, r_ofs, 1 + 4 * 2);
+            w[0] = TAG_VECTOR2;
+            encode_float(v.x, &w[1]);
+            encode_float(v.y, &w[5]);
+            r_ofs += 1 + 4 * 2;
+        } break;
+        case VariantType::VECTOR3: {
+            Vector3 v = p_value.as<Vector3>();
+            uint8_t *w = reserve(r_buffer, r_ofs, 1 + 4 * 3);
+            w[0] = TAG_VECTOR3;
+            encode_float(v.x, &w[1]);
+            encode_float(v.y, &w[5]);
+            encode_float(v.z, &w[9]);
+            r_ofs += 1 + 4 * 3;
+        } break;
+        case VariantType::STRING: {
+            String str = p_value.as<String>();
+            uint8_t *w = reserve(r_buffer, r_ofs, 1 + 5 + str.size());
+            w[0] = TAG_STRING;
+            int len = 1 + encode_varint(str.size(), &w[1]);
+            memcpy(&w[len], str.data(), str.size());
+            r_ofs += len + str.size();
+        } break;
+        default: {
+            *reserve(r_buffer, r_ofs, 1) = TAG_VARIANT;
+            VariantWriter writer(r_buffer, r_ofs + 1, p_full_objects);
+            Error err = writer.write(p_value);
+            ERR_FAIL_COND_V(err != OK, err);
+            r_ofs = writer.get_position();
+        } break;
+    }
+    return OK;
+}
+
+Error decode_value(Variant &r_value, const uint8_t *p_buffer, int p_len, int &r_len, bool p_allow_objects) {
+
+    ERR_FAIL_COND_V(p_len < 1, ERR_INVALID_DATA);
+    const uint8_t *buf = &p_buffer[1];
+    const int len = p_len - 1;
+
+    switch (p_buffer[0]) {
+        case TAG_VARIANT: {
+            int vlen;
+            Error err = decode_variant(r_value, buf, len, &vlen, p_allow_objects);
+            if (err != OK) {
+                return err;
+            }
+            r_len = 1 + vlen;
+        } break;
+        case TAG_NIL: {
+            r_value = Variant();
+            r_len = 1;
+        } break;
+        case TAG_FALSE:
+        case TAG_TRUE: {
+            r_value = p_buffer[0] == TAG_TRUE;
+            r_len = 1;
+        } break;
+        case TAG_INT8: {
+            ERR_FAIL_COND_V(len < 1, ERR_INVALID_DATA);
+            r_value = int64_t(int8_t(buf[0]));
+            r_len = 2;
+        } break;
+        case TAG_INT16: {
+            ERR_FAIL_COND_V(len < 2, ERR_INVALID_DATA);
+            r_value = int64_t(int16_t(decode_uint16(buf)));
+            r_len = 3;
+        } break;
+        case TAG_INT32: {
+            ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+            r_value = int64_t(int32_t(decode_uint32(buf)));
+            r_len = 5;
+        } break;
+        case TAG_INT64: {
+            ERR_FAIL_COND_V(len < 8, ERR_INVALID_DATA);
+            r_value = int64_t(decode_uint64(buf));
+            r_len = 9;
+        } break;
+        case TAG_FLOAT32: {
+            ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+            r_value = decode_float(buf);
+            r_len = 5;
+        } break;
+        case TAG_FLOAT64: {
+            ERR_FAIL_COND_V(len < 8, ERR_INVALID_DATA);
+            r_value = decode_double(buf);
+            r_len = 9;
+        } break;
+        case TAG_VECTOR2: {
+            ERR_FAIL_COND_V(len < 4 * 2, ERR_INVALID_DATA);
+            r_value = Vector2(decode_float(&buf[0]), decode_float(&buf[4]));
+            r_len = 1 + 4 * 2;
+        } break;
+        case TAG_VECTOR3: {
+            ERR_FAIL_COND_V(len < 4 * 3, ERR_INVALID_DATA);
+            r_value = Vector3(decode_float(&buf[0]), decode_float(&buf[4]), decode_float(&buf[8]));
+            r_len = 1 + 4 * 3;
+        } break;
+        case TAG_STRING: {
+            uint32_t str_len;
+            int varint_len;
+            Error err = decode_varint(buf, len, str_len, varint_len);
+            ERR_FAIL_COND_V(err != OK, err);
+            ERR_FAIL_COND_V(int64_t(varint_len) + str_len > int64_t(len), ERR_INVALID_DATA);
+            r_value = String((const char *)&buf[varint_len], str_len);
+            r_len = 1 + varint_len + str_len;
+        } break;
+        default: {
+            ERR_FAIL_V(ERR_INVALID_DATA);
+        }
+    }
+    return OK;
+}
+} // namespace MultiplayerCodec
@@ -0,0 +1,51 @@
+/*************************************************************************/
+/*  multiplayer_codec.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/error_list.h"
+#include "core/vector.h"
+
+class Variant;
+
+// Compact encoding shared by RPC arguments, RSET values and replicated state: the common small
+// types get a one byte tag and a tight payload, everything else falls back to the regular variant encoding.
+namespace MultiplayerCodec {
+
+// Makes room for p_amount bytes at p_ofs and returns where to write them.
+uint8_t *reserve(Vector<uint8_t> &r_buffer, int p_ofs, int p_amount);
+
+int encode_varint(uint32_t p_value, uint8_t *r_buffer);
+Error decode_varint(const uint8_t *p_buffer, int p_len, uint32_t &r_value, int &r_len);
+
+Error encode_value(const Variant &p_value, Vector<uint8_t> &r_buffer, int &r_ofs, bool p_full_objects);
+Error decode_value(Variant &r_value, const uint8_t *p_buffer, int p_len, int &r_len, bool p_allow_objects);
+
+} // namespace MultiplayerCodec
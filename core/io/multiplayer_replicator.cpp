@@ -0,0 +1,480 @@
+/*************************************************************************/
+/*  multiplayer_replicator.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "multiplayer_replicator.h"
+
+#include "core/io/marshalls.h"
+#include "core/io/multiplayer_api.h"
+#include "core/io/multiplayer_codec.h"
+#include "core/math/transform.h"
+#include "core/math/vector2.h"
+#include "core/string_formatter.h"
+#include "core/string_utils.h"
+#include "scene/main/node.h"
+
+#include "EASTL/sort.h"
+
+namespace {
+// Snapshots that were never acknowledged are forgotten past this, the next ones carry their changes anyway.
+constexpr int MAX_IN_FLIGHT_SNAPSHOTS = 64;
+constexpr int MAX_REPLICATED_PROPERTIES = 32;
+constexpr int SNAPSHOT_HEADER_SIZE = 1 + 4;
+// Grid coordinates are packed into 21 bits each.
+constexpr int CELL_COORD_BITS = 21;
+constexpr int CELL_COORD_MASK = (1 << CELL_COORD_BITS) - 1;
+} // namespace
+
+uint64_t MultiplayerReplicator::_cell_key(int p_x, int p_y, int p_z) const {
+    return (uint64_t(p_x & CELL_COORD_MASK) << (2 * CELL_COORD_BITS)) | (uint64_t(p_y & CELL_COORD_MASK) << CELL_COORD_BITS) | uint64_t(p_z & CELL_COORD_MASK);
+}
+
+Error MultiplayerReplicator::add_node(Node *p_node, const Vector<String> &p_properties, float p_priority) {
+
+    ERR_FAIL_NULL_V(p_node, ERR_INVALID_PARAMETER);
+    ERR_FAIL_COND_V_MSG(!p_node->is_inside_tree(), ERR_UNCONFIGURED, "Only nodes inside the SceneTree can be replicated.");
+    ERR_FAIL_COND_V_MSG(p_properties.empty() || p_properties.size() > MAX_REPLICATED_PROPERTIES, ERR_INVALID_PARAMETER,
+            FormatVE("Between 1 and %d properties can be replicated per node.", MAX_REPLICATED_PROPERTIES));
+    ERR_FAIL_COND_V(p_priority <= 0, ERR_INVALID_PARAMETER);
+
+    Node *root = multiplayer->get_root_node();
+    ERR_FAIL_COND_V_MSG(root == nullptr, ERR_UNCONFIGURED, "Multiplayer root node was not initialized.");
+
+    // Both ends register the same node, its path below the root identifies it on the wire.
+    const String path = (String)root->get_path().rel_path_to(p_node->get_path());
+    const uint32_t id = StringUtils::hash(path.data(), path.size());
+
+    auto E = node_index.find(id);
+    if (E != node_index.end()) {
+        ERR_FAIL_COND_V_MSG(nodes[E->second].instance != p_node->get_instance_id(), ERR_ALREADY_EXISTS,
+                "Another replicated node has the same id as '" + path + "'.");
+        _remove_node_at(E->second);
+    }
+
+    TrackedNode tracked;
+    tracked.instance = p_node->get_instance_id();
+    tracked.id = id;
+    tracked.priority = p_priority;
+    tracked.local = false;
+    if (p_node->is_class("Node3D")) {
+        tracked.position_source = POSITION_3D;
+    } else if (p_node->is_class("Node2D")) {
+        tracked.position_source = POSITION_2D;
+    } else {
+        tracked.position_source = POSITION_NONE;
+    }
+    tracked.properties.reserve(p_properties.size());
+    for (const String &property : p_properties) {
+        tracked.properties.emplace_back(property);
+    }
+    tracked.values.resize(p_properties.size());
+
+    node_index[id] = nodes.size();
+    nodes.emplace_back(eastl::move(tracked));
+    return OK;
+}
+
+void MultiplayerReplicator::remove_node(Node *p_node) {
+
+    ERR_FAIL_NULL(p_node);
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].instance == p_node->get_instance_id()) {
+            _remove_node_at(i);
+            return;
+        }
+    }
+}
+
+void MultiplayerReplicator::_remove_node_at(int p_index) {
+
+    const uint32_t id = nodes[p_index].id;
+    for (auto &E : peers) {
+        E.second.baselines.erase(id);
+    }
+    node_index.erase(id);
+
+    if (p_index != int(nodes.size()) - 1) {
+        nodes[p_index] = eastl::move(nodes.back());
+        node_index[nodes[p_index].id] = p_index;
+    }
+    nodes.pop_back();
+}
+
+void MultiplayerReplicator::set_peer_interest(int p_peer_id, const Vector3 &p_position, float p_radius) {
+
+    PeerState &peer = peers[p_peer_id];
+    peer.interest_position = p_position;
+    peer.interest_radius = p_radius;
+}
+
+void MultiplayerReplicator::set_cell_size(float p_size) {
+
+    ERR_FAIL_COND(p_size <= 0);
+    cell_size = p_size;
+}
+
+void MultiplayerReplicator::set_budget(int p_bytes) {
+
+    ERR_FAIL_COND(p_bytes < 0);
+    budget = p_bytes;
+}
+
+void MultiplayerReplicator::_refresh_nodes() {
+
+    static const StringName global_transform("global_transform");
+    static const StringName global_position("global_position");
+
+    const int unique_id = multiplayer->get_network_unique_id();
+
+    for (int i = nodes.size() - 1; i >= 0; i--) {
+        Node *node = object_cast<Node>(object_for_entity(nodes[i].instance));
+        if (!node || !node->is_inside_tree()) {
+            // Freed or removed from the tree, stop replicating it.
+            _remove_node_at(i);
+            continue;
+        }
+
+        TrackedNode &tracked = nodes[i];
+        tracked.local = node->get_network_master() == unique_id;
+        if (!tracked.local) {
+            continue;
+        }
+
+        for (size_t j = 0; j < tracked.properties.size(); j++) {
+            tracked.values[j] = node->get(tracked.properties[j]);
+        }
+
+        switch (tracked.position_source) {
+            case POSITION_NONE: {
+            } break;
+            case POSITION_2D: {
+                Vector2 position = node->get(global_position).as<Vector2>();
+                tracked.position = Vector3(position.x, position.y, 0);
+            } break;
+            case POSITION_3D: {
+                tracked.position = node->get(global_transform).as<Transform>().origin;
+            } break;
+        }
+    }
+}
+
+void MultiplayerReplicator::_build_grid() {
+
+    cell_nodes.clear();
+    cell_ranges.clear();
+    unpositioned_nodes.clear();
+
+    const float inv_cell_size = 1.0f / cell_size;
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        const TrackedNode &tracked = nodes[i];
+        if (!tracked.local) {
+            continue;
+        }
+        if (tracked.position_source == POSITION_NONE) {
+            unpositioned_nodes.push_back(i);
+            continue;
+        }
+        const Vector3 cell = (tracked.position * inv_cell_size).floor();
+        cell_nodes.emplace_back(_cell_key(int(cell.x), int(cell.y), int(cell.z)), int(i));
+    }
+
+    eastl::sort(cell_nodes.begin(), cell_nodes.end());
+
+    for (size_t i = 0; i < cell_nodes.size();) {
+        size_t end = i + 1;
+        while (end < cell_nodes.size() && cell_nodes[end].first == cell_nodes[i].first) {
+            end++;
+        }
+        cell_ranges[cell_nodes[i].first] = { int(i), int(end - i) };
+        i = end;
+    }
+}
+
+void MultiplayerReplicator::_gather_candidates(PeerState &p_peer) {
+
+    candidates.clear();
+
+    auto consider = [this, &p_peer](int p_node) {
+        const TrackedNode &tracked = nodes[p_node];
+        Baseline &baseline = p_peer.baselines[tracked.id];
+        if (baseline.values.size() != tracked.values.size()) {
+            baseline.values.resize(tracked.values.size());
+        }
+
+        uint32_t mask = 0;
+        for (size_t i = 0; i < tracked.values.size(); i++) {
+            if (!(baseline.known & (1u << i)) || tracked.values[i] != baseline.values[i]) {
+                mask |= 1u << i;
+            }
+        }
+        if (mask) {
+            baseline.waited_priority += tracked.priority;
+            candidates.push_back({ p_node, mask, baseline.waited_priority });
+        }
+    };
+
+    for (int node : unpositioned_nodes) {
+        consider(node);
+    }
+
+    if (p_peer.interest_radius < 0) {
+        for (const eastl::pair<uint64_t, int> &E : cell_nodes) {
+            consider(E.second);
+        }
+        return;
+    }
+
+    const float radius = p_peer.interest_radius;
+    const float radius_squared = radius * radius;
+    const Vector3 &center = p_peer.interest_position;
+    auto consider_in_range = [&](int p_node) {
+        if (nodes[p_node].position.distance_squared_to(center) <= radius_squared) {
+            consider(p_node);
+        }
+    };
+
+    const float inv_cell_size = 1.0f / cell_size;
+    const Vector3 from = ((center - Vector3(radius, radius, radius)) * inv_cell_size).floor();
+    const Vector3 to = ((center + Vector3(radius, radius, radius)) * inv_cell_size).floor();
+    const float cell_count = (to.x - from.x + 1) * (to.y - from.y + 1) * (to.z - from.z + 1);
+
+    if (cell_count >= cell_ranges.size()) {
+        // Covers more cells than are occupied, scanning all nodes is cheaper.
+        for (const eastl::pair<uint64_t, int> &E : cell_nodes) {
+            consider_in_range(E.second);
+        }
+        return;
+    }
+
+    for (int x = int(from.x); x <= int(to.x); x++) {
+        for (int y = int(from.y); y <= int(to.y); y++) {
+            for (int z = int(from.z); z <= int(to.z); z++) {
+                auto E = cell_ranges.find(_cell_key(x, y, z));
+                if (E == cell_ranges.end()) {
+                    continue;
+                }
+                for (int i = 0; i < E->second.second; i++) {
+                    consider_in_range(cell_nodes[E->second.first + i].second);
+                }
+            }
+        }
+    }
+}
+
+void MultiplayerReplicator::_send_snapshot(int p_peer_id, PeerState &p_peer) {
+
+    _gather_candidates(p_peer);
+    if (candidates.empty()) {
+        return;
+    }
+
+    // Longest waiting first, so nodes left out by the budget eventually get their turn.
+    eastl::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.priority > b.priority;
+    });
+
+    Snapshot snapshot;
+    snapshot.sequence = p_peer.next_sequence++;
+
+    uint8_t *w = MultiplayerCodec::reserve(packet, 0, SNAPSHOT_HEADER_SIZE);
+    w[0] = NETWORK_COMMAND_REPLICATE;
+    encode_uint32(snapshot.sequence, &w[1]);
+    int ofs = SNAPSHOT_HEADER_SIZE;
+
+    for (const Candidate &candidate : candidates) {
+        const TrackedNode &tracked = nodes[candidate.node];
+
+        const int entry_start = ofs;
+        encode_uint32(tracked.id, MultiplayerCodec::reserve(packet, ofs, 4 + 5));
+        ofs += 4;
+        ofs += MultiplayerCodec::encode_varint(candidate.mask, &packet[ofs]);
+
+        SentEntry entry;
+        entry.id = tracked.id;
+        entry.mask = candidate.mask;
+        bool failed = false;
+        for (size_t i = 0; i < tracked.values.size(); i++) {
+            if (!(candidate.mask & (1u << i))) {
+                continue;
+            }
+            if (MultiplayerCodec::encode_value(tracked.values[i], packet, ofs, false) != OK) {
+                failed = true;
+                break;
+            }
+            entry.values.push_back(tracked.values[i]);
+        }
+        if (failed) {
+            ofs = entry_start;
+            ERR_CONTINUE_MSG(true, "Unable to encode a replicated property.");
+        }
+
+        if (budget > 0 && ofs > budget && !snapshot.entries.empty()) {
+            // Over budget, it waits for a later snapshot with a higher priority.
+            ofs = entry_start;
+            continue;
+        }
+
+        p_peer.baselines[tracked.id].waited_priority = 0;
+        snapshot.entries.emplace_back(eastl::move(entry));
+    }
+
+    multiplayer->network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE);
+    multiplayer->network_peer->set_target_peer(p_peer_id);
+    multiplayer->network_peer->put_packet(packet.data(), ofs);
+    bytes_sent += ofs;
+
+    if (p_peer.in_flight.size() >= MAX_IN_FLIGHT_SNAPSHOTS) {
+        p_peer.in_flight.pop_front();
+    }
+    p_peer.in_flight.emplace_back(eastl::move(snapshot));
+}
+
+void MultiplayerReplicator::poll() {
+
+    if (nodes.empty()) {
+        return;
+    }
+
+    _refresh_nodes();
+    _build_grid();
+    if (cell_nodes.empty() && unpositioned_nodes.empty()) {
+        return;
+    }
+
+    for (int peer_id : multiplayer->connected_peers) {
+        _send_snapshot(peer_id, peers[peer_id]);
+    }
+}
+
+void MultiplayerReplicator::process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+    ERR_FAIL_COND_MSG(p_packet_len < SNAPSHOT_HEADER_SIZE, "Invalid packet received. Size too small.");
+
+    PeerState &peer = peers[p_from];
+    const uint32_t sequence = decode_uint32(&p_packet[1]);
+    if (sequence <= peer.last_received) {
+        return; // Arrived after a newer one, which already carried its changes.
+    }
+
+    const bool allow_objects = multiplayer->allow_object_decoding || multiplayer->network_peer->is_object_decoding_allowed();
+
+    int ofs = SNAPSHOT_HEADER_SIZE;
+    while (ofs < p_packet_len) {
+        ERR_FAIL_COND_MSG(ofs + 4 > p_packet_len, "Invalid packet received. Size too small.");
+        const uint32_t id = decode_uint32(&p_packet[ofs]);
+        ofs += 4;
+
+        uint32_t mask;
+        int len;
+        ERR_FAIL_COND_MSG(MultiplayerCodec::decode_varint(&p_packet[ofs], p_packet_len - ofs, mask, len) != OK, "Invalid packet received. Malformed replicated node.");
+        ofs += len;
+
+        // Values of nodes this peer doesn't replicate, or doesn't accept from the sender, are decoded and skipped.
+        Node *node = nullptr;
+        const TrackedNode *tracked = nullptr;
+        auto E = node_index.find(id);
+        if (E != node_index.end()) {
+            tracked = &nodes[E->second];
+            node = object_cast<Node>(object_for_entity(tracked->instance));
+            if (node && node->get_network_master() != p_from) {
+                node = nullptr;
+            }
+        }
+        ERR_FAIL_COND_MSG(tracked && (uint64_t(mask) >> tracked->properties.size()), "Invalid packet received. Unknown replicated property.");
+
+        for (int i = 0; mask; i++, mask >>= 1) {
+            if (!(mask & 1)) {
+                continue;
+            }
+            Variant value;
+            ERR_FAIL_COND_MSG(MultiplayerCodec::decode_value(value, &p_packet[ofs], p_packet_len - ofs, len, allow_objects) != OK, "Invalid packet received. Unable to decode replicated property.");
+            ofs += len;
+            if (node) {
+                node->set(tracked->properties[i], value);
+            }
+        }
+    }
+
+    peer.last_received = sequence;
+
+    uint8_t ack[SNAPSHOT_HEADER_SIZE];
+    ack[0] = NETWORK_COMMAND_REPLICATE_ACK;
+    encode_uint32(sequence, &ack[1]);
+    multiplayer->network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE);
+    multiplayer->network_peer->set_target_peer(p_from);
+    multiplayer->network_peer->put_packet(ack, SNAPSHOT_HEADER_SIZE);
+}
+
+void MultiplayerReplicator::process_ack(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+    ERR_FAIL_COND_MSG(p_packet_len < SNAPSHOT_HEADER_SIZE, "Invalid packet received. Size too small.");
+
+    auto P = peers.find(p_from);
+    if (P == peers.end()) {
+        return;
+    }
+    PeerState &peer = P->second;
+    const uint32_t sequence = decode_uint32(&p_packet[1]);
+
+    // Older snapshots are dropped unapplied: anything they carried that still differs is in the acknowledged one.
+    while (!peer.in_flight.empty() && peer.in_flight.front().sequence < sequence) {
+        peer.in_flight.pop_front();
+    }
+    if (peer.in_flight.empty() || peer.in_flight.front().sequence != sequence) {
+        return; // Late or duplicate.
+    }
+
+    for (SentEntry &entry : peer.in_flight.front().entries) {
+        auto B = peer.baselines.find(entry.id);
+        if (B == peer.baselines.end()) {
+            continue; // Stopped replicating since.
+        }
+        Baseline &baseline = B->second;
+        int value = 0;
+        for (size_t i = 0; i < baseline.values.size(); i++) {
+            if (entry.mask & (1u << i)) {
+                baseline.values[i] = eastl::move(entry.values[value++]);
+            }
+        }
+        baseline.known |= entry.mask;
+    }
+    peer.in_flight.pop_front();
+}
+
+void MultiplayerReplicator::remove_peer(int p_peer_id) {
+
+    peers.erase(p_peer_id);
+}
+
+void MultiplayerReplicator::clear_peers() {
+
+    peers.clear();
+}
@@ -0,0 +1,147 @@
+/*************************************************************************/
+/*  multiplayer_replicator.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/deque.h"
+#include "core/engine_entities.h"
+#include "core/error_list.h"
+#include "core/hash_map.h"
+#include "core/math/vector3.h"
+#include "core/string_name.h"
+#include "core/variant.h"
+#include "core/vector.h"
+
+class MultiplayerAPI;
+class Node;
+
+// Replicates registered node properties from their network master to the peers interested in them.
+//
+// Every poll the master sends each connected peer one unreliable snapshot holding the properties that differ
+// from what that peer acknowledged last, so unchanged state costs nothing and lost snapshots are repaired by
+// the next one. Nodes with a position (Node2D, Node3D) are only sent to peers whose interest area contains
+// them, looked up through a uniform grid, and an optional per-peer byte budget sends the nodes that waited
+// longest (weighted by priority) first.
+class MultiplayerReplicator {
+
+    enum PositionSource : uint8_t {
+        POSITION_NONE,
+        POSITION_2D,
+        POSITION_3D,
+    };
+
+    struct TrackedNode {
+        GameEntity instance;
+        uint32_t id;
+        float priority;
+        PositionSource position_source;
+        bool local; // This peer is the network master and sends the node.
+        Vector<StringName> properties;
+        // Refreshed every poll for local nodes.
+        Vector<Variant> values;
+        Vector3 position;
+    };
+
+    // What a peer is known to have for one node.
+    struct Baseline {
+        Vector<Variant> values;
+        uint32_t known = 0; // Properties acknowledged at least once.
+        float waited_priority = 0; // Grows every poll the node had changes but was left out.
+    };
+
+    struct SentEntry {
+        uint32_t id;
+        uint32_t mask;
+        Vector<Variant> values; // One per bit set in mask.
+    };
+
+    struct Snapshot {
+        uint32_t sequence;
+        Vector<SentEntry> entries;
+    };
+
+    struct PeerState {
+        Vector3 interest_position;
+        float interest_radius = -1; // Negative means interested in everything.
+        uint32_t next_sequence = 1;
+        uint32_t last_received = 0; // Newest snapshot applied from this peer.
+        HashMap<uint32_t, Baseline> baselines;
+        Dequeue<Snapshot> in_flight;
+    };
+
+    struct Candidate {
+        int node;
+        uint32_t mask;
+        float priority;
+    };
+
+    MultiplayerAPI *multiplayer;
+    Vector<TrackedNode> nodes;
+    HashMap<uint32_t, int> node_index;
+    HashMap<int, PeerState> peers;
+
+    // Interest grid over the positioned local nodes, rebuilt every poll: cell_nodes is sorted by cell and
+    // cell_ranges maps a cell to its (start, count) run in it.
+    float cell_size = 64;
+    Vector<eastl::pair<uint64_t, int>> cell_nodes;
+    HashMap<uint64_t, eastl::pair<int, int>> cell_ranges;
+    Vector<int> unpositioned_nodes;
+
+    int budget = 0;
+    uint64_t bytes_sent = 0;
+    Vector<Candidate> candidates;
+    Vector<uint8_t> packet;
+
+    uint64_t _cell_key(int p_x, int p_y, int p_z) const;
+    void _remove_node_at(int p_index);
+    void _refresh_nodes();
+    void _build_grid();
+    void _gather_candidates(PeerState &p_peer);
+    void _send_snapshot(int p_peer_id, PeerState &p_peer);
+
+public:
+    Error add_node(Node *p_node, const Vector<String> &p_properties, float p_priority);
+    void remove_node(Node *p_node);
+
+    void set_peer_interest(int p_peer_id, const Vector3 &p_position, float p_radius);
+    void set_cell_size(float p_size);
+    float get_cell_size() const { return cell_size; }
+    void set_budget(int p_bytes);
+    int get_budget() const { return budget; }
+    uint64_t get_bytes_sent() const { return bytes_sent; }
+
+    void poll();
+    void process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len);
+    void process_ack(int p_from, const uint8_t *p_packet, int p_packet_len);
+    void remove_peer(int p_peer_id);
+    void clear_peers();
+
+    explicit MultiplayerReplicator(MultiplayerAPI *p_multiplayer) : multiplayer(p_multiplayer) {}
+};
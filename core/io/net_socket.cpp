@@ -40,3 +40,19 @@ NetSocket *NetSocket::create() {
     ERR_PRINT("Unable to create network socket, platform not supported");
     return nullptr;
 }
+
+Error NetSocket::send_vectored(const uint8_t *p_head, int p_head_len, const uint8_t *p_body, int p_body_len, int &r_sent) {
+
+    Error err = send(p_head, p_head_len, r_sent);
+    if (err != OK || r_sent < p_head_len || p_body_len == 0) {
+        return err;
+    }
+    int body_sent = 0;
+    err = send(p_body, p_body_len, body_sent);
+    if (err == ERR_BUSY) {
+        // The head went out, report that instead of the busy body.
+        return OK;
+    }
+    r_sent += body_sent;
+    return err;
+}
@@ -62,6 +62,8 @@ public:
     virtual Error recv(uint8_t *p_buffer, int p_len, int &r_read) = 0;
     virtual Error recvfrom(uint8_t *p_buffer, int p_len, int &r_read, IP_Address &r_ip, uint16_t &r_port, bool p_peek = false) = 0;
     virtual Error send(const uint8_t *p_buffer, int p_len, int &r_sent) = 0;
+    // Sends p_head followed by p_body, in a single call where the platform supports scatter/gather writes.
+    virtual Error send_vectored(const uint8_t *p_head, int p_head_len, const uint8_t *p_body, int p_body_len, int &r_sent);
     virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port) = 0;
     virtual Ref<NetSocket> accept(IP_Address &r_ip, uint16_t &r_port) = 0;
 
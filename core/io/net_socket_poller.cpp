@@ -0,0 +1,100 @@
+/*************************************************************************/
+/*  net_socket_poller.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "net_socket_poller.h"
+
+#include "core/os/os.h"
+
+NetSocketPoller *(*NetSocketPoller::_create)() = nullptr;
+
+NetSocketPoller *NetSocketPoller::create() {
+
+    if (_create)
+        return _create();
+
+    return memnew(NetSocketPoller);
+}
+
+Error NetSocketPoller::add(uint64_t p_id, const Ref<NetSocket> &p_socket, uint32_t p_events) {
+
+    ERR_FAIL_COND_V(!p_socket || !p_socket->is_open(), ERR_INVALID_PARAMETER);
+    ERR_FAIL_COND_V_MSG(entries.contains(p_id), ERR_ALREADY_EXISTS, "A socket is already registered with this id.");
+
+    entries[p_id] = Entry { p_socket, p_events & (EVENT_IN | EVENT_OUT) };
+    return OK;
+}
+
+void NetSocketPoller::remove(uint64_t p_id) {
+
+    entries.erase(p_id);
+}
+
+void NetSocketPoller::clear() {
+
+    // Go through remove(), implementations keep per socket state of their own.
+    while (!entries.empty()) {
+        remove(entries.begin()->first);
+    }
+}
+
+int NetSocketPoller::wait(Vector<Event> &r_events, int p_timeout) {
+
+    uint64_t deadline = p_timeout > 0 ? OS::get_singleton()->get_ticks_msec() + p_timeout : 0;
+    int found = 0;
+
+    while (true) {
+        for (const eastl::pair<const uint64_t, Entry> &E : entries) {
+
+            const Entry &entry = E.second;
+            uint32_t ready = 0;
+            if (!entry.socket->is_open()) {
+                ready = EVENT_ERROR;
+            } else {
+                if (entry.events & EVENT_IN) {
+                    Error err = entry.socket->poll(NetSocket::POLL_TYPE_IN, 0);
+                    ready |= err == OK ? EVENT_IN : err == ERR_BUSY ? 0 : EVENT_ERROR;
+                }
+                if (entry.events & EVENT_OUT) {
+                    Error err = entry.socket->poll(NetSocket::POLL_TYPE_OUT, 0);
+                    ready |= err == OK ? EVENT_OUT : err == ERR_BUSY ? 0 : EVENT_ERROR;
+                }
+            }
+            if (ready) {
+                r_events.push_back({ E.first, ready });
+                found++;
+            }
+        }
+
+        if (found || p_timeout == 0 || (p_timeout > 0 && OS::get_singleton()->get_ticks_msec() >= deadline)) {
+            return found;
+        }
+        OS::get_singleton()->delay_usec(1000);
+    }
+}
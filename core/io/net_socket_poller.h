@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  net_socket_poller.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/hash_map.h"
+#include "core/io/net_socket.h"
+
+/**
+ * Waits on many sockets at once and reports only the ready ones.
+ * Sockets are registered under a caller chosen id, which is what wait() hands back. Readiness is level triggered:
+ * a socket keeps being reported until it is drained. The default implementation polls every registered socket
+ * one by one; platforms replace it through _create with one that needs a single syscall per wait().
+ */
+class GODOT_EXPORT NetSocketPoller : public RefCounted {
+
+protected:
+    struct Entry {
+        Ref<NetSocket> socket;
+        uint32_t events;
+    };
+
+    HashMap<uint64_t, Entry> entries;
+
+    static NetSocketPoller *(*_create)();
+
+public:
+    enum EventFlags : uint32_t {
+        EVENT_IN = 1,
+        EVENT_OUT = 2,
+        EVENT_ERROR = 4, //!< Only reported, never needs to be requested.
+    };
+
+    struct Event {
+        uint64_t id;
+        uint32_t events;
+    };
+
+    static NetSocketPoller *create();
+
+    virtual Error add(uint64_t p_id, const Ref<NetSocket> &p_socket, uint32_t p_events);
+    virtual void remove(uint64_t p_id);
+    //! Appends the ready sockets to r_events and returns how many were added, or -1 on failure.
+    //! p_timeout is in milliseconds, 0 returns immediately and -1 blocks until something is ready.
+    virtual int wait(Vector<Event> &r_events, int p_timeout);
+
+    bool has(uint64_t p_id) const { return entries.contains(p_id); }
+    int get_socket_count() const { return int(entries.size()); }
+    void clear();
+};
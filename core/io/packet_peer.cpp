@@ -106,26 +106,17 @@ Error PacketPeer::get_var(Variant &r_variant, bool p_allow_objects) {
 
 Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
 
-    int len;
-    Error err = encode_variant(p_packet, nullptr, len, p_full_objects || allow_object_decoding); // compute len first
-    if (err)
-        return err;
-
-    if (len == 0)
-        return OK;
-
-    ERR_FAIL_COND_V_MSG(len > encode_buffer_max_size, ERR_OUT_OF_MEMORY,
+    // Single pass into the reused encode_buffer; it only grows, so steady state puts do not allocate.
+    // The cap is enforced by the writer, an oversized variant fails before the buffer grows past it.
+    VariantWriter writer(encode_buffer, 0, p_full_objects || allow_object_decoding);
+    writer.set_max_size(encode_buffer_max_size);
+    Error err = writer.write(p_packet);
+    ERR_FAIL_COND_V_MSG(writer.is_overflowed(), ERR_OUT_OF_MEMORY,
             "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via "
             "'set_encode_buffer_max_size'.");
-
-    if (unlikely(encode_buffer.size() < len)) {
-        encode_buffer.resize(next_power_of_2(len));
-    }
-
-    err = encode_variant(p_packet, encode_buffer.data(), len, p_full_objects || allow_object_decoding);
     ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to encode Variant.");
 
-    return put_packet(encode_buffer.data(), len);
+    return put_packet(encode_buffer.data(), writer.get_position());
 }
 
 Variant PacketPeer::_bnd_get_var(bool p_allow_objects) {
@@ -81,6 +81,8 @@ public:
     int get_available_packet_count() const override;
     int get_max_packet_size() const override;
     void set_broadcast_enabled(bool p_enabled);
+    //! The underlying socket, for registering with a NetSocketPoller.
+    const Ref<NetSocket> &get_socket() const { return _sock; }
     Error join_multicast_group(IP_Address p_multi_address, StringView p_if_name);
     Error join_multicast_group(StringView p_multi_address, StringView p_if_name) {
         return join_multicast_group(IP_Address(p_multi_address), p_if_name);
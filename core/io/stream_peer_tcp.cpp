@@ -305,6 +305,46 @@ Error StreamPeerTCP::put_partial_data(const uint8_t *p_data, int p_bytes, int &r
     return write(p_data, p_bytes, r_sent, false);
 }
 
+Error StreamPeerTCP::put_partial_data_vectored(const uint8_t *p_head, int p_head_len, const uint8_t *p_body, int p_body_len, int &r_sent) {
+
+    ERR_FAIL_COND_V(not _sock, ERR_UNAVAILABLE);
+
+    r_sent = 0;
+    if (status == STATUS_NONE || status == STATUS_ERROR) {
+        return FAILED;
+    }
+    if (status != STATUS_CONNECTED) {
+        if (_poll_connection() != OK) {
+            return FAILED;
+        }
+        if (status != STATUS_CONNECTED) {
+            return OK;
+        }
+    }
+    if (!_sock->is_open())
+        return FAILED;
+
+    int total = p_head_len + p_body_len;
+    while (r_sent < total) {
+        int sent_amount = 0;
+        Error err;
+        if (r_sent < p_head_len) {
+            err = _sock->send_vectored(p_head + r_sent, p_head_len - r_sent, p_body, p_body_len, sent_amount);
+        } else {
+            err = _sock->send(p_body + (r_sent - p_head_len), total - r_sent, sent_amount);
+        }
+        if (err == ERR_BUSY) {
+            return OK;
+        }
+        if (err != OK) {
+            disconnect_from_host();
+            return FAILED;
+        }
+        r_sent += sent_amount;
+    }
+    return OK;
+}
+
 Error StreamPeerTCP::get_data(uint8_t *p_buffer, int p_bytes) {
 
     int total;
@@ -78,10 +78,14 @@ public:
     Status get_status();
 
     void set_no_delay(bool p_enabled);
+    //! The underlying socket, for registering with a NetSocketPoller.
+    const Ref<NetSocket> &get_socket() const { return _sock; }
 
     // Read/Write from StreamPeer
     Error put_data(const uint8_t *p_data, int p_bytes) override;
     Error put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent) override;
+    // Non blocking write of p_head followed by p_body, with a single syscall where possible.
+    Error put_partial_data_vectored(const uint8_t *p_head, int p_head_len, const uint8_t *p_body, int p_body_len, int &r_sent);
     Error get_data(uint8_t *p_buffer, int p_bytes) override;
     Error get_partial_data(uint8_t *p_buffer, int p_bytes, int &r_received) override;
 
@@ -408,7 +408,19 @@ public:
 
     int cull_convex(Span<const Plane> p_convex, Span<T> p_result_array, const T p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF) {
         BVH_LOCKED_FUNCTION
-                if (!p_convex.size()) {
+        return _cull_convex(p_convex, p_result_array, p_tester, p_tree_collision_mask, nullptr);
+    }
+
+    // Same as cull_convex, but without taking the lock and with the hits gathered per thread.
+    // Several threads may cull at once, as long as nothing modifies the tree meanwhile.
+    int cull_convex_concurrent(Span<const Plane> p_convex, Span<T> p_result_array, const T p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF) {
+        thread_local Vector<uint32_t> hits;
+        return _cull_convex(p_convex, p_result_array, p_tester, p_tree_collision_mask, &hits);
+    }
+
+private:
+    int _cull_convex(Span<const Plane> p_convex, Span<T> p_result_array, const T p_tester, uint32_t p_tree_collision_mask, Vector<uint32_t> *r_hits) {
+        if (!p_convex.size()) {
             return 0;
         }
 
@@ -426,13 +438,13 @@ public:
 
         params.hull.planes = p_convex;
         params.hull.points = convex_points;
+        params.hits = r_hits;
 
         tree.cull_convex(params);
 
         return params.result_count_overall;
     }
 
-private:
     // do this after moving etc.
     void _check_for_collisions(bool p_full_check = false) {
         if (!changed_items.size()) {
@@ -729,11 +729,19 @@ public:
         // When collision testing, we can specify which tree ids
         // to collide test against with the tree_collision_mask.
         uint32_t tree_collision_mask;
+
+        // where to gather the hits, the tree's own list if not set
+        Vector<uint32_t> *hits = nullptr;
     };
 
 private:
+    Vector<uint32_t> &_get_cull_hits(const CullParams &p) {
+        return p.hits ? *p.hits : _cull_hits;
+    }
+
     void _cull_translate_hits(CullParams &p) {
-        int num_hits = _cull_hits.size();
+        const Vector<uint32_t> &hits = _get_cull_hits(p);
+        int num_hits = hits.size();
         int left = (p.result_array.empty() ? INT_MAX : p.result_array.size()) - p.result_count_overall;
 
         if (num_hits > left) {
@@ -743,7 +751,7 @@ private:
         int out_n = p.result_count_overall;
 
         for (int n = 0; n < num_hits; n++) {
-            uint32_t ref_id = _cull_hits[n];
+            uint32_t ref_id = hits[n];
 
             const ItemExtra &ex = _extra[ref_id];
             p.result_array[out_n] = ex.userdata;
@@ -761,7 +769,7 @@ private:
 
 public:
     int cull_convex(CullParams &r_params, bool p_translate_hits = true) {
-        _cull_hits.clear();
+        _get_cull_hits(r_params).clear();
         r_params.result_count = 0;
 
         uint32_t tree_test_mask = 0;
@@ -875,7 +883,7 @@ public:
         // it isn't a problem if we write too much _cull_hits because they only the
         // result_max amount will be translated and outputted. But we might as
         // well stop our cull checks after the maximum has been reached.
-        return p.result_array.empty() ? false : (int)_cull_hits.size() >= p.result_array.size();
+        return p.result_array.empty() ? false : (int)_get_cull_hits(p).size() >= p.result_array.size();
     }
 
 
@@ -892,7 +900,7 @@ public:
             }
         }
 
-        _cull_hits.push_back(p_ref_id);
+        _get_cull_hits(p).push_back(p_ref_id);
     }
 
     bool _cull_segment_iterative(uint32_t p_node_id, CullParams &r_params) {
@@ -35,7 +35,6 @@
 #include "core/external_profiler.h"
 #include "core/object_db.h"
 #include "core/object.h"
-#include "core/os/mutex.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
@@ -45,7 +44,24 @@
 
 namespace {
 SafeNumeric<int> null_object_calls {0};
-}
+SafeNumeric<uint64_t> queue_ids {0};
+std::atomic<uint64_t> live_queue {0};
+
+// The calling thread's shard, kept outside the exported class since thread_local data can't be exported.
+struct ShardHandle {
+    uint64_t owner = 0;
+    void *shard = nullptr;
+    std::atomic<bool> *in_use = nullptr;
+
+    ~ShardHandle() {
+        // Hand the shard back so the next thread can adopt it, unless the queue that owns it is already gone.
+        if (in_use && owner == live_queue.load(std::memory_order_acquire)) {
+            in_use->store(false, std::memory_order_release);
+        }
+    }
+};
+thread_local ShardHandle current_shard;
+} // namespace
 
 MessageQueue *MessageQueue::singleton = nullptr;
 
@@ -54,29 +70,88 @@ MessageQueue *MessageQueue::get_singleton() {
     return singleton;
 }
 
-Error MessageQueue::push_call(GameEntity p_id, eastl::function<void()> p_method) {
+MessageQueue::Block *MessageQueue::_alloc_block(uint32_t p_size) {
+
+    Block *block = memnew_placement(memalloc(sizeof(Block) + p_size), Block);
+    block->size = p_size;
+    allocated_bytes.add(sizeof(Block) + p_size);
+    return block;
+}
+
+void MessageQueue::_free_block(Block *p_block) {
+
+    allocated_bytes.sub(sizeof(Block) + p_block->size);
+    p_block->~Block();
+    memfree(p_block);
+}
+
+MessageQueue::Shard *MessageQueue::_get_shard() {
 
-    _THREAD_SAFE_METHOD_;
-    constexpr size_t room_needed = sizeof(Message);
+    ShardHandle &handle = current_shard;
+    if (likely(handle.owner == id)) {
+        return static_cast<Shard *>(handle.shard);
+    }
 
-    if ((buffer_end + room_needed) >= buffer_size) {
-        String type;
-        auto obj = object_for_entity(p_id);
-        if (obj) {
-            type = obj->get_class();
+    // First push from this thread: adopt a shard left behind by a finished thread, or register a new one.
+    Shard *shard = nullptr;
+    for (Shard *s = shards.load(std::memory_order_acquire); s; s = s->next_shard) {
+        bool expected = false;
+        if (s->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            shard = s;
+            break;
         }
-        print_line(String("Failed ::function call: ") + type + ": target ID: " + ::to_string(entt::to_integral(p_id)));
-        statistics();
-        ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
     }
-    TRACE_ALLOC_NS(&buffer[buffer_end],room_needed,STACK_DEPTH,"MessageQueueAlloc");
-    Message *msg = memnew_placement(&buffer[buffer_end], Message);
-    msg->args = 0;
-    msg->callable = Callable(memnew_args(FunctorCallable,p_id,p_method));
-    msg->type = TYPE_CALL;
+    if (!shard) {
+        shard = memnew(Shard);
+        shard->head = shard->tail = _alloc_block(BLOCK_SIZE);
+        shard->next_shard = shards.load(std::memory_order_relaxed);
+        while (!shards.compare_exchange_weak(shard->next_shard, shard, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+    handle.owner = id;
+    handle.shard = shard;
+    handle.in_use = &shard->in_use;
+    return shard;
+}
 
-    buffer_end += sizeof(Message);
-    return OK;
+uint8_t *MessageQueue::_reserve(Shard *p_shard, uint32_t p_size) {
+
+    Block *tail = p_shard->tail;
+    uint32_t end = tail->write_end.load(std::memory_order_relaxed);
+    if (likely(end + p_size <= tail->size)) {
+        TRACE_ALLOC_NS(tail->data() + end,p_size,STACK_DEPTH,"MessageQueueAlloc");
+        return tail->data() + end;
+    }
+
+    // Out of room: chain a new block. The consumer only moves past the current one once it is fully read.
+    Block *block = p_shard->spare.exchange(nullptr, std::memory_order_acquire);
+    if (block && block->size < p_size) {
+        _free_block(block);
+        block = nullptr;
+    }
+    if (!block) {
+        block = _alloc_block(M_MAX(uint32_t(BLOCK_SIZE), p_size));
+    }
+    tail->next.store(block, std::memory_order_release);
+    p_shard->tail = block;
+    TRACE_ALLOC_NS(block->data(),p_size,STACK_DEPTH,"MessageQueueAlloc");
+    return block->data();
+}
+
+void MessageQueue::_commit(Shard *p_shard, uint32_t p_size) {
+
+    // Counted before publishing, so a message is never seen consumed before it is seen pushed.
+    p_shard->pushed_calls.increment();
+    p_shard->pushed_bytes.add(p_size);
+    Block *tail = p_shard->tail;
+    tail->write_end.store(tail->write_end.load(std::memory_order_relaxed) + p_size, std::memory_order_release);
+}
+
+Error MessageQueue::push_call(GameEntity p_id, eastl::function<void()> p_method) {
+
+    ERR_FAIL_COND_V(!p_method, ERR_INVALID_PARAMETER);
+    // Stored in place, no FunctorCallable allocation per deferred lambda.
+    return _push_typed(p_id, eastl::move(p_method));
 }
 Error MessageQueue::push_call(GameEntity p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 
@@ -100,34 +175,26 @@ Error MessageQueue::push_call(GameEntity p_id, const StringName &p_method, VARIA
 }
 
 Error MessageQueue::push_callable(const Callable& p_callable, const Variant** p_args, int p_argcount, bool p_show_error) {
-    _THREAD_SAFE_METHOD_;
-
-    int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
-    if ((buffer_end + room_needed) >= buffer_size) {
-        print_line("Failed method: " + (String)p_callable);
-        statistics();
-        ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
-    }
-
-    TRACE_ALLOC_NS(&buffer[buffer_end],room_needed,STACK_DEPTH,"MessageQueueAlloc");
+    uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
-    Message* msg = memnew_placement(&buffer[buffer_end], Message);
+    Shard *shard = _get_shard();
+    Message* msg = memnew_placement(_reserve(shard, room_needed), Message);
     msg->args = p_argcount;
+    msg->payload = 0;
     msg->callable = p_callable;
     msg->type = TYPE_CALL;
     if (p_show_error) {
         msg->type |= FLAG_SHOW_ERROR;
     }
 
-    buffer_end += sizeof(Message);
-
+    Variant *args = (Variant *)(msg + 1);
     for (int i = 0; i < p_argcount; i++) {
-        Variant* v = memnew_placement(&buffer[buffer_end], Variant);
-        buffer_end += sizeof(Variant);
+        Variant* v = memnew_placement(&args[i], Variant);
         *v = *p_args[i];
     }
 
+    _commit(shard, room_needed);
     return OK;
 }
 Error MessageQueue::push_callable(const Callable& p_callable, VARIANT_ARG_DECLARE) {
@@ -147,46 +214,77 @@ Error MessageQueue::push_callable(const Callable& p_callable, VARIANT_ARG_DECLAR
 
 void MessageQueue::statistics() const {
     HashMap<Callable, int> call_count;
-    int func_count = 0;
+    int typed_count = 0;
     int null_count = 0;
 
-    uint32_t read_pos = 0;
-    while (read_pos < buffer_end) {
-        Message *message = (Message *)&buffer[read_pos];
-
-        Object *target = object_for_entity(message->callable.get_object_id());
-
-        if (target != nullptr) {
+    for (Shard *shard = shards.load(std::memory_order_acquire); shard; shard = shard->next_shard) {
+        for (Block *block = shard->head; block; block = block->next.load(std::memory_order_acquire)) {
+            uint32_t read_pos = block->read_pos;
+            uint32_t end = block->write_end.load(std::memory_order_acquire);
+            while (read_pos < end) {
+                Message *message = (Message *)(block->data() + read_pos);
+
+                bool typed = (message->type & FLAG_MASK) == TYPE_TYPED_CALL;
+                GameEntity target_id = typed ? ((TypedCall *)(message + 1))->target : message->callable.get_object_id();
+                Object *target = object_for_entity(target_id);
+
+                if (target != nullptr) {
+
+                    switch (message->type & FLAG_MASK) {
+                        case TYPE_CALL: {
+                            call_count[message->callable]++;
+                        } break;
+                        case TYPE_TYPED_CALL: {
+                            typed_count++;
+                        } break;
+                    }
+
+                } else {
+                    //object was deleted
+                    print_line("Object was deleted while awaiting a callback");
+
+                    null_count++;
+                }
 
-            switch (message->type & FLAG_MASK) {
-                case TYPE_CALL: {
-                    call_count[message->callable]++;
-                } break;
+                read_pos += _message_size(message);
             }
-
-        } else {
-            //object was deleted
-            print_line("Object was deleted while awaiting a callback");
-
-            null_count++;
         }
-
-        read_pos += sizeof(Message);
-        read_pos += sizeof(Variant) * message->args;
     }
 
-    print_line("TOTAL BYTES: " + itos(buffer_end));
+    Stats stats = get_stats();
+    print_line("TOTAL BYTES: " + ::to_string(stats.pending_bytes));
+    print_line("ALLOCATED BYTES: " + ::to_string(stats.allocated_bytes));
+    print_line("PRODUCER THREADS: " + itos(stats.producer_threads));
     print_line("NULL count: " + itos(null_count+null_object_calls.get()));
-    print_line("FUNC count: " + itos(func_count));
+    print_line("TYPED count: " + itos(typed_count));
 
     for (const eastl::pair<const Callable,int> &E : call_count) {
         print_line("CALL " + String(E.first) + ": " + ::to_string(E.second));
     }
 }
 
+MessageQueue::Stats MessageQueue::get_stats() const {
+
+    // Pending counts are exact for the consumer thread and a close snapshot for anyone else.
+    // Consumed counts are read first: everything they include was pushed before, so the difference can't go negative.
+    Stats stats;
+    for (Shard *shard = shards.load(std::memory_order_acquire); shard; shard = shard->next_shard) {
+        uint64_t consumed_calls = shard->consumed_calls.get();
+        uint64_t consumed_bytes = shard->consumed_bytes.get();
+        stats.pending_calls += shard->pushed_calls.get() - consumed_calls;
+        stats.pending_bytes += shard->pushed_bytes.get() - consumed_bytes;
+        if (shard->in_use.load(std::memory_order_relaxed)) {
+            stats.producer_threads++;
+        }
+    }
+    stats.allocated_bytes = allocated_bytes.get();
+    stats.last_flush_calls = last_flush_calls.get();
+    return stats;
+}
+
 int MessageQueue::get_max_buffer_usage() const {
 
-    return buffer_max_used;
+    return int(MIN(buffer_max_used, uint64_t(INT32_MAX)));
 }
 
 void MessageQueue::_call_function(const Callable& p_callable, const Variant* p_args, int p_argcount, bool p_show_error) {
@@ -206,112 +304,164 @@ void MessageQueue::_call_function(const Callable& p_callable, const Variant* p_a
     }
 }
 
-void MessageQueue::flush()
-{
-    if (buffer_end > buffer_max_used)
-    {
-        buffer_max_used = buffer_end;
-    }
-
-    uint32_t read_pos = 0;
+void MessageQueue::_destroy_message(Message *p_message) {
 
-    //using reverse locking strategy
-    _THREAD_SAFE_LOCK_
-
-    if (flushing)
-    {
-        _THREAD_SAFE_UNLOCK_
-        ERR_FAIL_COND(flushing); //already flushing, you did something odd
+    if ((p_message->type & FLAG_MASK) == TYPE_TYPED_CALL) {
+        ((TypedCall *)(p_message + 1))->~TypedCall();
+    } else {
+        Variant *args = (Variant *)(p_message + 1);
+        for (int i = 0; i < p_message->args; i++) {
+            args[i].~Variant();
+        }
     }
-    flushing = true;
-
-    while (read_pos < buffer_end)
-    {
-        //lock on each iteration, so a call can re-add itself to the message queue
-        TRACE_FREE_N(&buffer[read_pos],"MessageQueueAlloc");
+    p_message->~Message();
+}
 
-        Message *message = (Message*)&buffer[read_pos];
+bool MessageQueue::_drain(Shard *p_shard, uint64_t &r_calls) {
 
-        uint32_t advance = sizeof(Message);
-        advance += sizeof(Variant) * message->args;
+    bool drained_any = false;
+    Block *block = p_shard->head;
+    while (true) {
+        // Load the link before the end marker: once a successor exists the producer no longer writes here.
+        Block *next = block->next.load(std::memory_order_acquire);
+        uint32_t end = block->write_end.load(std::memory_order_acquire);
 
-        //pre-advance so this function is reentrant
-        read_pos += advance;
+        if (block->read_pos < end) {
+            TRACE_FREE_N(block->data() + block->read_pos,"MessageQueueAlloc");
 
-        _THREAD_SAFE_UNLOCK_
+            Message *message = (Message *)(block->data() + block->read_pos);
+            uint32_t advance = _message_size(message);
 
-        Object *target = message->callable.get_object();
+            //pre-advance so this function is reentrant
+            block->read_pos += advance;
+            p_shard->consumed_calls.increment();
+            p_shard->consumed_bytes.add(advance);
+            r_calls++;
+            drained_any = true;
 
-        if (target != nullptr)
-        {
-            switch (message->type & FLAG_MASK)
-            {
-            case TYPE_CALL:
-                {
-                    Variant *args = (Variant*)(message + 1);
+            switch (message->type & FLAG_MASK) {
+                case TYPE_CALL: {
+                    if (message->callable.get_object() != nullptr) {
+                        Variant *args = (Variant *)(message + 1);
 
-                    // messages don't expect a return value
+                        // messages don't expect a return value
 
-                    _call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-                }
-                break;
+                        _call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+                    } else {
+                        null_object_calls.increment();
+                    }
+                } break;
+                case TYPE_TYPED_CALL: {
+                    TypedCall *call = (TypedCall *)(message + 1);
+                    if (object_for_entity(call->target) != nullptr) {
+                        call->call();
+                    } else {
+                        null_object_calls.increment();
+                    }
+                } break;
             }
+
+            _destroy_message(message);
+            continue;
         }
 
-        else {
-            null_object_calls.increment();
+        if (!next) {
+            break;
         }
-        Variant *args = (Variant*)(message + 1);
-        for (int i = 0; i < message->args; i++)
-        {
-            args[i].~Variant();
+
+        // Block fully read and superseded, keep one around for the producer and release the rest.
+        p_shard->head = next;
+        block->next.store(nullptr, std::memory_order_relaxed);
+        block->write_end.store(0, std::memory_order_relaxed);
+        block->read_pos = 0;
+        Block *old_spare = p_shard->spare.exchange(block, std::memory_order_acq_rel);
+        if (old_spare) {
+            _free_block(old_spare);
         }
+        block = next;
+    }
+    return drained_any;
+}
 
-        message->~Message();
+void MessageQueue::flush()
+{
+    bool expected = false;
+    ERR_FAIL_COND(!flushing.compare_exchange_strong(expected, true, std::memory_order_acquire)); //already flushing, you did something odd
 
-        _THREAD_SAFE_LOCK_
+    Stats stats = get_stats();
+    if (stats.pending_bytes > buffer_max_used) {
+        buffer_max_used = stats.pending_bytes;
+    }
+    if (stats.pending_bytes > soft_limit && !soft_limit_warned) {
+        soft_limit_warned = true;
+        WARN_PRINT("Message queue grew to " + ::to_string(stats.pending_bytes / 1024) +
+                   " KiB, past 'memory/limits/message_queue/max_size_kb'. Deferred calls are probably being queued faster than they are flushed.");
     }
 
-    buffer_end = 0; // reset buffer
-    flushing = false;
-    _THREAD_SAFE_UNLOCK_
+    // Calls may queue more calls, keep going until every shard is empty.
+    uint64_t calls = 0;
+    bool drained_any;
+    do {
+        drained_any = false;
+        for (Shard *shard = shards.load(std::memory_order_acquire); shard; shard = shard->next_shard) {
+            drained_any |= _drain(shard, calls);
+        }
+    } while (drained_any);
+
+    last_flush_calls.set(calls);
+    flushing.store(false, std::memory_order_release);
 }
 
 bool MessageQueue::is_flushing() const {
 
-    return flushing;
+    return flushing.load(std::memory_order_relaxed);
 }
 
 MessageQueue::MessageQueue() {
     ERR_FAIL_COND_MSG(singleton != nullptr, "A MessageQueue singleton already exists.");
     singleton = this;
+    id = queue_ids.increment();
+    live_queue.store(id, std::memory_order_release);
     StringName prop_name("memory/limits/message_queue/max_size_kb");
-    buffer_size = GLOBAL_DEF_T_RST(prop_name, DEFAULT_QUEUE_SIZE_KB,uint32_t);
+    soft_limit = GLOBAL_DEF_T_RST(prop_name, DEFAULT_QUEUE_SIZE_KB,uint32_t);
     ProjectSettings::get_singleton()->set_custom_property_info(
             prop_name, PropertyInfo(VariantType::INT, "memory/limits/message_queue/max_size_kb", PropertyHint::Range,
                                "1024,4096,1,or_greater"));
-    buffer_size *= 1024;
-    buffer = memnew_arr(uint8_t, buffer_size);
+    soft_limit *= 1024;
 }
 
 MessageQueue::~MessageQueue() {
 
-    uint32_t read_pos = 0;
-
-    while (read_pos < buffer_end) {
-
-        Message *message = (Message *)&buffer[read_pos];
-        Variant *args = (Variant *)(message + 1);
-        int argc = message->args;
-        for (int i = 0; i < argc; i++)
-            args[i].~Variant();
-        message->~Message();
-        TRACE_FREE_N(message,"MessageQueueAlloc");
-
-        read_pos += sizeof(Message);
-        read_pos += sizeof(Variant) * message->args;
+    live_queue.store(0, std::memory_order_release);
+
+    Shard *shard = shards.exchange(nullptr, std::memory_order_acquire);
+    while (shard) {
+        Block *block = shard->head;
+        while (block) {
+            uint32_t end = block->write_end.load(std::memory_order_acquire);
+            while (block->read_pos < end) {
+                Message *message = (Message *)(block->data() + block->read_pos);
+                block->read_pos += _message_size(message);
+                _destroy_message(message);
+                TRACE_FREE_N(message,"MessageQueueAlloc");
+            }
+            Block *next = block->next.load(std::memory_order_acquire);
+            _free_block(block);
+            block = next;
+        }
+        Block *spare = shard->spare.exchange(nullptr, std::memory_order_acquire);
+        if (spare) {
+            _free_block(spare);
+        }
+        Shard *next_shard = shard->next_shard;
+        memdelete(shard);
+        shard = next_shard;
     }
 
+    if (current_shard.owner == id) {
+        current_shard.owner = 0;
+        current_shard.shard = nullptr;
+        current_shard.in_use = nullptr;
+    }
     singleton = nullptr;
-    memdelete_arr(buffer);
 }
@@ -31,20 +31,27 @@
 #pragma once
 
 #include "core/object.h"
-#include "core/os/thread_safe.h"
+#include "core/safe_refcount.h"
 
+#include "EASTL/tuple.h"
+#include <atomic>
+
+// Deferred call queue.
+// Every producer thread owns a shard: a chain of blocks it appends to without locking.
+// flush() runs on a single consumer thread and drains each shard in the order it was written,
+// so calls keep their relative order per thread, but not across threads.
 class GODOT_EXPORT MessageQueue
 {
-    _THREAD_SAFE_CLASS_
-
     enum
     {
-        DEFAULT_QUEUE_SIZE_KB = 4096
+        DEFAULT_QUEUE_SIZE_KB = 4096,
+        BLOCK_SIZE = 64 * 1024
     };
 
     enum
     {
         TYPE_CALL=0,
+        TYPE_TYPED_CALL,
         FLAG_SHOW_ERROR = 1 << 14,
         FLAG_MASK = FLAG_SHOW_ERROR - 1
     };
@@ -54,20 +61,103 @@ class GODOT_EXPORT MessageQueue
         Callable callable;
         int16_t type;
         int16_t args;
+        uint32_t payload; // bytes of typed call data following the message
+    };
+
+    // Typed deferred call, constructed in the queue right after its Message so the arguments stay unboxed.
+    struct TypedCall
+    {
+        GameEntity target;
+        explicit TypedCall(GameEntity p_target) : target(p_target) {}
+        virtual void call() = 0;
+        virtual ~TypedCall() = default;
+    };
+
+    template <class F>
+    struct TypedCallT final : TypedCall
+    {
+        F func;
+        TypedCallT(GameEntity p_target, F &&p_func) : TypedCall(p_target), func(eastl::move(p_func)) {}
+        void call() override { func(); }
+    };
+
+    struct alignas(16) Block
+    {
+        std::atomic<Block *> next {nullptr};
+        std::atomic<uint32_t> write_end {0}; // published by the producer
+        uint32_t read_pos = 0; // consumer only
+        uint32_t size;
+
+        uint8_t *data() { return reinterpret_cast<uint8_t *>(this + 1); }
     };
 
-    uint8_t *buffer;
-    uint32_t buffer_end = 0;
-    uint32_t buffer_max_used = 0;
-    uint32_t buffer_size;
+    struct Shard
+    {
+        Block *head; // oldest block, consumer side
+        Block *tail; // block being written, producer side
+        std::atomic<Block *> spare {nullptr}; // one drained block kept for reuse
+        std::atomic<bool> in_use {true}; // cleared when the owning thread exits
+        Shard *next_shard = nullptr; // registry link, immutable once published
+        // Each counter has a single writer, the producer or the consumer, and may be read from any thread.
+        SafeNumeric<uint64_t> pushed_calls {0};
+        SafeNumeric<uint64_t> pushed_bytes {0};
+        SafeNumeric<uint64_t> consumed_calls {0};
+        SafeNumeric<uint64_t> consumed_bytes {0};
+    };
+
+    std::atomic<Shard *> shards {nullptr};
+    SafeNumeric<uint64_t> allocated_bytes {0};
+    uint64_t id;
+    uint64_t soft_limit;
+    uint64_t buffer_max_used = 0;
+    SafeNumeric<uint64_t> last_flush_calls {0};
+    bool soft_limit_warned = false;
+
+    Shard *_get_shard();
+    Block *_alloc_block(uint32_t p_size);
+    void _free_block(Block *p_block);
+    uint8_t *_reserve(Shard *p_shard, uint32_t p_size);
+    void _commit(Shard *p_shard, uint32_t p_size);
+    bool _drain(Shard *p_shard, uint64_t &r_calls);
+    static uint32_t _message_size(const Message *p_message) {
+        return sizeof(Message) + sizeof(Variant) * p_message->args + p_message->payload;
+    }
+    static void _destroy_message(Message *p_message);
+
+    template <class F>
+    Error _push_typed(GameEntity p_target, F &&p_func) {
+        using Call = TypedCallT<eastl::decay_t<F>>;
+        static_assert(alignof(Call) <= 8, "Typed deferred calls are stored with 8 byte alignment.");
+        constexpr uint32_t payload = (sizeof(Call) + 7) & ~7u;
+        constexpr uint32_t room_needed = sizeof(Message) + payload;
+
+        Shard *shard = _get_shard();
+        Message *msg = memnew_placement(_reserve(shard, room_needed), Message);
+        msg->args = 0;
+        msg->payload = payload;
+        msg->type = TYPE_TYPED_CALL;
+        memnew_placement_args_basic(msg + 1, Call, p_target, eastl::forward<F>(p_func));
+
+        _commit(shard, room_needed);
+        return OK;
+    }
 
     void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
     static MessageQueue *singleton;
 
-    bool flushing=false;
+    std::atomic<bool> flushing {false};
 
 public:
+    struct Stats
+    {
+        uint64_t pending_calls = 0;
+        uint64_t pending_bytes = 0;
+        uint64_t allocated_bytes = 0;
+        uint64_t last_flush_calls = 0;
+        uint32_t producer_threads = 0;
+    };
+
     static MessageQueue *get_singleton();
 
     Error push_call(GameEntity p_id, eastl::function<void()> func);
@@ -78,7 +168,22 @@ public:
     Error push_callable(const Callable& p_callable, const Variant** p_args, int p_argcount, bool p_show_error = false);
     Error push_callable(const Callable& p_callable, VARIANT_ARG_LIST);
 
+    // Queues p_instance->p_method(p_args...) with the arguments stored by value in the queue, skipping
+    // both the Variant boxing and the by-name dispatch of push_call/push_callable.
+    // Arguments are stored as decayed copies, so view and pointer arguments must outlive the flush.
+    template <class T, class R, class... P, class... Args>
+    Error push_call_mp(T *p_instance, R (T::*p_method)(P...), Args &&...p_args) {
+        static_assert(sizeof...(P) == sizeof...(Args), "Argument count does not match the method.");
+        return _push_typed(p_instance->get_instance_id(),
+                [p_instance, p_method, args = eastl::tuple<eastl::decay_t<P>...>(eastl::forward<Args>(p_args)...)]() mutable {
+                    eastl::apply([p_instance, p_method](auto &...p_unpacked) { (p_instance->*p_method)(p_unpacked...); }, args);
+                });
+    }
+
+    // Prints the pending messages. Call it from the thread that flushes the queue: it walks the blocks that a flush
+    // consumes and frees.
     void statistics() const;
+    Stats get_stats() const;
     void flush();
 
     bool is_flushing() const;
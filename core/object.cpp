@@ -386,7 +386,7 @@ Variant Object::get(const StringName &p_name, bool *r_valid) const {
     return ret;
 }
 
-void Object::set_indexed(const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid) {
+void Object::_set_indexed(const PropertyHandle *p_root, const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid) {
     if (p_names.empty()) {
         if (r_valid) {
             *r_valid = false;
@@ -394,7 +394,11 @@ void Object::set_indexed(const Vector<StringName> &p_names, const Variant &p_val
         return;
     }
     if (p_names.size() == 1) {
-        set(p_names[0], p_value, r_valid);
+        if (p_root) {
+            set_by_handle(*p_root, p_value, r_valid);
+        } else {
+            set(p_names[0], p_value, r_valid);
+        }
         return;
     }
 
@@ -405,7 +409,7 @@ void Object::set_indexed(const Vector<StringName> &p_names, const Variant &p_val
 
     FixedVector<Variant,8,true> value_stack;
 
-    value_stack.push_back(get(p_names[0], r_valid));
+    value_stack.push_back(p_root ? get_by_handle(*p_root, r_valid) : get(p_names[0], r_valid));
 
     if (!*r_valid) {
         value_stack.clear();
@@ -434,13 +438,17 @@ void Object::set_indexed(const Vector<StringName> &p_names, const Variant &p_val
         }
     }
 
-    set(p_names[0], value_stack.back(), r_valid);
+    if (p_root) {
+        set_by_handle(*p_root, value_stack.back(), r_valid);
+    } else {
+        set(p_names[0], value_stack.back(), r_valid);
+    }
     value_stack.pop_back();
 
     ERR_FAIL_COND(!value_stack.empty());
 }
 
-Variant Object::get_indexed(const Vector<StringName> &p_names, bool *r_valid) const {
+Variant Object::_get_indexed(const PropertyHandle *p_root, const Vector<StringName> &p_names, bool *r_valid) const {
     if (p_names.empty()) {
         if (r_valid) {
             *r_valid = false;
@@ -449,7 +457,7 @@ Variant Object::get_indexed(const Vector<StringName> &p_names, bool *r_valid) co
     }
     bool valid = false;
 
-    Variant current_value = get(p_names[0], &valid);
+    Variant current_value = p_root ? get_by_handle(*p_root, &valid) : get(p_names[0], &valid);
     for (size_t i = 1; i < p_names.size(); i++) {
         current_value = current_value.get_named(p_names[i], &valid);
 
@@ -464,6 +472,73 @@ Variant Object::get_indexed(const Vector<StringName> &p_names, bool *r_valid) co
     return current_value;
 }
 
+void Object::set_indexed(const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid) {
+    _set_indexed(nullptr, p_names, p_value, r_valid);
+}
+
+Variant Object::get_indexed(const Vector<StringName> &p_names, bool *r_valid) const {
+    return _get_indexed(nullptr, p_names, r_valid);
+}
+
+void Object::set_indexed(const PropertyHandle &p_root, const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid) {
+    _set_indexed(&p_root, p_names, p_value, r_valid);
+}
+
+Variant Object::get_indexed(const PropertyHandle &p_root, const Vector<StringName> &p_names, bool *r_valid) const {
+    return _get_indexed(&p_root, p_names, r_valid);
+}
+
+PropertyHandle Object::get_property_handle(const StringName &p_name) const {
+    PropertyHandle handle;
+    handle.name = p_name;
+    handle.setget = ClassDB::get_property_setget(get_class_name(), p_name);
+    handle.class_key = get_class_name().data_unique_pointer();
+    return handle;
+}
+
+void Object::set_by_handle(const PropertyHandle &p_handle, const Variant &p_value, bool *r_valid) {
+    // Same order as set(): script first, then the bound setter, skipping the ClassDB walk.
+    if (!p_handle.setget || p_handle.class_key != get_class_name().data_unique_pointer()) {
+        set(p_handle.name, p_value, r_valid);
+        return;
+    }
+
+    Object_set_edited(this,true,false);
+
+    if (script_instance && script_instance->set(p_handle.name, p_value)) {
+        if (r_valid) {
+            *r_valid = true;
+        }
+        return;
+    }
+
+    bool valid;
+    ClassDB::set_property(this, *p_handle.setget, p_value, &valid);
+    if (r_valid) {
+        *r_valid = valid;
+    }
+}
+
+Variant Object::get_by_handle(const PropertyHandle &p_handle, bool *r_valid) const {
+    if (!p_handle.setget || p_handle.class_key != get_class_name().data_unique_pointer()) {
+        return get(p_handle.name, r_valid);
+    }
+
+    Variant ret;
+    if (script_instance && script_instance->get(p_handle.name, ret)) {
+        if (r_valid) {
+            *r_valid = true;
+        }
+        return ret;
+    }
+
+    ClassDB::get_property(const_cast<Object *>(this), *p_handle.setget, ret);
+    if (r_valid) {
+        *r_valid = true;
+    }
+    return ret;
+}
+
 void Object::get_property_list(Vector<PropertyInfo> *p_list, bool p_reversed) const {
 
     if (script_instance && p_reversed) {
@@ -616,6 +691,42 @@ bool Object::free()
     return true;
 
 }
+namespace {
+// Per-thread cache of ClassDB::get_method results, calls by name would otherwise take the ClassDB lock and
+// walk the inheritance chain every time. Only hits are stored: their names are kept alive by ClassDB, and the
+// whole cache is dropped when ClassDB reports a new method generation.
+struct MethodCacheEntry {
+    const void *class_name;
+    const void *method;
+    MethodBind *bind;
+};
+constexpr uint32_t METHOD_CACHE_SIZE = 512;
+thread_local MethodCacheEntry method_cache[METHOD_CACHE_SIZE];
+thread_local uint32_t method_cache_generation = 0;
+
+MethodBind *get_method_cached(const StringName &p_class, const StringName &p_method) {
+    uint32_t generation = ClassDB::get_method_generation();
+    if (unlikely(method_cache_generation != generation)) {
+        memset(method_cache, 0, sizeof(method_cache));
+        method_cache_generation = generation;
+    }
+
+    const void *class_key = p_class.data_unique_pointer();
+    const void *method_key = p_method.data_unique_pointer();
+    uintptr_t mix = (uintptr_t(class_key) >> 4) * 31 + (uintptr_t(method_key) >> 4);
+    MethodCacheEntry &entry = method_cache[mix & (METHOD_CACHE_SIZE - 1)];
+    if (entry.bind && entry.class_name == class_key && entry.method == method_key) {
+        return entry.bind;
+    }
+
+    MethodBind *bind = ClassDB::get_method(p_class, p_method);
+    if (bind) {
+        entry = { class_key, method_key, bind };
+    }
+    return bind;
+}
+} // namespace
+
 Variant Object::call(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 
     r_error.error = Callable::CallError::CALL_OK;
@@ -658,7 +769,7 @@ Variant Object::call(const StringName &p_method, const Variant **p_args, int p_a
         }
     }
 
-    MethodBind *method = ClassDB::get_method(get_class_name(), p_method);
+    MethodBind *method = get_method_cached(get_class_name(), p_method);
 
     if (method) {
 
@@ -883,6 +994,21 @@ IObjectTooling *Object::get_tooling_interface() const
     return private_data->get_tooling();
 }
 
+void Object::SignalData::rebuild() {
+
+    Dispatch::release(dispatch);
+    dispatch = nullptr;
+    if (slot_map.empty()) {
+        return;
+    }
+    dispatch = memnew(Dispatch);
+    dispatch->targets.reserve(slot_map.size());
+    for (const auto &entry : slot_map) {
+        const Slot &slot = entry.second;
+        dispatch->targets.push_back({ slot.conn.callable, slot.method, slot.conn.flags });
+    }
+}
+
 struct _ObjectSignalDisconnectData {
 
     StringName signal;
@@ -907,24 +1033,19 @@ void Object::do_emit_signal(const StringName &p_name, const Variant **p_args, in
         return; // ERR_UNAVAILABLE;
     }
 
-    FixedVector<_ObjectSignalDisconnectData,32> disconnect_data;
-
-    //copy on write will ensure that disconnecting the signal or even deleting the object will not affect the signal calling.
-    //this happens automatically and will not change the performance of calling.
-    //awesome, isn't it?
-    auto & slot_map = s->second.slot_map;
+    // The dispatch list is a snapshot: disconnecting the signal or even deleting the object during a callback
+    // will not affect this emit, and emits without connection changes in between share the same list.
+    SignalData::Dispatch *dispatch = s->second.get_dispatch();
+    if (!dispatch) {
+        return;
+    }
+    dispatch->refs.fetch_add(1, std::memory_order_relaxed);
 
-    ssize_t ssize = slot_map.size();
+    FixedVector<_ObjectSignalDisconnectData,32> disconnect_data;
 
     OBJ_DEBUG_LOCK
 
-    FixedVector<const Variant *,16,true> bind_mem; // upto 16 binds will not heap alloc here.
-
-   // Error err = OK;
-
-    for (int i = 0; i < ssize; i++) {
-
-        const Connection &c = slot_map.at(i).second.conn;
+    for (const SignalData::Dispatch::Target &c : dispatch->targets) {
 
         Object* target = c.callable.get_object();
         if (!target) {
@@ -940,8 +1061,17 @@ void Object::do_emit_signal(const StringName &p_name, const Variant **p_args, in
         } else {
             Callable::CallError ce;
             _emitting = true;
-            Variant ret;
-            c.callable.call(args, argc, ret, ce);
+            if (c.method && !target->get_script_instance()) {
+                // Resolved on connect, skips the Callable -> Object::call -> ClassDB lookup chain.
+#ifdef DEBUG_ENABLED
+                _ObjectDebugLock target_lock(target);
+#endif
+                ce.error = Callable::CallError::CALL_OK;
+                c.method->call(target, args, argc, ce);
+            } else {
+                Variant ret;
+                c.callable.call(args, argc, ret, ce);
+            }
             _emitting = false;
 
             if (ce.error != Callable::CallError::CALL_OK) {
@@ -968,6 +1098,8 @@ void Object::do_emit_signal(const StringName &p_name, const Variant **p_args, in
             disconnect_data.emplace_back(eastl::move(dd));
         }
     }
+    SignalData::Dispatch::release(dispatch);
+
     for(const _ObjectSignalDisconnectData & dd : disconnect_data) {
         _disconnect(dd.signal, dd.callable);
     }
@@ -1176,6 +1308,7 @@ void Object::disconnect_all(const StringName& p_signal, GameEntity target_object
     Object *tgt = object_for_entity(target_object);
     // find all connections from this signal to tgt
     bool any_erased=false;
+    bool signal_erased=false;
     auto &slotmap(per_sig_data->second.slot_map);
     for(auto iter=slotmap.begin(); iter!=slotmap.end(); ) {
         auto & entr = *iter;
@@ -1195,9 +1328,13 @@ void Object::disconnect_all(const StringName& p_signal, GameEntity target_object
         if (slotmap.empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
             //not user signal, delete
             private_data->signal_map.erase(p_signal);
+            signal_erased = true;
             break;
         }
     }
+    if (any_erased && !signal_erased) {
+        per_sig_data->second.rebuild();
+    }
     ERR_FAIL_COND_MSG(!any_erased, "Signal '" + p_signal + "', is not connected to object: " + tgt->to_string() + ".");
 }
 void Object::disconnect(const StringName& p_signal, const Callable& p_callable) {
@@ -1229,6 +1366,7 @@ void Object::_disconnect(const StringName& p_signal, const Callable& p_callable,
 
     target_object->private_data->connections.erase(slot->cE);
     per_sig_data->second.slot_map.erase(p_callable);
+    per_sig_data->second.rebuild();
 
     if (per_sig_data->second.slot_map.empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
         //not user signal, delete
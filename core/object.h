@@ -229,6 +229,15 @@ private:
 
 class ScriptInstance;
 class ObjectRC;
+struct ClassDB_PropertySetGet;
+
+// Property name resolved once against an object's class by Object::get_property_handle().
+// Objects of another class, or whose script handles the property, go through the regular by-name path.
+struct PropertyHandle {
+    StringName name;
+    const ClassDB_PropertySetGet *setget = nullptr;
+    const void *class_key = nullptr;
+};
 
 GODOT_EXPORT void predelete_handler(Object *p_object);
 GODOT_EXPORT void postinitialize_handler(Object *p_object);
@@ -296,6 +305,8 @@ public:
     Variant _get_bind(const StringName &p_name) const;
     void _set_indexed_bind(const NodePath &p_name, const Variant &p_value);
     Variant _get_indexed_bind(const NodePath &p_name) const;
+    void _set_indexed(const PropertyHandle *p_root, const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid);
+    Variant _get_indexed(const PropertyHandle *p_root, const Vector<StringName> &p_names, bool *r_valid) const;
 private:
     friend class RefCounted;
 protected:
@@ -412,6 +423,13 @@ public:
     void set_indexed(const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid = nullptr);
     Variant get_indexed(const Vector<StringName> &p_names, bool *r_valid = nullptr) const;
 
+    PropertyHandle get_property_handle(const StringName &p_name) const;
+    void set_by_handle(const PropertyHandle &p_handle, const Variant &p_value, bool *r_valid = nullptr);
+    Variant get_by_handle(const PropertyHandle &p_handle, bool *r_valid = nullptr) const;
+    // p_root must be the handle of p_names[0].
+    void set_indexed(const PropertyHandle &p_root, const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid = nullptr);
+    Variant get_indexed(const PropertyHandle &p_root, const Vector<StringName> &p_names, bool *r_valid = nullptr) const;
+
     void get_property_list(Vector<PropertyInfo> *p_list, bool p_reversed = false) const;
 
     bool has_method(const StringName &p_method) const;
@@ -6,16 +6,56 @@
 #include "EASTL/list.h"
 #include "EASTL/vector_map.h"
 
+#include <atomic>
+
+class MethodBind;
+
 struct Object::SignalData  {
     struct Slot {
         int reference_count = 0;
         Connection conn;
         List<Connection>::iterator cE;
+        MethodBind *method = nullptr; // resolved on connect for plain object/method callables
+    };
+
+    // Flat copy of slot_map, rebuilt whenever it changes so emits only ever read it.
+    // A running emit holds a reference, so callbacks that connect or disconnect don't disturb it,
+    // and emits from several threads can share it.
+    struct Dispatch {
+        struct Target {
+            Callable callable;
+            MethodBind *method;
+            uint32_t flags;
+        };
+        std::atomic<int> refs { 1 };
+        Vector<Target> targets;
+
+        static void release(Dispatch *p_dispatch) {
+            if (p_dispatch && p_dispatch->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                memdelete(p_dispatch);
+            }
+        }
     };
 
     MethodInfo user;
     eastl::vector_map<Callable, Slot> slot_map;
     //VMap<Callable, Slot> slot_map;
+    Dispatch *dispatch = nullptr;
+
+    SignalData() = default;
+    SignalData(const SignalData &p_other) : user(p_other.user), slot_map(p_other.slot_map) { rebuild(); }
+    SignalData &operator=(const SignalData &p_other) {
+        user = p_other.user;
+        slot_map = p_other.slot_map;
+        rebuild();
+        return *this;
+    }
+    ~SignalData() { Dispatch::release(dispatch); }
+
+    // Must be called whenever slot_map changes.
+    void rebuild();
+    // nullptr while nothing is connected.
+    Dispatch *get_dispatch() const { return dispatch; }
 };
 
 struct Object::ObjectPrivate {
@@ -30,7 +30,9 @@
 
 #include "thread_work_pool.h"
 
+#include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/safe_refcount.h"
 
 void ThreadWorkPool::_thread_function(void *p_user) {
     ThreadData *thread = static_cast<ThreadData *>(p_user);
@@ -79,3 +81,112 @@ void ThreadWorkPool::finish() {
 ThreadWorkPool::~ThreadWorkPool() {
     finish();
 }
+
+namespace {
+Mutex shared_pool_mutex;
+ThreadWorkPool *shared_pool = nullptr;
+bool shared_pool_busy = false; // a do_work() job, or the end of a background job, holds the pool
+SharedThreadWorkPool::BackgroundWork *shared_pool_background = nullptr;
+SafeNumeric<uint64_t> shared_pool_serial_jobs;
+// Set on the workers while they run a background job. The jobs those elements start must not wait for the pool,
+// it waits for them.
+thread_local bool in_background_job = false;
+
+ThreadWorkPool *_get_shared_pool() {
+    if (!shared_pool) {
+        shared_pool = memnew(ThreadWorkPool);
+        shared_pool->init();
+    }
+    return shared_pool;
+}
+} // namespace
+
+void SharedThreadWorkPool::_end_background_work_locked() {
+    shared_pool->end_work();
+    memdelete(shared_pool_background->job);
+    shared_pool_background->job = nullptr;
+    shared_pool_background = nullptr;
+}
+
+void SharedThreadWorkPool::BackgroundWork::_run(uint32_t p_index, void *p_unused) {
+    in_background_job = true;
+    job->run(p_index);
+    in_background_job = false;
+}
+
+ThreadWorkPool *SharedThreadWorkPool::_acquire() {
+    if (in_background_job) {
+        shared_pool_serial_jobs.increment();
+        return nullptr;
+    }
+    MutexLock lock(shared_pool_mutex);
+    if (shared_pool_busy || (shared_pool_background && !shared_pool->is_done_dispatching())) {
+        shared_pool_serial_jobs.increment();
+        return nullptr;
+    }
+    if (shared_pool_background) {
+        // Only the last elements of the background job are still running.
+        _end_background_work_locked();
+    }
+    shared_pool_busy = true;
+    return _get_shared_pool();
+}
+
+void SharedThreadWorkPool::_release() {
+    MutexLock lock(shared_pool_mutex);
+    shared_pool_busy = false;
+}
+
+bool SharedThreadWorkPool::_begin_background_work(BackgroundWork &r_work, BackgroundWork::BaseJob *p_job, uint32_t p_elements) {
+    if (in_background_job) {
+        shared_pool_serial_jobs.increment();
+        return false;
+    }
+    MutexLock lock(shared_pool_mutex);
+    ERR_FAIL_COND_V_MSG(r_work.job != nullptr, false, "The background work was started again before it ended.");
+    if (shared_pool_busy || (shared_pool_background && !shared_pool->is_done_dispatching())) {
+        shared_pool_serial_jobs.increment();
+        return false;
+    }
+    if (shared_pool_background) {
+        _end_background_work_locked();
+    }
+    r_work.job = p_job;
+    shared_pool_background = &r_work;
+    _get_shared_pool()->begin_work(p_elements, &r_work, &BackgroundWork::_run, (void *)nullptr);
+    return true;
+}
+
+void SharedThreadWorkPool::end_background_work(BackgroundWork &r_work) {
+    {
+        MutexLock lock(shared_pool_mutex);
+        if (shared_pool_background != &r_work) {
+            return;
+        }
+        // Waited for without the mutex, the other callers see a busy pool meanwhile.
+        shared_pool_busy = true;
+        shared_pool_background = nullptr;
+    }
+    shared_pool->end_work();
+    MutexLock lock(shared_pool_mutex);
+    memdelete(r_work.job);
+    r_work.job = nullptr;
+    shared_pool_busy = false;
+}
+
+uint64_t SharedThreadWorkPool::get_serial_job_count() {
+    return shared_pool_serial_jobs.get();
+}
+
+void SharedThreadWorkPool::finish() {
+    MutexLock lock(shared_pool_mutex);
+    ERR_FAIL_COND_MSG(shared_pool_busy, "The shared work pool can't be finished while it runs a job.");
+    if (shared_pool_background) {
+        _end_background_work_locked();
+    }
+    if (shared_pool) {
+        shared_pool->finish();
+        memdelete(shared_pool);
+        shared_pool = nullptr;
+    }
+}
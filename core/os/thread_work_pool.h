@@ -155,4 +155,81 @@ public:
     ~ThreadWorkPool();
 };
 
+/// One pool for the engine's short, data parallel jobs, so they don't each keep a thread per core.
+/// do_work() can be called from any thread. While the pool runs the job of one caller, other callers, including
+/// jobs started from the workers, run theirs on the calling thread. Those jobs are counted, see
+/// get_serial_job_count().
+class SharedThreadWorkPool {
+public:
+    /// A job started by begin_background_work(), the workers run it while its owner goes on.
+    class BackgroundWork {
+        friend class SharedThreadWorkPool;
+
+        struct BaseJob {
+            virtual void run(uint32_t p_index) = 0;
+            virtual ~BaseJob() = default;
+        };
+
+        template <class C, class M, class U>
+        struct Job : public BaseJob {
+            C *instance;
+            M method;
+            U userdata;
+            void run(uint32_t p_index) override {
+                (instance->*method)(p_index, userdata);
+            }
+        };
+
+        BaseJob *job = nullptr; // while the workers own the job, guarded by the pool mutex
+
+        void _run(uint32_t p_index, void *p_unused);
+    };
+
+private:
+    static ThreadWorkPool *_acquire(); // null when busy
+    static void _release();
+    static void _end_background_work_locked();
+    static bool _begin_background_work(BackgroundWork &r_work, BackgroundWork::BaseJob *p_job, uint32_t p_elements);
+
+public:
+    template <class C, class M, class U>
+    static void do_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
+        ThreadWorkPool *pool = p_elements > 1 ? _acquire() : nullptr;
+        if (!pool) {
+            for (uint32_t i = 0; i < p_elements; i++) {
+                (p_instance->*p_method)(i, p_userdata);
+            }
+            return;
+        }
+        pool->do_work(p_elements, p_instance, p_method, p_userdata);
+        _release();
+    }
+
+    /// Starts a job that runs on the workers until end_background_work(), do_work() callers can take the pool over
+    /// once all its elements were handed out. When the pool is busy the job runs right away on the calling thread.
+    template <class C, class M, class U>
+    static void begin_background_work(BackgroundWork &r_work, uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
+        if (p_elements == 0) {
+            return;
+        }
+        BackgroundWork::Job<C, M, U> *job = memnew((BackgroundWork::Job<C, M, U>));
+        job->instance = p_instance;
+        job->method = p_method;
+        job->userdata = p_userdata;
+        if (!_begin_background_work(r_work, job, p_elements)) {
+            for (uint32_t i = 0; i < p_elements; i++) {
+                job->run(i);
+            }
+            memdelete(job);
+        }
+    }
+    /// Waits for the elements of `r_work` still running. Does nothing if the job already ended.
+    static void end_background_work(BackgroundWork &r_work);
+
+    /// Number of multi-element jobs that ran on the calling thread because the pool was busy.
+    static uint64_t get_serial_job_count();
+    /// Stops the worker threads, they are started again on the next do_work().
+    static void finish();
+};
+
 #endif // THREAD_WORK_POOL_H
@@ -0,0 +1,99 @@
+/*************************************************************************/
+/*  radix_sort.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <cstring>
+
+/// Key and payload sorted by RadixSort::sort(), the payload is usually the
+/// index of the sorted item in its owning array.
+struct RadixSortPair {
+    uint64_t key;
+    uint32_t value;
+};
+
+namespace RadixSort {
+
+/// Maps a float to an unsigned integer that orders the same way.
+_FORCE_INLINE_ uint32_t float_to_key(float p_value) {
+    uint32_t bits;
+    memcpy(&bits, &p_value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/// Stable least significant digit sort of p_count pairs by ascending key,
+/// one byte per pass. Passes over a byte that is equal in every key are
+/// skipped, so narrow keys only pay for the bytes they use.
+/// p_scratch must hold p_count pairs, the sorted pairs end up in either
+/// buffer and the one holding them is returned.
+inline RadixSortPair *sort(RadixSortPair *p_data, RadixSortPair *p_scratch, uint32_t p_count) {
+    if (p_count < 2) {
+        return p_data;
+    }
+
+    uint32_t histograms[8][256] = {};
+    for (uint32_t i = 0; i < p_count; i++) {
+        const uint64_t key = p_data[i].key;
+        for (int b = 0; b < 8; b++) {
+            histograms[b][(key >> (b * 8)) & 0xFF]++;
+        }
+    }
+
+    RadixSortPair *src = p_data;
+    RadixSortPair *dst = p_scratch;
+    for (int b = 0; b < 8; b++) {
+        const int shift = b * 8;
+        uint32_t *offsets = histograms[b];
+        if (offsets[(src[0].key >> shift) & 0xFF] == p_count) {
+            continue;
+        }
+
+        uint32_t sum = 0;
+        for (int d = 0; d < 256; d++) {
+            const uint32_t count = offsets[d];
+            offsets[d] = sum;
+            sum += count;
+        }
+
+        for (uint32_t i = 0; i < p_count; i++) {
+            dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+
+        RadixSortPair *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    return src;
+}
+
+} // namespace RadixSort
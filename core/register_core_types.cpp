@@ -68,6 +68,7 @@
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/os/thread_work_pool.h"
 #include "core/packed_data_container.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
@@ -291,6 +292,8 @@ void register_core_singletons() {
 
 void unregister_core_types() {
 
+    SharedThreadWorkPool::finish();
+
     memdelete(_resource_manger);
     memdelete(_os);
     memdelete(_engine);
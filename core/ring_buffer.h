@@ -129,6 +129,13 @@ public:
         return -1;
     }
 
+    // The next p_size elements in place, or nullptr when they wrap around the end of the buffer.
+    const T *read_ptr(int p_size) const {
+        if (p_size > data_left() || read_pos + p_size > size())
+            return nullptr;
+        return data.data() + read_pos;
+    }
+
     int advance_read(int p_n) {
         p_n = MIN(p_n, data_left());
         inc(read_pos, p_n);
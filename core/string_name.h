@@ -108,6 +108,8 @@ public:
         return _data == p_name._data;
     }
     [[nodiscard]] uint32_t hash() const;
+    // Identity of the interned string, stable for as long as any StringName refers to it.
+    [[nodiscard]] const void *data_unique_pointer() const noexcept { return _data; }
 
     bool operator!=(const StringName &p_name) const noexcept {
 
@@ -30,101 +30,100 @@
 
 #pragma once
 
+#include "core/ecs_registry.h"
 #include "core/math/camera_matrix.h"
-#include "core/self_list.h"
 #include "scene/resources/mesh.h"
 #include "servers/rendering/rasterizer.h"
+#include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering_server.h"
 
 class RasterizerSceneDummy : public RasterizerScene {
 public:
     /* SHADOW ATLAS API */
 
-    RenderingEntity shadow_atlas_create() { return entt::null; }
-    void shadow_atlas_set_size(RenderingEntity p_atlas, int p_size) {}
-    void shadow_atlas_set_quadrant_subdivision(RenderingEntity p_atlas, int p_quadrant, int p_subdivision) {}
-    bool shadow_atlas_update_light(RenderingEntity p_atlas, RenderingEntity p_light_intance, float p_coverage, uint64_t p_light_version) { return false; }
+    RenderingEntity shadow_atlas_create() override { return entt::null; }
+    void shadow_atlas_set_size(RenderingEntity p_atlas, int p_size) override {}
+    void shadow_atlas_set_quadrant_subdivision(RenderingEntity p_atlas, int p_quadrant, int p_subdivision) override {}
+    bool shadow_atlas_update_light(RenderingEntity p_atlas, RenderingEntity p_light_intance, float p_coverage, uint64_t p_light_version) override { return false; }
 
-    int get_directional_light_shadow_size(RenderingEntity p_light_intance) { return 0; }
-    void set_directional_shadow_count(int p_count) {}
+    int get_directional_light_shadow_size(RenderingEntity p_light_intance) override { return 0; }
+    void set_directional_shadow_count(int p_count) override {}
 
     /* ENVIRONMENT API */
 
-    RenderingEntity environment_create() { return entt::null; }
+    RenderingEntity environment_create() override { return entt::null; }
 
-    void environment_set_background(RenderingEntity p_env, RS::EnvironmentBG p_bg) {}
-    void environment_set_sky(RenderingEntity p_env, RenderingEntity p_sky) {}
-    void environment_set_sky_custom_fov(RenderingEntity p_env, float p_scale) {}
-    void environment_set_sky_orientation(RenderingEntity p_env, const Basis &p_orientation) {}
-    void environment_set_bg_color(RenderingEntity p_env, const Color &p_color) {}
-    void environment_set_bg_energy(RenderingEntity p_env, float p_energy) {}
-    void environment_set_canvas_max_layer(RenderingEntity p_env, int p_max_layer) {}
-    void environment_set_ambient_light(RenderingEntity p_env, const Color &p_color, float p_energy = 1.0, float p_sky_contribution = 0.0) {}
-    void environment_set_camera_feed_id(RenderingEntity p_env, int p_camera_feed_id){};
+    void environment_set_background(RenderingEntity p_env, RS::EnvironmentBG p_bg) override {}
+    void environment_set_sky(RenderingEntity p_env, RenderingEntity p_sky) override {}
+    void environment_set_sky_custom_fov(RenderingEntity p_env, float p_scale) override {}
+    void environment_set_sky_orientation(RenderingEntity p_env, const Basis &p_orientation) override {}
+    void environment_set_bg_color(RenderingEntity p_env, const Color &p_color) override {}
+    void environment_set_bg_energy(RenderingEntity p_env, float p_energy) override {}
+    void environment_set_canvas_max_layer(RenderingEntity p_env, int p_max_layer) override {}
+    void environment_set_ambient_light(RenderingEntity p_env, const Color &p_color, float p_energy = 1.0, float p_sky_contribution = 0.0) override {}
+    void environment_set_camera_feed_id(RenderingEntity p_env, int p_camera_feed_id) override {}
 
-    void environment_set_dof_blur_near(RenderingEntity p_env, bool p_enable, float p_distance, float p_transition, float p_far_amount, RS::EnvironmentDOFBlurQuality p_quality) {}
-    void environment_set_dof_blur_far(RenderingEntity p_env, bool p_enable, float p_distance, float p_transition, float p_far_amount, RS::EnvironmentDOFBlurQuality p_quality) {}
-    void environment_set_glow(RenderingEntity p_env, bool p_enable, int p_level_flags, float p_intensity, float p_strength, float p_bloom_threshold, RS::EnvironmentGlowBlendMode p_blend_mode, float p_hdr_bleed_threshold, float p_hdr_bleed_scale, float p_hdr_luminance_cap, bool p_bicubic_upscale) {}
+    void environment_set_dof_blur_near(RenderingEntity p_env, bool p_enable, float p_distance, float p_transition, float p_far_amount, RS::EnvironmentDOFBlurQuality p_quality) override {}
+    void environment_set_dof_blur_far(RenderingEntity p_env, bool p_enable, float p_distance, float p_transition, float p_far_amount, RS::EnvironmentDOFBlurQuality p_quality) override {}
+    void environment_set_glow(RenderingEntity p_env, bool p_enable, int p_level_flags, float p_intensity, float p_strength, float p_bloom_threshold, RS::EnvironmentGlowBlendMode p_blend_mode, float p_hdr_bleed_threshold, float p_hdr_bleed_scale, float p_hdr_luminance_cap, bool p_bicubic_upscale, bool p_high_quality) override {}
 
-    void environment_set_fog(RenderingEntity p_env, bool p_enable, float p_begin, float p_end, RenderingEntity p_gradient_texture) {}
+    void environment_set_fog(RenderingEntity p_env, bool p_enable, float p_begin, float p_end, RenderingEntity p_gradient_texture) override {}
 
-    void environment_set_ssr(RenderingEntity p_env, bool p_enable, int p_max_steps, float p_fade_int, float p_fade_out, float p_depth_tolerance, bool p_roughness) {}
-    void environment_set_ssao(RenderingEntity p_env, bool p_enable, float p_radius, float p_intensity, float p_radius2, float p_intensity2, float p_bias, float p_light_affect, float p_ao_channel_affect, const Color &p_color, RS::EnvironmentSSAOQuality p_quality, RS::EnvironmentSSAOBlur p_blur, float p_bilateral_sharpness) {}
+    void environment_set_ssr(RenderingEntity p_env, bool p_enable, int p_max_steps, float p_fade_int, float p_fade_out, float p_depth_tolerance, bool p_roughness) override {}
+    void environment_set_ssao(RenderingEntity p_env, bool p_enable, float p_radius, float p_intensity, float p_radius2, float p_intensity2, float p_bias, float p_light_affect, float p_ao_channel_affect, const Color &p_color, RS::EnvironmentSSAOQuality p_quality, RS::EnvironmentSSAOBlur p_blur, float p_bilateral_sharpness) override {}
 
-    void environment_set_tonemap(RenderingEntity p_env, RS::EnvironmentToneMapper p_tone_mapper, float p_exposure, float p_white, bool p_auto_exposure, float p_min_luminance, float p_max_luminance, float p_auto_exp_speed, float p_auto_exp_scale) {}
+    void environment_set_tonemap(RenderingEntity p_env, RS::EnvironmentToneMapper p_tone_mapper, float p_exposure, float p_white, bool p_auto_exposure, float p_min_luminance, float p_max_luminance, float p_auto_exp_speed, float p_auto_exp_scale) override {}
 
-    void environment_set_adjustment(RenderingEntity p_env, bool p_enable, float p_brightness, float p_contrast, float p_saturation, RenderingEntity p_ramp) {}
+    void environment_set_adjustment(RenderingEntity p_env, bool p_enable, float p_brightness, float p_contrast, float p_saturation, RenderingEntity p_ramp) override {}
 
-    void environment_set_fog(RenderingEntity p_env, bool p_enable, const Color &p_color, const Color &p_sun_color, float p_sun_amount) {}
-    void environment_set_fog_depth(RenderingEntity p_env, bool p_enable, float p_depth_begin, float p_depth_end, float p_depth_curve, bool p_transmit, float p_transmit_curve) {}
-    void environment_set_fog_height(RenderingEntity p_env, bool p_enable, float p_min_height, float p_max_height, float p_height_curve) {}
+    void environment_set_fog(RenderingEntity p_env, bool p_enable, const Color &p_color, const Color &p_sun_color, float p_sun_amount) override {}
+    void environment_set_fog_depth(RenderingEntity p_env, bool p_enable, float p_depth_begin, float p_depth_end, float p_depth_curve, bool p_transmit, float p_transmit_curve) override {}
+    void environment_set_fog_height(RenderingEntity p_env, bool p_enable, float p_min_height, float p_max_height, float p_height_curve) override {}
 
-    bool is_environment(RenderingEntity p_env) { return false; }
-    RS::EnvironmentBG environment_get_background(RenderingEntity p_env) { return RS::ENV_BG_KEEP; }
-    int environment_get_canvas_max_layer(RenderingEntity p_env) { return 0; }
+    bool is_environment(RenderingEntity p_env) override { return false; }
+    RS::EnvironmentBG environment_get_background(RenderingEntity p_env) override { return RS::ENV_BG_KEEP; }
+    int environment_get_canvas_max_layer(RenderingEntity p_env) override { return 0; }
 
-    RenderingEntity light_instance_create(RenderingEntity p_light) { return entt::null; }
-    void light_instance_set_transform(RenderingEntity p_light_instance, const Transform &p_transform) {}
-    void light_instance_set_shadow_transform(RenderingEntity p_light_instance, const CameraMatrix &p_projection, const Transform &p_transform, float p_far, float p_split, int p_pass, float p_bias_scale = 1.0) {}
-    void light_instance_mark_visible(RenderingEntity p_light_instance) {}
+    RenderingEntity light_instance_create(RenderingEntity p_light) override { return entt::null; }
+    void light_instance_set_transform(RenderingEntity p_light_instance, const Transform &p_transform) override {}
+    void light_instance_set_shadow_transform(RenderingEntity p_light_instance, const CameraMatrix &p_projection, const Transform &p_transform, float p_far, float p_split, int p_pass, float p_bias_scale = 1.0) override {}
+    void light_instance_mark_visible(RenderingEntity p_light_instance) override {}
 
-    RenderingEntity reflection_atlas_create() { return entt::null; }
-    void reflection_atlas_set_size(RenderingEntity p_ref_atlas, int p_size) {}
-    void reflection_atlas_set_subdivision(RenderingEntity p_ref_atlas, int p_subdiv) {}
+    RenderingEntity reflection_atlas_create() override { return entt::null; }
+    void reflection_atlas_set_size(RenderingEntity p_ref_atlas, int p_size) override {}
+    void reflection_atlas_set_subdivision(RenderingEntity p_ref_atlas, int p_subdiv) override {}
 
-    RenderingEntity reflection_probe_instance_create(RenderingEntity p_probe) { return entt::null; }
-    void reflection_probe_instance_set_transform(RenderingEntity p_instance, const Transform &p_transform) {}
-    void reflection_probe_release_atlas_index(RenderingEntity p_instance) {}
-    bool reflection_probe_instance_needs_redraw(RenderingEntity p_instance) { return false; }
-    bool reflection_probe_instance_has_reflection(RenderingEntity p_instance) { return false; }
-    bool reflection_probe_instance_begin_render(RenderingEntity p_instance, RenderingEntity p_reflection_atlas) { return false; }
-    bool reflection_probe_instance_postprocess_step(RenderingEntity p_instance) { return true; }
+    RenderingEntity reflection_probe_instance_create(RenderingEntity p_probe) override { return entt::null; }
+    void reflection_probe_instance_set_transform(RenderingEntity p_instance, const Transform &p_transform) override {}
+    void reflection_probe_release_atlas_index(RenderingEntity p_instance) override {}
+    bool reflection_probe_instance_needs_redraw(RenderingEntity p_instance) override { return false; }
+    bool reflection_probe_instance_has_reflection(RenderingEntity p_instance) override { return false; }
+    bool reflection_probe_instance_begin_render(RenderingEntity p_instance, RenderingEntity p_reflection_atlas) override { return false; }
+    bool reflection_probe_instance_postprocess_step(RenderingEntity p_instance) override { return true; }
 
-    RenderingEntity gi_probe_instance_create() { return entt::null; }
-    void gi_probe_instance_set_light_data(RenderingEntity p_probe, RenderingEntity p_base, RenderingEntity p_data) {}
-    void gi_probe_instance_set_transform_to_data(RenderingEntity p_probe, const Transform &p_xform) {}
-    void gi_probe_instance_set_bounds(RenderingEntity p_probe, const Vector3 &p_bounds) {}
+    RenderingEntity gi_probe_instance_create() override { return entt::null; }
+    void gi_probe_instance_set_light_data(RenderingEntity p_probe, RenderingEntity p_base, RenderingEntity p_data) override {}
+    void gi_probe_instance_set_transform_to_data(RenderingEntity p_probe, const Transform &p_xform) override {}
+    void gi_probe_instance_set_bounds(RenderingEntity p_probe, const Vector3 &p_bounds) override {}
 
-    void render_scene(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RenderingEntity *p_light_cull_result, int p_light_cull_count, RenderingEntity *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RenderingEntity p_environment, RenderingEntity p_shadow_atlas, RenderingEntity p_reflection_atlas, RenderingEntity p_reflection_probe, int p_reflection_probe_pass) {}
-    void render_shadow(RenderingEntity p_light, RenderingEntity p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count) {}
+    void render_scene(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, const int p_eye, bool p_cam_ortogonal, Span<RenderingEntity> p_cull_result, RenderingEntity *p_light_cull_result, int p_light_cull_count, RenderingEntity *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RenderingEntity p_environment, RenderingEntity p_shadow_atlas, RenderingEntity p_reflection_atlas, RenderingEntity p_reflection_probe, int p_reflection_probe_pass) override {}
+    void render_shadow(RenderingEntity p_light, RenderingEntity p_shadow_atlas, int p_pass, Span<RenderingEntity> p_cull_result) override {}
 
-    void set_scene_pass(uint64_t p_pass) {}
-    void set_debug_draw_mode(RS::ViewportDebugDraw p_debug_draw) {}
-
-    bool free(RenderingEntity p_rid) { return true; }
+    void set_scene_pass(uint64_t p_pass) override {}
+    void set_debug_draw_mode(RS::ViewportDebugDraw p_debug_draw) override {}
 
     RasterizerSceneDummy() {}
-    ~RasterizerSceneDummy() {}
+    ~RasterizerSceneDummy() override {}
 };
 
 class RasterizerStorageDummy : public RasterizerStorage {
 public:
     /* TEXTURE API */
-    struct DummyTexture : public RID_Data {
-        int width;
-        int height;
-        uint32_t flags;
-        Image::Format format;
+    struct DummyTexture {
+        int width = 0;
+        int height = 0;
+        uint32_t flags = 0;
+        Image::Format format = ImageData::FORMAT_RGB8;
         Ref<Image> image;
         String path;
     };
@@ -132,32 +131,62 @@ public:
     struct DummySurface {
         uint32_t format;
         RS::PrimitiveType primitive;
-        PoolVector<uint8_t> array;
+        Vector<uint8_t> array;
         int vertex_count;
-        PoolVector<uint8_t> index_array;
+        Vector<uint8_t> index_array;
         int index_count;
         AABB aabb;
-        Vector<PoolVector<uint8_t> > blend_shapes;
+        Vector<Vector<uint8_t>> blend_shapes;
         Vector<AABB> bone_aabbs;
     };
 
-    struct DummyMesh : public RID_Data {
+    struct DummyMesh {
         Vector<DummySurface> surfaces;
-        int blend_shape_count;
-        RS::BlendShapeMode blend_shape_mode;
+        AABB custom_aabb;
+        int blend_shape_count = 0;
+        RS::BlendShapeMode blend_shape_mode = RS::BLEND_SHAPE_MODE_NORMALIZED;
     };
 
-    mutable RID_Owner<DummyTexture> texture_owner;
-    mutable RID_Owner<DummyMesh> mesh_owner;
+    // Lights keep the state the scene server reads back to cull and pair them.
+    struct DummyLight {
+        RS::LightType type;
+        float param[RS::LIGHT_PARAM_MAX] = {};
+        Color color = Color(1, 1, 1, 1);
+        uint64_t version = 0;
+        bool shadow = false;
+    };
 
-    RenderingEntity texture_create() {
+    struct DummyLightmapCapture {
+        PoolVector<LightmapCaptureOctree> octree;
+        AABB bounds;
+        Transform cell_xform;
+        int cell_subdiv = 1;
+        float energy = 1.0f;
+        bool interior = false;
+    };
+
+    mutable RenderingEntity_Owner<DummyTexture> texture_owner;
+    mutable RenderingEntity_Owner<DummyMesh> mesh_owner;
+    mutable RenderingEntity_Owner<DummyLight> light_owner;
+    mutable RenderingEntity_Owner<DummyLightmapCapture> lightmap_capture_data_owner;
+
+    static PoolVector<uint8_t> to_pool_vector(const Vector<uint8_t> &p_data) {
+        PoolVector<uint8_t> res;
+        res.resize(p_data.size());
+        if (!p_data.empty()) {
+            PoolVector<uint8_t>::Write w = res.write();
+            memcpy(w.ptr(), p_data.data(), p_data.size());
+        }
+        return res;
+    }
 
-        DummyTexture *texture = memnew(DummyTexture);
-        ERR_FAIL_COND_V(!texture, entt::null)
-        return texture_owner.make_rid(texture);
+    RenderingEntity texture_create() override {
+        auto res = VSG::ecs->create();
+        VSG::ecs->registry.emplace<DummyTexture>(res);
+        return res;
     }
 
-    void texture_allocate(RenderingEntity p_texture, int p_width, int p_height, int p_depth_3d, Image::Format p_format, RenderingServerEnums::TextureType p_type = RS::TEXTURE_TYPE_2D, uint32_t p_flags = RS::TEXTURE_FLAGS_DEFAULT) {
+    void texture_allocate(RenderingEntity p_texture, int p_width, int p_height, int p_depth_3d, Image::Format p_format, RS::TextureType p_type, uint32_t p_flags = RS::TEXTURE_FLAGS_DEFAULT) override {
         DummyTexture *t = texture_owner.getornull(p_texture);
         ERR_FAIL_COND(!t);
         t->width = p_width;
@@ -167,19 +196,21 @@ public:
         t->image = make_ref_counted<Image>();
         t->image->create(p_width, p_height, false, p_format);
     }
-    void texture_set_data(RenderingEntity p_texture, const Ref<Image> &p_image, int p_level) {
+    void texture_set_data(RenderingEntity p_texture, const Ref<Image> &p_image, int p_level) override {
         DummyTexture *t = texture_owner.getornull(p_texture);
         ERR_FAIL_COND(!t);
+        ERR_FAIL_COND(!t->image);
         t->width = p_image->get_width();
         t->height = p_image->get_height();
         t->format = p_image->get_format();
         t->image->create(t->width, t->height, false, t->format, p_image->get_data());
     }
 
-    void texture_set_data_partial(RenderingEntity p_texture, const Ref<Image> &p_image, int src_x, int src_y, int src_w, int src_h, int dst_x, int dst_y, int p_dst_mip, int p_level) {
+    void texture_set_data_partial(RenderingEntity p_texture, const Ref<Image> &p_image, int src_x, int src_y, int src_w, int src_h, int dst_x, int dst_y, int p_dst_mip, int p_level) override {
         DummyTexture *t = texture_owner.get(p_texture);
 
         ERR_FAIL_COND(!t);
+        ERR_FAIL_COND(!t->image);
         ERR_FAIL_COND_MSG(not p_image, "It's not a reference to a valid Image object.");
         ERR_FAIL_COND(t->format != p_image->get_format());
         ERR_FAIL_COND(src_w <= 0 || src_h <= 0);
@@ -189,593 +220,713 @@ public:
         t->image->blit_rect(p_image, Rect2(src_x, src_y, src_w, src_h), Vector2(dst_x, dst_y));
     }
 
-    Ref<Image> texture_get_data(RenderingEntity p_texture, int p_level) const {
+    Ref<Image> texture_get_data(RenderingEntity p_texture, int p_level) const override {
         DummyTexture *t = texture_owner.getornull(p_texture);
-        ERR_FAIL_COND_V(!t, Ref<Image>())
+        ERR_FAIL_COND_V(!t, Ref<Image>());
         return t->image;
     }
-    void texture_set_flags(RenderingEntity p_texture, uint32_t p_flags) {
+    void texture_set_flags(RenderingEntity p_texture, uint32_t p_flags) override {
         DummyTexture *t = texture_owner.getornull(p_texture);
         ERR_FAIL_COND(!t);
         t->flags = p_flags;
     }
-    uint32_t texture_get_flags(RenderingEntity p_texture) const {
+    uint32_t texture_get_flags(RenderingEntity p_texture) const override {
         DummyTexture *t = texture_owner.getornull(p_texture);
-        ERR_FAIL_COND_V(!t, 0)
+        ERR_FAIL_COND_V(!t, 0);
         return t->flags;
     }
-    Image::Format texture_get_format(RenderingEntity p_texture) const {
+    Image::Format texture_get_format(RenderingEntity p_texture) const override {
         DummyTexture *t = texture_owner.getornull(p_texture);
-        ERR_FAIL_COND_V(!t, ImageData::FORMAT_RGB8)
+        ERR_FAIL_COND_V(!t, ImageData::FORMAT_RGB8);
         return t->format;
     }
 
-    RenderingServer::TextureType texture_get_type(RenderingEntity p_texture) const { return RS::TEXTURE_TYPE_2D; }
-    uint32_t texture_get_texid(RenderingEntity p_texture) const { return 0; }
-    uint32_t texture_get_width(RenderingEntity p_texture) const { return 0; }
-    uint32_t texture_get_height(RenderingEntity p_texture) const { return 0; }
-    uint32_t texture_get_depth(RenderingEntity p_texture) const { return 0; }
-    void texture_set_size_override(RenderingEntity p_texture, int p_width, int p_height, int p_depth_3d) {}
-    void texture_bind(RenderingEntity p_texture, uint32_t p_texture_no) {}
+    RS::TextureType texture_get_type(RenderingEntity p_texture) const override { return RS::TEXTURE_TYPE_2D; }
+    uint32_t texture_get_texid(RenderingEntity p_texture) const override { return 0; }
+    uint32_t texture_get_width(RenderingEntity p_texture) const override {
+        DummyTexture *t = texture_owner.getornull(p_texture);
+        ERR_FAIL_COND_V(!t, 0);
+        return t->width;
+    }
+    uint32_t texture_get_height(RenderingEntity p_texture) const override {
+        DummyTexture *t = texture_owner.getornull(p_texture);
+        ERR_FAIL_COND_V(!t, 0);
+        return t->height;
+    }
+    uint32_t texture_get_depth(RenderingEntity p_texture) const override { return 0; }
+    void texture_set_size_override(RenderingEntity p_texture, int p_width, int p_height, int p_depth_3d) override {}
+    void texture_bind(RenderingEntity p_texture, uint32_t p_texture_no) override {}
 
-    void texture_set_path(RenderingEntity p_texture, StringView p_path) {
+    void texture_set_path(RenderingEntity p_texture, StringView p_path) override {
         DummyTexture *t = texture_owner.getornull(p_texture);
         ERR_FAIL_COND(!t);
         t->path = p_path;
     }
-    const String &texture_get_path(RenderingEntity p_texture) const {
+    const String &texture_get_path(RenderingEntity p_texture) const override {
         DummyTexture *t = texture_owner.getornull(p_texture);
-        ERR_FAIL_COND_V(!t, null_string)
+        ERR_FAIL_COND_V(!t, null_string);
         return t->path;
     }
 
-    void texture_set_shrink_all_x2_on_set_data(bool p_enable) {}
+    void texture_set_shrink_all_x2_on_set_data(bool p_enable) override {}
 
-    void texture_debug_usage(List<RS::TextureInfo> *r_info) {}
+    void texture_debug_usage(Vector<RenderingServer::TextureInfo> *r_info) override {}
 
-    RenderingEntity texture_create_radiance_cubemap(RenderingEntity p_source, int p_resolution = -1) const { return entt::null; }
+    RenderingEntity texture_create_radiance_cubemap(RenderingEntity p_source, int p_resolution = -1) const override { return entt::null; }
 
-    void texture_set_detect_3d_callback(RenderingEntity p_texture, RenderingServer::TextureDetectCallback p_callback, void *p_userdata) {}
-    void texture_set_detect_srgb_callback(RenderingEntity p_texture, RenderingServer::TextureDetectCallback p_callback, void *p_userdata) {}
-    void texture_set_detect_normal_callback(RenderingEntity p_texture, RenderingServer::TextureDetectCallback p_callback, void *p_userdata) {}
+    void texture_set_detect_3d_callback(RenderingEntity p_texture, RenderingServer::TextureDetectCallback p_callback, void *p_userdata) override {}
+    void texture_set_detect_srgb_callback(RenderingEntity p_texture, RenderingServer::TextureDetectCallback p_callback, void *p_userdata) override {}
+    void texture_set_detect_normal_callback(RenderingEntity p_texture, RenderingServer::TextureDetectCallback p_callback, void *p_userdata) override {}
 
-    void textures_keep_original(bool p_enable) {}
+    void textures_keep_original(bool p_enable) override {}
 
-    void texture_set_proxy(RenderingEntity p_proxy, RenderingEntity p_base) {}
-    virtual Size2 texture_size_with_proxy(RenderingEntity p_texture) const { return Size2(); }
-    void texture_set_force_redraw_if_visible(RenderingEntity p_texture, bool p_enable) {}
+    void texture_set_proxy(RenderingEntity p_proxy, RenderingEntity p_base) override {}
+    Size2 texture_size_with_proxy(RenderingEntity p_texture) const override { return Size2(); }
+    void texture_set_force_redraw_if_visible(RenderingEntity p_texture, bool p_enable) override {}
 
     /* SKY API */
 
-    RenderingEntity sky_create() { return entt::null; }
-    void sky_set_texture(RenderingEntity p_sky, RenderingEntity p_cube_map, int p_radiance_size) {}
+    RenderingEntity sky_create() override { return entt::null; }
+    void sky_set_texture(RenderingEntity p_sky, RenderingEntity p_cube_map, int p_radiance_size) override {}
 
     /* SHADER API */
 
-    RenderingEntity shader_create() { return entt::null; }
+    RenderingEntity shader_create() override { return entt::null; }
+
+    void shader_set_code(RenderingEntity p_shader, const String &p_code) override {}
+    String shader_get_code(RenderingEntity p_shader) const override { return String(); }
+    void shader_get_param_list(RenderingEntity p_shader, Vector<PropertyInfo> *p_param_list) const override {}
 
-    void shader_set_code(RenderingEntity p_shader, const String &p_code) {}
-    String shader_get_code(RenderingEntity p_shader) const { return String(); }
-    void shader_get_param_list(RenderingEntity p_shader, Vector<PropertyInfo> *p_param_list) const {}
+    void shader_set_default_texture_param(RenderingEntity p_shader, const StringName &p_name, RenderingEntity p_texture) override {}
+    RenderingEntity shader_get_default_texture_param(RenderingEntity p_shader, const StringName &p_name) const override { return entt::null; }
 
-    void shader_set_default_texture_param(RenderingEntity p_shader, const StringName &p_name, RenderingEntity p_texture) {}
-    RenderingEntity shader_get_default_texture_param(RenderingEntity p_shader, const StringName &p_name) const { return entt::null; }
+    void shader_add_custom_define(RenderingEntity p_shader, StringView p_define) override {}
+    void shader_get_custom_defines(RenderingEntity p_shader, Vector<StringView> *p_defines) const override {}
+    void shader_remove_custom_define(RenderingEntity p_shader, StringView p_define) override {}
 
-    void shader_add_custom_define(RenderingEntity p_shader, StringView p_define) {}
-    void shader_get_custom_defines(RenderingEntity p_shader, Span<const StringView> p_defines) const {}
-    void shader_remove_custom_define(RenderingEntity p_shader, StringView p_define) {}
+    void set_shader_async_hidden_forbidden(bool p_forbidden) override {}
+    bool is_shader_async_hidden_forbidden() override { return false; }
 
     /* COMMON MATERIAL API */
 
-    RenderingEntity material_create() { return entt::null; }
+    RenderingEntity material_create() override { return entt::null; }
 
-    void material_set_render_priority(RenderingEntity p_material, int priority) {}
-    void material_set_shader(RenderingEntity p_shader_material, RenderingEntity p_shader) {}
-    RenderingEntity material_get_shader(RenderingEntity p_shader_material) const { return entt::null; }
+    void material_set_render_priority(RenderingEntity p_material, int priority) override {}
+    void material_set_shader(RenderingEntity p_shader_material, RenderingEntity p_shader) override {}
+    RenderingEntity material_get_shader(RenderingEntity p_shader_material) const override { return entt::null; }
 
-    void material_set_param(RenderingEntity p_material, const StringName &p_param, const Variant &p_value) {}
-    Variant material_get_param(RenderingEntity p_material, const StringName &p_param) const { return Variant(); }
-    Variant material_get_param_default(RenderingEntity p_material, const StringName &p_param) const { return Variant(); }
+    void material_set_param(RenderingEntity p_material, const StringName &p_param, const Variant &p_value) override {}
+    Variant material_get_param(RenderingEntity p_material, const StringName &p_param) const override { return Variant(); }
+    Variant material_get_param_default(RenderingEntity p_material, const StringName &p_param) const override { return Variant(); }
 
-    void material_set_line_width(RenderingEntity p_material, float p_width) {}
+    void material_set_line_width(RenderingEntity p_material, float p_width) override {}
 
-    void material_set_next_pass(RenderingEntity p_material, RenderingEntity p_next_material) {}
+    void material_set_next_pass(RenderingEntity p_material, RenderingEntity p_next_material) override {}
 
-    bool material_is_animated(RenderingEntity p_material) { return false; }
-    bool material_casts_shadows(RenderingEntity p_material) { return false; }
+    bool material_is_animated(RenderingEntity p_material) override { return false; }
+    bool material_casts_shadows(RenderingEntity p_material) override { return false; }
 
-    void material_add_instance_owner(RenderingEntity p_material, RenderingEntity p_instance) {}
-    void material_remove_instance_owner(RenderingEntity p_material, RenderingEntity p_instance) {}
+    void material_add_instance_owner(RenderingEntity p_material, RenderingEntity p_instance) override {}
+    void material_remove_instance_owner(RenderingEntity p_material, RenderingEntity p_instance) override {}
 
     /* MESH API */
 
-    RenderingEntity mesh_create() {
-        DummyMesh *mesh = memnew(DummyMesh);
-        ERR_FAIL_COND_V(!mesh, entt::null)
-        mesh->blend_shape_count = 0;
-        mesh->blend_shape_mode = RS::BLEND_SHAPE_MODE_NORMALIZED;
-        return mesh_owner.make_rid(mesh);
+    RenderingEntity mesh_create() override {
+        auto res = VSG::ecs->create();
+        VSG::ecs->registry.emplace<DummyMesh>(res);
+        return res;
     }
 
-    void mesh_add_surface(RenderingEntity p_mesh, uint32_t p_format, RS::PrimitiveType p_primitive, const Vector<uint8_t> &p_array, int p_vertex_count, const Vector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<Vector<uint8_t> > &p_blend_shapes = Vector<Vector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>()) {
+    void mesh_add_surface(RenderingEntity p_mesh, uint32_t p_format, RS::PrimitiveType p_primitive, Span<const uint8_t> p_array, int p_vertex_count, Span<const uint8_t> p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t>> &p_blend_shapes = Vector<PoolVector<uint8_t>>(), Span<const AABB> p_bone_aabbs = {}) override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
         ERR_FAIL_COND(!m);
 
-        m->surfaces.push_back(DummySurface());
-        DummySurface *s = &m->surfaces.write[m->surfaces.size() - 1];
-        s->format = p_format;
-        s->primitive = p_primitive;
-        s->array = p_array;
-        s->vertex_count = p_vertex_count;
-        s->index_array = p_index_array;
-        s->index_count = p_index_count;
-        s->aabb = p_aabb;
-        s->blend_shapes = p_blend_shapes;
-        s->bone_aabbs = p_bone_aabbs;
+        DummySurface &s = m->surfaces.emplace_back();
+        s.format = p_format;
+        s.primitive = p_primitive;
+        s.array.assign(p_array.begin(), p_array.end());
+        s.vertex_count = p_vertex_count;
+        s.index_array.assign(p_index_array.begin(), p_index_array.end());
+        s.index_count = p_index_count;
+        s.aabb = p_aabb;
+        s.blend_shapes.reserve(p_blend_shapes.size());
+        for (const PoolVector<uint8_t> &shape : p_blend_shapes) {
+            PoolVector<uint8_t>::Read r = shape.read();
+            s.blend_shapes.emplace_back(r.ptr(), r.ptr() + shape.size());
+        }
+        s.bone_aabbs.assign(p_bone_aabbs.begin(), p_bone_aabbs.end());
     }
 
-    void mesh_set_blend_shape_count(RenderingEntity p_mesh, int p_amount) {
+    void mesh_set_blend_shape_count(RenderingEntity p_mesh, int p_amount) override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
         ERR_FAIL_COND(!m);
         m->blend_shape_count = p_amount;
     }
-    int mesh_get_blend_shape_count(RenderingEntity p_mesh) const {
+    int mesh_get_blend_shape_count(RenderingEntity p_mesh) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, 0)
+        ERR_FAIL_COND_V(!m, 0);
         return m->blend_shape_count;
     }
 
-    void mesh_set_blend_shape_mode(RenderingEntity p_mesh, RS::BlendShapeMode p_mode) {
+    void mesh_set_blend_shape_mode(RenderingEntity p_mesh, RS::BlendShapeMode p_mode) override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
         ERR_FAIL_COND(!m);
         m->blend_shape_mode = p_mode;
     }
-    RS::BlendShapeMode mesh_get_blend_shape_mode(RenderingEntity p_mesh) const {
+    RS::BlendShapeMode mesh_get_blend_shape_mode(RenderingEntity p_mesh) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, RS::BLEND_SHAPE_MODE_NORMALIZED)
+        ERR_FAIL_COND_V(!m, RS::BLEND_SHAPE_MODE_NORMALIZED);
         return m->blend_shape_mode;
     }
 
-    void mesh_surface_update_region(RenderingEntity p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data) {}
+    void mesh_set_blend_shape_values(RenderingEntity p_mesh, Span<const float> p_values) override {}
+    Vector<float> mesh_get_blend_shape_values(RenderingEntity p_mesh) const override { return Vector<float>(); }
+
+    void mesh_surface_update_region(RenderingEntity p_mesh, int p_surface, int p_offset, Span<const uint8_t> p_data) override {}
 
-    void mesh_surface_set_material(RenderingEntity p_mesh, int p_surface, RenderingEntity p_material) {}
-    RenderingEntity mesh_surface_get_material(RenderingEntity p_mesh, int p_surface) const { return entt::null; }
+    void mesh_surface_set_material(RenderingEntity p_mesh, int p_surface, RenderingEntity p_material) override {}
+    RenderingEntity mesh_surface_get_material(RenderingEntity p_mesh, int p_surface) const override { return entt::null; }
 
-    int mesh_surface_get_array_len(RenderingEntity p_mesh, int p_surface) const {
+    int mesh_surface_get_array_len(RenderingEntity p_mesh, int p_surface) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, 0)
+        ERR_FAIL_COND_V(!m, 0);
+        ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), 0);
 
         return m->surfaces[p_surface].vertex_count;
     }
-    int mesh_surface_get_array_index_len(RenderingEntity p_mesh, int p_surface) const {
+    int mesh_surface_get_array_index_len(RenderingEntity p_mesh, int p_surface) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, 0)
+        ERR_FAIL_COND_V(!m, 0);
+        ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), 0);
 
         return m->surfaces[p_surface].index_count;
     }
 
-    PoolVector<uint8_t> mesh_surface_get_array(RenderingEntity p_mesh, int p_surface) const {
+    PoolVector<uint8_t> mesh_surface_get_array(RenderingEntity p_mesh, int p_surface) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, PoolVector<uint8_t>())
+        ERR_FAIL_COND_V(!m, PoolVector<uint8_t>());
+        ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), PoolVector<uint8_t>());
 
-        return m->surfaces[p_surface].array;
+        return to_pool_vector(m->surfaces[p_surface].array);
     }
-    PoolVector<uint8_t> mesh_surface_get_index_array(RenderingEntity p_mesh, int p_surface) const {
+    PoolVector<uint8_t> mesh_surface_get_index_array(RenderingEntity p_mesh, int p_surface) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, PoolVector<uint8_t>())
+        ERR_FAIL_COND_V(!m, PoolVector<uint8_t>());
+        ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), PoolVector<uint8_t>());
 
-        return m->surfaces[p_surface].index_array;
+        return to_pool_vector(m->surfaces[p_surface].index_array);
     }
 
-    uint32_t mesh_surface_get_format(RenderingEntity p_mesh, int p_surface) const {
+    uint32_t mesh_surface_get_format(RenderingEntity p_mesh, int p_surface) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, 0)
+        ERR_FAIL_COND_V(!m, 0);
+        ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), 0);
 
         return m->surfaces[p_surface].format;
     }
-    RS::PrimitiveType mesh_surface_get_primitive_type(RenderingEntity p_mesh, int p_surface) const {
+    RS::PrimitiveType mesh_surface_get_primitive_type(RenderingEntity p_mesh, int p_surface) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, RS::PRIMITIVE_POINTS)
+        ERR_FAIL_COND_V(!m, RS::PRIMITIVE_POINTS);
+        ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), RS::PRIMITIVE_POINTS);
 
         return m->surfaces[p_surface].primitive;
     }
 
-    AABB mesh_surface_get_aabb(RenderingEntity p_mesh, int p_surface) const {
+    AABB mesh_surface_get_aabb(RenderingEntity p_mesh, int p_surface) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, AABB())
+        ERR_FAIL_COND_V(!m, AABB());
+        ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), AABB());
 
         return m->surfaces[p_surface].aabb;
     }
-    Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RenderingEntity p_mesh, int p_surface) const {
+    Vector<Vector<uint8_t>> mesh_surface_get_blend_shapes(RenderingEntity p_mesh, int p_surface) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, Vector<PoolVector<uint8_t> >())
+        ERR_FAIL_COND_V(!m, Vector<Vector<uint8_t>>());
+        ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), Vector<Vector<uint8_t>>());
 
         return m->surfaces[p_surface].blend_shapes;
     }
-    Vector<AABB> mesh_surface_get_skeleton_aabb(RenderingEntity p_mesh, int p_surface) const {
+    const Vector<AABB> &mesh_surface_get_skeleton_aabb(RenderingEntity p_mesh, int p_surface) const override {
+        static const Vector<AABB> null_aabb_pvec;
+
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, Vector<AABB>())
+        ERR_FAIL_COND_V(!m, null_aabb_pvec);
+        ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), null_aabb_pvec);
 
         return m->surfaces[p_surface].bone_aabbs;
     }
 
-    void mesh_remove_surface(RenderingEntity p_mesh, int p_index) {
+    void mesh_remove_surface(RenderingEntity p_mesh, int p_index) override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
         ERR_FAIL_COND(!m);
-        ERR_FAIL_COND(p_index >= m->surfaces.size());
+        ERR_FAIL_INDEX(p_index, m->surfaces.size());
 
-        m->surfaces.remove(p_index);
+        m->surfaces.erase_at(p_index);
     }
-    int mesh_get_surface_count(RenderingEntity p_mesh) const {
+    int mesh_get_surface_count(RenderingEntity p_mesh) const override {
         DummyMesh *m = mesh_owner.getornull(p_mesh);
-        ERR_FAIL_COND_V(!m, 0)
+        ERR_FAIL_COND_V(!m, 0);
         return m->surfaces.size();
     }
 
-    void mesh_set_custom_aabb(RenderingEntity p_mesh, const AABB &p_aabb) {}
-    AABB mesh_get_custom_aabb(RenderingEntity p_mesh) const { return AABB(); }
+    void mesh_set_custom_aabb(RenderingEntity p_mesh, const AABB &p_aabb) override {
+        DummyMesh *m = mesh_owner.getornull(p_mesh);
+        ERR_FAIL_COND(!m);
+        m->custom_aabb = p_aabb;
+    }
+    AABB mesh_get_custom_aabb(RenderingEntity p_mesh) const override {
+        DummyMesh *m = mesh_owner.getornull(p_mesh);
+        ERR_FAIL_COND_V(!m, AABB());
+        return m->custom_aabb;
+    }
+
+    AABB mesh_get_aabb(RenderingEntity p_mesh, RenderingEntity p_skeleton) const override {
+        DummyMesh *m = mesh_owner.getornull(p_mesh);
+        ERR_FAIL_COND_V(!m, AABB());
+
+        if (m->custom_aabb != AABB()) {
+            return m->custom_aabb;
+        }
 
-    AABB mesh_get_aabb(RenderingEntity p_mesh, RenderingEntity p_skeleton) const { return AABB(); }
-    void mesh_clear(RenderingEntity p_mesh) {}
+        AABB aabb;
+        for (size_t i = 0; i < m->surfaces.size(); i++) {
+            if (i == 0) {
+                aabb = m->surfaces[i].aabb;
+            } else {
+                aabb.merge_with(m->surfaces[i].aabb);
+            }
+        }
+        return aabb;
+    }
+    void mesh_clear(RenderingEntity p_mesh) override {
+        DummyMesh *m = mesh_owner.getornull(p_mesh);
+        ERR_FAIL_COND(!m);
+        m->surfaces.clear();
+    }
 
     /* MULTIMESH API */
 
-    virtual RenderingEntity multimesh_create() { return entt::null; }
+    RenderingEntity multimesh_create() override { return entt::null; }
 
-    void multimesh_allocate(RenderingEntity p_multimesh, int p_instances, RS::MultimeshTransformFormat p_transform_format, RS::MultimeshColorFormat p_color_format, RS::MultimeshCustomDataFormat p_data = RS::MULTIMESH_CUSTOM_DATA_NONE) {}
-    int multimesh_get_instance_count(RenderingEntity p_multimesh) const { return 0; }
+    void multimesh_allocate(RenderingEntity p_multimesh, int p_instances, RS::MultimeshTransformFormat p_transform_format, RS::MultimeshColorFormat p_color_format, RS::MultimeshCustomDataFormat p_data = RS::MULTIMESH_CUSTOM_DATA_NONE) override {}
+    int multimesh_get_instance_count(RenderingEntity p_multimesh) const override { return 0; }
 
-    void multimesh_set_mesh(RenderingEntity p_multimesh, RenderingEntity p_mesh) {}
-    void multimesh_instance_set_transform(RenderingEntity p_multimesh, int p_index, const Transform &p_transform) {}
-    void multimesh_instance_set_transform_2d(RenderingEntity p_multimesh, int p_index, const Transform2D &p_transform) {}
-    void multimesh_instance_set_color(RenderingEntity p_multimesh, int p_index, const Color &p_color) {}
-    void multimesh_instance_set_custom_data(RenderingEntity p_multimesh, int p_index, const Color &p_color) {}
+    void multimesh_set_mesh(RenderingEntity p_multimesh, RenderingEntity p_mesh) override {}
+    void multimesh_instance_set_transform(RenderingEntity p_multimesh, int p_index, const Transform &p_transform) override {}
+    void multimesh_instance_set_transform_2d(RenderingEntity p_multimesh, int p_index, const Transform2D &p_transform) override {}
+    void multimesh_instance_set_color(RenderingEntity p_multimesh, int p_index, const Color &p_color) override {}
+    void multimesh_instance_set_custom_data(RenderingEntity p_multimesh, int p_index, const Color &p_color) override {}
 
-    RenderingEntity multimesh_get_mesh(RenderingEntity p_multimesh) const { return entt::null; }
+    RenderingEntity multimesh_get_mesh(RenderingEntity p_multimesh) const override { return entt::null; }
 
-    Transform multimesh_instance_get_transform(RenderingEntity p_multimesh, int p_index) const { return Transform(); }
-    Transform2D multimesh_instance_get_transform_2d(RenderingEntity p_multimesh, int p_index) const { return Transform2D(); }
-    Color multimesh_instance_get_color(RenderingEntity p_multimesh, int p_index) const { return Color(); }
-    Color multimesh_instance_get_custom_data(RenderingEntity p_multimesh, int p_index) const { return Color(); }
+    Transform multimesh_instance_get_transform(RenderingEntity p_multimesh, int p_index) const override { return Transform(); }
+    Transform2D multimesh_instance_get_transform_2d(RenderingEntity p_multimesh, int p_index) const override { return Transform2D(); }
+    Color multimesh_instance_get_color(RenderingEntity p_multimesh, int p_index) const override { return Color(); }
+    Color multimesh_instance_get_custom_data(RenderingEntity p_multimesh, int p_index) const override { return Color(); }
 
-    void multimesh_set_as_bulk_array(RenderingEntity p_multimesh, const PoolVector<float> &p_array) {}
+    void multimesh_set_as_bulk_array(RenderingEntity p_multimesh, Span<const float> p_array) override {}
 
-    void multimesh_set_visible_instances(RenderingEntity p_multimesh, int p_visible) {}
-    int multimesh_get_visible_instances(RenderingEntity p_multimesh) const { return 0; }
+    void multimesh_set_visible_instances(RenderingEntity p_multimesh, int p_visible) override {}
+    int multimesh_get_visible_instances(RenderingEntity p_multimesh) const override { return 0; }
 
-    AABB multimesh_get_aabb(RenderingEntity p_multimesh) const { return AABB(); }
+    AABB multimesh_get_aabb(RenderingEntity p_multimesh) const override { return AABB(); }
 
     /* IMMEDIATE API */
 
-    RenderingEntity immediate_create() { return entt::null; }
-    void immediate_begin(RenderingEntity p_immediate, RS::PrimitiveType p_rimitive, RenderingEntity p_texture = entt::null) {}
-    void immediate_vertex(RenderingEntity p_immediate, const Vector3 &p_vertex) {}
-    void immediate_normal(RenderingEntity p_immediate, const Vector3 &p_normal) {}
-    void immediate_tangent(RenderingEntity p_immediate, const Plane &p_tangent) {}
-    void immediate_color(RenderingEntity p_immediate, const Color &p_color) {}
-    void immediate_uv(RenderingEntity p_immediate, const Vector2 &tex_uv) {}
-    void immediate_uv2(RenderingEntity p_immediate, const Vector2 &tex_uv) {}
-    void immediate_end(RenderingEntity p_immediate) {}
-    void immediate_clear(RenderingEntity p_immediate) {}
-    void immediate_set_material(RenderingEntity p_immediate, RenderingEntity p_material) {}
-    RenderingEntity immediate_get_material(RenderingEntity p_immediate) const { return entt::null; }
-    AABB immediate_get_aabb(RenderingEntity p_immediate) const { return AABB(); }
+    RenderingEntity immediate_create() override { return entt::null; }
+    void immediate_begin(RenderingEntity p_immediate, RS::PrimitiveType p_rimitive, RenderingEntity p_texture = entt::null) override {}
+    void immediate_vertex(RenderingEntity p_immediate, const Vector3 &p_vertex) override {}
+    void immediate_normal(RenderingEntity p_immediate, const Vector3 &p_normal) override {}
+    void immediate_tangent(RenderingEntity p_immediate, const Plane &p_tangent) override {}
+    void immediate_color(RenderingEntity p_immediate, const Color &p_color) override {}
+    void immediate_uv(RenderingEntity p_immediate, const Vector2 &tex_uv) override {}
+    void immediate_uv2(RenderingEntity p_immediate, const Vector2 &tex_uv) override {}
+    void immediate_end(RenderingEntity p_immediate) override {}
+    void immediate_clear(RenderingEntity p_immediate) override {}
+    void immediate_set_material(RenderingEntity p_immediate, RenderingEntity p_material) override {}
+    RenderingEntity immediate_get_material(RenderingEntity p_immediate) const override { return entt::null; }
+    AABB immediate_get_aabb(RenderingEntity p_immediate) const override { return AABB(); }
 
     /* SKELETON API */
 
-    RenderingEntity skeleton_create() { return entt::null; }
-    void skeleton_allocate(RenderingEntity p_skeleton, int p_bones, bool p_2d_skeleton = false) {}
-    void skeleton_set_base_transform_2d(RenderingEntity p_skeleton, const Transform2D &p_base_transform) {}
-    void skeleton_set_world_transform(RenderingEntity p_skeleton, bool p_enable, const Transform &p_world_transform) {}
-    int skeleton_get_bone_count(RenderingEntity p_skeleton) const { return 0; }
-    void skeleton_bone_set_transform(RenderingEntity p_skeleton, int p_bone, const Transform &p_transform) {}
-    Transform skeleton_bone_get_transform(RenderingEntity p_skeleton, int p_bone) const { return Transform(); }
-    void skeleton_bone_set_transform_2d(RenderingEntity p_skeleton, int p_bone, const Transform2D &p_transform) {}
-    Transform2D skeleton_bone_get_transform_2d(RenderingEntity p_skeleton, int p_bone) const { return Transform2D(); }
+    RenderingEntity skeleton_create() override { return entt::null; }
+    void skeleton_allocate(RenderingEntity p_skeleton, int p_bones, bool p_2d_skeleton = false) override {}
+    void skeleton_set_base_transform_2d(RenderingEntity p_skeleton, const Transform2D &p_base_transform) override {}
+    int skeleton_get_bone_count(RenderingEntity p_skeleton) const override { return 0; }
+    void skeleton_bone_set_transform(RenderingEntity p_skeleton, int p_bone, const Transform &p_transform) override {}
+    void skeleton_set_bone_transforms(RenderingEntity p_skeleton, Span<const Transform> p_transforms) override {}
+    Transform skeleton_bone_get_transform(RenderingEntity p_skeleton, int p_bone) const override { return Transform(); }
+    void skeleton_bone_set_transform_2d(RenderingEntity p_skeleton, int p_bone, const Transform2D &p_transform) override {}
+    Transform2D skeleton_bone_get_transform_2d(RenderingEntity p_skeleton, int p_bone) const override { return Transform2D(); }
+    uint32_t skeleton_get_revision(RenderingEntity p_skeleton) const override { return 0; }
 
     /* Light3D API */
 
-    RenderingEntity light_create(RS::LightType p_type) { return entt::null; }
-
-    RenderingEntity directional_light_create() { return light_create(RS::LIGHT_DIRECTIONAL); }
-    RenderingEntity omni_light_create() { return light_create(RS::LIGHT_OMNI); }
-    RenderingEntity spot_light_create() { return light_create(RS::LIGHT_SPOT); }
-
-    void light_set_color(RenderingEntity p_light, const Color &p_color) {}
-    void light_set_param(RenderingEntity p_light, RS::LightParam p_param, float p_value) {}
-    void light_set_shadow(RenderingEntity p_light, bool p_enabled) {}
-    void light_set_shadow_color(RenderingEntity p_light, const Color &p_color) {}
-    void light_set_projector(RenderingEntity p_light, RenderingEntity p_texture) {}
-    void light_set_negative(RenderingEntity p_light, bool p_enable) {}
-    void light_set_cull_mask(RenderingEntity p_light, uint32_t p_mask) {}
-    void light_set_reverse_cull_face_mode(RenderingEntity p_light, bool p_enabled) {}
+    RenderingEntity light_create(RS::LightType p_type) override {
+        auto res = VSG::ecs->create();
+        DummyLight &light = VSG::ecs->registry.emplace<DummyLight>(res);
+
+        light.type = p_type;
+        light.param[RS::LIGHT_PARAM_ENERGY] = 1.0f;
+        light.param[RS::LIGHT_PARAM_INDIRECT_ENERGY] = 1.0f;
+        light.param[RS::LIGHT_PARAM_SPECULAR] = 0.5f;
+        light.param[RS::LIGHT_PARAM_RANGE] = 1.0f;
+        light.param[RS::LIGHT_PARAM_SPOT_ANGLE] = 45;
+
+        return res;
+    }
+
+    void light_set_color(RenderingEntity p_light, const Color &p_color) override {
+        DummyLight *light = light_owner.getornull(p_light);
+        ERR_FAIL_COND(!light);
+        light->color = p_color;
+    }
+    void light_set_param(RenderingEntity p_light, RS::LightParam p_param, float p_value) override {
+        DummyLight *light = light_owner.getornull(p_light);
+        ERR_FAIL_COND(!light);
+        ERR_FAIL_INDEX(p_param, RS::LIGHT_PARAM_MAX);
+        light->param[p_param] = p_value;
+        light->version++;
+    }
+    void light_set_shadow(RenderingEntity p_light, bool p_enabled) override {
+        DummyLight *light = light_owner.getornull(p_light);
+        ERR_FAIL_COND(!light);
+        light->shadow = p_enabled;
+        light->version++;
+    }
+    void light_set_shadow_color(RenderingEntity p_light, const Color &p_color) override {}
+    void light_set_projector(RenderingEntity p_light, RenderingEntity p_texture) override {}
+    void light_set_negative(RenderingEntity p_light, bool p_enable) override {}
+    void light_set_cull_mask(RenderingEntity p_light, uint32_t p_mask) override {}
+    void light_set_reverse_cull_face_mode(RenderingEntity p_light, bool p_enabled) override {}
     void light_set_use_gi(RenderingEntity p_light, bool p_enabled) override {}
     void light_set_bake_mode(RenderingEntity p_light, RS::LightBakeMode p_bake_mode) override {}
 
-    void light_omni_set_shadow_mode(RenderingEntity p_light, RS::LightOmniShadowMode p_mode) {}
-    void light_omni_set_shadow_detail(RenderingEntity p_light, RS::LightOmniShadowDetail p_detail) {}
+    void light_omni_set_shadow_mode(RenderingEntity p_light, RS::LightOmniShadowMode p_mode) override {}
+    void light_omni_set_shadow_detail(RenderingEntity p_light, RS::LightOmniShadowDetail p_detail) override {}
 
-    void light_directional_set_shadow_mode(RenderingEntity p_light, RS::LightDirectionalShadowMode p_mode) {}
-    void light_directional_set_blend_splits(RenderingEntity p_light, bool p_enable) {}
-    bool light_directional_get_blend_splits(RenderingEntity p_light) const { return false; }
-    void light_directional_set_shadow_depth_range_mode(RenderingEntity p_light, RS::LightDirectionalShadowDepthRangeMode p_range_mode) {}
-    RS::LightDirectionalShadowDepthRangeMode light_directional_get_shadow_depth_range_mode(RenderingEntity p_light) const { return RS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_STABLE; }
+    void light_directional_set_shadow_mode(RenderingEntity p_light, RS::LightDirectionalShadowMode p_mode) override {}
+    void light_directional_set_blend_splits(RenderingEntity p_light, bool p_enable) override {}
+    bool light_directional_get_blend_splits(RenderingEntity p_light) const override { return false; }
+    void light_directional_set_shadow_depth_range_mode(RenderingEntity p_light, RS::LightDirectionalShadowDepthRangeMode p_range_mode) override {}
+    RS::LightDirectionalShadowDepthRangeMode light_directional_get_shadow_depth_range_mode(RenderingEntity p_light) const override { return RS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_STABLE; }
 
-    RS::LightDirectionalShadowMode light_directional_get_shadow_mode(RenderingEntity p_light) { return RS::LIGHT_DIRECTIONAL_SHADOW_ORTHOGONAL; }
-    RS::LightOmniShadowMode light_omni_get_shadow_mode(RenderingEntity p_light) { return RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID; }
+    RS::LightDirectionalShadowMode light_directional_get_shadow_mode(RenderingEntity p_light) override { return RS::LIGHT_DIRECTIONAL_SHADOW_ORTHOGONAL; }
+    RS::LightOmniShadowMode light_omni_get_shadow_mode(RenderingEntity p_light) override { return RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID; }
 
-    bool light_has_shadow(RenderingEntity p_light) const { return false; }
+    bool light_has_shadow(RenderingEntity p_light) const override {
+        DummyLight *light = light_owner.getornull(p_light);
+        ERR_FAIL_COND_V(!light, false);
+        return light->shadow;
+    }
 
-    RS::LightType light_get_type(RenderingEntity p_light) const { return RS::LIGHT_OMNI; }
-    AABB light_get_aabb(RenderingEntity p_light) const { return AABB(); }
-    float light_get_param(RenderingEntity p_light, RS::LightParam p_param) { return 0.0; }
-    Color light_get_color(RenderingEntity p_light) { return Color(); }
-    bool light_get_use_gi(RenderingEntity p_light) { return false; }
+    RS::LightType light_get_type(RenderingEntity p_light) const override {
+        DummyLight *light = light_owner.getornull(p_light);
+        ERR_FAIL_COND_V(!light, RS::LIGHT_DIRECTIONAL);
+        return light->type;
+    }
+    AABB light_get_aabb(RenderingEntity p_light) const override {
+        DummyLight *light = light_owner.getornull(p_light);
+        ERR_FAIL_COND_V(!light, AABB());
+
+        switch (light->type) {
+            case RS::LIGHT_SPOT: {
+                float len = light->param[RS::LIGHT_PARAM_RANGE];
+                float size = Math::tan(Math::deg2rad(light->param[RS::LIGHT_PARAM_SPOT_ANGLE])) * len;
+                return AABB(Vector3(-size, -size, -len), Vector3(size * 2, size * 2, len));
+            }
+            case RS::LIGHT_OMNI: {
+                float r = light->param[RS::LIGHT_PARAM_RANGE];
+                return AABB(-Vector3(r, r, r), Vector3(r, r, r) * 2);
+            }
+            case RS::LIGHT_DIRECTIONAL: {
+                return AABB();
+            }
+        }
+
+        ERR_FAIL_V(AABB());
+    }
+    float light_get_param(RenderingEntity p_light, RS::LightParam p_param) override {
+        DummyLight *light = light_owner.getornull(p_light);
+        ERR_FAIL_COND_V(!light, 0.0f);
+        ERR_FAIL_INDEX_V(p_param, RS::LIGHT_PARAM_MAX, 0.0f);
+        return light->param[p_param];
+    }
+    Color light_get_color(RenderingEntity p_light) override {
+        DummyLight *light = light_owner.getornull(p_light);
+        ERR_FAIL_COND_V(!light, Color());
+        return light->color;
+    }
+    bool light_get_use_gi(RenderingEntity p_light) override { return false; }
     RS::LightBakeMode light_get_bake_mode(RenderingEntity p_light) override { return RS::LightBakeMode::LIGHT_BAKE_DISABLED; }
-    uint64_t light_get_version(RenderingEntity p_light) const { return 0; }
+    uint64_t light_get_version(RenderingEntity p_light) const override {
+        DummyLight *light = light_owner.getornull(p_light);
+        ERR_FAIL_COND_V(!light, 0);
+        return light->version;
+    }
 
     /* PROBE API */
 
-    RenderingEntity reflection_probe_create() { return entt::null; }
-
-    void reflection_probe_set_update_mode(RenderingEntity p_probe, RS::ReflectionProbeUpdateMode p_mode) {}
-    void reflection_probe_set_intensity(RenderingEntity p_probe, float p_intensity) {}
-    void reflection_probe_set_interior_ambient(RenderingEntity p_probe, const Color &p_ambient) {}
-    void reflection_probe_set_interior_ambient_energy(RenderingEntity p_probe, float p_energy) {}
-    void reflection_probe_set_interior_ambient_probe_contribution(RenderingEntity p_probe, float p_contrib) {}
-    void reflection_probe_set_max_distance(RenderingEntity p_probe, float p_distance) {}
-    void reflection_probe_set_extents(RenderingEntity p_probe, const Vector3 &p_extents) {}
-    void reflection_probe_set_origin_offset(RenderingEntity p_probe, const Vector3 &p_offset) {}
-    void reflection_probe_set_as_interior(RenderingEntity p_probe, bool p_enable) {}
-    void reflection_probe_set_enable_box_projection(RenderingEntity p_probe, bool p_enable) {}
-    void reflection_probe_set_enable_shadows(RenderingEntity p_probe, bool p_enable) {}
-    void reflection_probe_set_cull_mask(RenderingEntity p_probe, uint32_t p_layers) {}
-    void reflection_probe_set_resolution(RenderingEntity p_probe, int p_resolution) {}
-
-    AABB reflection_probe_get_aabb(RenderingEntity p_probe) const { return AABB(); }
-    RS::ReflectionProbeUpdateMode reflection_probe_get_update_mode(RenderingEntity p_probe) const { return RenderingServer::REFLECTION_PROBE_UPDATE_ONCE; }
-    uint32_t reflection_probe_get_cull_mask(RenderingEntity p_probe) const { return 0; }
-    Vector3 reflection_probe_get_extents(RenderingEntity p_probe) const { return Vector3(); }
-    Vector3 reflection_probe_get_origin_offset(RenderingEntity p_probe) const { return Vector3(); }
-    float reflection_probe_get_origin_max_distance(RenderingEntity p_probe) const { return 0.0; }
-    bool reflection_probe_renders_shadows(RenderingEntity p_probe) const { return false; }
-
-    void instance_add_skeleton(RenderingEntity p_skeleton, RenderingEntity p_instance) {}
-    void instance_remove_skeleton(RenderingEntity p_skeleton, RenderingEntity p_instance) {}
-
-    void instance_add_dependency(RenderingEntity p_base, RenderingEntity p_instance) {}
-    void instance_remove_dependency(RenderingEntity p_base, RenderingEntity p_instance) {}
+    RenderingEntity reflection_probe_create() override { return entt::null; }
+
+    void reflection_probe_set_update_mode(RenderingEntity p_probe, RS::ReflectionProbeUpdateMode p_mode) override {}
+    void reflection_probe_set_intensity(RenderingEntity p_probe, float p_intensity) override {}
+    void reflection_probe_set_interior_ambient(RenderingEntity p_probe, const Color &p_ambient) override {}
+    void reflection_probe_set_interior_ambient_energy(RenderingEntity p_probe, float p_energy) override {}
+    void reflection_probe_set_interior_ambient_probe_contribution(RenderingEntity p_probe, float p_contrib) override {}
+    void reflection_probe_set_max_distance(RenderingEntity p_probe, float p_distance) override {}
+    void reflection_probe_set_extents(RenderingEntity p_probe, const Vector3 &p_extents) override {}
+    void reflection_probe_set_origin_offset(RenderingEntity p_probe, const Vector3 &p_offset) override {}
+    void reflection_probe_set_as_interior(RenderingEntity p_probe, bool p_enable) override {}
+    void reflection_probe_set_enable_box_projection(RenderingEntity p_probe, bool p_enable) override {}
+    void reflection_probe_set_enable_shadows(RenderingEntity p_probe, bool p_enable) override {}
+    void reflection_probe_set_cull_mask(RenderingEntity p_probe, uint32_t p_layers) override {}
+    void reflection_probe_set_resolution(RenderingEntity p_probe, int p_resolution) override {}
+
+    AABB reflection_probe_get_aabb(RenderingEntity p_probe) const override { return AABB(); }
+    RS::ReflectionProbeUpdateMode reflection_probe_get_update_mode(RenderingEntity p_probe) const override { return RS::REFLECTION_PROBE_UPDATE_ONCE; }
+    uint32_t reflection_probe_get_cull_mask(RenderingEntity p_probe) const override { return 0; }
+    Vector3 reflection_probe_get_extents(RenderingEntity p_probe) const override { return Vector3(); }
+    Vector3 reflection_probe_get_origin_offset(RenderingEntity p_probe) const override { return Vector3(); }
+    float reflection_probe_get_origin_max_distance(RenderingEntity p_probe) const override { return 0.0; }
+    bool reflection_probe_renders_shadows(RenderingEntity p_probe) const override { return false; }
+
+    void instance_add_skeleton(RenderingEntity p_skeleton, RenderingEntity p_instance) override {}
+    void instance_remove_skeleton(RenderingEntity p_skeleton, RenderingEntity p_instance) override {}
+
+    void instance_add_dependency(RenderingEntity p_base, RenderingEntity p_instance) override {}
+    void instance_remove_dependency(RenderingEntity p_base, RenderingEntity p_instance) override {}
 
     /* GI PROBE API */
 
-    RenderingEntity gi_probe_create() { return entt::null; }
+    RenderingEntity gi_probe_create() override { return entt::null; }
 
-    void gi_probe_set_bounds(RenderingEntity p_probe, const AABB &p_bounds) {}
-    AABB gi_probe_get_bounds(RenderingEntity p_probe) const { return AABB(); }
+    void gi_probe_set_bounds(RenderingEntity p_probe, const AABB &p_bounds) override {}
+    AABB gi_probe_get_bounds(RenderingEntity p_probe) const override { return AABB(); }
 
-    void gi_probe_set_cell_size(RenderingEntity p_probe, float p_range) {}
-    float gi_probe_get_cell_size(RenderingEntity p_probe) const { return 0.0; }
+    void gi_probe_set_cell_size(RenderingEntity p_probe, float p_range) override {}
+    float gi_probe_get_cell_size(RenderingEntity p_probe) const override { return 0.0; }
 
-    void gi_probe_set_to_cell_xform(RenderingEntity p_probe, const Transform &p_xform) {}
-    Transform gi_probe_get_to_cell_xform(RenderingEntity p_probe) const { return Transform(); }
+    void gi_probe_set_to_cell_xform(RenderingEntity p_probe, const Transform &p_xform) override {}
+    Transform gi_probe_get_to_cell_xform(RenderingEntity p_probe) const override { return Transform(); }
 
-    void gi_probe_set_dynamic_data(RenderingEntity p_probe, const PoolVector<int> &p_data) {}
-    PoolVector<int> gi_probe_get_dynamic_data(RenderingEntity p_probe) const {
+    void gi_probe_set_dynamic_data(RenderingEntity p_probe, const PoolVector<int> &p_data) override {}
+    PoolVector<int> gi_probe_get_dynamic_data(RenderingEntity p_probe) const override {
         PoolVector<int> p;
         return p;
     }
 
-    void gi_probe_set_dynamic_range(RenderingEntity p_probe, int p_range) {}
-    int gi_probe_get_dynamic_range(RenderingEntity p_probe) const { return 0; }
-
-    void gi_probe_set_energy(RenderingEntity p_probe, float p_range) {}
-    float gi_probe_get_energy(RenderingEntity p_probe) const { return 0.0; }
+    void gi_probe_set_dynamic_range(RenderingEntity p_probe, int p_range) override {}
+    int gi_probe_get_dynamic_range(RenderingEntity p_probe) const override { return 0; }
 
-    void gi_probe_set_bias(RenderingEntity p_probe, float p_range) {}
-    float gi_probe_get_bias(RenderingEntity p_probe) const { return 0.0; }
+    void gi_probe_set_energy(RenderingEntity p_probe, float p_range) override {}
+    float gi_probe_get_energy(RenderingEntity p_probe) const override { return 0.0; }
 
-    void gi_probe_set_normal_bias(RenderingEntity p_probe, float p_range) {}
-    float gi_probe_get_normal_bias(RenderingEntity p_probe) const { return 0.0; }
+    void gi_probe_set_bias(RenderingEntity p_probe, float p_range) override {}
+    float gi_probe_get_bias(RenderingEntity p_probe) const override { return 0.0; }
 
-    void gi_probe_set_propagation(RenderingEntity p_probe, float p_range) {}
-    float gi_probe_get_propagation(RenderingEntity p_probe) const { return 0.0; }
+    void gi_probe_set_normal_bias(RenderingEntity p_probe, float p_range) override {}
+    float gi_probe_get_normal_bias(RenderingEntity p_probe) const override { return 0.0; }
 
-    void gi_probe_set_interior(RenderingEntity p_probe, bool p_enable) {}
-    bool gi_probe_is_interior(RenderingEntity p_probe) const { return false; }
+    void gi_probe_set_propagation(RenderingEntity p_probe, float p_range) override {}
+    float gi_probe_get_propagation(RenderingEntity p_probe) const override { return 0.0; }
 
+    void gi_probe_set_interior(RenderingEntity p_probe, bool p_enable) override {}
+    bool gi_probe_is_interior(RenderingEntity p_probe) const override { return false; }
 
-    uint32_t gi_probe_get_version(RenderingEntity p_probe) { return 0; }
+    uint32_t gi_probe_get_version(RenderingEntity p_probe) override { return 0; }
 
-    RenderingEntity gi_probe_dynamic_data_create(int p_width, int p_height, int p_depth) { return entt::null; }
-    void gi_probe_dynamic_data_update(RenderingEntity p_gi_probe_data, int p_depth_slice, int p_slice_count, int p_mipmap, const void *p_data) {}
+    RenderingEntity gi_probe_dynamic_data_create(int p_width, int p_height, int p_depth) override { return entt::null; }
+    void gi_probe_dynamic_data_update(RenderingEntity p_gi_probe_data, int p_depth_slice, int p_slice_count, int p_mipmap, const void *p_data) override {}
 
     /* LIGHTMAP CAPTURE */
-    struct Instantiable : public RID_Data {
-
-        InList<RasterizerScene::InstanceBase> instance_list;
-
-        _FORCE_INLINE_ void instance_change_notify(bool p_aabb = true, bool p_materials = true) {
-
-            IntrusiveListNode<RasterizerScene::InstanceBase> *instances = instance_list.first();
-            while (instances) {
-
-                instances->self()->base_changed(p_aabb, p_materials);
-                instances = instances->next();
-            }
-        }
 
-        void instance_remove_deps() {
-            IntrusiveListNode<RasterizerScene::InstanceBase> *instances = instance_list.first();
-            while (instances) {
-
-                IntrusiveListNode<RasterizerScene::InstanceBase> *next = instances->next();
-                instances->self()->base_removed();
-                instances = next;
-            }
-        }
-
-        Instantiable() {}
-        virtual ~Instantiable() {
-        }
-    };
-
-    struct LightmapCapture : public Instantiable {
-
-        PoolVector<LightmapCaptureOctree> octree;
-        AABB bounds;
-        Transform cell_xform;
-        int cell_subdiv;
-        float energy;
-        LightmapCapture() {
-            energy = 1.0;
-            cell_subdiv = 1;
-        }
-    };
-
-    mutable RID_Owner<LightmapCapture> lightmap_capture_data_owner;
-    void lightmap_capture_set_bounds(RenderingEntity p_capture, const AABB &p_bounds) {}
-    AABB lightmap_capture_get_bounds(RenderingEntity p_capture) const { return AABB(); }
-    void lightmap_capture_set_octree(RenderingEntity p_capture, const PoolVector<uint8_t> &p_octree) {}
-    RenderingEntity lightmap_capture_create() {
-        LightmapCapture *capture = memnew(LightmapCapture);
-        return lightmap_capture_data_owner.make_rid(capture);
-    }
-    PoolVector<uint8_t> lightmap_capture_get_octree(RenderingEntity p_capture) const {
-        const LightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
-        ERR_FAIL_COND_V(!capture, PoolVector<uint8_t>())
+    RenderingEntity lightmap_capture_create() override {
+        auto res = VSG::ecs->create();
+        VSG::ecs->registry.emplace<DummyLightmapCapture>(res);
+        return res;
+    }
+    void lightmap_capture_set_bounds(RenderingEntity p_capture, const AABB &p_bounds) override {
+        DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND(!capture);
+        capture->bounds = p_bounds;
+    }
+    AABB lightmap_capture_get_bounds(RenderingEntity p_capture) const override {
+        const DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND_V(!capture, AABB());
+        return capture->bounds;
+    }
+    void lightmap_capture_set_octree(RenderingEntity p_capture, const PoolVector<uint8_t> &p_octree) override {}
+    PoolVector<uint8_t> lightmap_capture_get_octree(RenderingEntity p_capture) const override {
+        const DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND_V(!capture, PoolVector<uint8_t>());
         return PoolVector<uint8_t>();
     }
-    void lightmap_capture_set_octree_cell_transform(RenderingEntity p_capture, const Transform &p_xform) {}
-    Transform lightmap_capture_get_octree_cell_transform(RenderingEntity p_capture) const { return Transform(); }
-    void lightmap_capture_set_octree_cell_subdiv(RenderingEntity p_capture, int p_subdiv) {}
-    int lightmap_capture_get_octree_cell_subdiv(RenderingEntity p_capture) const { return 0; }
-    void lightmap_capture_set_energy(RenderingEntity p_capture, float p_energy) {}
-    float lightmap_capture_get_energy(RenderingEntity p_capture) const { return 0.0; }
-    const PoolVector<LightmapCaptureOctree> *lightmap_capture_get_octree_ptr(RenderingEntity p_capture) const {
-        const LightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
-        ERR_FAIL_COND_V(!capture, NULL)
+    void lightmap_capture_set_octree_cell_transform(RenderingEntity p_capture, const Transform &p_xform) override {
+        DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND(!capture);
+        capture->cell_xform = p_xform;
+    }
+    Transform lightmap_capture_get_octree_cell_transform(RenderingEntity p_capture) const override {
+        const DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND_V(!capture, Transform());
+        return capture->cell_xform;
+    }
+    void lightmap_capture_set_octree_cell_subdiv(RenderingEntity p_capture, int p_subdiv) override {
+        DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND(!capture);
+        capture->cell_subdiv = p_subdiv;
+    }
+    int lightmap_capture_get_octree_cell_subdiv(RenderingEntity p_capture) const override {
+        const DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND_V(!capture, 0);
+        return capture->cell_subdiv;
+    }
+    void lightmap_capture_set_energy(RenderingEntity p_capture, float p_energy) override {
+        DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND(!capture);
+        capture->energy = p_energy;
+    }
+    float lightmap_capture_get_energy(RenderingEntity p_capture) const override {
+        const DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND_V(!capture, 0.0f);
+        return capture->energy;
+    }
+    void lightmap_capture_set_interior(RenderingEntity p_capture, bool p_interior) override {
+        DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND(!capture);
+        capture->interior = p_interior;
+    }
+    bool lightmap_capture_is_interior(RenderingEntity p_capture) const override {
+        const DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND_V(!capture, false);
+        return capture->interior;
+    }
+    const PoolVector<LightmapCaptureOctree> *lightmap_capture_get_octree_ptr(RenderingEntity p_capture) const override {
+        const DummyLightmapCapture *capture = lightmap_capture_data_owner.getornull(p_capture);
+        ERR_FAIL_COND_V(!capture, nullptr);
         return &capture->octree;
     }
 
     /* PARTICLES */
 
-    RenderingEntity particles_create() { return entt::null; }
+    RenderingEntity particles_create() override { return entt::null; }
 
-    void particles_set_emitting(RenderingEntity p_particles, bool p_emitting) {}
-    void particles_set_amount(RenderingEntity p_particles, int p_amount) {}
-    void particles_set_lifetime(RenderingEntity p_particles, float p_lifetime) {}
-    void particles_set_one_shot(RenderingEntity p_particles, bool p_one_shot) {}
-    void particles_set_pre_process_time(RenderingEntity p_particles, float p_time) {}
-    void particles_set_explosiveness_ratio(RenderingEntity p_particles, float p_ratio) {}
-    void particles_set_randomness_ratio(RenderingEntity p_particles, float p_ratio) {}
-    void particles_set_custom_aabb(RenderingEntity p_particles, const AABB &p_aabb) {}
-    void particles_set_speed_scale(RenderingEntity p_particles, float p_scale) {}
-    void particles_set_use_local_coordinates(RenderingEntity p_particles, bool p_enable) {}
-    void particles_set_process_material(RenderingEntity p_particles, RenderingEntity p_material) {}
-    void particles_set_fixed_fps(RenderingEntity p_particles, int p_fps) {}
-    void particles_set_fractional_delta(RenderingEntity p_particles, bool p_enable) {}
-    void particles_restart(RenderingEntity p_particles) {}
+    void particles_set_emitting(RenderingEntity p_particles, bool p_emitting) override {}
+    void particles_set_amount(RenderingEntity p_particles, int p_amount) override {}
+    void particles_set_lifetime(RenderingEntity p_particles, float p_lifetime) override {}
+    void particles_set_one_shot(RenderingEntity p_particles, bool p_one_shot) override {}
+    void particles_set_pre_process_time(RenderingEntity p_particles, float p_time) override {}
+    void particles_set_explosiveness_ratio(RenderingEntity p_particles, float p_ratio) override {}
+    void particles_set_randomness_ratio(RenderingEntity p_particles, float p_ratio) override {}
+    void particles_set_custom_aabb(RenderingEntity p_particles, const AABB &p_aabb) override {}
+    void particles_set_speed_scale(RenderingEntity p_particles, float p_scale) override {}
+    void particles_set_use_local_coordinates(RenderingEntity p_particles, bool p_enable) override {}
+    void particles_set_process_material(RenderingEntity p_particles, RenderingEntity p_material) override {}
+    void particles_set_fixed_fps(RenderingEntity p_particles, int p_fps) override {}
+    void particles_set_fractional_delta(RenderingEntity p_particles, bool p_enable) override {}
+    void particles_restart(RenderingEntity p_particles) override {}
 
-    void particles_set_draw_order(RenderingEntity p_particles, RS::ParticlesDrawOrder p_order) {}
+    void particles_set_draw_order(RenderingEntity p_particles, RS::ParticlesDrawOrder p_order) override {}
 
-    void particles_set_draw_passes(RenderingEntity p_particles, int p_count) {}
-    void particles_set_draw_pass_mesh(RenderingEntity p_particles, int p_pass, RenderingEntity p_mesh) {}
+    void particles_set_draw_passes(RenderingEntity p_particles, int p_count) override {}
+    void particles_set_draw_pass_mesh(RenderingEntity p_particles, int p_pass, RenderingEntity p_mesh) override {}
 
-    void particles_request_process(RenderingEntity p_particles) {}
-    AABB particles_get_current_aabb(RenderingEntity p_particles) { return AABB(); }
-    AABB particles_get_aabb(RenderingEntity p_particles) const { return AABB(); }
+    void particles_request_process(RenderingEntity p_particles) override {}
+    AABB particles_get_current_aabb(RenderingEntity p_particles) override { return AABB(); }
+    AABB particles_get_aabb(RenderingEntity p_particles) const override { return AABB(); }
 
-    void particles_set_emission_transform(RenderingEntity p_particles, const Transform &p_transform) {}
+    void particles_set_emission_transform(RenderingEntity p_particles, const Transform &p_transform) override {}
 
-    bool particles_get_emitting(RenderingEntity p_particles) { return false; }
-    int particles_get_draw_passes(RenderingEntity p_particles) const { return 0; }
-    RenderingEntity particles_get_draw_pass_mesh(RenderingEntity p_particles, int p_pass) const { return entt::null; }
+    bool particles_get_emitting(RenderingEntity p_particles) override { return false; }
+    int particles_get_draw_passes(RenderingEntity p_particles) const override { return 0; }
+    RenderingEntity particles_get_draw_pass_mesh(RenderingEntity p_particles, int p_pass) const override { return entt::null; }
 
-    virtual bool particles_is_inactive(RenderingEntity p_particles) const { return false; }
+    bool particles_is_inactive(RenderingEntity p_particles) const override { return false; }
 
     /* RENDER TARGET */
 
-    RenderingEntity render_target_create() { return entt::null; }
-    void render_target_set_position(RenderingEntity p_render_target, int p_x, int p_y) {}
-    void render_target_set_size(RenderingEntity p_render_target, int p_width, int p_height) {}
-    RenderingEntity render_target_get_texture(RenderingEntity p_render_target) const { return entt::null; }
-    void render_target_set_external_texture(RenderingEntity p_render_target, unsigned int p_texture_id) {}
-    void render_target_set_flag(RenderingEntity p_render_target, RenderTargetFlags p_flag, bool p_value) {}
-    bool render_target_was_used(RenderingEntity p_render_target) { return false; }
-    void render_target_clear_used(RenderingEntity p_render_target) {}
-    void render_target_set_msaa(RenderingEntity p_render_target, RS::ViewportMSAA p_msaa) {}
+    RenderingEntity render_target_create() override { return entt::null; }
+    void render_target_set_size(RenderingEntity p_render_target, int p_width, int p_height) override {}
+    RenderingEntity render_target_get_texture(RenderingEntity p_render_target) const override { return entt::null; }
+    uint32_t render_target_get_depth_texture_id(RenderingEntity p_render_target) const override { return 0; }
+    void render_target_set_external_texture(RenderingEntity p_render_target, unsigned int p_texture_id, unsigned int p_depth_id) override {}
+    void render_target_set_flag(RenderingEntity p_render_target, RS::RenderTargetFlags p_flag, bool p_value) override {}
+    bool render_target_was_used(RenderingEntity p_render_target) override { return false; }
+    void render_target_clear_used(RenderingEntity p_render_target) override {}
+    void render_target_set_msaa(RenderingEntity p_render_target, RS::ViewportMSAA p_msaa) override {}
     void render_target_set_use_fxaa(RenderingEntity p_render_target, bool p_fxaa) override {}
     void render_target_set_use_debanding(RenderingEntity p_render_target, bool p_debanding) override {}
+    void render_target_set_sharpen_intensity(RenderingEntity p_render_target, float p_intensity) override {}
 
     /* CANVAS SHADOW */
 
-    RenderingEntity canvas_light_shadow_buffer_create(int p_width) { return entt::null; }
+    RenderingEntity canvas_light_shadow_buffer_create(int p_width) override { return entt::null; }
 
     /* LIGHT SHADOW MAPPING */
 
-    RenderingEntity canvas_light_occluder_create() { return entt::null; }
+    RenderingEntity canvas_light_occluder_create() override { return entt::null; }
     void canvas_light_occluder_set_polylines(RenderingEntity p_occluder, Span<const Vector2> p_lines) override {}
 
-    RS::InstanceType get_base_type(RenderingEntity p_rid) const {
+    RS::InstanceType get_base_type(RenderingEntity p_rid) const override {
         if (mesh_owner.owns(p_rid)) {
             return RS::INSTANCE_MESH;
+        } else if (light_owner.owns(p_rid)) {
+            return RS::INSTANCE_LIGHT;
         } else if (lightmap_capture_data_owner.owns(p_rid)) {
             return RS::INSTANCE_LIGHTMAP_CAPTURE;
         }
         return RS::INSTANCE_NONE;
     }
 
-    bool free(RenderingEntity p_rid) {
-
-        if (texture_owner.owns(p_rid)) {
-            // delete the texture
-            DummyTexture *texture = texture_owner.get(p_rid);
-            texture_owner.free(p_rid);
-            memdelete(texture);
+    // The rendering server frees all of its entities through here, so this
+    // destroys any entity, not only the ones this storage created.
+    bool free(RenderingEntity p_rid) override {
+        if (!VSG::ecs->registry.valid(p_rid)) {
+            return false;
         }
+        VSG::ecs->registry.destroy(p_rid);
         return true;
     }
 
-    bool has_os_feature(const String &p_feature) const { return false; }
+    bool has_os_feature(const StringName &p_feature) const override { return false; }
 
-    void update_dirty_resources() {}
+    void update_dirty_resources() override {}
 
-    void set_debug_generate_wireframes(bool p_generate) {}
+    void set_debug_generate_wireframes(bool p_generate) override {}
 
-    void render_info_begin_capture() {}
-    void render_info_end_capture() {}
-    int get_captured_render_info(RS::RenderInfo p_info) { return 0; }
+    void render_info_begin_capture() override {}
+    void render_info_end_capture() override {}
+    int get_captured_render_info(RS::RenderInfo p_info) override { return 0; }
 
-    int get_render_info(RS::RenderInfo p_info) { return 0; }
-    const char *get_video_adapter_name() const { return ""; }
-    const char *get_video_adapter_vendor() const { return ""; }
+    uint64_t get_render_info(RS::RenderInfo p_info) override { return 0; }
+    const char *get_video_adapter_name() const override { return ""; }
+    const char *get_video_adapter_vendor() const override { return ""; }
 
-    static RasterizerStorage *base_singleton;
-
-    RasterizerStorageDummy(){};
-    ~RasterizerStorageDummy() {}
+    RasterizerStorageDummy() {}
+    ~RasterizerStorageDummy() override {}
 };
 
 class RasterizerCanvasDummy : public RasterizerCanvas {
 public:
-    RenderingEntity light_internal_create() { return entt::null; }
-    void light_internal_update(RenderingEntity p_rid, Span<RasterizerCanvasLight3DComponent *> p_light) {}
-    void light_internal_free(RenderingEntity p_rid) {}
+    RenderingEntity light_internal_create() override { return entt::null; }
+    void light_internal_update(RenderingEntity p_rid, RasterizerCanvasLight3DComponent *p_light) override {}
+    void light_internal_free(RenderingEntity p_rid) override {}
 
-    void canvas_begin(){};
-    void canvas_end(){};
+    void canvas_begin() override {}
+    void canvas_end() override {}
 
-    void canvas_render_items(Dequeue<Item *> &p_item_list, int p_z, const Color &p_modulate, Span<RasterizerCanvasLight3DComponent *> p_light, const Transform2D &p_transform){};
-    void canvas_debug_viewport_shadows(Span<RasterizerCanvasLight3DComponent *> p_lights_with_shadow){};
+    void canvas_render_items(Dequeue<Item *> &p_item_list, int p_z, const Color &p_modulate, Span<RasterizerCanvasLight3DComponent *> p_light, const Transform2D &p_base_transform) override {}
+    void canvas_debug_viewport_shadows(Span<RasterizerCanvasLight3DComponent *> p_lights_with_shadow) override {}
 
-    void canvas_light_shadow_buffer_update(RenderingEntity p_buffer, const Transform2D &p_light_xform, int p_light_mask, float p_near, float p_far, LightOccluderInstance *p_occluders, CameraMatrix *p_xform_cache) {}
+    void canvas_light_shadow_buffer_update(RenderingEntity p_buffer, const Transform2D &p_light_xform, int p_light_mask, float p_near, float p_far, RenderingEntity p_occluders, CameraMatrix *p_xform_cache) override {}
 
-    void reset_canvas() {}
+    void reset_canvas() override {}
 
-    void draw_window_margins(int *p_margins, RenderingEntity *p_margin_textures) {}
+    void draw_window_margins(int *p_margins, RenderingEntity *p_margin_textures) override {}
 
     RasterizerCanvasDummy() {}
-    ~RasterizerCanvasDummy() {}
+    ~RasterizerCanvasDummy() override {}
 };
 
 class RasterizerDummy : public Rasterizer {
@@ -785,21 +936,22 @@ protected:
     RasterizerSceneDummy scene;
 
 public:
-    RasterizerStorage *get_storage() { return &storage; }
-    RasterizerCanvas *get_canvas() { return &canvas; }
-    RasterizerScene *get_scene() { return &scene; }
-
-    void set_boot_image(const Ref<Image> &p_image, const Color &p_color, bool p_scale, bool p_use_filter = true) {}
-
-    void initialize() {}
-    void begin_frame(double frame_step) {}
-    void set_current_render_target(RenderingEntity p_render_target) {}
-    void restore_render_target(bool p_3d_was_drawn) {}
-    void clear_render_target(const Color &p_color) {}
-    void blit_render_target_to_screen(RenderingEntity p_render_target, const Rect2 &p_screen_rect, int p_screen = 0) {}
-    void output_lens_distorted_to_screen(RenderingEntity p_render_target, const Rect2 &p_screen_rect, float p_k1, float p_k2, const Vector2 &p_eye_center, float p_oversample) {}
-    void end_frame(bool p_swap_buffers) {}
-    void finalize() {}
+    RasterizerStorage *get_storage() override { return &storage; }
+    RasterizerCanvas *get_canvas() override { return &canvas; }
+    RasterizerScene *get_scene() override { return &scene; }
+
+    void set_boot_image(const Ref<Image> &p_image, const Color &p_color, bool p_scale, bool p_use_filter = true) override {}
+    void set_shader_time_scale(float p_scale) override {}
+
+    void initialize() override {}
+    void begin_frame(double frame_step) override {}
+    void set_current_render_target(RenderingEntity p_render_target) override {}
+    void restore_render_target(bool p_3d_was_drawn) override {}
+    void clear_render_target(const Color &p_color) override {}
+    void blit_render_target_to_screen(RenderingEntity p_render_target, const Rect2 &p_screen_rect, int p_screen = 0) override {}
+    void output_lens_distorted_to_screen(RenderingEntity p_render_target, const Rect2 &p_screen_rect, float p_k1, float p_k2, const Vector2 &p_eye_center, float p_oversample) override {}
+    void end_frame(bool p_swap_buffers) override {}
+    void finalize() override {}
 
     static Error is_viable() {
         return OK;
@@ -814,7 +966,5 @@ public:
     }
 
     RasterizerDummy() {}
-    ~RasterizerDummy() {}
+    ~RasterizerDummy() override {}
 };
-
-#endif // RASTERIZER_DUMMY_H
@@ -56,6 +56,18 @@ void RasterizerCanvasBatcherBaseClass::batch_canvas_begin() {
 }
 
 void RasterizerCanvasBatcherBaseClass::batch_canvas_end() {
+    // cached items that are no longer drawn were most likely freed
+    bdata.item_cache_tick++;
+    if ((bdata.item_cache_tick % ITEM_CACHE_MAX_AGE) == 0) {
+        for (auto iter = bdata.item_cache.begin(); iter != bdata.item_cache.end();) {
+            if (bdata.item_cache_tick - iter->second.last_used_tick > ITEM_CACHE_MAX_AGE) {
+                iter = bdata.item_cache.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
 #if defined(TOOLS_ENABLED) && defined(DEBUG_ENABLED)
     if (bdata.diagnose_frame) {
         bdata.frame_string += "canvas_end\n";
@@ -109,6 +121,7 @@ RasterizerCanvasBatcherBaseClass::BatchData::BatchData() {
     settings_scissor_lights = false;
     settings_scissor_threshold = -1.0f;
     settings_use_single_rect_fallback = false;
+    settings_use_item_cache = true;
     settings_use_software_skinning = true;
     settings_ninepatch_mode = 0; // default
     settings_light_max_join_items = 16;
@@ -119,6 +132,8 @@ RasterizerCanvasBatcherBaseClass::BatchData::BatchData() {
     buffer_mode_batch_upload_send_null = true;
     buffer_mode_batch_upload_flag_stream = false;
 
+    item_cache_tick = 0;
+
     stats_items_sorted = 0;
     stats_light_items_joined = 0;
 }
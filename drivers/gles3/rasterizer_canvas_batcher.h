@@ -35,6 +35,7 @@
 #include "core/string_utils.h"
 #include "core/print_string.h"
 #include "core/deque.h"
+#include "core/hash_map.h"
 #include "drivers/gles3/rasterizer_render_target_component.h"
 #include "drivers/gles3/rasterizer_skeleton_component.h"
 #include "rasterizer_array.h"
@@ -262,6 +263,33 @@ public:
         Color final_modulate;
     };
 
+    // Prefilled batches of a single item, reused on later frames while the item's command list
+    // is unchanged. Only items drawn with hardware transform are cached, their vertices are in
+    // local space so moving the item does not invalidate them.
+    struct BItemCache {
+        uint64_t commands_version;
+        int command_count;
+        uint32_t joined_item_batch_flags;
+        uint32_t sequence_batch_type_flags;
+        uint64_t last_used_tick;
+
+        int total_quads;
+        int total_verts;
+        int total_color_changes;
+        bool use_light_angles;
+
+        Vector<Batch> batches;
+        Vector<BatchTex> batch_textures;
+        Vector<BatchVertex> vertices;
+        Vector<float> light_angles;
+        Vector<BatchColor> vertex_colors;
+    };
+
+    // items with fewer commands are cheaper to prefill than to copy back from the cache
+    static constexpr int ITEM_CACHE_MIN_COMMANDS = 8;
+    // cached items not drawn for this many canvas renders are dropped
+    static constexpr uint64_t ITEM_CACHE_MAX_AGE = 120;
+
     struct BLightRegion {
         void reset() {
             light_bitfield = 0;
@@ -337,6 +365,9 @@ public:
         // items are sorted prior to joining
         RasterizerArray<BSortItem> sort_items;
 
+        HashMap<const RasterizerCanvas::Item *, BItemCache> item_cache;
+        uint64_t item_cache_tick;
+
         // counts
         int total_quads;
         int total_verts;
@@ -371,6 +402,7 @@ public:
         float settings_scissor_threshold; // 0.0 to 1.0
         int settings_item_reordering_lookahead;
         bool settings_use_single_rect_fallback;
+        bool settings_use_item_cache;
         bool settings_use_software_skinning;
         int settings_light_max_join_items;
         int settings_ninepatch_mode;
@@ -580,6 +612,12 @@ private:
 
     // dealing with textures
     int _batch_find_or_create_tex(RenderingEntity p_texture, RenderingEntity p_normal, bool p_tile, int p_previous_match);
+    void _batch_tex_setup(BatchTex &r_batch_tex, RenderingEntity p_texture, RenderingEntity p_normal, bool p_tile);
+
+    // retaining the prefill of unchanged items across frames
+    bool _item_cache_usable(const BItemJoined &p_bij, const RasterizerCanvas::Item *p_item) const;
+    bool _item_cache_restore(const RasterizerCanvas::Item *p_item, uint32_t &r_sequence_batch_type_flags);
+    void _item_cache_store(const RasterizerCanvas::Item *p_item, uint32_t p_sequence_batch_type_flags);
 
 protected:
     // legacy support for non batched mode
@@ -824,8 +862,17 @@ PREAMBLE(int)::_batch_find_or_create_tex(RenderingEntity p_texture, RenderingEnt
     // pushing back from local variable .. not ideal but has to use a Vector because non pod
     // due to RIDs
     BatchTex new_batch_tex;
-    new_batch_tex.RID_texture = p_texture;
-    new_batch_tex.RID_normal = p_normal;
+    _batch_tex_setup(new_batch_tex, p_texture, p_normal, p_tile);
+
+    // push back
+    bdata.batch_textures.push_back(new_batch_tex);
+
+    return bdata.batch_textures.size() - 1;
+}
+
+PREAMBLE(void)::_batch_tex_setup(BatchTex &r_batch_tex, RenderingEntity p_texture, RenderingEntity p_normal, bool p_tile) {
+    r_batch_tex.RID_texture = p_texture;
+    r_batch_tex.RID_normal = p_normal;
 
     // get the texture
     RasterizerTextureComponent*texture = _get_canvas_texture(p_texture);
@@ -840,39 +887,126 @@ PREAMBLE(int)::_batch_find_or_create_tex(RenderingEntity p_texture, RenderingEnt
             h = 1;
         }
 
-        new_batch_tex.tex_pixel_size.x = 1.0 / w;
-        new_batch_tex.tex_pixel_size.y = 1.0 / h;
-        new_batch_tex.flags = texture->flags;
+        r_batch_tex.tex_pixel_size.x = 1.0 / w;
+        r_batch_tex.tex_pixel_size.y = 1.0 / h;
+        r_batch_tex.flags = texture->flags;
     } else {
         // maybe doesn't need doing...
-        new_batch_tex.tex_pixel_size.x = 1.0f;
-        new_batch_tex.tex_pixel_size.y = 1.0f;
-        new_batch_tex.flags = 0;
+        r_batch_tex.tex_pixel_size.x = 1.0f;
+        r_batch_tex.tex_pixel_size.y = 1.0f;
+        r_batch_tex.flags = 0;
     }
 
     if (p_tile) {
         if (texture) {
             // default
-            new_batch_tex.tile_mode = BatchTex::TILE_NORMAL;
+            r_batch_tex.tile_mode = BatchTex::TILE_NORMAL;
 
             // no hardware support for non power of 2 tiling
             if (!get_storage()->config.support_npot_repeat_mipmap) {
                 if (next_power_of_2(texture->alloc_width) != (unsigned int)texture->alloc_width && next_power_of_2(texture->alloc_height) != (unsigned int)texture->alloc_height) {
-                    new_batch_tex.tile_mode = BatchTex::TILE_FORCE_REPEAT;
+                    r_batch_tex.tile_mode = BatchTex::TILE_FORCE_REPEAT;
                 }
             }
         } else {
             // this should not happen?
-            new_batch_tex.tile_mode = BatchTex::TILE_OFF;
+            r_batch_tex.tile_mode = BatchTex::TILE_OFF;
         }
     } else {
-        new_batch_tex.tile_mode = BatchTex::TILE_OFF;
+        r_batch_tex.tile_mode = BatchTex::TILE_OFF;
     }
+}
 
-    // push back
-    bdata.batch_textures.push_back(new_batch_tex);
+PREAMBLE(bool)::_item_cache_usable(const BItemJoined &p_bij, const RasterizerCanvas::Item *p_item) const {
+    if (!bdata.settings_use_item_cache || !p_bij.is_single_item()) {
+        return false;
+    }
 
-    return bdata.batch_textures.size() - 1;
+    // the modulate and large FVFs bake the final modulate and transform into the vertices
+    if (p_bij.flags & (RasterizerStorageCommon::USE_MODULATE_FVF | RasterizerStorageCommon::USE_LARGE_FVF)) {
+        return false;
+    }
+
+    // skinned vertices change with the pose
+    if (p_item->skeleton != entt::null || get_this()->state.using_skeleton) {
+        return false;
+    }
+
+    return (int)p_item->commands.size() >= ITEM_CACHE_MIN_COMMANDS;
+}
+
+PREAMBLE(bool)::_item_cache_restore(const RasterizerCanvas::Item *p_item, uint32_t &r_sequence_batch_type_flags) {
+    auto iter = bdata.item_cache.find(p_item);
+    if (iter == bdata.item_cache.end()) {
+        return false;
+    }
+
+    BItemCache &cache = iter->second;
+    if (cache.commands_version != p_item->commands_version || cache.command_count != (int)p_item->commands.size() || cache.joined_item_batch_flags != bdata.joined_item_batch_flags) {
+        return false;
+    }
+
+    // texture sizes are baked into the uvs, so a resized texture needs a new prefill
+    for (const BatchTex &cached_tex : cache.batch_textures) {
+        BatchTex current_tex;
+        _batch_tex_setup(current_tex, cached_tex.RID_texture, cached_tex.RID_normal, cached_tex.tile_mode != BatchTex::TILE_OFF);
+        if (current_tex.tex_pixel_size.x != cached_tex.tex_pixel_size.x || current_tex.tex_pixel_size.y != cached_tex.tex_pixel_size.y ||
+                current_tex.flags != cached_tex.flags || current_tex.tile_mode != cached_tex.tile_mode) {
+            return false;
+        }
+    }
+
+    // the batch list may have been smaller when this was cached
+    while (bdata.batches.max_size() < (int)cache.batches.size()) {
+        bdata.batches.grow();
+        bdata.batches_temp.reset();
+        bdata.batches_temp.grow();
+    }
+
+    // the item was prefilled in a single flush, so it fits in the (empty) arrays
+    if (!cache.batches.empty()) {
+        memcpy(bdata.batches.request(cache.batches.size()), cache.batches.data(), cache.batches.size() * sizeof(Batch));
+    }
+    if (!cache.vertices.empty()) {
+        memcpy(bdata.vertices.request(cache.vertices.size()), cache.vertices.data(), cache.vertices.size() * sizeof(BatchVertex));
+    }
+    if (!cache.light_angles.empty()) {
+        memcpy(bdata.light_angles.request(cache.light_angles.size()), cache.light_angles.data(), cache.light_angles.size() * sizeof(float));
+    }
+    if (!cache.vertex_colors.empty()) {
+        memcpy(bdata.vertex_colors.request(cache.vertex_colors.size()), cache.vertex_colors.data(), cache.vertex_colors.size() * sizeof(BatchColor));
+    }
+    bdata.batch_textures = cache.batch_textures;
+
+    bdata.total_quads = cache.total_quads;
+    bdata.total_verts = cache.total_verts;
+    bdata.total_color_changes = cache.total_color_changes;
+    bdata.use_light_angles = cache.use_light_angles;
+
+    r_sequence_batch_type_flags = cache.sequence_batch_type_flags;
+    cache.last_used_tick = bdata.item_cache_tick;
+    return true;
+}
+
+PREAMBLE(void)::_item_cache_store(const RasterizerCanvas::Item *p_item, uint32_t p_sequence_batch_type_flags) {
+    BItemCache &cache = bdata.item_cache[p_item];
+
+    cache.commands_version = p_item->commands_version;
+    cache.command_count = p_item->commands.size();
+    cache.joined_item_batch_flags = bdata.joined_item_batch_flags;
+    cache.sequence_batch_type_flags = p_sequence_batch_type_flags;
+    cache.last_used_tick = bdata.item_cache_tick;
+
+    cache.total_quads = bdata.total_quads;
+    cache.total_verts = bdata.total_verts;
+    cache.total_color_changes = bdata.total_color_changes;
+    cache.use_light_angles = bdata.use_light_angles;
+
+    cache.batches.assign(bdata.batches.get_data(), bdata.batches.get_data() + bdata.batches.size());
+    cache.batch_textures = bdata.batch_textures;
+    cache.vertices.assign(bdata.vertices.get_data(), bdata.vertices.get_data() + bdata.vertices.size());
+    cache.light_angles.assign(bdata.light_angles.get_data(), bdata.light_angles.get_data() + bdata.light_angles.size());
+    cache.vertex_colors.assign(bdata.vertex_colors.get_data(), bdata.vertex_colors.get_data() + bdata.vertex_colors.size());
 }
 
 PREAMBLE(void)::batch_initialize() {
@@ -882,6 +1016,7 @@ PREAMBLE(void)::batch_initialize() {
     bdata.settings_item_reordering_lookahead = T_GLOBAL_GET<int>("rendering/batching/parameters/item_reordering_lookahead");
     bdata.settings_light_max_join_items = T_GLOBAL_GET<int>("rendering/batching/lights/max_join_items");
     bdata.settings_use_single_rect_fallback = T_GLOBAL_GET<bool>("rendering/batching/options/single_rect_fallback");
+    bdata.settings_use_item_cache = T_GLOBAL_GET<bool>("rendering/batching/options/cache_static_items");
     bdata.settings_use_software_skinning = T_GLOBAL_GET<bool>("rendering/2d/options/use_software_skinning");
     bdata.settings_ninepatch_mode = T_GLOBAL_GET<int>("rendering/2d/options/ninepatch_mode");
 
@@ -1005,6 +1140,7 @@ PREAMBLE(void)::batch_initialize() {
             batching_options_string += "\titem_reordering_lookahead " + itos(bdata.settings_item_reordering_lookahead) + "\n";
             batching_options_string += "\tlight_max_join_items " + itos(bdata.settings_light_max_join_items) + "\n";
             batching_options_string += "\tsingle_rect_fallback " + String(Variant(bdata.settings_use_single_rect_fallback)) + "\n";
+            batching_options_string += "\tcache_static_items " + String(Variant(bdata.settings_use_item_cache)) + "\n";
 
             batching_options_string += "\tdebug_flash " + String(Variant(bdata.settings_flash_batching)) + "\n";
             batching_options_string += "\tdiagnose_frame " + String(Variant(bdata.settings_diagnose_frame));
@@ -2424,6 +2560,19 @@ PREAMBLE(void)::render_joined_item_commands(const BItemJoined &p_bij, Rasterizer
         fill_state.extra_matrix_sent = true;
     }
 
+    // static items can skip the prefill entirely and send the batches from the last time they were drawn
+    const bool use_item_cache = _item_cache_usable(p_bij, first_item);
+    if (use_item_cache) {
+        uint32_t sequence_batch_type_flags = 0;
+        if (_item_cache_restore(first_item, sequence_batch_type_flags)) {
+            flush_render_batches(first_item, p_current_clip, r_reclip, p_material, sequence_batch_type_flags);
+            bdata.reset_flush();
+            return;
+        }
+    }
+    // an item spread over several flushes can't be restored in one go
+    bool flushed_early = false;
+
     for (unsigned int i = 0; i < p_bij.num_item_refs; i++) {
         const BItemRef &ref = bdata.item_refs[p_bij.first_item_ref + i];
         item = ref.item;
@@ -2472,6 +2621,8 @@ PREAMBLE(void)::render_joined_item_commands(const BItemJoined &p_bij, Rasterizer
             bool bFull = get_this()->prefill_joined_item(fill_state, command_start, item, p_current_clip, r_reclip, p_material);
 
             if (bFull) {
+                flushed_early = true;
+
                 // always pass first item (commands for default are always first item)
                 flush_render_batches(first_item, p_current_clip, r_reclip, p_material, fill_state.sequence_batch_type_flags);
 
@@ -2484,6 +2635,11 @@ PREAMBLE(void)::render_joined_item_commands(const BItemJoined &p_bij, Rasterizer
         }
     }
 
+    // the flush translates the batches in place, so keep them before that
+    if (use_item_cache && !flushed_early) {
+        _item_cache_store(first_item, fill_state.sequence_batch_type_flags);
+    }
+
     // flush if any left
     flush_render_batches(first_item, p_current_clip, r_reclip, p_material, fill_state.sequence_batch_type_flags);
 
@@ -47,6 +47,7 @@
 #include "drivers/gles3/shaders/tonemap.glsl.gen.h"
 #include "servers/rendering/rendering_server_globals.h"
 
+#include "core/radix_sort.h"
 #include "EASTL/sort.h"
 struct RasterizerCommonGeometryComponent;
 struct RasterizerLight3DComponent;
@@ -125,41 +126,56 @@ struct RenderList {
         alpha_elements.clear();
     }
 
-    //should eventually be replaced by radix
+    // Scratch storage reused by the sorts.
+    Vector<RadixSortPair> sort_pairs;
+    Vector<RadixSortPair> sort_scratch;
+    Vector<RenderListElement *> sorted_elements;
 
-    static bool compare_by_key(const RenderListElement *A, const RenderListElement *B) {
-        return A->sort_key < B->sort_key;
-    };
-    static bool compare_by_depth(const RenderListElement *A, const RenderListElement *B) {
-        return A->sort_depth < B->sort_depth;
+    static uint64_t key_by_key(const RenderListElement *e) {
+        return e->sort_key;
     }
-    static bool compare_by_reverse_depth_and_priority(const RenderListElement *A, const RenderListElement *B) {
-        uint32_t layer_A = uint32_t(A->sort_key >> RenderListConstants::SORT_KEY_PRIORITY_SHIFT);
-        uint32_t layer_B = uint32_t(B->sort_key >> RenderListConstants::SORT_KEY_PRIORITY_SHIFT);
-        if (layer_A == layer_B) {
-            return A->sort_depth > B->sort_depth;
-        } else {
-            return layer_A < layer_B;
-        }
+    static uint64_t key_by_depth(const RenderListElement *e) {
+        return RadixSort::float_to_key(e->sort_depth);
     }
-    void sort_by(bool p_alpha, bool(*sorter)(const RenderListElement *A, const RenderListElement *B)) {
-        if (p_alpha) {
-            eastl::sort(alpha_elements.begin(),alpha_elements.end(),sorter);
-        } else {
-            eastl::sort(elements.begin(),elements.end(),sorter);
-        }
+    static uint64_t key_by_reverse_depth_and_priority(const RenderListElement *e) {
+        // priority ascending in the high word, depth descending in the low word
+        uint64_t layer = e->sort_key >> RenderListConstants::SORT_KEY_PRIORITY_SHIFT;
+        return (layer << 32) | uint32_t(~RadixSort::float_to_key(e->sort_depth));
     }
 
+    template <class KeyFunc>
+    void sort_by(bool p_alpha, KeyFunc p_key) {
+        Vector<RenderListElement *> &list = p_alpha ? alpha_elements : elements;
+        const uint32_t count = list.size();
+        if (count < 2) {
+            return;
+        }
+
+        sort_pairs.resize(count);
+        sort_scratch.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            sort_pairs[i].key = p_key(list[i]);
+            sort_pairs[i].value = i;
+        }
+
+        const RadixSortPair *sorted = RadixSort::sort(sort_pairs.data(), sort_scratch.data(), count);
+
+        sorted_elements.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            sorted_elements[i] = list[sorted[i].value];
+        }
+        list.swap(sorted_elements);
+    }
 
     void sort_by_key(bool p_alpha) {
-        sort_by(p_alpha,compare_by_key);
+        sort_by(p_alpha, key_by_key);
     }
     void sort_by_depth(bool p_alpha) { //used for shadows
-        sort_by(p_alpha,compare_by_depth);
+        sort_by(p_alpha, key_by_depth);
     }
 
     void sort_by_reverse_depth_and_priority(bool p_alpha) { //used for alpha
-        sort_by(p_alpha,compare_by_reverse_depth_and_priority);
+        sort_by(p_alpha, key_by_reverse_depth_and_priority);
     }
 
     _FORCE_INLINE_ RenderListElement *add_element(float depth) {
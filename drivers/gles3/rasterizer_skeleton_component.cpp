@@ -146,6 +146,50 @@ void RasterizerStorageGLES3::skeleton_bone_set_transform(RenderingEntity p_skele
     VSG::ecs->registry.emplace_or_replace<RasterizerSkeletonDirty>(p_skeleton);
 }
 
+void RasterizerStorageGLES3::skeleton_set_bone_transforms(RenderingEntity p_skeleton, Span<const Transform> p_transforms) {
+
+    auto * skeleton = VSG::ecs->try_get<RasterizerSkeletonComponent>(p_skeleton);
+
+    ERR_FAIL_COND(!skeleton);
+    ERR_FAIL_COND(p_transforms.size() > size_t(skeleton->size));
+    ERR_FAIL_COND(skeleton->use_2d);
+
+    float *texture = skeleton->skel_texture.data();
+    const Transform *src = p_transforms.data();
+    const int count = int(p_transforms.size());
+
+    // The bones are stored in rows of 256, each bone using one texel in 3 consecutive rows.
+    for (int block = 0; block < count; block += 256) {
+        float *row0 = texture + block * 3 * 4;
+        float *row1 = row0 + 256 * 4;
+        float *row2 = row1 + 256 * 4;
+        const int block_end = MIN(count, block + 256);
+
+        for (int i = block; i < block_end; i++) {
+            const Transform &xform = src[i];
+
+            row0[0] = xform.basis[0].x;
+            row0[1] = xform.basis[0].y;
+            row0[2] = xform.basis[0].z;
+            row0[3] = xform.origin.x;
+            row1[0] = xform.basis[1].x;
+            row1[1] = xform.basis[1].y;
+            row1[2] = xform.basis[1].z;
+            row1[3] = xform.origin.y;
+            row2[0] = xform.basis[2].x;
+            row2[1] = xform.basis[2].y;
+            row2[2] = xform.basis[2].z;
+            row2[3] = xform.origin.z;
+
+            row0 += 4;
+            row1 += 4;
+            row2 += 4;
+        }
+    }
+
+    VSG::ecs->registry.emplace_or_replace<RasterizerSkeletonDirty>(p_skeleton);
+}
+
 Transform RasterizerStorageGLES3::skeleton_bone_get_transform(RenderingEntity p_skeleton, int p_bone) const {
 
     const auto * skeleton = VSG::ecs->try_get<RasterizerSkeletonComponent>(p_skeleton);
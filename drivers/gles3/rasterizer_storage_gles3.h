@@ -410,6 +410,7 @@ public:
     void skeleton_allocate(RenderingEntity p_skeleton, int p_bones, bool p_2d_skeleton = false) override;
     int skeleton_get_bone_count(RenderingEntity p_skeleton) const override;
     void skeleton_bone_set_transform(RenderingEntity p_skeleton, int p_bone, const Transform &p_transform) override;
+    void skeleton_set_bone_transforms(RenderingEntity p_skeleton, Span<const Transform> p_transforms) override;
     Transform skeleton_bone_get_transform(RenderingEntity p_skeleton, int p_bone) const override;
     void skeleton_bone_set_transform_2d(RenderingEntity p_skeleton, int p_bone, const Transform2D &p_transform) override;
     Transform2D skeleton_bone_get_transform_2d(RenderingEntity p_skeleton, int p_bone) const override;
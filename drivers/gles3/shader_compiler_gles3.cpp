@@ -30,6 +30,7 @@
 
 #include "shader_compiler_gles3.h"
 
+#include "core/hashfuncs.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "core/print_string.h"
@@ -720,6 +721,7 @@ String ShaderCompilerGLES3::_dump_node_code(const SL::Node *p_node, int p_level,
 
             if (p_assigning && p_actions.write_flag_pointers.contains(vnode->name)) {
                 *p_actions.write_flag_pointers[vnode->name] = true;
+                used_write_flags.insert(vnode->name);
             }
 
             if (p_default_actions.usage_defines.contains(vnode->name) && !used_name_defines.contains(vnode->name)) {
@@ -840,6 +842,7 @@ String ShaderCompilerGLES3::_dump_node_code(const SL::Node *p_node, int p_level,
             }
             if (p_assigning && p_actions.write_flag_pointers.contains(anode->name)) {
                 *p_actions.write_flag_pointers[anode->name] = true;
+                used_write_flags.insert(anode->name);
             }
 
             if (p_default_actions.usage_defines.contains(anode->name) && !used_name_defines.contains(anode->name)) {
@@ -1084,8 +1087,78 @@ String ShaderCompilerGLES3::_dump_node_code(const SL::Node *p_node, int p_level,
     return code;
 }
 
+uint64_t ShaderCompilerGLES3::_hash_code(RS::ShaderMode p_mode, const String &p_code) {
+    return hash_djb2_buffer64((const uint8_t *)p_code.data(), p_code.size(), hash_djb2_one_32(uint32_t(p_mode)));
+}
+
+void ShaderCompilerGLES3::_apply_cached_code(const CachedCode &p_cached, IdentifierActions &p_actions, GeneratedCode &r_gen_code) {
+
+    r_gen_code = p_cached.gen_code;
+
+    for (const StringName &render_mode : p_cached.render_modes) {
+        auto flag = p_actions.render_mode_flags.find(render_mode);
+        if (flag != p_actions.render_mode_flags.end()) {
+            *flag->second = true;
+        }
+        auto value = p_actions.render_mode_values.find(render_mode);
+        if (value != p_actions.render_mode_values.end()) {
+            *value->second.first = value->second.second;
+        }
+    }
+    for (const StringName &name : p_cached.usage_flags) {
+        auto flag = p_actions.usage_flag_pointers.find(name);
+        if (flag != p_actions.usage_flag_pointers.end()) {
+            *flag->second = true;
+        }
+    }
+    for (const StringName &name : p_cached.write_flags) {
+        auto flag = p_actions.write_flag_pointers.find(name);
+        if (flag != p_actions.write_flag_pointers.end()) {
+            *flag->second = true;
+        }
+    }
+    for (const eastl::pair<const StringName, SL::ShaderNode::Uniform> &E : p_cached.uniforms) {
+        p_actions.uniforms->emplace(E.first, E.second);
+    }
+}
+
+void ShaderCompilerGLES3::_store_cached_code(uint64_t p_hash, RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions, const GeneratedCode &p_gen_code) {
+
+    if (code_cache.size() >= MAX_CACHED_CODE && !code_cache.contains(p_hash)) {
+        auto oldest = code_cache.begin();
+        for (auto E = code_cache.begin(); E != code_cache.end(); ++E) {
+            if (E->second.last_used < oldest->second.last_used) {
+                oldest = E;
+            }
+        }
+        code_cache.erase(oldest);
+    }
+
+    CachedCode &cached = code_cache[p_hash];
+    cached.code = p_code;
+    cached.mode = p_mode;
+    cached.gen_code = p_gen_code;
+    cached.uniforms = *p_actions.uniforms;
+    cached.render_modes = shader->render_modes;
+    cached.usage_flags.assign(used_flag_pointers.begin(), used_flag_pointers.end());
+    cached.write_flags.assign(used_write_flags.begin(), used_write_flags.end());
+    cached.last_used = ++code_cache_tick;
+}
+
+void ShaderCompilerGLES3::clear_cache() {
+    code_cache.clear();
+}
+
 Error ShaderCompilerGLES3::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 
+    const uint64_t hash = _hash_code(p_mode, p_code);
+    auto cached = code_cache.find(hash);
+    if (cached != code_cache.end() && cached->second.mode == p_mode && cached->second.code == p_code) {
+        cached->second.last_used = ++code_cache_tick;
+        _apply_cached_code(cached->second, *p_actions, r_gen_code);
+        return OK;
+    }
+
     Error err = parser.compile(p_code, ShaderTypes::get_singleton()->get_functions(p_mode),
             ShaderTypes::get_singleton()->get_modes(p_mode), ShaderTypes::get_singleton()->get_types());
 
@@ -1119,6 +1192,7 @@ Error ShaderCompilerGLES3::compile(RS::ShaderMode p_mode, const String &p_code,
     used_name_defines.clear();
     used_rmode_defines.clear();
     used_flag_pointers.clear();
+    used_write_flags.clear();
     fragment_varyings.clear();
 
     shader = parser.get_shader();
@@ -1133,6 +1207,10 @@ Error ShaderCompilerGLES3::compile(RS::ShaderMode p_mode, const String &p_code,
         r_gen_code.uniform_total_size += md; //pad just in case
     }
 
+    _store_cached_code(hash, p_mode, p_code, *p_actions, r_gen_code);
+    // the generated code no longer needs the tree
+    parser.clear();
+
     return OK;
 }
 
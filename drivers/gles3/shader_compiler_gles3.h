@@ -91,14 +91,42 @@ private:
 
     HashSet<StringName> used_name_defines;
     HashSet<StringName> used_flag_pointers;
+    HashSet<StringName> used_write_flags;
     HashSet<StringName> used_rmode_defines;
     HashSet<StringName> internal_functions;
     HashSet<StringName> fragment_varyings;
 
     DefaultIdentifierActions actions[int(RenderingServerEnums::ShaderMode::MAX)];
 
+    // Result of compiling a given code, with the names the identifier
+    // actions were triggered for so a cache hit can replay them.
+    struct CachedCode {
+        String code;
+        RS::ShaderMode mode;
+        GeneratedCode gen_code;
+        HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+        Vector<StringName> render_modes;
+        Vector<StringName> usage_flags;
+        Vector<StringName> write_flags;
+        uint64_t last_used;
+    };
+
+    enum {
+        MAX_CACHED_CODE = 1024
+    };
+
+    HashMap<uint64_t, CachedCode> code_cache;
+    uint64_t code_cache_tick = 0;
+
+    static uint64_t _hash_code(RS::ShaderMode p_mode, const String &p_code);
+    void _apply_cached_code(const CachedCode &p_cached, IdentifierActions &p_actions, GeneratedCode &r_gen_code);
+    void _store_cached_code(uint64_t p_hash, RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions, const GeneratedCode &p_gen_code);
+
 public:
+    /// Shaders whose code was compiled before for the same mode are served
+    /// from a cache and skip parsing and code generation.
     Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+    void clear_cache();
 
     ShaderCompilerGLES3();
 };
@@ -58,6 +58,7 @@ int sock;
 #include <cstring>
 #include <sys/ioctl.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #ifndef NO_FCNTL
 #include <fcntl.h>
@@ -73,6 +74,10 @@ int sock;
 
 #include <netinet/tcp.h>
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 // BSD calls this flag IPV6_JOIN_GROUP
 #if !defined(IPV6_ADD_MEMBERSHIP) && defined(IPV6_JOIN_GROUP)
 #define IPV6_ADD_MEMBERSHIP IPV6_JOIN_GROUP
@@ -178,6 +183,9 @@ GODOT_EXPORT void NetSocketPosix::make_default() {
     }
 #endif
     _create = _create_func;
+#if !defined(WINDOWS_ENABLED)
+    NetSocketPollerPosix::make_default();
+#endif
 }
 
 GODOT_EXPORT void NetSocketPosix::cleanup() {
@@ -623,6 +631,42 @@ Error NetSocketPosix::send(const uint8_t *p_buffer, int p_len, int &r_sent) {
     return OK;
 }
 
+Error NetSocketPosix::send_vectored(const uint8_t *p_head, int p_head_len, const uint8_t *p_body, int p_body_len, int &r_sent) {
+#if defined(WINDOWS_ENABLED)
+    return NetSocket::send_vectored(p_head, p_head_len, p_body, p_body_len, r_sent);
+#else
+    ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+    struct iovec iov[2];
+    iov[0].iov_base = const_cast<uint8_t *>(p_head);
+    iov[0].iov_len = p_head_len;
+    iov[1].iov_base = const_cast<uint8_t *>(p_body);
+    iov[1].iov_len = p_body_len;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = p_body_len ? 2 : 1;
+
+    int flags = 0;
+#ifdef MSG_NOSIGNAL
+    if (_is_stream)
+        flags = MSG_NOSIGNAL;
+#endif
+    r_sent = ::sendmsg(_sock->sock, &msg, flags);
+
+    if (r_sent < 0) {
+        NetError err = _get_socket_error();
+        if (err == ERR_NET_WOULD_BLOCK)
+            return ERR_BUSY;
+
+        return FAILED;
+    }
+
+    return OK;
+#endif
+}
+
 Error NetSocketPosix::sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port) {
     ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
 
@@ -768,3 +812,142 @@ Error NetSocketPosix::join_multicast_group(const IP_Address &p_multi_address, St
 Error NetSocketPosix::leave_multicast_group(const IP_Address &p_multi_address, StringView p_if_name) {
     return _change_multicast_group(p_multi_address, p_if_name, false);
 }
+
+#if !defined(WINDOWS_ENABLED)
+
+#ifdef __linux__
+struct POLLER_STATE {
+    int epoll_fd;
+    Vector<struct epoll_event> ready;
+};
+#else
+struct POLLER_STATE {
+    // Kept parallel, so the pollfd array can be handed to ::poll as is.
+    Vector<struct pollfd> fds;
+    Vector<uint64_t> ids;
+};
+#endif
+
+NetSocketPoller *NetSocketPollerPosix::_create_func() {
+    return memnew(NetSocketPollerPosix);
+}
+
+void NetSocketPollerPosix::make_default() {
+    _create = _create_func;
+}
+
+Error NetSocketPollerPosix::add(uint64_t p_id, const Ref<NetSocket> &p_socket, uint32_t p_events) {
+
+    Error err = NetSocketPoller::add(p_id, p_socket, p_events);
+    if (err != OK) {
+        return err;
+    }
+    int fd = static_cast<NetSocketPosix *>(p_socket.get())->_sock->sock;
+
+#ifdef __linux__
+    struct epoll_event ev;
+    ev.events = (p_events & EVENT_IN ? EPOLLIN : 0) | (p_events & EVENT_OUT ? EPOLLOUT : 0);
+    ev.data.u64 = p_id;
+    if (epoll_ctl(_state->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        NetSocketPoller::remove(p_id);
+        ERR_FAIL_V_MSG(FAILED, "Unable to register socket with epoll, errno: " + itos(errno) + ".");
+    }
+#else
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = (p_events & EVENT_IN ? POLLIN : 0) | (p_events & EVENT_OUT ? POLLOUT : 0);
+    pfd.revents = 0;
+    _state->fds.push_back(pfd);
+    _state->ids.push_back(p_id);
+#endif
+    return OK;
+}
+
+void NetSocketPollerPosix::remove(uint64_t p_id) {
+
+    auto iter = entries.find(p_id);
+    if (iter == entries.end()) {
+        return;
+    }
+
+#ifdef __linux__
+    // A socket that was already closed left the epoll set on its own, and its fd may now belong to another one.
+    const Ref<NetSocket> &socket = iter->second.socket;
+    if (socket->is_open()) {
+        epoll_ctl(_state->epoll_fd, EPOLL_CTL_DEL, static_cast<NetSocketPosix *>(socket.get())->_sock->sock, nullptr);
+    }
+#else
+    for (size_t i = 0; i < _state->ids.size(); i++) {
+        if (_state->ids[i] == p_id) {
+            _state->fds.erase_unsorted(_state->fds.begin() + i);
+            _state->ids.erase_unsorted(_state->ids.begin() + i);
+            break;
+        }
+    }
+#endif
+    NetSocketPoller::remove(p_id);
+}
+
+int NetSocketPollerPosix::wait(Vector<Event> &r_events, int p_timeout) {
+
+#ifdef __linux__
+    _state->ready.resize(CLAMP(int(entries.size()), 1, 1024));
+
+    int count;
+    do {
+        count = epoll_wait(_state->epoll_fd, _state->ready.data(), int(_state->ready.size()), p_timeout);
+    } while (count < 0 && errno == EINTR);
+    ERR_FAIL_COND_V_MSG(count < 0, -1, "epoll_wait failed, errno: " + itos(errno) + ".");
+
+    for (int i = 0; i < count; i++) {
+        const struct epoll_event &ev = _state->ready[i];
+        uint32_t events = (ev.events & EPOLLIN ? EVENT_IN : 0) | (ev.events & EPOLLOUT ? EVENT_OUT : 0);
+        if (ev.events & (EPOLLERR | EPOLLHUP)) {
+            events |= EVENT_ERROR;
+        }
+        r_events.push_back({ ev.data.u64, events });
+    }
+    return count;
+#else
+    int count;
+    do {
+        count = ::poll(_state->fds.data(), _state->fds.size(), p_timeout);
+    } while (count < 0 && errno == EINTR);
+    ERR_FAIL_COND_V_MSG(count < 0, -1, "poll failed, errno: " + itos(errno) + ".");
+
+    int found = 0;
+    for (size_t i = 0; i < _state->fds.size() && found < count; i++) {
+        short revents = _state->fds[i].revents;
+        if (!revents) {
+            continue;
+        }
+        uint32_t events = (revents & POLLIN ? EVENT_IN : 0) | (revents & POLLOUT ? EVENT_OUT : 0);
+        if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            events |= EVENT_ERROR;
+        }
+        r_events.push_back({ _state->ids[i], events });
+        found++;
+    }
+    return found;
+#endif
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() :
+        _state(new POLLER_STATE) {
+#ifdef __linux__
+    _state->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    ERR_FAIL_COND_MSG(_state->epoll_fd < 0, "Unable to create epoll instance, errno: " + itos(errno) + ".");
+#endif
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+    clear();
+#ifdef __linux__
+    if (_state->epoll_fd >= 0) {
+        ::close(_state->epoll_fd);
+    }
+#endif
+    delete _state;
+}
+
+#endif // !WINDOWS_ENABLED
@@ -31,11 +31,14 @@
 #pragma once
 
 #include "core/io/net_socket.h"
+#include "core/io/net_socket_poller.h"
 
 
 struct SOCKET_HOLDER;
 class NetSocketPosix : public NetSocket {
 
+    friend class NetSocketPollerPosix;
+
 private:
     SOCKET_HOLDER *_sock;
     IP::Type _ip_type;
@@ -72,6 +75,7 @@ public:
     Error recv(uint8_t *p_buffer, int p_len, int &r_read) override;
     Error recvfrom(uint8_t *p_buffer, int p_len, int &r_read, IP_Address &r_ip, uint16_t &r_port, bool p_peek = false) override;
     Error send(const uint8_t *p_buffer, int p_len, int &r_sent) override;
+    Error send_vectored(const uint8_t *p_head, int p_head_len, const uint8_t *p_body, int p_body_len, int &r_sent) override;
     Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port) override;
     Ref<NetSocket> accept(IP_Address &r_ip, uint16_t &r_port) override;
 
@@ -90,3 +94,24 @@ public:
     GODOT_EXPORT NetSocketPosix();
     GODOT_EXPORT ~NetSocketPosix() override;
 };
+
+#if !defined(WINDOWS_ENABLED)
+struct POLLER_STATE;
+// epoll on Linux and Android, a single ::poll over all sockets elsewhere.
+class NetSocketPollerPosix : public NetSocketPoller {
+
+    POLLER_STATE *_state;
+
+    static NetSocketPoller *_create_func();
+
+public:
+    static void make_default();
+
+    Error add(uint64_t p_id, const Ref<NetSocket> &p_socket, uint32_t p_events) override;
+    void remove(uint64_t p_id) override;
+    int wait(Vector<Event> &r_events, int p_timeout) override;
+
+    NetSocketPollerPosix();
+    ~NetSocketPollerPosix() override;
+};
+#endif
@@ -923,6 +923,22 @@ void ResourceImporterScene::_optimize_animations(
     }
 }
 
+void ResourceImporterScene::_compress_animations(Node *scene) {
+
+    if (!scene->has_node(NodePath("AnimationPlayer"))) return;
+    Node *n = scene->get_node(NodePath("AnimationPlayer"));
+    ERR_FAIL_COND(!n);
+    AnimationPlayer *anim = object_cast<AnimationPlayer>(n);
+    ERR_FAIL_COND(!anim);
+
+    Vector<StringName> anim_names(anim->get_animation_list());
+    for (const StringName &E : anim_names) {
+
+        Ref<Animation> a = anim->get_animation(E);
+        a->compress();
+    }
+}
+
 static String _make_extname(StringView p_str) {
 
     String ext_name(p_str);
@@ -1232,6 +1248,7 @@ void ResourceImporterScene::get_import_options(Vector<ResourceImporterInterface:
     r_options->push_back(ImportOption(PropertyInfo(VariantType::FLOAT, "animation/optimizer/max_angle"), 22));
     r_options->push_back(
             ImportOption(PropertyInfo(VariantType::BOOL, "animation/optimizer/remove_unused_tracks"), true));
+    r_options->push_back(ImportOption(PropertyInfo(VariantType::BOOL, "animation/compression/enabled"), false));
     r_options->push_back(
             ImportOption(PropertyInfo(VariantType::INT, "animation/clips/amount", PropertyHint::Range, "0,256,1",
                                  PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED),
@@ -1490,6 +1507,10 @@ Error ResourceImporterScene::import(StringView p_source_file, StringView p_save_
         _filter_tracks(scene, animation_filter);
     }
 
+    if (p_options.at("animation/compression/enabled").as<bool>()) {
+        _compress_animations(scene);
+    }
+
     bool external_animations =
             p_options.at("animation/storage").as<int>() == 1 || p_options.at("animation/storage").as<int>() == 2;
     bool external_animations_as_text = p_options.at("animation/storage").as<int>() == 2;
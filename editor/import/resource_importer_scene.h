@@ -144,6 +144,7 @@ public:
     void _filter_anim_tracks(const Ref<Animation>& anim, Set<String> &keep);
     void _filter_tracks(Node *scene, StringView p_text);
     void _optimize_animations(Node *scene, float p_max_lin_error, float p_max_ang_error, float p_max_angle);
+    void _compress_animations(Node *scene);
 
     Error import(StringView p_source_file, StringView p_save_path, const HashMap<StringName, Variant> &p_options, Vector<String> &r_missing_deps,
                  Vector<String> *r_platform_variants, Vector<String> *r_gen_files = nullptr, Variant *r_metadata = nullptr) override;
@@ -36,6 +36,7 @@
 #include "core/method_enum_caster.h"
 #include "core/object_db.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio_server.h"
@@ -83,6 +84,13 @@ void Performance::_bind_methods() {
     BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
     BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
     BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+    BIND_ENUM_CONSTANT(RENDER_INSTANCE_UPDATES_IN_FRAME);
+    BIND_ENUM_CONSTANT(RENDER_PENDING_INSTANCE_UPDATES);
+    BIND_ENUM_CONSTANT(MESSAGE_QUEUE_CALLS_FLUSHED);
+    BIND_ENUM_CONSTANT(MESSAGE_QUEUE_PENDING_CALLS);
+    BIND_ENUM_CONSTANT(MESSAGE_QUEUE_MEMORY);
+    BIND_ENUM_CONSTANT(MESSAGE_QUEUE_THREADS);
+    BIND_ENUM_CONSTANT(THREAD_POOL_SERIAL_JOBS);
 
     BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -130,6 +138,13 @@ StringView Performance::get_monitor_name(Monitor p_monitor) const {
         "physics_3d/collision_pairs",
         "physics_3d/islands",
         "audio/output_latency",
+        "raster/instance_updates",
+        "raster/pending_instance_updates",
+        "message_queue/calls_flushed",
+        "message_queue/pending_calls",
+        "message_queue/memory",
+        "message_queue/threads",
+        "thread_pool/serial_jobs",
 
     };
 
@@ -201,6 +216,20 @@ float Performance::get_monitor(Monitor p_monitor) const {
             return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
         case AUDIO_OUTPUT_LATENCY:
             return AudioServer::get_singleton()->get_output_latency();
+        case RENDER_INSTANCE_UPDATES_IN_FRAME:
+            return RenderingServer::get_singleton()->get_render_info(RS::INFO_INSTANCE_UPDATES_IN_FRAME);
+        case RENDER_PENDING_INSTANCE_UPDATES:
+            return RenderingServer::get_singleton()->get_render_info(RS::INFO_PENDING_INSTANCE_UPDATES);
+        case MESSAGE_QUEUE_CALLS_FLUSHED:
+            return MessageQueue::get_singleton()->get_stats().last_flush_calls;
+        case MESSAGE_QUEUE_PENDING_CALLS:
+            return MessageQueue::get_singleton()->get_stats().pending_calls;
+        case MESSAGE_QUEUE_MEMORY:
+            return MessageQueue::get_singleton()->get_stats().allocated_bytes;
+        case MESSAGE_QUEUE_THREADS:
+            return MessageQueue::get_singleton()->get_stats().producer_threads;
+        case THREAD_POOL_SERIAL_JOBS:
+            return SharedThreadWorkPool::get_serial_job_count();
 
         default: {
         }
@@ -245,6 +274,13 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
         MONITOR_TYPE_QUANTITY,
         MONITOR_TYPE_QUANTITY,
         MONITOR_TYPE_TIME,
+        MONITOR_TYPE_QUANTITY,
+        MONITOR_TYPE_QUANTITY,
+        MONITOR_TYPE_QUANTITY,
+        MONITOR_TYPE_QUANTITY,
+        MONITOR_TYPE_MEMORY,
+        MONITOR_TYPE_QUANTITY,
+        MONITOR_TYPE_QUANTITY,
 
     };
 
@@ -81,6 +81,13 @@ public:
         PHYSICS_3D_ISLAND_COUNT,
         //physics
         AUDIO_OUTPUT_LATENCY,
+        RENDER_INSTANCE_UPDATES_IN_FRAME,
+        RENDER_PENDING_INSTANCE_UPDATES,
+        MESSAGE_QUEUE_CALLS_FLUSHED,
+        MESSAGE_QUEUE_PENDING_CALLS,
+        MESSAGE_QUEUE_MEMORY,
+        MESSAGE_QUEUE_THREADS,
+        THREAD_POOL_SERIAL_JOBS,
         MONITOR_MAX
     };
 
@@ -0,0 +1,194 @@
+/*************************************************************************/
+/*  test_animation_skeletons.cpp                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_animation_skeletons.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "core/string_utils.h"
+#include "core/vector.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+#include "scene/resources/animation.h"
+
+namespace TestAnimationSkeletons {
+
+namespace {
+
+constexpr int BONE_COUNT = 64;
+constexpr int KEY_COUNT = 30;
+constexpr int WARMUP_FRAMES = 10;
+constexpr int MEASURED_FRAMES = 60;
+
+struct Run {
+    int characters;
+    bool parallel;
+};
+
+const Run runs[] = {
+    { 100, false }, { 100, true },
+    { 500, false }, { 500, true },
+    { 2000, false }, { 2000, true },
+};
+
+/// Animates every bone of a chain, with keys at 30 fps on a 1 second loop.
+Ref<Animation> make_animation() {
+    Ref<Animation> animation(make_ref_counted<Animation>());
+    animation->set_length(1.0);
+    animation->set_loop(true);
+
+    for (int bone = 0; bone < BONE_COUNT; bone++) {
+        int track = animation->add_track(Animation::TYPE_TRANSFORM);
+        animation->track_set_path(track, NodePath(String("Skeleton:bone_") + itos(bone)));
+        for (int key = 0; key <= KEY_COUNT; key++) {
+            const float time = float(key) / KEY_COUNT;
+            const Quat rot(Vector3(0, 1, 0), Math::sin(time * Math_TAU + bone) * 0.5f);
+            animation->transform_track_insert_key(track, time, Vector3(0, 0.1f * bone, 0), rot, Vector3(1, 1, 1));
+        }
+    }
+
+    return animation;
+}
+
+/// Steps characters made of a skeleton and an animation player, switching
+/// the players between serial and parallel evaluation, and prints the average
+/// frame time of each run.
+class TestMainLoop : public SceneTree {
+
+    Ref<Animation> animation;
+    Vector<Node3D *> characters;
+    Vector<AnimationPlayer *> players;
+    int run = -1;
+    int frame = 0;
+    uint64_t total_usec = 0;
+
+    void _add_character() {
+        Node3D *character = memnew(Node3D);
+
+        Skeleton *skeleton = memnew(Skeleton);
+        skeleton->set_name("Skeleton");
+        for (int bone = 0; bone < BONE_COUNT; bone++) {
+            skeleton->add_bone(String("bone_") + itos(bone));
+            if (bone > 0) {
+                skeleton->set_bone_parent(bone, bone - 1);
+            }
+        }
+        character->add_child(skeleton);
+
+        AnimationPlayer *player = memnew(AnimationPlayer);
+        player->add_animation("run", animation);
+        character->add_child(player);
+
+        get_root()->add_child(character);
+        player->play("run");
+        // Desynchronize the characters.
+        player->seek(Math::randf());
+
+        characters.push_back(character);
+        players.push_back(player);
+    }
+
+    void _start_run(const Run &p_run) {
+        while (characters.size() > p_run.characters) {
+            memdelete(characters.back());
+            characters.pop_back();
+            players.pop_back();
+        }
+        while (characters.size() < p_run.characters) {
+            _add_character();
+        }
+        for (AnimationPlayer *player : players) {
+            player->set_parallel_evaluation(p_run.parallel);
+        }
+
+        frame = 0;
+        total_usec = 0;
+    }
+
+public:
+    void init() override {
+
+        SceneTree::init();
+
+        animation = make_animation();
+        OS::get_singleton()->print("characters\tbones\tparallel\tframe (ms)\n");
+    }
+
+    bool idle(float p_time) override {
+
+        if (run < 0 || frame == WARMUP_FRAMES + MEASURED_FRAMES) {
+            if (run >= 0) {
+                const Run &done = runs[run];
+                OS::get_singleton()->print(FormatVE("%d\t%d\t%s\t%.3f\n", done.characters, BONE_COUNT,
+                        done.parallel ? "yes" : "no", total_usec / (MEASURED_FRAMES * 1000.0)));
+            }
+            run++;
+            if (run == int(sizeof(runs) / sizeof(runs[0]))) {
+                return true;
+            }
+            _start_run(runs[run]);
+        }
+
+        const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+        // Processes the players, then flushes the message queue which
+        // applies the batched poses.
+        bool quit = SceneTree::idle(p_time);
+        if (frame >= WARMUP_FRAMES) {
+            total_usec += OS::get_singleton()->get_ticks_usec() - begin;
+        }
+        frame++;
+
+        return quit;
+    }
+
+    void finish() override {
+
+        for (Node3D *character : characters) {
+            memdelete(character);
+        }
+        characters.clear();
+        players.clear();
+        animation.unref();
+
+        SceneTree::finish();
+    }
+};
+
+} // namespace
+
+MainLoop *test() {
+
+    return memnew(TestMainLoop);
+}
+
+} // namespace TestAnimationSkeletons
@@ -0,0 +1,290 @@
+/*************************************************************************/
+/*  test_enet_coalescing.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_enet_coalescing.h"
+
+#include "core/class_db.h"
+#include "core/io/networked_multiplayer_peer.h"
+#include "core/os/os.h"
+#include "core/pool_vector.h"
+#include "core/reference.h"
+#include "core/string_utils.h"
+#include "core/variant.h"
+
+namespace TestENetCoalescing {
+
+namespace {
+
+constexpr int CLIENTS = 2;
+constexpr int COALESCED_SENDS = 20;
+constexpr int OVERSIZED_BYTES = 4000; // Well above the default ENet MTU.
+constexpr int TIMEOUT_MSEC = 5000;
+constexpr int SETTLE_POLLS = 20;
+constexpr uint16_t FIRST_PORT = 27980;
+
+// The module classes are only reachable through ClassDB from here, tests link against core alone.
+Ref<RefCounted> create(const StringName &p_class) {
+    return Ref<RefCounted>(object_cast<RefCounted>(ClassDB::instance(p_class)));
+}
+
+int status(const Ref<RefCounted> &p_peer) {
+    return p_peer->call_va("get_connection_status").as<int>();
+}
+
+int available(const Ref<RefCounted> &p_peer) {
+    return p_peer->call_va("get_available_packet_count").as<int>();
+}
+
+int64_t coalesced(const Ref<RefCounted> &p_peer) {
+    return p_peer->call_va("get_coalesced_packet_count").as<int64_t>();
+}
+
+/// p_size bytes tagged with p_tag, so reordered or corrupted packets show.
+PoolVector<uint8_t> make_payload(int p_tag, int p_size) {
+    PoolVector<uint8_t> payload;
+    payload.resize(p_size);
+    PoolVector<uint8_t>::Write w = payload.write();
+    for (int i = 0; i < p_size; i++) {
+        w[i] = uint8_t(p_tag + i);
+    }
+    return payload;
+}
+
+bool same(const PoolVector<uint8_t> &p_a, const PoolVector<uint8_t> &p_b) {
+    return p_a.size() == p_b.size() && memcmp(p_a.read().ptr(), p_b.read().ptr(), p_a.size()) == 0;
+}
+
+struct Peers {
+    uint16_t port = 0;
+    Ref<RefCounted> server;
+    Ref<RefCounted> clients[CLIENTS];
+
+    void poll() {
+        server->call_va("poll");
+        for (const Ref<RefCounted> &client : clients) {
+            if (client && status(client) != NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED) {
+                client->call_va("poll");
+            }
+        }
+    }
+
+    // Polls everything until p_done returns true or the timeout runs out.
+    template <class F>
+    bool poll_until(F p_done) {
+        uint64_t deadline = OS::get_singleton()->get_ticks_msec() + TIMEOUT_MSEC;
+        while (OS::get_singleton()->get_ticks_msec() < deadline) {
+            poll();
+            if (p_done()) {
+                return true;
+            }
+            OS::get_singleton()->delay_usec(1000);
+        }
+        return false;
+    }
+
+    void settle() {
+        for (int i = 0; i < SETTLE_POLLS; i++) {
+            poll();
+            OS::get_singleton()->delay_usec(1000);
+        }
+    }
+
+    Ref<RefCounted> connect_client() {
+        Ref<RefCounted> client = create("NetworkedMultiplayerENet");
+        client->call_va("set_packet_coalescing_enabled", true);
+        if (client->call_va("create_client", "127.0.0.1", port).as<int>() != OK) {
+            return Ref<RefCounted>();
+        }
+        bool connected = poll_until([&client]() {
+            client->call_va("poll");
+            return status(client) == NetworkedMultiplayerPeer::CONNECTION_CONNECTED;
+        });
+        if (!connected) {
+            return Ref<RefCounted>();
+        }
+        // Let the server register the peer as well.
+        settle();
+        return client;
+    }
+};
+
+bool connect_all(Peers &r_peers) {
+    r_peers.server = create("NetworkedMultiplayerENet");
+    r_peers.server->call_va("set_packet_coalescing_enabled", true);
+    r_peers.port = FIRST_PORT;
+    while (r_peers.server->call_va("create_server", r_peers.port, CLIENTS + 1).as<int>() != OK) {
+        if (++r_peers.port == FIRST_PORT + 20) {
+            OS::get_singleton()->printerr("enet_coalescing: no free port to listen on.\n");
+            return false;
+        }
+    }
+
+    for (Ref<RefCounted> &client : r_peers.clients) {
+        client = r_peers.connect_client();
+        if (!client) {
+            OS::get_singleton()->printerr("enet_coalescing: a client failed to connect.\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads as many packets from p_peer as p_expected holds and compares them, in order.
+bool receive(const Ref<RefCounted> &p_peer, const Vector<PoolVector<uint8_t>> &p_expected) {
+    for (const PoolVector<uint8_t> &expected : p_expected) {
+        if (!same(p_peer->call_va("get_packet").as<PoolVector<uint8_t>>(), expected)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Small packets put between two polls leave as one frame and arrive split back, in order. The frame is shared by
+// every packet it carried, so it must stay valid while they are read across further polls.
+bool test_coalesced_sends(Peers &p_peers) {
+    const Ref<RefCounted> &client = p_peers.clients[0];
+    const int64_t coalesced_before = coalesced(client);
+    const int64_t saved_before = client->call_va("get_saved_packet_count").as<int64_t>();
+
+    Vector<PoolVector<uint8_t>> sent;
+    client->call_va("set_target_peer", 1);
+    for (int i = 0; i < COALESCED_SENDS; i++) {
+        sent.push_back(make_payload(i, 16 + i));
+        client->call_va("put_packet", sent.back());
+    }
+    if (!p_peers.poll_until([&p_peers]() { return available(p_peers.server) == COALESCED_SENDS; })) {
+        return false;
+    }
+    if (coalesced(client) - coalesced_before != COALESCED_SENDS ||
+            client->call_va("get_saved_packet_count").as<int64_t>() - saved_before != COALESCED_SENDS - 1) {
+        return false;
+    }
+
+    const int half = COALESCED_SENDS / 2;
+    if (!receive(p_peers.server, Vector<PoolVector<uint8_t>>(sent.begin(), sent.begin() + half))) {
+        return false;
+    }
+    p_peers.settle();
+    return receive(p_peers.server, Vector<PoolVector<uint8_t>>(sent.begin() + half, sent.end())) && available(p_peers.server) == 0;
+}
+
+// A packet too large for a frame flushes the pending frame first, so it can't overtake it.
+bool test_oversized_flush(Peers &p_peers) {
+    const Ref<RefCounted> &client = p_peers.clients[0];
+    Vector<PoolVector<uint8_t>> sent;
+    sent.push_back(make_payload(1, 32));
+    sent.push_back(make_payload(2, 32));
+    sent.push_back(make_payload(3, OVERSIZED_BYTES));
+    sent.push_back(make_payload(4, 32));
+
+    client->call_va("set_target_peer", 1);
+    for (const PoolVector<uint8_t> &payload : sent) {
+        client->call_va("put_packet", payload);
+    }
+    if (!p_peers.poll_until([&p_peers, &sent]() { return available(p_peers.server) == int(sent.size()); })) {
+        return false;
+    }
+    return receive(p_peers.server, sent);
+}
+
+// The server queues frames for two clients and drops one of them before polling: only the other frame goes out,
+// and nothing queued for the gone peer reaches a client that takes its place.
+bool test_disconnect_mid_frame(Peers &p_peers) {
+    const int dropped_id = p_peers.clients[0]->call_va("get_unique_id").as<int>();
+    const int kept_id = p_peers.clients[1]->call_va("get_unique_id").as<int>();
+    const int64_t coalesced_before = coalesced(p_peers.server);
+
+    Vector<PoolVector<uint8_t>> sent;
+    sent.push_back(make_payload(5, 24));
+    sent.push_back(make_payload(6, 24));
+    for (int target : { dropped_id, kept_id }) {
+        p_peers.server->call_va("set_target_peer", target);
+        for (const PoolVector<uint8_t> &payload : sent) {
+            p_peers.server->call_va("put_packet", payload);
+        }
+    }
+    p_peers.server->call_va("disconnect_peer", dropped_id, true);
+
+    const Ref<RefCounted> dropped = p_peers.clients[0];
+    bool done = p_peers.poll_until([&p_peers, &dropped]() {
+        return available(p_peers.clients[1]) == 2 && status(dropped) == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED;
+    });
+    if (!done || available(dropped) != 0 || !receive(p_peers.clients[1], sent)) {
+        return false;
+    }
+    if (coalesced(p_peers.server) - coalesced_before != int64_t(sent.size())) {
+        return false;
+    }
+
+    // ENet hands the freed peer slot to the next connection.
+    p_peers.clients[0] = p_peers.connect_client();
+    if (!p_peers.clients[0]) {
+        return false;
+    }
+    p_peers.settle();
+    return available(p_peers.clients[0]) == 0;
+}
+
+void report(const char *p_name, bool p_ok) {
+    OS::get_singleton()->print(String("enet_coalescing: ") + p_name + (p_ok ? " OK\n" : " FAILED\n"));
+}
+
+} // namespace
+
+/// Loopback test of NetworkedMultiplayerENet packet coalescing: several
+/// sends sharing a frame, an oversized packet flushing the pending frame,
+/// and frames dropped for a peer disconnected before they were flushed.
+MainLoop *test() {
+
+    if (!ClassDB::class_exists("NetworkedMultiplayerENet")) {
+        OS::get_singleton()->print("enet_coalescing: module not built, skipped.\n");
+        return nullptr;
+    }
+
+    Peers peers;
+    bool ok = connect_all(peers);
+    report("connect", ok);
+    if (ok) {
+        report("coalesced sends", test_coalesced_sends(peers));
+        report("oversized flush", test_oversized_flush(peers));
+        report("disconnect mid frame", test_disconnect_mid_frame(peers));
+    }
+    for (const Ref<RefCounted> &client : peers.clients) {
+        if (client) {
+            client->call_va("close_connection");
+        }
+    }
+    if (peers.server) {
+        peers.server->call_va("close_connection");
+    }
+    return nullptr;
+}
+
+} // namespace TestENetCoalescing
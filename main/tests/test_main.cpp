@@ -34,14 +34,30 @@
 
 #ifdef DEBUG_ENABLED
 
+#include "test_animation_skeletons.h"
 #include "test_astar.h"
 #include "test_gui.h"
 #include "test_math.h"
+#include "test_navigation_crowd.h"
 #include "test_oa_hash_map.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
 #include "test_render.h"
+#include "test_render_list_sort.h"
+#include "test_rendering_benchmark.h"
+#include "test_replication.h"
+#include "test_multiplayer_codec.h"
+#include "test_shadow_cull_benchmark.h"
+#include "test_variant_codec.h"
 #include "test_shader_lang.h"
+#include "test_skeleton_pose.h"
+#include "test_socket_poller.h"
+#include "test_message_queue.h"
+#include "test_signal_dispatch.h"
+#include "test_property_handle.h"
+#include "test_websocket.h"
+#include "test_enet_coalescing.h"
+#include "test_thread_work_pool.h"
 //#include "test_string.h"
 
 const char **tests_get_names() {
@@ -61,6 +77,22 @@ const char **tests_get_names() {
         "gd_bytecode",
         "ordered_hash_map",
         "astar",
+        "navigation_crowd",
+        "animation_skeletons",
+        "skeleton_pose",
+        "render_list_sort",
+        "rendering_benchmark",
+        "shadow_cull_benchmark",
+        "replication",
+        "multiplayer_codec",
+        "variant_codec",
+        "socket_poller",
+        "message_queue",
+        "signal_dispatch",
+        "property_handle",
+        "websocket",
+        "enet_coalescing",
+        "thread_work_pool",
         nullptr
     };
 
@@ -116,6 +148,86 @@ MainLoop *test_main(const String& p_test, const Vector<String> &p_args) {
         return TestAStar::test();
     }
 
+    if (p_test == "navigation_crowd") {
+
+        return TestNavigationCrowd::test();
+    }
+
+    if (p_test == "animation_skeletons") {
+
+        return TestAnimationSkeletons::test();
+    }
+
+    if (p_test == "skeleton_pose") {
+
+        return TestSkeletonPose::test();
+    }
+
+    if (p_test == "render_list_sort") {
+
+        return TestRenderListSort::test();
+    }
+
+    if (p_test == "rendering_benchmark") {
+
+        return TestRenderingBenchmark::test();
+    }
+
+    if (p_test == "shadow_cull_benchmark") {
+
+        return TestShadowCullBenchmark::test();
+    }
+
+    if (p_test == "replication") {
+
+        return TestReplication::test();
+    }
+
+    if (p_test == "multiplayer_codec") {
+
+        return TestMultiplayerCodec::test();
+    }
+
+    if (p_test == "variant_codec") {
+
+        return TestVariantCodec::test();
+    }
+
+    if (p_test == "socket_poller") {
+
+        return TestSocketPoller::test();
+    }
+
+    if (p_test == "message_queue") {
+
+        return TestMessageQueue::test();
+    }
+
+    if (p_test == "signal_dispatch") {
+
+        return TestSignalDispatch::test();
+    }
+
+    if (p_test == "property_handle") {
+
+        return TestPropertyHandle::test();
+    }
+
+    if (p_test == "websocket") {
+
+        return TestWebSocket::test();
+    }
+
+    if (p_test == "enet_coalescing") {
+
+        return TestENetCoalescing::test();
+    }
+
+    if (p_test == "thread_work_pool") {
+
+        return TestThreadWorkPool::test();
+    }
+
     print_line("Unknown test: " + p_test);
     return nullptr;
 }
@@ -0,0 +1,146 @@
+/*************************************************************************/
+/*  test_message_queue.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_message_queue.h"
+
+#include "core/message_queue.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string_utils.h"
+
+#include <atomic>
+
+namespace TestMessageQueue {
+
+namespace {
+
+constexpr int THREADS = 8;
+constexpr int CALLS_PER_THREAD = 200000;
+
+struct Producer {
+    Thread thread;
+    GameEntity target;
+    int index = 0;
+    int next_expected = 0;
+    bool out_of_order = false;
+    std::atomic<bool> done {false};
+};
+
+void produce(void *p_userdata) {
+    Producer *producer = static_cast<Producer *>(p_userdata);
+    MessageQueue *queue = MessageQueue::get_singleton();
+    for (int i = 0; i < CALLS_PER_THREAD; i++) {
+        // Calls run on the flushing thread, one producer's calls must arrive in push order.
+        queue->push_call(producer->target, [producer, i]() {
+            if (producer->next_expected != i) {
+                producer->out_of_order = true;
+            }
+            producer->next_expected = i + 1;
+        });
+    }
+    producer->done.store(true, std::memory_order_release);
+}
+
+// Same call queued by name with boxed arguments and as a typed member call.
+void compare_typed_calls(MessageQueue *p_queue, Object *p_target) {
+    constexpr int CALLS = 100000;
+
+    uint64_t start = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < CALLS; i++) {
+        p_queue->push_call(p_target->get_instance_id(), "set_block_signals", (i & 1) != 0);
+    }
+    p_queue->flush();
+    uint64_t by_name = OS::get_singleton()->get_ticks_usec() - start;
+
+    start = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < CALLS; i++) {
+        p_queue->push_call_mp(p_target, &Object::set_block_signals, (i & 1) != 0);
+    }
+    p_queue->flush();
+    uint64_t typed = OS::get_singleton()->get_ticks_usec() - start;
+
+    OS::get_singleton()->print("message_queue: " + itos(CALLS) + " deferred calls by name in " + itos(by_name / 1000) +
+                               " msec, typed in " + itos(typed / 1000) + " msec.\n");
+}
+
+} // namespace
+
+MainLoop *test() {
+    MessageQueue *queue = MessageQueue::get_singleton();
+    Object *target = memnew(Object);
+
+    Producer producers[THREADS];
+    uint64_t start = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < THREADS; i++) {
+        producers[i].target = target->get_instance_id();
+        producers[i].index = i;
+        producers[i].thread.start(produce, &producers[i]);
+    }
+
+    int flushes = 0;
+    bool producing = true;
+    while (producing) {
+        producing = false;
+        for (const Producer &producer : producers) {
+            producing |= !producer.done.load(std::memory_order_acquire);
+        }
+        queue->flush();
+        flushes++;
+    }
+    for (Producer &producer : producers) {
+        producer.thread.wait_to_finish();
+    }
+    queue->flush();
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+    MessageQueue::Stats stats = queue->get_stats();
+    bool ok = stats.pending_calls == 0;
+    for (const Producer &producer : producers) {
+        if (producer.next_expected != CALLS_PER_THREAD || producer.out_of_order) {
+            OS::get_singleton()->printerr("message_queue: thread " + itos(producer.index) + " ran " +
+                                          itos(producer.next_expected) + " calls" +
+                                          (producer.out_of_order ? ", out of order.\n" : ".\n"));
+            ok = false;
+        }
+    }
+
+    OS::get_singleton()->print("message_queue: " + itos(THREADS * CALLS_PER_THREAD) + " calls from " + itos(THREADS) +
+                               " threads in " + itos(elapsed / 1000) + " msec, " + itos(flushes) + " flushes, " +
+                               ::to_string(stats.allocated_bytes / 1024) + " KiB held.\n");
+    OS::get_singleton()->print(ok ? "message_queue: OK\n" : "message_queue: FAILED\n");
+
+    compare_typed_calls(queue, target);
+    target->set_block_signals(false);
+
+    memdelete(target);
+    return nullptr;
+}
+
+} // namespace TestMessageQueue
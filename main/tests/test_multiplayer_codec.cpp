@@ -0,0 +1,474 @@
+/*************************************************************************/
+/*  test_multiplayer_codec.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_multiplayer_codec.h"
+
+#include "core/color.h"
+#include "core/deque.h"
+#include "core/io/marshalls.h"
+#include "core/io/multiplayer_api.h"
+#include "core/io/multiplayer_codec.h"
+#include "core/io/networked_multiplayer_peer.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "core/string_utils.h"
+#include "scene/3d/node_3d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+namespace TestMultiplayerCodec {
+
+namespace {
+
+constexpr int SERVER_ID = 1;
+constexpr int CLIENT_ID = 2;
+// Frames pumped after each send, enough for a name to be announced and confirmed.
+constexpr int PUMP_ROUNDS = 3;
+
+struct CodecCase {
+    const char *name;
+    Variant value;
+    int encoded_size; //!< -1 for values that fall back to the regular variant encoding.
+};
+
+Vector<CodecCase> make_codec_cases() {
+    return {
+        { "nil", Variant(), 1 },
+        { "false", false, 1 },
+        { "true", true, 1 },
+        { "int8_min", int64_t(INT8_MIN), 2 },
+        { "int8_max", int64_t(INT8_MAX), 2 },
+        { "int16_above_int8", int64_t(INT8_MAX) + 1, 3 },
+        { "int16_min", int64_t(INT16_MIN), 3 },
+        { "int32_above_int16", int64_t(INT16_MAX) + 1, 5 },
+        { "int32_min", int64_t(INT32_MIN), 5 },
+        { "int64_above_int32", int64_t(INT32_MAX) + 1, 9 },
+        { "int64_min", int64_t(INT64_MIN), 9 },
+        { "float32", 0.5, 5 },
+        { "float64", 0.1, 9 },
+        { "vector2", Vector2(1.5f, -2), 9 },
+        { "vector3", Vector3(1, -2.25f, 1e6f), 13 },
+        { "string_empty", String(), 2 },
+        { "string_utf8", String("h\xc3\xa9llo"), 8 },
+        { "string_long", String(200, 'x'), 1 + 2 + 200 },
+        { "fallback_color", Color(0.25f, 0.5f, 0.75f, 1), -1 },
+        { "fallback_rect2", Rect2(1, 2, 3, 4), -1 },
+    };
+}
+
+bool report(const char *p_check, const String &p_detail) {
+    OS::get_singleton()->printerr("multiplayer_codec: " + String(p_check) + ": " + p_detail + ".\n");
+    return false;
+}
+
+/// Every value decodes back to itself from the compact tags, in the expected size,
+/// also when several values share one buffer.
+bool check_round_trips(const Vector<CodecCase> &p_cases) {
+    bool ok = true;
+    Vector<uint8_t> buffer;
+    int ofs = 3; // Values are appended after a header in packets.
+    Vector<int> offsets;
+    for (const CodecCase &c : p_cases) {
+        int begin = ofs;
+        offsets.push_back(begin);
+        if (MultiplayerCodec::encode_value(c.value, buffer, ofs, false) != OK) {
+            ok = report("round trip", String(c.name) + " failed to encode");
+            continue;
+        }
+        if (c.encoded_size >= 0 && ofs - begin != c.encoded_size) {
+            ok = report("round trip", String(c.name) + " took " + itos(ofs - begin) + " bytes instead of " + itos(c.encoded_size));
+        }
+    }
+    offsets.push_back(ofs);
+
+    for (int i = 0; i < p_cases.size(); i++) {
+        Variant decoded;
+        int len = 0;
+        Error err = MultiplayerCodec::decode_value(decoded, &buffer[offsets[i]], ofs - offsets[i], len, false);
+        if (err != OK || len != offsets[i + 1] - offsets[i]) {
+            ok = report("round trip", String(p_cases[i].name) + " failed to decode");
+        } else if (decoded.get_type() != p_cases[i].value.get_type() || decoded != p_cases[i].value) {
+            ok = report("round trip", String(p_cases[i].name) + " decoded to " + decoded.as<String>());
+        }
+    }
+    return ok;
+}
+
+/// Truncated values, unknown tags and lengths past the end of the buffer are rejected.
+bool check_rejections(const Vector<CodecCase> &p_cases) {
+    bool ok = true;
+    Variant decoded;
+    int len;
+    for (const CodecCase &c : p_cases) {
+        Vector<uint8_t> buffer;
+        int size = 0;
+        MultiplayerCodec::encode_value(c.value, buffer, size, false);
+        for (int truncated = 0; truncated < size; truncated++) {
+            if (MultiplayerCodec::decode_value(decoded, buffer.data(), truncated, len, false) == OK) {
+                ok = report("truncated value", String(c.name) + " decoded from " + itos(truncated) + " of " + itos(size) + " bytes");
+                break;
+            }
+        }
+    }
+
+    // Past the last tag.
+    const uint8_t unknown_tag[] = { 0x7F, 0, 0, 0, 0, 0, 0, 0, 0 };
+    if (MultiplayerCodec::decode_value(decoded, unknown_tag, sizeof(unknown_tag), len, false) == OK) {
+        ok = report("unknown tag", "decoded");
+    }
+
+    Vector<uint8_t> string_buffer;
+    int string_size = 0;
+    MultiplayerCodec::encode_value(String("abc"), string_buffer, string_size, false);
+    // A length of 2^32 - 1 in the varint that follows the tag.
+    const uint8_t huge_length[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x0F };
+    string_buffer.erase(string_buffer.begin() + 1, string_buffer.begin() + 2);
+    string_buffer.insert(string_buffer.begin() + 1, huge_length, huge_length + sizeof(huge_length));
+    if (MultiplayerCodec::decode_value(decoded, string_buffer.data(), string_buffer.size(), len, false) == OK) {
+        ok = report("string length", "a length past the end of the buffer decoded");
+    }
+
+    const uint8_t overlong_varint[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+    uint32_t value;
+    if (MultiplayerCodec::decode_varint(overlong_varint, sizeof(overlong_varint), value, len) == OK) {
+        ok = report("varint", "a varint longer than 5 bytes decoded");
+    }
+    uint8_t varint[5];
+    int varint_len = MultiplayerCodec::encode_varint(UINT32_MAX, varint);
+    if (varint_len != 5 || MultiplayerCodec::decode_varint(varint, varint_len, value, len) != OK || value != UINT32_MAX || len != 5) {
+        ok = report("varint", "UINT32_MAX did not round trip");
+    }
+    return ok;
+}
+
+/// One end of an in-process connection, put_packet lands in the other end's queue.
+/// Keeps a copy of every packet it sent.
+class LoopbackPeer : public NetworkedMultiplayerPeer {
+
+    struct Packet {
+        Vector<uint8_t> data;
+        int from;
+    };
+
+    Dequeue<Packet> incoming;
+    Packet current;
+    LoopbackPeer *other = nullptr;
+    int unique_id = 0;
+    TransferMode transfer_mode = TRANSFER_MODE_RELIABLE;
+
+public:
+    Vector<Vector<uint8_t>> sent;
+
+    void link(LoopbackPeer *p_other, int p_id) {
+        other = p_other;
+        unique_id = p_id;
+    }
+    void unlink() { other = nullptr; }
+    //! Queues a packet as if the other end had sent it.
+    void inject(const Vector<uint8_t> &p_packet) { incoming.push_back({ p_packet, other->unique_id }); }
+
+    void set_transfer_mode(TransferMode p_mode) override { transfer_mode = p_mode; }
+    TransferMode get_transfer_mode() const override { return transfer_mode; }
+    void set_target_peer(int p_peer_id) override {}
+    int get_packet_peer() const override { return incoming.front().from; }
+    bool is_server() const override { return unique_id == SERVER_ID; }
+    void poll() override {}
+    int get_unique_id() const override { return unique_id; }
+    void set_refuse_new_connections(bool p_enable) override {}
+    bool is_refusing_new_connections() const override { return false; }
+    ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+
+    int get_available_packet_count() const override { return incoming.size(); }
+    Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+        ERR_FAIL_COND_V(incoming.empty(), ERR_UNAVAILABLE);
+        current = eastl::move(incoming.front());
+        incoming.pop_front();
+        *r_buffer = current.data.data();
+        r_buffer_size = current.data.size();
+        return OK;
+    }
+    Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+        ERR_FAIL_COND_V(!other, ERR_UNCONFIGURED);
+        Vector<uint8_t> packet(p_buffer, p_buffer + p_buffer_size);
+        sent.push_back(packet);
+        other->incoming.push_back({ eastl::move(packet), unique_id });
+        return OK;
+    }
+    int get_max_packet_size() const override { return 1 << 24; }
+};
+
+int count_command(const Vector<Vector<uint8_t>> &p_packets, uint8_t p_command) {
+    int count = 0;
+    for (const Vector<uint8_t> &packet : p_packets) {
+        if (!packet.empty() && (packet[0] & ~NETWORK_COMMAND_FLAG_NAME_ID) == p_command) {
+            count++;
+        }
+    }
+    return count;
+}
+
+const Vector<uint8_t> *last_command(const Vector<Vector<uint8_t>> &p_packets, uint8_t p_command) {
+    for (auto it = p_packets.rbegin(); it != p_packets.rend(); ++it) {
+        if (!it->empty() && ((*it)[0] & ~NETWORK_COMMAND_FLAG_NAME_ID) == p_command) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+/// Sends RPCs and RSETs from a server to a client over loopback peers. Checks that the names switch to
+/// negotiated ids once SIMPLIFY_NAME is confirmed, then feeds the client malformed packets that it must drop.
+class TestMainLoop : public SceneTree {
+
+    Ref<MultiplayerAPI> server_api;
+    Ref<MultiplayerAPI> client_api;
+    Ref<LoopbackPeer> server_peer;
+    Ref<LoopbackPeer> client_peer;
+    Node *server_root = nullptr;
+    Node *client_root = nullptr;
+    Node3D *server_unit = nullptr;
+    Node3D *client_unit = nullptr;
+
+    Node3D *_make_side(const char *p_name, Node *&r_root) {
+        r_root = memnew(Node);
+        r_root->set_name(p_name);
+        get_root()->add_child(r_root);
+        Node3D *unit = memnew(Node3D);
+        unit->set_name("Unit");
+        r_root->add_child(unit);
+        return unit;
+    }
+
+    void _pump() {
+        for (int i = 0; i < PUMP_ROUNDS; i++) {
+            server_api->poll();
+            client_api->poll();
+        }
+    }
+
+    void _call(const Vector3 &p_translation) {
+        Variant arg(p_translation);
+        const Variant *args[] = { &arg };
+        server_api->rpcp(server_unit, CLIENT_ID, false, "set_translation", args, 1);
+        _pump();
+    }
+
+    void _set(const Vector3 &p_rotation) {
+        server_api->rsetp(server_unit, CLIENT_ID, false, "rotation_degrees", p_rotation);
+        _pump();
+    }
+
+    /// p_name_id: whether the last packet of p_command named the method or property by id.
+    bool _check_sent(const char *p_step, uint8_t p_command, bool p_name_id, bool p_applied) {
+        const Vector<uint8_t> *packet = last_command(server_peer->sent, p_command);
+        if (!packet) {
+            return report(p_step, "nothing was sent");
+        }
+        if (bool((*packet)[0] & NETWORK_COMMAND_FLAG_NAME_ID) != p_name_id) {
+            return report(p_step, p_name_id ? "the name was not sent as an id" : "the name was sent as an id before it was confirmed");
+        }
+        if (!p_applied) {
+            return report(p_step, "the client did not apply it");
+        }
+        return true;
+    }
+
+    bool _check_negotiation() {
+        bool ok = true;
+
+        // Unknown path: SIMPLIFY_PATH, then the full path and the name as a string.
+        _call(Vector3(1, 0, 0));
+        ok &= _check_sent("first rpc", NETWORK_COMMAND_REMOTE_CALL, false, client_unit->get_translation() == Vector3(1, 0, 0));
+        // Confirmed path, unconfirmed name: SIMPLIFY_NAME goes out and the name is still a string.
+        _call(Vector3(2, 0, 0));
+        ok &= _check_sent("second rpc", NETWORK_COMMAND_REMOTE_CALL, false, client_unit->get_translation() == Vector3(2, 0, 0));
+        _call(Vector3(3, 0, 0));
+        ok &= _check_sent("third rpc", NETWORK_COMMAND_REMOTE_CALL, true, client_unit->get_translation() == Vector3(3, 0, 0));
+        const Vector<uint8_t> *packet = last_command(server_peer->sent, NETWORK_COMMAND_REMOTE_CALL);
+        // Command, path id, name id, argument count and a tagged Vector3.
+        if (packet && packet->size() != 1 + 4 + 2 + 1 + 13) {
+            ok = report("third rpc", "took " + itos(packet->size()) + " bytes");
+        }
+
+        // Property names get ids of their own within the same path.
+        _set(Vector3(0, 10, 0));
+        ok &= _check_sent("first rset", NETWORK_COMMAND_REMOTE_SET, false, client_unit->get_rotation_degrees().is_equal_approx(Vector3(0, 10, 0)));
+        _set(Vector3(0, 20, 0));
+        ok &= _check_sent("second rset", NETWORK_COMMAND_REMOTE_SET, true, client_unit->get_rotation_degrees().is_equal_approx(Vector3(0, 20, 0)));
+
+        if (count_command(server_peer->sent, NETWORK_COMMAND_SIMPLIFY_PATH) != 1) {
+            ok = report("negotiation", "the path was announced more than once");
+        }
+        if (count_command(server_peer->sent, NETWORK_COMMAND_SIMPLIFY_NAME) != 2 ||
+                count_command(client_peer->sent, NETWORK_COMMAND_CONFIRM_NAME) != 2) {
+            ok = report("negotiation", "each name must be announced and confirmed once");
+        }
+        return ok;
+    }
+
+    /// Injects p_packet into the client, which must not call the method.
+    bool _check_dropped(const char *p_step, const Vector<uint8_t> &p_packet) {
+        const Vector3 sentinel(-1, -1, -1);
+        client_unit->set_translation(sentinel);
+        client_peer->inject(p_packet);
+        client_api->poll();
+        if (client_unit->get_translation() != sentinel) {
+            return report(p_step, "the client applied a malformed packet");
+        }
+        return true;
+    }
+
+    bool _check_malformed_packets() {
+        const Vector<uint8_t> *last_call = last_command(server_peer->sent, NETWORK_COMMAND_REMOTE_CALL);
+        if (!last_call) {
+            return false;
+        }
+        const Vector<uint8_t> valid = *last_call;
+        bool ok = true;
+
+        for (int truncated = 1; truncated < valid.size(); truncated++) {
+            ok &= _check_dropped("truncated rpc", Vector<uint8_t>(valid.begin(), valid.begin() + truncated));
+        }
+
+        Vector<uint8_t> packet = valid;
+        encode_uint16(0x7FFF, &packet[5]);
+        ok &= _check_dropped("unknown name id", packet);
+
+        packet = valid;
+        encode_uint32(999, &packet[1]);
+        ok &= _check_dropped("unknown path id", packet);
+
+        // Name ids are only valid along a cached path, even when the full path resolves.
+        packet = valid;
+        encode_uint32(0x80000000 | uint32_t(valid.size()), &packet[1]);
+        const char unit_path[] = "Unit";
+        packet.insert(packet.end(), unit_path, unit_path + sizeof(unit_path));
+        ok &= _check_dropped("name id with a full path", packet);
+
+        packet = valid;
+        packet[7] = 2; // Claims an argument the packet doesn't hold.
+        ok &= _check_dropped("argument count", packet);
+
+        packet = valid;
+        packet[8] = 0x7F; // Unknown value tag.
+        ok &= _check_dropped("argument tag", packet);
+
+        // Names announced for unknown paths or in truncated packets are not confirmed.
+        const int confirmed = count_command(client_peer->sent, NETWORK_COMMAND_CONFIRM_NAME);
+        const Vector<uint8_t> *last_name = last_command(server_peer->sent, NETWORK_COMMAND_SIMPLIFY_NAME);
+        if (last_name) {
+            packet = *last_name;
+            encode_uint32(999, &packet[1]);
+            client_peer->inject(packet);
+            client_peer->inject(Vector<uint8_t>(last_name->begin(), last_name->begin() + 7));
+            client_api->poll();
+            if (count_command(client_peer->sent, NETWORK_COMMAND_CONFIRM_NAME) != confirmed) {
+                ok = report("simplify name", "a malformed name announcement was confirmed");
+            }
+        }
+
+        // Confirmations of names the server never announced are ignored, and the negotiated ids keep working.
+        uint8_t confirm[7];
+        confirm[0] = NETWORK_COMMAND_CONFIRM_NAME;
+        encode_uint32(decode_uint32(&valid[1]), &confirm[1]);
+        encode_uint16(0x7FFF, &confirm[5]);
+        server_peer->inject(Vector<uint8_t>(confirm, confirm + sizeof(confirm)));
+        server_peer->inject(Vector<uint8_t>(confirm, confirm + 3));
+        _call(Vector3(4, 0, 0));
+        ok &= _check_sent("rpc after bad confirmations", NETWORK_COMMAND_REMOTE_CALL, true, client_unit->get_translation() == Vector3(4, 0, 0));
+        return ok;
+    }
+
+public:
+    void init() override {
+
+        SceneTree::init();
+
+        server_unit = _make_side("Server", server_root);
+        client_unit = _make_side("Client", client_root);
+        client_unit->rpc_config("set_translation", RPC_MODE_REMOTE);
+        client_unit->rset_config("rotation_degrees", RPC_MODE_REMOTE);
+
+        server_peer = make_ref_counted<LoopbackPeer>();
+        client_peer = make_ref_counted<LoopbackPeer>();
+        server_peer->link(client_peer.get(), SERVER_ID);
+        client_peer->link(server_peer.get(), CLIENT_ID);
+
+        server_api = make_ref_counted<MultiplayerAPI>();
+        client_api = make_ref_counted<MultiplayerAPI>();
+        server_api->set_root_node(server_root);
+        client_api->set_root_node(client_root);
+        server_api->set_network_peer(server_peer);
+        client_api->set_network_peer(client_peer);
+        server_peer->emit_signal("peer_connected", CLIENT_ID);
+        client_peer->emit_signal("peer_connected", SERVER_ID);
+
+        const Vector<CodecCase> cases = make_codec_cases();
+        bool ok = check_round_trips(cases);
+        ok &= _check_negotiation();
+
+        // The rejected packets are expected to print errors.
+        const bool print_errors = _print_error_enabled;
+        _print_error_enabled = false;
+        ok &= check_rejections(cases);
+        ok &= _check_malformed_packets();
+        _print_error_enabled = print_errors;
+
+        OS::get_singleton()->print(ok ? "multiplayer_codec: OK\n" : "multiplayer_codec: FAILED\n");
+    }
+
+    bool idle(float p_time) override {
+
+        SceneTree::idle(p_time);
+        return true;
+    }
+
+    void finish() override {
+
+        server_peer->unlink();
+        client_peer->unlink();
+        server_api.unref();
+        client_api.unref();
+        server_peer.unref();
+        client_peer.unref();
+        memdelete(server_root);
+        memdelete(client_root);
+        SceneTree::finish();
+    }
+};
+
+} // namespace
+
+MainLoop *test() {
+
+    return memnew(TestMainLoop);
+}
+
+} // namespace TestMultiplayerCodec
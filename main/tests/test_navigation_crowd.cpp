@@ -0,0 +1,132 @@
+/*************************************************************************/
+/*  test_navigation_crowd.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_navigation_crowd.h"
+
+#include "core/callable_method_pointer.h"
+#include "core/math/math_funcs.h"
+#include "core/object.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "core/vector.h"
+#include "servers/navigation_server.h"
+
+namespace TestNavigationCrowd {
+
+namespace {
+
+constexpr real_t STEP_DELTA = 1.0f / 60.0f;
+constexpr int WARMUP_FRAMES = 10;
+constexpr int MEASURED_FRAMES = 60;
+
+/// Steps a crowd of `p_count` agents crossing a square towards its center,
+/// returns the average time of `NavigationServer::process` in microseconds.
+uint64_t run_crowd(NavigationServer *ns, Object *holder, int p_count) {
+    RID map = ns->map_create();
+    ns->map_set_active(map, true);
+
+    // Two agents per square meter, as in a dense crowd.
+    const int side = int(Math::ceil(Math::sqrt(float(p_count))));
+    const real_t spacing = 0.7;
+    const Vector3 center(side * spacing * 0.5f, 0, side * spacing * 0.5f);
+
+    Vector<RID> agents;
+    Vector<Vector3> positions;
+    Vector<Vector3> velocities;
+    agents.reserve(p_count);
+    positions.resize(p_count);
+    velocities.resize(p_count, Vector3());
+
+    for (int i = 0; i < p_count; i++) {
+        RID agent = ns->agent_create();
+        positions[i] = Vector3((i % side) * spacing, 0, (i / side) * spacing);
+        ns->agent_set_map(agent, map);
+        ns->agent_set_radius(agent, 0.3);
+        ns->agent_set_neighbor_dist(agent, 3.0);
+        ns->agent_set_max_neighbors(agent, 10);
+        ns->agent_set_time_horizon(agent, 2.0);
+        ns->agent_set_max_speed(agent, 2.0);
+        ns->agent_set_ignore_y(agent, true);
+        ns->agent_set_position(agent, positions[i]);
+        Vector3 *velocity = &velocities[i];
+        ns->agent_set_callback(agent, callable_gen(holder, [velocity](Vector3 p_velocity) { *velocity = p_velocity; }));
+        agents.push_back(agent);
+    }
+
+    uint64_t total_usec = 0;
+    for (int frame = 0; frame < WARMUP_FRAMES + MEASURED_FRAMES; frame++) {
+        for (int i = 0; i < p_count; i++) {
+            positions[i] += velocities[i] * STEP_DELTA;
+            const Vector3 to_center = center - positions[i];
+            const Vector3 target = to_center.length() > 0.1f ? to_center.normalized() * 2.0f : Vector3();
+            ns->agent_set_position(agents[i], positions[i]);
+            ns->agent_set_velocity(agents[i], velocities[i]);
+            ns->agent_set_target_velocity(agents[i], target);
+        }
+
+        const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+        ns->process(STEP_DELTA);
+        if (frame >= WARMUP_FRAMES) {
+            total_usec += OS::get_singleton()->get_ticks_usec() - begin;
+        }
+    }
+
+    for (const RID &agent : agents) {
+        ns->free_rid(agent);
+    }
+    ns->free_rid(map);
+    ns->process(STEP_DELTA);
+
+    return total_usec / MEASURED_FRAMES;
+}
+
+} // namespace
+
+MainLoop *test() {
+    NavigationServer *ns = NavigationServer::get_singleton_mut();
+    if (!ns) {
+        OS::get_singleton()->print("NavigationServer is not available\n");
+        return nullptr;
+    }
+
+    Object *holder = memnew(Object);
+
+    OS::get_singleton()->print("agents\tstep (ms)\n");
+    static const int counts[] = { 250, 500, 1000, 2000, 4000, 8000, 16000 };
+    for (int count : counts) {
+        const uint64_t usec = run_crowd(ns, holder, count);
+        OS::get_singleton()->print(FormatVE("%d\t%.3f\n", count, usec / 1000.0));
+    }
+
+    memdelete(holder);
+    return nullptr;
+}
+
+} // namespace TestNavigationCrowd
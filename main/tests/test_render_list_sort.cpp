@@ -0,0 +1,188 @@
+/*************************************************************************/
+/*  test_render_list_sort.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_render_list_sort.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/radix_sort.h"
+#include "core/string_formatter.h"
+#include "core/vector.h"
+
+#include "EASTL/sort.h"
+
+namespace TestRenderListSort {
+
+namespace {
+
+constexpr int RUNS = 20;
+constexpr int PRIORITY_SHIFT = 56; // RenderListConstants::SORT_KEY_PRIORITY_SHIFT
+
+/// The parts of the GLES3 RenderListElement the sorts look at.
+struct Element {
+    uint64_t sort_key;
+    float sort_depth;
+};
+
+enum Order {
+    ORDER_KEY,
+    ORDER_DEPTH,
+    ORDER_REVERSE_DEPTH_AND_PRIORITY,
+    ORDER_MAX
+};
+
+const char *order_names[ORDER_MAX] = { "key", "depth", "alpha" };
+
+bool compare(Order p_order, const Element *A, const Element *B) {
+    switch (p_order) {
+        case ORDER_KEY:
+            return A->sort_key < B->sort_key;
+        case ORDER_DEPTH:
+            return A->sort_depth < B->sort_depth;
+        default: {
+            uint32_t layer_A = uint32_t(A->sort_key >> PRIORITY_SHIFT);
+            uint32_t layer_B = uint32_t(B->sort_key >> PRIORITY_SHIFT);
+            if (layer_A == layer_B) {
+                return A->sort_depth > B->sort_depth;
+            }
+            return layer_A < layer_B;
+        }
+    }
+}
+
+uint64_t make_key(Order p_order, const Element *e) {
+    switch (p_order) {
+        case ORDER_KEY:
+            return e->sort_key;
+        case ORDER_DEPTH:
+            return RadixSort::float_to_key(e->sort_depth);
+        default: {
+            uint64_t layer = e->sort_key >> PRIORITY_SHIFT;
+            return (layer << 32) | uint32_t(~RadixSort::float_to_key(e->sort_depth));
+        }
+    }
+}
+
+/// Fills p_elements with keys laid out like the scene render list: a few
+/// priorities, a few hundred materials and a few thousand geometries.
+void make_list(Vector<Element> &p_elements, int p_count, RandomPCG &p_rng) {
+    p_elements.resize(p_count);
+    for (int i = 0; i < p_count; i++) {
+        uint64_t priority = 128 + p_rng.rand() % 4;
+        uint64_t material = p_rng.rand() % 300;
+        uint64_t geometry = p_rng.rand() % 4000;
+        p_elements[i].sort_key = (priority << PRIORITY_SHIFT) | (material << 28) | (geometry << 8) | (p_rng.rand() & 0xF);
+        p_elements[i].sort_depth = p_rng.randf() * 500.0f;
+    }
+}
+
+void reset(Vector<Element *> &r_list, Vector<Element> &p_elements) {
+    r_list.resize(p_elements.size());
+    for (size_t i = 0; i < p_elements.size(); i++) {
+        r_list[i] = &p_elements[i];
+    }
+}
+
+/// Sorts the list like RenderList::sort_by() does.
+void radix_sort(Order p_order, Vector<Element *> &r_list, Vector<RadixSortPair> &r_pairs,
+        Vector<RadixSortPair> &r_scratch, Vector<Element *> &r_sorted) {
+    const uint32_t count = r_list.size();
+    r_pairs.resize(count);
+    r_scratch.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        r_pairs[i].key = make_key(p_order, r_list[i]);
+        r_pairs[i].value = i;
+    }
+    const RadixSortPair *sorted = RadixSort::sort(r_pairs.data(), r_scratch.data(), count);
+    r_sorted.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        r_sorted[i] = r_list[sorted[i].value];
+    }
+    r_list.swap(r_sorted);
+}
+
+/// Both sorts must agree on the key sequence, equal keys may be ordered differently.
+bool same_order(Order p_order, const Vector<Element *> &p_a, const Vector<Element *> &p_b) {
+    for (size_t i = 0; i < p_a.size(); i++) {
+        if (make_key(p_order, p_a[i]) != make_key(p_order, p_b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+MainLoop *test() {
+
+    RandomPCG rng(1234);
+    Vector<Element> elements;
+    Vector<Element *> list;
+    Vector<Element *> reference;
+    Vector<RadixSortPair> pairs;
+    Vector<RadixSortPair> scratch;
+    Vector<Element *> sorted;
+
+    OS::get_singleton()->print("elements\torder\tcomparison (ms)\tradix (ms)\n");
+    static const int counts[] = { 10000, 50000, 200000 };
+    for (int count : counts) {
+        make_list(elements, count, rng);
+
+        for (int o = 0; o < ORDER_MAX; o++) {
+            const Order order = Order(o);
+            auto comparator = [order](const Element *A, const Element *B) { return compare(order, A, B); };
+
+            uint64_t comparison_usec = 0;
+            uint64_t radix_usec = 0;
+            for (int run = 0; run < RUNS; run++) {
+                reset(reference, elements);
+                uint64_t begin = OS::get_singleton()->get_ticks_usec();
+                eastl::sort(reference.begin(), reference.end(), comparator);
+                comparison_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+                reset(list, elements);
+                begin = OS::get_singleton()->get_ticks_usec();
+                radix_sort(order, list, pairs, scratch, sorted);
+                radix_usec += OS::get_singleton()->get_ticks_usec() - begin;
+            }
+
+            if (!same_order(order, reference, list)) {
+                OS::get_singleton()->print(FormatVE("%d\t%s\tradix sort order mismatch\n", count, order_names[o]));
+                continue;
+            }
+            OS::get_singleton()->print(FormatVE("%d\t%s\t%.3f\t%.3f\n", count, order_names[o],
+                    comparison_usec / 1000.0 / RUNS, radix_usec / 1000.0 / RUNS));
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace TestRenderListSort
@@ -0,0 +1,279 @@
+/*************************************************************************/
+/*  test_rendering_benchmark.cpp                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_rendering_benchmark.h"
+
+#include "core/array.h"
+#include "core/dictionary.h"
+#include "core/io/json.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/variant.h"
+#include "servers/rendering/rendering_server_canvas.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering/rendering_server_scene.h"
+#include "servers/rendering_server.h"
+
+namespace TestRenderingBenchmark {
+
+namespace {
+
+constexpr int WARMUP_FRAMES = 10;
+constexpr int MEASURED_FRAMES = 100;
+constexpr int MOVED_PER_FRAME_DIVISOR = 10; // a tenth of the objects move every frame
+constexpr float SPACING = 4.0f;
+const Size2 VIEWPORT_SIZE(1920, 1080);
+
+struct Scenario {
+    int instances;
+    int lights;
+    int canvas_items;
+};
+
+enum Phase {
+    PHASE_INSTANCE_UPDATE,
+    PHASE_RENDER_CAMERA,
+    PHASE_CANVAS_UPDATE,
+    PHASE_RENDER_CANVAS,
+    PHASE_MAX
+};
+
+const char *phase_names[PHASE_MAX] = {
+    "instance_update",
+    "render_camera",
+    "canvas_update",
+    "render_canvas",
+};
+
+struct PhaseTimes {
+    uint64_t total = 0;
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+
+    void add(uint64_t p_usec) {
+        total += p_usec;
+        min = MIN(min, p_usec);
+        max = M_MAX(max, p_usec);
+    }
+};
+
+RenderingEntity make_box_mesh(RenderingServer *rs) {
+    Vector<Vector3> vertices;
+    for (int i = 0; i < 8; i++) {
+        vertices.push_back(Vector3(i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f));
+    }
+    static const int faces[36] = {
+        0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+        2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5
+    };
+    Vector<int> indices(faces, faces + 36);
+
+    SurfaceArrays arrays(eastl::move(vertices));
+    arrays.m_indices = eastl::move(indices);
+
+    RenderingEntity mesh = rs->mesh_create();
+    rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+    return mesh;
+}
+
+/// Builds the scenario, renders it for a fixed number of frames and returns
+/// the timings of each phase as a dictionary.
+Dictionary run_scenario(const Scenario &p_scenario) {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    RandomPCG rng(p_scenario.instances);
+
+    RenderingEntity scenario = rs->scenario_create();
+    RenderingEntity mesh = make_box_mesh(rs);
+
+    // instances on a square grid, the camera looks at it from one side
+    const int side = M_MAX(1, int(Math::ceil(Math::sqrt(float(p_scenario.instances)))));
+    Vector<RenderingEntity> instances;
+    Vector<Transform> instance_xforms;
+    for (int i = 0; i < p_scenario.instances; i++) {
+        Transform xform;
+        xform.origin = Vector3((i % side) * SPACING, 0, (i / side) * SPACING);
+        RenderingEntity instance = rs->instance_create2(mesh, scenario);
+        rs->instance_set_transform(instance, xform);
+        instances.push_back(instance);
+        instance_xforms.push_back(xform);
+    }
+
+    Vector<RenderingEntity> lights;
+    Vector<RenderingEntity> light_instances;
+    for (int i = 0; i < p_scenario.lights; i++) {
+        RenderingEntity light = rs->omni_light_create();
+        rs->light_set_param(light, RS::LIGHT_PARAM_RANGE, SPACING * 4.0f);
+        rs->light_set_shadow(light, true);
+        RenderingEntity instance = rs->instance_create2(light, scenario);
+        Transform xform;
+        xform.origin = Vector3(rng.randf() * side * SPACING, 2.0f, rng.randf() * side * SPACING);
+        rs->instance_set_transform(instance, xform);
+        lights.push_back(light);
+        light_instances.push_back(instance);
+    }
+
+    RenderingEntity camera = rs->camera_create();
+    rs->camera_set_perspective(camera, 70.0f, 0.05f, side * SPACING);
+    Transform camera_xform;
+    camera_xform.origin = Vector3(side * SPACING * 0.5f, 10.0f, side * SPACING + 10.0f);
+    rs->camera_set_transform(camera, camera_xform.looking_at(Vector3(side * SPACING * 0.5f, 0, side * SPACING * 0.5f), Vector3(0, 1, 0)));
+
+    RenderingEntity shadow_atlas = VSG::scene_render->shadow_atlas_create();
+    VSG::scene_render->shadow_atlas_set_size(shadow_atlas, 4096);
+
+    // canvas items in groups of 16 under a parent item
+    RenderingEntity canvas = rs->canvas_create();
+    Vector<RenderingEntity> canvas_items;
+    RenderingEntity group = entt::null;
+    for (int i = 0; i < p_scenario.canvas_items; i++) {
+        RenderingEntity item = rs->canvas_item_create();
+        if (i % 16 == 0) {
+            rs->canvas_item_set_parent(item, canvas);
+            group = item;
+        } else {
+            rs->canvas_item_set_parent(item, group);
+        }
+        rs->canvas_item_set_transform(item, Transform2D(0, Vector2(rng.randf() * VIEWPORT_SIZE.width, rng.randf() * VIEWPORT_SIZE.height)));
+        rs->canvas_item_add_rect(item, Rect2(0, 0, 16, 16), Color(1, 1, 1));
+        canvas_items.push_back(item);
+    }
+    RenderingCanvasComponent *canvas_component = VSG::ecs->try_get<RenderingCanvasComponent>(canvas);
+
+    PhaseTimes times[PHASE_MAX];
+    const int moved_instances = p_scenario.instances / MOVED_PER_FRAME_DIVISOR;
+    const int moved_items = p_scenario.canvas_items / MOVED_PER_FRAME_DIVISOR;
+
+    for (int frame = 0; frame < WARMUP_FRAMES + MEASURED_FRAMES; frame++) {
+        const bool measured = frame >= WARMUP_FRAMES;
+        uint64_t phase_usec[PHASE_MAX];
+
+        uint64_t begin = OS::get_singleton()->get_ticks_usec();
+        for (int i = 0; i < moved_instances; i++) {
+            const int idx = (frame * moved_instances + i) % p_scenario.instances;
+            Transform xform = instance_xforms[idx];
+            xform.origin.y = Math::sin(frame * 0.1f + idx);
+            rs->instance_set_transform(instances[idx], xform);
+        }
+        VSG::scene->update_dirty_instances();
+        phase_usec[PHASE_INSTANCE_UPDATE] = OS::get_singleton()->get_ticks_usec() - begin;
+
+        begin = OS::get_singleton()->get_ticks_usec();
+        VSG::scene->render_camera(camera, scenario, VIEWPORT_SIZE, shadow_atlas);
+        phase_usec[PHASE_RENDER_CAMERA] = OS::get_singleton()->get_ticks_usec() - begin;
+
+        begin = OS::get_singleton()->get_ticks_usec();
+        for (int i = 0; i < moved_items; i++) {
+            const int idx = (frame * moved_items + i) % p_scenario.canvas_items;
+            rs->canvas_item_set_transform(canvas_items[idx], Transform2D(frame * 0.01f, Vector2(rng.randf() * VIEWPORT_SIZE.width, rng.randf() * VIEWPORT_SIZE.height)));
+        }
+        phase_usec[PHASE_CANVAS_UPDATE] = OS::get_singleton()->get_ticks_usec() - begin;
+
+        begin = OS::get_singleton()->get_ticks_usec();
+        if (canvas_component) {
+            VSG::canvas->render_canvas(canvas_component, Transform2D(), {}, {}, Rect2(Point2(), VIEWPORT_SIZE));
+        }
+        phase_usec[PHASE_RENDER_CANVAS] = OS::get_singleton()->get_ticks_usec() - begin;
+
+        if (measured) {
+            for (int p = 0; p < PHASE_MAX; p++) {
+                times[p].add(phase_usec[p]);
+            }
+        }
+    }
+
+    for (RenderingEntity item : canvas_items) {
+        rs->free_rid(item);
+    }
+    rs->free_rid(canvas);
+    for (RenderingEntity instance : light_instances) {
+        rs->free_rid(instance);
+    }
+    for (RenderingEntity light : lights) {
+        rs->free_rid(light);
+    }
+    for (RenderingEntity instance : instances) {
+        rs->free_rid(instance);
+    }
+    if (shadow_atlas != entt::null) {
+        VSG::storage->free(shadow_atlas);
+    }
+    rs->free_rid(camera);
+    rs->free_rid(mesh);
+    rs->free_rid(scenario);
+
+    Dictionary phases;
+    for (int p = 0; p < PHASE_MAX; p++) {
+        Dictionary phase;
+        phase["avg_ms"] = times[p].total / 1000.0 / MEASURED_FRAMES;
+        phase["min_ms"] = times[p].min / 1000.0;
+        phase["max_ms"] = times[p].max / 1000.0;
+        phases[StringName(phase_names[p])] = phase;
+    }
+
+    Dictionary result;
+    result["instances"] = p_scenario.instances;
+    result["lights"] = p_scenario.lights;
+    result["canvas_items"] = p_scenario.canvas_items;
+    result["phases"] = phases;
+    return result;
+}
+
+} // namespace
+
+/// Times the CPU side of the rendering server on synthetic scenes and prints
+/// the results as JSON. The render calls are made from this thread, so the
+/// server must not run on its own thread.
+MainLoop *test() {
+
+    if (OS::get_singleton()->get_render_thread_mode() == OS::RENDER_SEPARATE_THREAD) {
+        OS::get_singleton()->printerr("rendering_benchmark can't run with a separate render thread.\n");
+        return nullptr;
+    }
+
+    static const Scenario scenarios[] = {
+        { 1000, 8, 1000 },
+        { 10000, 32, 10000 },
+        { 50000, 128, 50000 },
+    };
+
+    Array results;
+    for (const Scenario &scenario : scenarios) {
+        results.push_back(run_scenario(scenario));
+    }
+
+    Dictionary report;
+    report["frames"] = MEASURED_FRAMES;
+    report["scenarios"] = results;
+    OS::get_singleton()->print(JSON::print(report, "  ") + "\n");
+
+    return nullptr;
+}
+
+} // namespace TestRenderingBenchmark
@@ -0,0 +1,310 @@
+/*************************************************************************/
+/*  test_replication.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_replication.h"
+
+#include "core/deque.h"
+#include "core/io/multiplayer_api.h"
+#include "core/io/multiplayer_codec.h"
+#include "core/io/networked_multiplayer_peer.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "core/string_utils.h"
+#include "scene/3d/node_3d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+namespace TestReplication {
+
+namespace {
+
+constexpr int UNITS = 2000;
+constexpr float WORLD_SIZE = 1000;
+constexpr float MOVING_FRACTION = 0.25f;
+constexpr float PACKET_LOSS = 0.1f;
+constexpr int MEASURED_FRAMES = 120;
+// Frames without movement nor loss at the end of a run, for the client to catch up before checking it.
+constexpr int SETTLE_FRAMES = 8;
+const char *REPLICATED_PROPERTIES[] = { "translation", "rotation_degrees" };
+
+struct Run {
+    float interest_radius;
+    int budget;
+};
+
+const Run runs[] = {
+    { -1, 0 },
+    { 150, 0 },
+    { 150, 1200 },
+};
+
+/// One end of an in-process connection, put_packet lands in the other end's queue.
+/// Unreliable packets are dropped at random while loss is enabled.
+class LoopbackPeer : public NetworkedMultiplayerPeer {
+
+    struct Packet {
+        Vector<uint8_t> data;
+        int from;
+    };
+
+    Dequeue<Packet> incoming;
+    Packet current;
+    LoopbackPeer *other = nullptr;
+    RandomPCG *rng = nullptr;
+    int unique_id = 0;
+    int target = 0;
+    TransferMode transfer_mode = TRANSFER_MODE_RELIABLE;
+
+public:
+    float loss = 0;
+
+    void link(LoopbackPeer *p_other, int p_id, RandomPCG *p_rng) {
+        other = p_other;
+        unique_id = p_id;
+        rng = p_rng;
+    }
+    void unlink() { other = nullptr; }
+
+    void set_transfer_mode(TransferMode p_mode) override { transfer_mode = p_mode; }
+    TransferMode get_transfer_mode() const override { return transfer_mode; }
+    void set_target_peer(int p_peer_id) override { target = p_peer_id; }
+    int get_packet_peer() const override { return incoming.front().from; }
+    bool is_server() const override { return unique_id == 1; }
+    void poll() override {}
+    int get_unique_id() const override { return unique_id; }
+    void set_refuse_new_connections(bool p_enable) override {}
+    bool is_refusing_new_connections() const override { return false; }
+    ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+
+    int get_available_packet_count() const override { return incoming.size(); }
+    Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+        ERR_FAIL_COND_V(incoming.empty(), ERR_UNAVAILABLE);
+        current = eastl::move(incoming.front());
+        incoming.pop_front();
+        *r_buffer = current.data.data();
+        r_buffer_size = current.data.size();
+        return OK;
+    }
+    Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+        ERR_FAIL_COND_V(!other, ERR_UNCONFIGURED);
+        if (transfer_mode != TRANSFER_MODE_RELIABLE && rng->randf() < loss) {
+            return OK;
+        }
+        other->incoming.push_back({ Vector<uint8_t>(p_buffer, p_buffer + p_buffer_size), unique_id });
+        return OK;
+    }
+    int get_max_packet_size() const override { return 1 << 24; }
+};
+
+/// Replicates randomly walking units from a server to a client over lossy loopback
+/// peers and prints the bytes sent per frame against sending every property of every
+/// unit each frame, then checks the client ended up with the state it was sent.
+class TestMainLoop : public SceneTree {
+
+    RandomPCG rng;
+    Ref<MultiplayerAPI> server_api;
+    Ref<MultiplayerAPI> client_api;
+    Ref<LoopbackPeer> server_peer;
+    Ref<LoopbackPeer> client_peer;
+    Node *server_root = nullptr;
+    Node *client_root = nullptr;
+    Vector<Node3D *> server_units;
+    Vector<Node3D *> client_units;
+    int run = -1;
+    int frame = 0;
+    uint64_t full_state_bytes = 0;
+    uint64_t update_usec = 0;
+
+    Node *_make_side(const char *p_name, Vector<Node3D *> &r_units) {
+        Node *root = memnew(Node);
+        root->set_name(p_name);
+        get_root()->add_child(root);
+        for (int i = 0; i < UNITS; i++) {
+            Node3D *unit = memnew(Node3D);
+            unit->set_name(String("Unit") + itos(i));
+            root->add_child(unit);
+            r_units.push_back(unit);
+        }
+        return root;
+    }
+
+    void _start_run(const Run &p_run) {
+        _end_run();
+
+        rng.seed(7);
+        server_root = _make_side("Server", server_units);
+        client_root = _make_side("Client", client_units);
+        for (Node3D *unit : server_units) {
+            unit->set_translation(Vector3(rng.randf() * WORLD_SIZE, 0, rng.randf() * WORLD_SIZE) - Vector3(WORLD_SIZE, 0, WORLD_SIZE) * 0.5f);
+        }
+
+        server_peer = make_ref_counted<LoopbackPeer>();
+        client_peer = make_ref_counted<LoopbackPeer>();
+        server_peer->link(client_peer.get(), 1, &rng);
+        client_peer->link(server_peer.get(), 2, &rng);
+        server_peer->loss = client_peer->loss = PACKET_LOSS;
+
+        server_api = make_ref_counted<MultiplayerAPI>();
+        client_api = make_ref_counted<MultiplayerAPI>();
+        server_api->set_root_node(server_root);
+        client_api->set_root_node(client_root);
+        server_api->set_network_peer(server_peer);
+        client_api->set_network_peer(client_peer);
+        server_peer->emit_signal("peer_connected", 2);
+        client_peer->emit_signal("peer_connected", 1);
+
+        Vector<String> properties;
+        for (const char *property : REPLICATED_PROPERTIES) {
+            properties.push_back(property);
+        }
+        for (int i = 0; i < UNITS; i++) {
+            server_api->add_replicated_node(server_units[i], properties);
+            client_api->add_replicated_node(client_units[i], properties);
+        }
+        server_api->set_replication_interest(2, Vector3(), p_run.interest_radius);
+        server_api->set_replication_budget(p_run.budget);
+
+        frame = 0;
+        full_state_bytes = 0;
+        update_usec = 0;
+    }
+
+    void _end_run() {
+        if (server_peer) {
+            server_peer->unlink();
+            client_peer->unlink();
+        }
+        server_api.unref();
+        client_api.unref();
+        server_peer.unref();
+        client_peer.unref();
+        if (server_root) {
+            memdelete(server_root);
+            memdelete(client_root);
+            server_root = client_root = nullptr;
+        }
+        server_units.clear();
+        client_units.clear();
+    }
+
+    void _move_units() {
+        Vector<uint8_t> buffer;
+        for (Node3D *unit : server_units) {
+            if (rng.randf() < MOVING_FRACTION) {
+                unit->set_translation(unit->get_translation() + Vector3(rng.randf() - 0.5f, 0, rng.randf() - 0.5f));
+                unit->set_rotation_degrees(Vector3(0, rng.randf() * 360, 0));
+            }
+            // What sending the whole state would cost, without even naming the nodes.
+            int ofs = 4;
+            for (const char *property : REPLICATED_PROPERTIES) {
+                MultiplayerCodec::encode_value(unit->get(StringName(property)), buffer, ofs, false);
+            }
+            full_state_bytes += ofs;
+        }
+    }
+
+    void _report(const Run &p_run) {
+        const float radius_squared = p_run.interest_radius * p_run.interest_radius;
+        int relevant = 0;
+        int mismatches = 0;
+        for (int i = 0; i < UNITS; i++) {
+            const Vector3 position = server_units[i]->get_translation();
+            if (p_run.interest_radius >= 0 && position.length_squared() > radius_squared) {
+                continue;
+            }
+            relevant++;
+            if (client_units[i]->get_translation() != position || !client_units[i]->get_rotation_degrees().is_equal_approx(server_units[i]->get_rotation_degrees())) {
+                mismatches++;
+            }
+        }
+
+        const int64_t sent = server_api->get_replication_bytes_sent();
+        OS::get_singleton()->print(FormatVE("%s\t%d\t%d/%d\t%.0f\t%.0f\t%.1fx\t%.3f\t%d\n",
+                p_run.interest_radius < 0 ? "all" : itos(int(p_run.interest_radius)).c_str(), p_run.budget, relevant, UNITS,
+                double(full_state_bytes) / MEASURED_FRAMES, double(sent) / MEASURED_FRAMES,
+                sent ? double(full_state_bytes) / sent : 0.0,
+                update_usec / (MEASURED_FRAMES * 1000.0), mismatches));
+    }
+
+public:
+    void init() override {
+
+        SceneTree::init();
+        OS::get_singleton()->print(FormatVE("units: %d, moving per frame: %d%%, unreliable loss: %d%%\n",
+                UNITS, int(MOVING_FRACTION * 100), int(PACKET_LOSS * 100)));
+        OS::get_singleton()->print("radius\tbudget\trelevant\tfull state (B/frame)\treplicated (B/frame)\tsaving\tserver poll (ms)\tmismatches\n");
+    }
+
+    bool idle(float p_time) override {
+
+        if (run < 0 || frame == MEASURED_FRAMES + SETTLE_FRAMES) {
+            if (run >= 0) {
+                _report(runs[run]);
+            }
+            run++;
+            if (run == int(sizeof(runs) / sizeof(runs[0]))) {
+                return true;
+            }
+            _start_run(runs[run]);
+        }
+
+        if (frame < MEASURED_FRAMES) {
+            _move_units();
+        } else {
+            server_peer->loss = client_peer->loss = 0;
+        }
+
+        const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+        server_api->poll();
+        if (frame < MEASURED_FRAMES) {
+            update_usec += OS::get_singleton()->get_ticks_usec() - begin;
+        }
+        client_api->poll();
+        frame++;
+
+        return SceneTree::idle(p_time);
+    }
+
+    void finish() override {
+
+        _end_run();
+        SceneTree::finish();
+    }
+};
+
+} // namespace
+
+MainLoop *test() {
+
+    return memnew(TestMainLoop);
+}
+
+} // namespace TestReplication
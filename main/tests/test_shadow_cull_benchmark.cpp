@@ -0,0 +1,196 @@
+/*************************************************************************/
+/*  test_shadow_cull_benchmark.cpp                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_shadow_cull_benchmark.h"
+
+#include "core/array.h"
+#include "core/dictionary.h"
+#include "core/io/json.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/variant.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering/rendering_server_scene.h"
+#include "servers/rendering_server.h"
+
+namespace TestShadowCullBenchmark {
+
+namespace {
+
+constexpr int WARMUP_FRAMES = 10;
+constexpr int MEASURED_FRAMES = 100;
+constexpr int INSTANCES = 20000;
+constexpr float SPACING = 2.0f;
+const Size2 VIEWPORT_SIZE(1920, 1080);
+
+RenderingEntity make_box_mesh(RenderingServer *rs) {
+    Vector<Vector3> vertices;
+    for (int i = 0; i < 8; i++) {
+        vertices.push_back(Vector3(i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f));
+    }
+    static const int faces[36] = {
+        0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+        2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5
+    };
+    Vector<int> indices(faces, faces + 36);
+
+    SurfaceArrays arrays(eastl::move(vertices));
+    arrays.m_indices = eastl::move(indices);
+
+    RenderingEntity mesh = rs->mesh_create();
+    rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+    return mesh;
+}
+
+/// Renders a grid of boxes lit by p_lights shadowed omni lights. The lights
+/// move every frame, so all of their shadow passes are culled again.
+Dictionary run_scenario(int p_lights) {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    RandomPCG rng(p_lights);
+
+    RenderingEntity scenario = rs->scenario_create();
+    RenderingEntity mesh = make_box_mesh(rs);
+
+    const int side = int(Math::ceil(Math::sqrt(float(INSTANCES))));
+    const float extent = side * SPACING;
+    Vector<RenderingEntity> instances;
+    for (int i = 0; i < INSTANCES; i++) {
+        Transform xform;
+        xform.origin = Vector3((i % side) * SPACING, 0, (i / side) * SPACING);
+        RenderingEntity instance = rs->instance_create2(mesh, scenario);
+        rs->instance_set_transform(instance, xform);
+        instances.push_back(instance);
+    }
+
+    Vector<RenderingEntity> lights;
+    Vector<RenderingEntity> light_instances;
+    Vector<Vector3> light_origins;
+    for (int i = 0; i < p_lights; i++) {
+        RenderingEntity light = rs->omni_light_create();
+        rs->light_set_param(light, RS::LIGHT_PARAM_RANGE, SPACING * 8.0f);
+        rs->light_set_shadow(light, true);
+        RenderingEntity instance = rs->instance_create2(light, scenario);
+        lights.push_back(light);
+        light_instances.push_back(instance);
+        light_origins.push_back(Vector3(rng.randf() * extent, 3.0f, rng.randf() * extent));
+    }
+
+    // the camera sees the whole grid, so every light gets a slot in the atlas
+    RenderingEntity camera = rs->camera_create();
+    rs->camera_set_perspective(camera, 70.0f, 0.05f, extent * 2.0f);
+    Transform camera_xform;
+    camera_xform.origin = Vector3(extent * 0.5f, extent, extent * 1.5f);
+    rs->camera_set_transform(camera, camera_xform.looking_at(Vector3(extent * 0.5f, 0, extent * 0.5f), Vector3(0, 1, 0)));
+
+    RenderingEntity shadow_atlas = VSG::scene_render->shadow_atlas_create();
+    VSG::scene_render->shadow_atlas_set_size(shadow_atlas, 8192);
+    for (int q = 0; q < 4; q++) {
+        VSG::scene_render->shadow_atlas_set_quadrant_subdivision(shadow_atlas, q, 64);
+    }
+
+    uint64_t render_total = 0;
+    uint64_t cull_total = 0;
+    uint64_t cull_min = UINT64_MAX;
+    uint64_t cull_max = 0;
+
+    for (int frame = 0; frame < WARMUP_FRAMES + MEASURED_FRAMES; frame++) {
+        for (int i = 0; i < p_lights; i++) {
+            Transform xform;
+            xform.origin = light_origins[i] + Vector3(Math::sin(frame * 0.1f + i), 0, 0);
+            rs->instance_set_transform(light_instances[i], xform);
+        }
+        VSG::scene->update_dirty_instances();
+        VSG::scene->take_shadow_cull_usec();
+
+        uint64_t begin = OS::get_singleton()->get_ticks_usec();
+        VSG::scene->render_camera(camera, scenario, VIEWPORT_SIZE, shadow_atlas);
+        uint64_t render_usec = OS::get_singleton()->get_ticks_usec() - begin;
+        uint64_t cull_usec = VSG::scene->take_shadow_cull_usec();
+
+        if (frame >= WARMUP_FRAMES) {
+            render_total += render_usec;
+            cull_total += cull_usec;
+            cull_min = MIN(cull_min, cull_usec);
+            cull_max = M_MAX(cull_max, cull_usec);
+        }
+    }
+
+    for (RenderingEntity instance : light_instances) {
+        rs->free_rid(instance);
+    }
+    for (RenderingEntity light : lights) {
+        rs->free_rid(light);
+    }
+    for (RenderingEntity instance : instances) {
+        rs->free_rid(instance);
+    }
+    VSG::storage->free(shadow_atlas);
+    rs->free_rid(camera);
+    rs->free_rid(mesh);
+    rs->free_rid(scenario);
+
+    Dictionary result;
+    result["lights"] = p_lights;
+    result["render_camera_avg_ms"] = render_total / 1000.0 / MEASURED_FRAMES;
+    result["shadow_cull_avg_ms"] = cull_total / 1000.0 / MEASURED_FRAMES;
+    result["shadow_cull_min_ms"] = cull_min / 1000.0;
+    result["shadow_cull_max_ms"] = cull_max / 1000.0;
+    return result;
+}
+
+} // namespace
+
+/// Measures how the time spent culling shadow casters grows with the number
+/// of shadowed lights and prints the results as JSON. The render calls are
+/// made from this thread, so the server must not run on its own thread.
+MainLoop *test() {
+
+    if (OS::get_singleton()->get_render_thread_mode() == OS::RENDER_SEPARATE_THREAD) {
+        OS::get_singleton()->printerr("shadow_cull_benchmark can't run with a separate render thread.\n");
+        return nullptr;
+    }
+
+    static const int light_counts[] = { 1, 10, 40, 80 };
+
+    Array results;
+    for (int lights : light_counts) {
+        results.push_back(run_scenario(lights));
+    }
+
+    Dictionary report;
+    report["frames"] = MEASURED_FRAMES;
+    report["instances"] = INSTANCES;
+    report["scenarios"] = results;
+    OS::get_singleton()->print(JSON::print(report, "  ") + "\n");
+
+    return nullptr;
+}
+
+} // namespace TestShadowCullBenchmark
@@ -0,0 +1,145 @@
+/*************************************************************************/
+/*  test_signal_dispatch.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_signal_dispatch.h"
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string_utils.h"
+#include "scene/main/node.h"
+
+#include <atomic>
+
+namespace TestSignalDispatch {
+
+namespace {
+
+constexpr int TARGETS = 64;
+constexpr int EMITS = 20000;
+
+// Callbacks that disconnect during an emit must not change who that emit reaches.
+bool test_disconnect_during_emit() {
+    Node *emitter = memnew(Node);
+    Object *targets[3];
+    int calls[3] = {};
+    for (int i = 0; i < 3; i++) {
+        targets[i] = memnew(Object);
+        int *count = &calls[i];
+        emitter->connectF("renamed", targets[i], [emitter, &targets, count]() {
+            (*count)++;
+            if (emitter->is_connected_any("renamed", targets[2]->get_instance_id())) {
+                emitter->disconnect_all("renamed", targets[2]->get_instance_id());
+            }
+        });
+    }
+
+    emitter->emit_signal("renamed");
+    emitter->emit_signal("renamed");
+    bool ok = calls[0] == 2 && calls[1] == 2 && calls[2] == 1;
+
+    memdelete(emitter);
+    for (Object *target : targets) {
+        memdelete(target);
+    }
+    return ok;
+}
+
+constexpr int EMIT_THREADS = 4;
+constexpr int EMITS_PER_THREAD = 2000;
+
+void emit_renamed(void *p_emitter) {
+    Object *emitter = (Object *)p_emitter;
+    for (int i = 0; i < EMITS_PER_THREAD; i++) {
+        emitter->emit_signal("renamed");
+    }
+}
+
+// Emits from several threads share the dispatch list, every one of them has to reach every target.
+bool test_concurrent_emits() {
+    Node *emitter = memnew(Node);
+    Object *targets[3];
+    std::atomic<int> calls { 0 };
+    for (Object *&target : targets) {
+        target = memnew(Object);
+        emitter->connectF("renamed", target, [&calls]() { calls.fetch_add(1, std::memory_order_relaxed); });
+    }
+
+    Thread threads[EMIT_THREADS];
+    for (Thread &thread : threads) {
+        thread.start(emit_renamed, emitter);
+    }
+    for (Thread &thread : threads) {
+        thread.wait_to_finish();
+    }
+    bool ok = calls.load() == EMIT_THREADS * EMITS_PER_THREAD * 3;
+
+    memdelete(emitter);
+    for (Object *target : targets) {
+        memdelete(target);
+    }
+    return ok;
+}
+
+uint64_t time_emits(Node *p_emitter) {
+    uint64_t start = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < EMITS; i++) {
+        p_emitter->emit_signal("renamed");
+    }
+    return OS::get_singleton()->get_ticks_usec() - start;
+}
+
+} // namespace
+
+MainLoop *test() {
+    bool ok = test_disconnect_during_emit();
+    OS::get_singleton()->print(String("signal_dispatch: disconnect during emit ") + (ok ? "OK\n" : "FAILED\n"));
+    ok = test_concurrent_emits();
+    OS::get_singleton()->print(String("signal_dispatch: concurrent emits ") + (ok ? "OK\n" : "FAILED\n"));
+
+    Node *emitter = memnew(Node);
+    Vector<Object *> targets;
+    for (int i = 0; i < TARGETS; i++) {
+        Object *target = memnew(Object);
+        emitter->connect("renamed", Callable(target, "property_list_changed_notify"));
+        targets.push_back(target);
+    }
+    uint64_t usec = time_emits(emitter);
+    OS::get_singleton()->print("signal_dispatch: " + itos(EMITS) + " emits to " + itos(TARGETS) + " bound methods in " +
+                               itos(usec / 1000) + " msec (" + ::to_string(double(usec) * 1000.0 / (EMITS * TARGETS)) +
+                               " nsec per call).\n");
+
+    memdelete(emitter);
+    for (Object *target : targets) {
+        memdelete(target);
+    }
+    return nullptr;
+}
+
+} // namespace TestSignalDispatch
@@ -0,0 +1,93 @@
+/*************************************************************************/
+/*  test_skeleton_pose.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_skeleton_pose.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "core/string_utils.h"
+#include "scene/3d/skeleton_3d.h"
+
+namespace TestSkeletonPose {
+
+namespace {
+
+constexpr int WARMUP_UPDATES = 10;
+constexpr int MEASURED_UPDATES = 100;
+
+/// Poses every bone of a skeleton shaped as a 4-ary tree and updates the
+/// global poses, returns the average update time in microseconds.
+double run_updates(int p_bone_count) {
+    Skeleton *skeleton = memnew(Skeleton);
+
+    for (int i = 0; i < p_bone_count; i++) {
+        skeleton->add_bone(String("bone_") + itos(i));
+        skeleton->set_bone_rest(i, Transform(Basis(), Vector3(0, 0.1f, 0)));
+        if (i > 0) {
+            skeleton->set_bone_parent(i, (i - 1) / 4);
+        }
+    }
+
+    uint64_t total_usec = 0;
+    for (int update = 0; update < WARMUP_UPDATES + MEASURED_UPDATES; update++) {
+        const float angle = update * 0.01f;
+        for (int i = 0; i < p_bone_count; i++) {
+            skeleton->set_bone_pose(i, Transform(Basis(Vector3(0, 1, 0), angle + i * 0.001f), Vector3()));
+        }
+
+        const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+        skeleton->notification(Skeleton::NOTIFICATION_UPDATE_SKELETON);
+        if (update >= WARMUP_UPDATES) {
+            total_usec += OS::get_singleton()->get_ticks_usec() - begin;
+        }
+    }
+
+    memdelete(skeleton);
+
+    return double(total_usec) / MEASURED_UPDATES;
+}
+
+} // namespace
+
+MainLoop *test() {
+
+    OS::get_singleton()->print("bones\tupdate (ms)\n");
+    static const int counts[] = { 100, 1000, 10000 };
+    for (int count : counts) {
+        const double usec = run_updates(count);
+        OS::get_singleton()->print(FormatVE("%d\t%.3f\n", count, usec / 1000.0));
+    }
+
+    return nullptr;
+}
+
+} // namespace TestSkeletonPose
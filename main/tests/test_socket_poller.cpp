@@ -0,0 +1,271 @@
+/*************************************************************************/
+/*  test_socket_poller.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_socket_poller.h"
+
+#include "core/array.h"
+#include "core/dictionary.h"
+#include "core/io/json.h"
+#include "core/io/net_socket_poller.h"
+#include "core/io/packet_peer_udp.h"
+#include "core/io/tcp_server.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/string_utils.h"
+#include "core/variant.h"
+
+namespace TestSocketPoller {
+
+namespace {
+
+// Every loopback connection costs two descriptors, keep well below the usual 1024 limit.
+constexpr int CLIENTS = 400;
+constexpr int ACTIVE_PER_FRAME = 8;
+constexpr int FRAMES = 500;
+constexpr int CONNECT_TIMEOUT_MSEC = 5000;
+constexpr uint16_t FIRST_PORT = 27900;
+constexpr int READY_TIMEOUT_MSEC = 1000;
+
+struct Connections {
+    Ref<TCP_Server> server;
+    Vector<Ref<StreamPeerTCP>> clients;
+    Vector<Ref<StreamPeerTCP>> accepted;
+};
+
+bool open_connections(Connections &r_conns) {
+    r_conns.server = make_ref_counted<TCP_Server>();
+    uint16_t port = FIRST_PORT;
+    while (r_conns.server->listen(port, IP_Address("127.0.0.1")) != OK) {
+        if (++port == FIRST_PORT + 20) {
+            OS::get_singleton()->printerr("socket_poller: no free port to listen on.\n");
+            return false;
+        }
+    }
+
+    for (int i = 0; i < CLIENTS; i++) {
+        Ref<StreamPeerTCP> client(make_ref_counted<StreamPeerTCP>());
+        if (client->connect_to_host(IP_Address("127.0.0.1"), port) != OK) {
+            OS::get_singleton()->printerr("socket_poller: connect failed after " + itos(i) + " clients.\n");
+            return false;
+        }
+        r_conns.clients.push_back(client);
+    }
+
+    uint64_t deadline = OS::get_singleton()->get_ticks_msec() + CONNECT_TIMEOUT_MSEC;
+    while (r_conns.accepted.size() < CLIENTS && OS::get_singleton()->get_ticks_msec() < deadline) {
+        while (r_conns.server->is_connection_available()) {
+            r_conns.accepted.push_back(r_conns.server->take_connection());
+        }
+        for (const Ref<StreamPeerTCP> &client : r_conns.clients) {
+            client->get_status();
+        }
+    }
+    if (r_conns.accepted.size() < CLIENTS) {
+        OS::get_singleton()->printerr("socket_poller: only " + itos(r_conns.accepted.size()) + " connections accepted.\n");
+        return false;
+    }
+    return true;
+}
+
+void send_from_random_clients(Connections &p_conns, RandomPCG &p_rng) {
+    static const uint8_t payload[16] = {};
+    for (int i = 0; i < ACTIVE_PER_FRAME; i++) {
+        p_conns.clients[p_rng.rand(CLIENTS)]->put_data(payload, sizeof(payload));
+    }
+}
+
+int drain(const Ref<StreamPeerTCP> &p_conn) {
+    uint8_t buffer[256];
+    int total = 0;
+    int read = 0;
+    do {
+        p_conn->get_partial_data(buffer, sizeof(buffer), read);
+        total += read;
+    } while (read == sizeof(buffer));
+    return total;
+}
+
+/// The old server loop: try to read from every connection, every frame.
+Dictionary run_per_socket(Connections &p_conns) {
+    RandomPCG rng(1);
+    uint64_t total_usec = 0;
+    int64_t received = 0;
+
+    for (int frame = 0; frame < FRAMES; frame++) {
+        send_from_random_clients(p_conns, rng);
+
+        uint64_t begin = OS::get_singleton()->get_ticks_usec();
+        for (const Ref<StreamPeerTCP> &conn : p_conns.accepted) {
+            received += drain(conn);
+        }
+        total_usec += OS::get_singleton()->get_ticks_usec() - begin;
+    }
+
+    Dictionary result;
+    result["mode"] = "per_socket";
+    result["frame_avg_usec"] = double(total_usec) / FRAMES;
+    result["bytes_received"] = received;
+    return result;
+}
+
+/// Registers every connection once and only reads from the ones reported ready.
+Dictionary run_poller(Connections &p_conns) {
+    Ref<NetSocketPoller> poller(NetSocketPoller::create(), DoNotAddRef);
+    for (int i = 0; i < p_conns.accepted.size(); i++) {
+        poller->add(i, p_conns.accepted[i]->get_socket(), NetSocketPoller::EVENT_IN);
+    }
+
+    RandomPCG rng(1);
+    Vector<NetSocketPoller::Event> events;
+    uint64_t total_usec = 0;
+    int64_t received = 0;
+    int64_t ready = 0;
+
+    for (int frame = 0; frame < FRAMES; frame++) {
+        send_from_random_clients(p_conns, rng);
+
+        uint64_t begin = OS::get_singleton()->get_ticks_usec();
+        events.clear();
+        poller->wait(events, 0);
+        for (const NetSocketPoller::Event &ev : events) {
+            received += drain(p_conns.accepted[ev.id]);
+        }
+        total_usec += OS::get_singleton()->get_ticks_usec() - begin;
+        ready += events.size();
+    }
+
+    Dictionary result;
+    result["mode"] = "poller";
+    result["frame_avg_usec"] = double(total_usec) / FRAMES;
+    result["bytes_received"] = received;
+    result["ready_avg"] = double(ready) / FRAMES;
+    return result;
+}
+
+/// Returns the ids the poller reports as readable.
+Vector<uint64_t> ready_ids(const Ref<NetSocketPoller> &p_poller, int p_timeout) {
+    Vector<NetSocketPoller::Event> events;
+    p_poller->wait(events, p_timeout);
+    Vector<uint64_t> ids;
+    for (const NetSocketPoller::Event &ev : events) {
+        if (ev.events & NetSocketPoller::EVENT_IN) {
+            ids.push_back(ev.id);
+        }
+    }
+    return ids;
+}
+
+bool check_ready(const char *p_step, const Vector<uint64_t> &p_ids, const Vector<uint64_t> &p_expected) {
+    if (p_ids == p_expected) {
+        return true;
+    }
+    OS::get_singleton()->printerr(String("socket_poller: wrong ready sockets ") + p_step + ".\n");
+    return false;
+}
+
+/// A TCP_Server listening socket is ready while a connection waits to be taken, a PacketPeerUDP socket while a
+/// datagram waits to be read.
+bool check_listen_and_udp() {
+    constexpr uint64_t LISTEN_ID = 0;
+    constexpr uint64_t UDP_ID = 1;
+
+    Ref<TCP_Server> server(make_ref_counted<TCP_Server>());
+    Ref<PacketPeerUDP> receiver(make_ref_counted<PacketPeerUDP>());
+    uint16_t port = FIRST_PORT;
+    while (server->listen(port, IP_Address("127.0.0.1")) != OK || receiver->listen(port, IP_Address("127.0.0.1")) != OK) {
+        server->stop();
+        receiver->close();
+        if (++port == FIRST_PORT + 20) {
+            OS::get_singleton()->printerr("socket_poller: no free port to listen on.\n");
+            return false;
+        }
+    }
+
+    Ref<NetSocketPoller> poller(NetSocketPoller::create(), DoNotAddRef);
+    poller->add(LISTEN_ID, server->get_socket(), NetSocketPoller::EVENT_IN);
+    poller->add(UDP_ID, receiver->get_socket(), NetSocketPoller::EVENT_IN);
+    bool ok = check_ready("while idle", ready_ids(poller, 0), {});
+
+    Ref<StreamPeerTCP> client(make_ref_counted<StreamPeerTCP>());
+    client->connect_to_host(IP_Address("127.0.0.1"), port);
+    ok = ok && check_ready("with a pending connection", ready_ids(poller, READY_TIMEOUT_MSEC), { LISTEN_ID });
+    Ref<StreamPeerTCP> accepted = server->take_connection();
+    ok = ok && check_ready("after taking the connection", ready_ids(poller, 0), {});
+
+    Ref<PacketPeerUDP> sender(make_ref_counted<PacketPeerUDP>());
+    sender->set_dest_address(IP_Address("127.0.0.1"), port);
+    static const uint8_t payload[16] = {};
+    sender->put_packet(payload, sizeof(payload));
+    ok = ok && check_ready("with a pending datagram", ready_ids(poller, READY_TIMEOUT_MSEC), { UDP_ID });
+    if (ok && receiver->get_available_packet_count() != 1) {
+        OS::get_singleton()->printerr("socket_poller: the datagram was not received.\n");
+        ok = false;
+    }
+    ok = ok && check_ready("after reading the datagram", ready_ids(poller, 0), {});
+
+    sender->close();
+    receiver->close();
+    server->stop();
+    return ok;
+}
+
+} // namespace
+
+/// Checks that the poller reports listening TCP and bound UDP sockets, then
+/// runs a loopback load test: CLIENTS connections of which a few send every
+/// frame, read on the server side either socket by socket or through a
+/// NetSocketPoller. Prints the results as JSON.
+MainLoop *test() {
+
+    if (!check_listen_and_udp()) {
+        return nullptr;
+    }
+
+    Connections conns;
+    if (!open_connections(conns)) {
+        return nullptr;
+    }
+
+    Array results;
+    results.push_back(run_per_socket(conns));
+    results.push_back(run_poller(conns));
+
+    Dictionary report;
+    report["clients"] = CLIENTS;
+    report["active_per_frame"] = ACTIVE_PER_FRAME;
+    report["frames"] = FRAMES;
+    report["results"] = results;
+    OS::get_singleton()->print(JSON::print(report, "  ") + "\n");
+
+    conns.server->stop();
+    return nullptr;
+}
+
+} // namespace TestSocketPoller
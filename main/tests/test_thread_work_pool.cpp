@@ -0,0 +1,162 @@
+/*************************************************************************/
+/*  test_thread_work_pool.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_thread_work_pool.h"
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/os/thread_work_pool.h"
+#include "core/string_utils.h"
+#include "core/vector.h"
+
+#include <atomic>
+
+namespace TestThreadWorkPool {
+
+namespace {
+
+constexpr int CALLERS = 4;
+constexpr int JOBS_PER_CALLER = 200;
+constexpr uint32_t ELEMENTS = 64;
+
+// Counts the visits of every element, a job must visit each of them exactly once.
+struct CountingJob {
+    Vector<std::atomic<int>> visits;
+    bool nested = false;
+
+    explicit CountingJob(bool p_nested = false) :
+            visits(ELEMENTS), nested(p_nested) {
+        reset();
+    }
+
+    void reset() {
+        for (std::atomic<int> &visit : visits) {
+            visit.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool check() const {
+        for (const std::atomic<int> &visit : visits) {
+            if (visit.load(std::memory_order_acquire) != 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void run(uint32_t p_index, void *p_unused) {
+        if (nested) {
+            // Runs on the calling worker, the pool is already taken.
+            CountingJob inner;
+            SharedThreadWorkPool::do_work(ELEMENTS, &inner, &CountingJob::run, (void *)nullptr);
+            if (!inner.check()) {
+                return;
+            }
+        }
+        visits[p_index].fetch_add(1, std::memory_order_acq_rel);
+    }
+};
+
+struct Caller {
+    Thread thread;
+    int failures = 0;
+};
+
+void call(void *p_userdata) {
+    Caller *caller = static_cast<Caller *>(p_userdata);
+    CountingJob job;
+    for (int i = 0; i < JOBS_PER_CALLER; i++) {
+        job.reset();
+        SharedThreadWorkPool::do_work(ELEMENTS, &job, &CountingJob::run, (void *)nullptr);
+        if (!job.check()) {
+            caller->failures++;
+        }
+    }
+}
+
+bool test_concurrent_callers() {
+    const uint64_t serial_before = SharedThreadWorkPool::get_serial_job_count();
+    Caller callers[CALLERS];
+    for (Caller &caller : callers) {
+        caller.thread.start(call, &caller);
+    }
+    int failures = 0;
+    for (Caller &caller : callers) {
+        caller.thread.wait_to_finish();
+        failures += caller.failures;
+    }
+    const uint64_t serial = SharedThreadWorkPool::get_serial_job_count() - serial_before;
+    OS::get_singleton()->print("thread_work_pool: " + itos(CALLERS * JOBS_PER_CALLER) + " jobs from " + itos(CALLERS) +
+                               " threads, " + ::to_string(serial) + " ran serially.\n");
+    return failures == 0;
+}
+
+bool test_nested_jobs() {
+    CountingJob job(true);
+    SharedThreadWorkPool::do_work(ELEMENTS, &job, &CountingJob::run, (void *)nullptr);
+    return job.check();
+}
+
+bool test_background_work() {
+    SharedThreadWorkPool::BackgroundWork background;
+    CountingJob background_job(true);
+    SharedThreadWorkPool::begin_background_work(background, ELEMENTS, &background_job, &CountingJob::run, (void *)nullptr);
+
+    // Either runs serially or takes the pool over once every background element was handed out.
+    CountingJob job;
+    SharedThreadWorkPool::do_work(ELEMENTS, &job, &CountingJob::run, (void *)nullptr);
+
+    SharedThreadWorkPool::end_background_work(background);
+    // Ending twice does nothing.
+    SharedThreadWorkPool::end_background_work(background);
+    return job.check() && background_job.check();
+}
+
+} // namespace
+
+MainLoop *test() {
+    bool ok = true;
+    if (!test_concurrent_callers()) {
+        OS::get_singleton()->printerr("thread_work_pool: concurrent callers missed or repeated elements.\n");
+        ok = false;
+    }
+    if (!test_nested_jobs()) {
+        OS::get_singleton()->printerr("thread_work_pool: nested jobs missed or repeated elements.\n");
+        ok = false;
+    }
+    if (!test_background_work()) {
+        OS::get_singleton()->printerr("thread_work_pool: background work missed or repeated elements.\n");
+        ok = false;
+    }
+    OS::get_singleton()->print(ok ? "thread_work_pool: OK\n" : "thread_work_pool: FAILED\n");
+    return nullptr;
+}
+
+} // namespace TestThreadWorkPool
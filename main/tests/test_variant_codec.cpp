@@ -0,0 +1,232 @@
+/*************************************************************************/
+/*  test_variant_codec.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_variant_codec.h"
+
+#include "core/array.h"
+#include "core/dictionary.h"
+#include "core/io/json.h"
+#include "core/io/marshalls.h"
+#include "core/math/vector3.h"
+#include "core/os/os.h"
+#include "core/pool_vector.h"
+#include "core/variant.h"
+
+namespace TestVariantCodec {
+
+namespace {
+
+constexpr int ITERATIONS = 100000;
+
+struct Payload {
+    const char *name;
+    Variant value;
+};
+
+Vector<Payload> make_payloads() {
+    Vector<Payload> payloads;
+
+    Array rpc;
+    rpc.push_back(42);
+    rpc.push_back(0.5f);
+    rpc.push_back(Vector3(1, 2, 3));
+    rpc.push_back(true);
+    payloads.push_back({ "rpc_small", rpc });
+
+    Dictionary state;
+    state["name"] = "player_1";
+    state["health"] = 100;
+    state["position"] = Vector3(10, 0, -4);
+    Array chat;
+    chat.push_back("hello there, this is a chat message");
+    chat.push_back(state);
+    payloads.push_back({ "string_dictionary", chat });
+
+    PoolVector<Vector3> points;
+    points.resize(256);
+    {
+        PoolVector<Vector3>::Write w = points.write();
+        for (int i = 0; i < 256; i++) {
+            w[i] = Vector3(i, i * 0.5f, -i);
+        }
+    }
+    payloads.push_back({ "vector3_array_256", points });
+
+    PoolVector<uint8_t> bytes;
+    bytes.resize(1024);
+    {
+        PoolVector<uint8_t>::Write w = bytes.write();
+        for (int i = 0; i < 1024; i++) {
+            w[i] = uint8_t(i * 31);
+        }
+    }
+    payloads.push_back({ "byte_array_1k", bytes });
+
+    return payloads;
+}
+
+/// Walks a message with VariantReader the way a receiver with a known
+/// schema would: containers by header, strings and packed arrays as views.
+float consume(VariantReader &p_reader) {
+    VariantType type;
+    if (p_reader.peek_type(type) != OK) {
+        return 0;
+    }
+
+    float sum = 0;
+    switch (type) {
+        case VariantType::ARRAY: {
+            int count;
+            p_reader.read_array_header(count);
+            for (int i = 0; i < count; i++) {
+                sum += consume(p_reader);
+            }
+        } break;
+        case VariantType::DICTIONARY: {
+            int count;
+            p_reader.read_dictionary_header(count);
+            for (int i = 0; i < count * 2; i++) {
+                sum += consume(p_reader);
+            }
+        } break;
+        case VariantType::STRING:
+        case VariantType::STRING_NAME: {
+            StringView str;
+            p_reader.read_string(str);
+            sum += str.size();
+        } break;
+        case VariantType::POOL_BYTE_ARRAY:
+        case VariantType::POOL_VECTOR3_ARRAY: {
+            PackedArrayView view;
+            p_reader.read_packed_array(view);
+            sum += view.count ? (type == VariantType::POOL_BYTE_ARRAY ? view.get_byte(view.count - 1) : view.get_vector3(view.count - 1).x) : 0;
+        } break;
+        default: {
+            Variant v;
+            p_reader.read(v);
+            sum += 1;
+        }
+    }
+    return sum;
+}
+
+double usec_per_message(uint64_t p_begin) {
+    return double(OS::get_singleton()->get_ticks_usec() - p_begin) / ITERATIONS;
+}
+
+Dictionary run_payload(const Payload &p_payload) {
+    Dictionary result;
+    result["payload"] = p_payload.name;
+
+    // Two pass encode into a fresh buffer, as the callers used to do.
+    Vector<uint8_t> legacy;
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < ITERATIONS; i++) {
+        int len;
+        encode_variant(p_payload.value, nullptr, len);
+        legacy.resize(len);
+        encode_variant(p_payload.value, legacy.data(), len);
+        if (i + 1 < ITERATIONS) {
+            legacy.set_capacity(0);
+        }
+    }
+    result["encode_variant_usec"] = usec_per_message(begin);
+
+    Vector<uint8_t> buffer;
+    VariantWriter writer(buffer);
+    begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < ITERATIONS; i++) {
+        writer.reset();
+        writer.write(p_payload.value);
+    }
+    result["variant_writer_usec"] = usec_per_message(begin);
+
+    int size = writer.get_position();
+    result["bytes"] = size;
+    result["identical"] = size == int(legacy.size()) && memcmp(buffer.data(), legacy.data(), size) == 0;
+
+    float sink = 0;
+    begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < ITERATIONS; i++) {
+        Variant v;
+        decode_variant(v, buffer.data(), size);
+        sink += v.get_type() == VariantType::NIL ? 0 : 1;
+    }
+    result["decode_variant_usec"] = usec_per_message(begin);
+
+    begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < ITERATIONS; i++) {
+        VariantReader reader(buffer.data(), size);
+        sink += consume(reader);
+    }
+    result["variant_reader_usec"] = usec_per_message(begin);
+    result["checksum"] = sink;
+
+    return result;
+}
+
+// A capped writer has to fail on an oversized value without growing its buffer past the cap.
+bool check_max_size() {
+    constexpr int MAX_SIZE = 64;
+    PoolVector<uint8_t> big;
+    big.resize(1024);
+
+    Vector<uint8_t> buffer;
+    VariantWriter writer(buffer);
+    writer.set_max_size(MAX_SIZE);
+    bool ok = writer.write(big) == ERR_OUT_OF_MEMORY && writer.is_overflowed() && int(buffer.size()) <= MAX_SIZE;
+
+    writer.reset();
+    ok = ok && writer.write(Vector3(1, 2, 3)) == OK && !writer.is_overflowed() && int(buffer.size()) <= MAX_SIZE;
+    return ok;
+}
+
+} // namespace
+
+/// Compares the two pass encode_variant()/decode_variant() pair against
+/// VariantWriter and VariantReader on typical RPC payloads, checks that both
+/// encoders produce the same bytes and prints the results as JSON.
+MainLoop *test() {
+
+    Array results;
+    for (const Payload &payload : make_payloads()) {
+        results.push_back(run_payload(payload));
+    }
+
+    Dictionary report;
+    report["iterations"] = ITERATIONS;
+    report["payloads"] = results;
+    report["max_size_enforced"] = check_max_size();
+    OS::get_singleton()->print(JSON::print(report, "  ") + "\n");
+
+    return nullptr;
+}
+
+} // namespace TestVariantCodec
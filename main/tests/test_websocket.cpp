@@ -0,0 +1,199 @@
+/*************************************************************************/
+/*  test_websocket.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_websocket.h"
+
+#include "core/class_db.h"
+#include "core/io/networked_multiplayer_peer.h"
+#include "core/os/os.h"
+#include "core/pool_vector.h"
+#include "core/reference.h"
+#include "core/string_utils.h"
+#include "core/variant.h"
+
+namespace TestWebSocket {
+
+namespace {
+
+constexpr int CLIENTS = 3;
+constexpr int TIMEOUT_MSEC = 5000;
+constexpr uint16_t FIRST_PORT = 27950;
+
+// The module classes are only reachable through ClassDB from here, tests link against core alone.
+Ref<RefCounted> create(const StringName &p_class) {
+    return Ref<RefCounted>(object_cast<RefCounted>(ClassDB::instance(p_class)));
+}
+
+struct Peers {
+    Ref<RefCounted> server;
+    Ref<RefCounted> clients[CLIENTS];
+
+    void poll() {
+        server->call_va("poll");
+        for (const Ref<RefCounted> &client : clients) {
+            if (client) {
+                client->call_va("poll");
+            }
+        }
+    }
+
+    // Polls everything until p_done returns true or the timeout runs out.
+    template <class F>
+    bool poll_until(F p_done) {
+        uint64_t deadline = OS::get_singleton()->get_ticks_msec() + TIMEOUT_MSEC;
+        while (OS::get_singleton()->get_ticks_msec() < deadline) {
+            poll();
+            if (p_done()) {
+                return true;
+            }
+            OS::get_singleton()->delay_usec(1000);
+        }
+        return false;
+    }
+};
+
+int status(const Ref<RefCounted> &p_peer) {
+    return p_peer->call_va("get_connection_status").as<int>();
+}
+
+bool connect_all(Peers &r_peers) {
+    r_peers.server = create("WebSocketServer");
+    uint16_t port = FIRST_PORT;
+    while (r_peers.server->call_va("listen", port, PoolVector<String>(), true).as<int>() != OK) {
+        if (++port == FIRST_PORT + 20) {
+            OS::get_singleton()->printerr("websocket: no free port to listen on.\n");
+            return false;
+        }
+    }
+
+    String url = "ws://127.0.0.1:" + itos(port);
+    for (Ref<RefCounted> &client : r_peers.clients) {
+        client = create("WebSocketClient");
+        if (client->call_va("connect_to_url", url, PoolVector<String>(), true).as<int>() != OK) {
+            OS::get_singleton()->printerr("websocket: connect_to_url failed.\n");
+            return false;
+        }
+    }
+
+    // A client only knows its id once the server sent it, by then both sides registered the peer.
+    return r_peers.poll_until([&r_peers]() {
+        for (const Ref<RefCounted> &client : r_peers.clients) {
+            if (status(client) != NetworkedMultiplayerPeer::CONNECTION_CONNECTED ||
+                    client->call_va("get_unique_id").as<int>() <= 1) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+// Client 0 broadcasts, the server relays one shared payload to the other clients.
+bool test_broadcast(Peers &p_peers) {
+    PoolVector<uint8_t> payload;
+    for (int i = 0; i < 64; i++) {
+        payload.push_back(uint8_t(i));
+    }
+    p_peers.clients[0]->call_va("set_target_peer", NetworkedMultiplayerPeer::TARGET_PEER_BROADCAST);
+    if (p_peers.clients[0]->call_va("put_packet", payload).as<int>() != OK) {
+        return false;
+    }
+
+    bool received = p_peers.poll_until([&p_peers]() {
+        for (int i = 1; i < CLIENTS; i++) {
+            if (p_peers.clients[i]->call_va("get_available_packet_count").as<int>() == 0) {
+                return false;
+            }
+        }
+        return true;
+    });
+    if (!received) {
+        return false;
+    }
+    for (int i = 1; i < CLIENTS; i++) {
+        PoolVector<uint8_t> packet = p_peers.clients[i]->call_va("get_packet").as<PoolVector<uint8_t>>();
+        if (packet.size() != payload.size() || memcmp(packet.read().ptr(), payload.read().ptr(), payload.size()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A client closes its side, the server has to drop the peer and free its wslay context.
+bool test_client_close(Peers &p_peers) {
+    int id = p_peers.clients[0]->call_va("get_unique_id").as<int>();
+    p_peers.clients[0]->call_va("disconnect_from_host");
+    bool closed = p_peers.poll_until([&p_peers, id]() {
+        return status(p_peers.clients[0]) == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED &&
+               !p_peers.server->call_va("has_peer", id).as<bool>();
+    });
+    p_peers.clients[0].unref();
+    return closed;
+}
+
+// The server goes away with clients still connected, they must all notice.
+bool test_server_stop(Peers &p_peers) {
+    p_peers.server->call_va("stop");
+    return p_peers.poll_until([&p_peers]() {
+        for (const Ref<RefCounted> &client : p_peers.clients) {
+            if (client && status(client) != NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+void report(const char *p_name, bool p_ok) {
+    OS::get_singleton()->print(String("websocket: ") + p_name + (p_ok ? " OK\n" : " FAILED\n"));
+}
+
+} // namespace
+
+/// Loopback round trip through WebSocketServer and WebSocketClient in
+/// multiplayer mode: connect, relay a broadcast, then close from either side.
+MainLoop *test() {
+
+    if (!ClassDB::class_exists("WebSocketServer")) {
+        OS::get_singleton()->print("websocket: module not built, skipped.\n");
+        return nullptr;
+    }
+
+    Peers peers;
+    bool ok = connect_all(peers);
+    report("connect", ok);
+    if (ok) {
+        report("broadcast", test_broadcast(peers));
+        report("client close", test_client_close(peers));
+        report("server stop", test_server_stop(peers));
+    }
+    return nullptr;
+}
+
+} // namespace TestWebSocket
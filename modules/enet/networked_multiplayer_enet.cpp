@@ -36,6 +36,7 @@
 #include "core/string_utils.inl"
 #include "core/string_formatter.h"
 #include "core/crypto/crypto.h"
+#include "core/hash_map.h"
 #include "EASTL/deque.h"
 
 #include <enet/enet.h>
@@ -56,8 +57,33 @@ struct NetworkedMultiplayerENet_Priv {
         ENetPacket *packet;
         int from;
         int channel;
+        int offset; // Where the 8 byte source/target header starts, non-zero inside coalesced frames.
+        int size;
     };
     Dequeue<Packet> incoming_packets;
+
+    // Coalesced frames put a marker in place of the target id, followed by
+    // [uint16 size][source][target][payload] entries for every packet carried.
+    static constexpr uint32_t FRAME_TARGET = 0x80000000;
+    enum {
+        FRAME_HEADER_SIZE = 8,
+        FRAME_ENTRY_HEADER_SIZE = 2 + 8,
+        FRAME_MTU_MARGIN = 64, // ENet protocol and command headers.
+    };
+    struct OutgoingFrame {
+        ENetPeer *peer;
+        int channel;
+        int flags;
+        int packets;
+        Vector<uint8_t> data;
+    };
+    // One frame per (peer, channel, flags), kept around between flushes so their buffers are reused.
+    Vector<OutgoingFrame> outgoing_frames;
+    HashMap<uint64_t, int> outgoing_frame_index;
+    Vector<eastl::pair<int, int>> frame_entries;
+    uint32_t frame_source = 0;
+    uint64_t coalesced_packets = 0;
+    uint64_t coalesced_frames = 0;
     Vector<uint8_t> src_compressor_mem;
     Vector<uint8_t> dst_compressor_mem;
 
@@ -103,17 +129,133 @@ public:
         }
 
         enet_host_destroy(host);
+        for (Packet &P : incoming_packets) {
+            _release_packet(P.packet);
+        }
         incoming_packets.clear();
+        outgoing_frames.clear();
+        outgoing_frame_index.clear();
         peer_map.clear();
     }
+    // Received ENet packets count the queued packets referencing them in userData,
+    // a coalesced frame stays alive until every packet it carried was consumed.
+    void _queue_packet(const Packet &p_packet) {
+        p_packet.packet->userData = (void *)((intptr_t)p_packet.packet->userData + 1);
+        incoming_packets.push_back(p_packet);
+    }
+    static void _release_packet(ENetPacket *p_packet) {
+        intptr_t refs = (intptr_t)p_packet->userData - 1;
+        p_packet->userData = (void *)refs;
+        if (refs <= 0) {
+            enet_packet_destroy(p_packet);
+        }
+    }
     void _pop_current_packet() {
         if (current_packet.packet) {
-            enet_packet_destroy(current_packet.packet);
+            _release_packet(current_packet.packet);
             current_packet.packet = nullptr;
             current_packet.from = 0;
             current_packet.channel = -1;
         }
     }
+    int _frame_budget() const {
+        return int(host->mtu) - FRAME_MTU_MARGIN;
+    }
+    bool _can_coalesce(int p_size) const {
+        return FRAME_HEADER_SIZE + FRAME_ENTRY_HEADER_SIZE + p_size <= _frame_budget();
+    }
+    static void _send_packet(ENetPeer *p_peer, int p_channel, ENetPacket *p_packet) {
+        // ENet only takes ownership of packets it accepted.
+        if (enet_peer_send(p_peer, p_channel, p_packet) < 0) {
+            enet_packet_destroy(p_packet);
+        }
+    }
+    void _send_frame(OutgoingFrame &p_frame) {
+        if (p_frame.packets == 0) {
+            return;
+        }
+        ENetPacket *packet;
+        if (p_frame.packets == 1) {
+            // A lone packet goes out as is, without the frame header.
+            const int ofs = FRAME_HEADER_SIZE + 2;
+            packet = enet_packet_create(&p_frame.data[ofs], p_frame.data.size() - ofs, p_frame.flags);
+        } else {
+            packet = enet_packet_create(p_frame.data.data(), p_frame.data.size(), p_frame.flags);
+            coalesced_packets += p_frame.packets;
+            coalesced_frames++;
+        }
+        _send_packet(p_frame.peer, p_frame.channel, packet);
+        p_frame.packets = 0;
+        p_frame.data.clear();
+    }
+    void _coalesce(ENetPeer *p_peer, int p_channel, int p_flags, uint32_t p_source, int p_target, const uint8_t *p_data, int p_size) {
+        const uint64_t key = (uint64_t(p_peer->incomingPeerID) << 32) | (uint64_t(p_channel & 0xFF) << 24) | uint64_t(p_flags & 0xFFFFFF);
+        auto E = outgoing_frame_index.find(key);
+        if (E == outgoing_frame_index.end()) {
+            E = outgoing_frame_index.emplace(key, int(outgoing_frames.size())).first;
+            outgoing_frames.push_back({ p_peer, p_channel, p_flags, 0, {} });
+        }
+        OutgoingFrame &frame = outgoing_frames[E->second];
+        const int entry_size = FRAME_ENTRY_HEADER_SIZE + p_size;
+        if (frame.packets && int(frame.data.size()) + entry_size > _frame_budget()) {
+            _send_frame(frame);
+        }
+        if (frame.packets == 0) {
+            frame.data.resize(FRAME_HEADER_SIZE);
+            encode_uint32(frame_source, &frame.data[0]);
+            encode_uint32(FRAME_TARGET, &frame.data[4]);
+        }
+        size_t ofs = frame.data.size();
+        frame.data.resize(ofs + entry_size);
+        encode_uint16(8 + p_size, &frame.data[ofs]);
+        encode_uint32(p_source, &frame.data[ofs + 2]);
+        encode_uint32(p_target, &frame.data[ofs + 6]);
+        memcpy(&frame.data[ofs + FRAME_ENTRY_HEADER_SIZE], p_data, p_size);
+        frame.packets++;
+    }
+    // p_data holds the source/target header followed by the payload.
+    void _relay_packet(ENetPeer *p_peer, int p_channel, int p_flags, const uint8_t *p_data, int p_size, bool p_coalesce) {
+        if (p_coalesce && _can_coalesce(p_size - 8)) {
+            _coalesce(p_peer, p_channel, p_flags, decode_uint32(&p_data[0]), decode_uint32(&p_data[4]), &p_data[8], p_size - 8);
+        } else {
+            if (p_coalesce) {
+                _flush_frames(); // Keep it behind what was queued before.
+            }
+            _send_packet(p_peer, p_channel, enet_packet_create(p_data, p_size, p_flags));
+        }
+    }
+    void _flush_frames() {
+        for (OutgoingFrame &F : outgoing_frames) {
+            _send_frame(F);
+        }
+    }
+    void _drop_frames(ENetPeer *p_peer) {
+        // ENet reuses peer slots, nothing queued for a gone peer may reach the next one.
+        for (OutgoingFrame &F : outgoing_frames) {
+            if (F.peer == p_peer) {
+                F.packets = 0;
+                F.data.clear();
+            }
+        }
+    }
+    // Splits a received packet into the (offset, size) ranges of the packets it carries.
+    bool _split_frame(ENetPacket *p_packet) {
+        frame_entries.clear();
+        if (decode_uint32(&p_packet->data[4]) != FRAME_TARGET) {
+            frame_entries.emplace_back(0, int(p_packet->dataLength));
+            return true;
+        }
+        size_t ofs = FRAME_HEADER_SIZE;
+        while (ofs < p_packet->dataLength) {
+            ERR_FAIL_COND_V(ofs + 2 > p_packet->dataLength, false);
+            int size = decode_uint16(&p_packet->data[ofs]);
+            ofs += 2;
+            ERR_FAIL_COND_V(size < 8 || ofs + size > p_packet->dataLength, false);
+            frame_entries.emplace_back(int(ofs), size);
+            ofs += size;
+        }
+        return true;
+    }
     void _setup_compressor();
 };
 #define D() ((NetworkedMultiplayerENet_Priv *)(private_data))
@@ -192,6 +334,8 @@ Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int
     server = true;
     refuse_connections = false;
     unique_id = 1;
+    D()->frame_source = unique_id;
+    D()->coalesced_packets = D()->coalesced_frames = 0;
     connection_status = CONNECTION_CONNECTED;
     return OK;
 }
@@ -244,6 +388,8 @@ Error NetworkedMultiplayerENet::create_client(StringView p_address, int p_port,
     address.port = p_port;
 
     unique_id = _gen_unique_id();
+    D()->frame_source = unique_id;
+    D()->coalesced_packets = D()->coalesced_frames = 0;
 
     // Initiate connection, allocating enough channels
     ENetPeer *peer = enet_host_connect(D()->host, &address, channel_count, unique_id);
@@ -273,6 +419,11 @@ void NetworkedMultiplayerENet::poll() {
             return;
     }
 
+    if (packet_coalescing) {
+        // Everything put since the last poll leaves as one frame per peer and channel.
+        D()->_flush_frames();
+    }
+
     ENetEvent event;
         int ret = enet_host_service(D()->host, &event, 0);
 
@@ -381,6 +532,7 @@ void NetworkedMultiplayerENet::poll() {
                 }
 
                 emit_signal("peer_disconnected", *id);
+                D()->_drop_frames(event.peer);
                 D()->peer_map.erase(*id);
                 memdelete(id);
             } break;
@@ -413,20 +565,35 @@ void NetworkedMultiplayerENet::poll() {
                     enet_packet_destroy(event.packet);
                 } else if (event.channelID < channel_count) {
 
-                    NetworkedMultiplayerENet_Priv::Packet packet;
-                    packet.packet = event.packet;
-
+                    ENetPacket *enet_packet = event.packet;
                     uint32_t *id = (uint32_t *)event.peer->data;
 
-                    ERR_CONTINUE(event.packet->dataLength < 8);
+                    if (enet_packet->dataLength < 8 || !D()->_split_frame(enet_packet)) {
+                        enet_packet_destroy(enet_packet);
+                        ERR_CONTINUE(true);
+                    }
 
-                    uint32_t source = decode_uint32(&event.packet->data[0]);
-                    int target = decode_uint32(&event.packet->data[4]);
+                    // Packets carried by a coalesced frame are relayed and queued exactly like standalone ones.
+                    bool forwarded = false;
+                    for (const eastl::pair<int, int> &entry : D()->frame_entries) {
 
-                    packet.from = source;
-                    packet.channel = event.channelID;
+                        NetworkedMultiplayerENet_Priv::Packet packet;
+                        packet.packet = enet_packet;
+                        packet.offset = entry.first;
+                        packet.size = entry.second;
+
+                        const uint8_t *data = &enet_packet->data[packet.offset];
+                        uint32_t source = decode_uint32(&data[0]);
+                        int target = decode_uint32(&data[4]);
+
+                        packet.from = source;
+                        packet.channel = event.channelID;
+
+                        if (!server) {
+                            D()->_queue_packet(packet);
+                            continue;
+                        }
 
-                    if (server) {
                         // Someone is cheating and trying to fake the source!
                         ERR_CONTINUE(source != *id);
 
@@ -434,57 +601,42 @@ void NetworkedMultiplayerENet::poll() {
 
                         if (target == 1) {
                             // To myself and only myself
-                            D()->incoming_packets.push_back(packet);
+                            D()->_queue_packet(packet);
                         } else if (!server_relay) {
                             // No other destination is allowed when server is not relaying
                             continue;
-                        } else if (target == 0) {
-                            // Re-send to everyone but sender :|
-
-                            D()->incoming_packets.push_back(packet);
-                            // And make copies for sending
-                            for (eastl::pair<const int,ENetPeer *> &E : D()->peer_map) {
-
-                                if (uint32_t(E.first) == source) // Do not resend to self
-                                    continue;
-
-                                ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
-
-                                enet_peer_send(E.second, event.channelID, packet2);
+                        } else if (target > 0) {
+                            // To someone else, specifically
+                            auto E = D()->peer_map.find(target);
+                            ERR_CONTINUE(E == D()->peer_map.end());
+                            if (!packet_coalescing && packet.size == int(enet_packet->dataLength)) {
+                                // Pass the whole packet along instead of copying it.
+                                NetworkedMultiplayerENet_Priv::_send_packet(E->second, event.channelID, enet_packet);
+                                forwarded = true;
+                            } else {
+                                D()->_relay_packet(E->second, event.channelID, enet_packet->flags, data, packet.size, packet_coalescing);
                             }
-
-                        } else if (target < 0) {
-                            // To all but one
-
-                            // And make copies for sending
+                        } else {
+                            // Re-send to everyone but the sender and, for negative targets, the excluded peer
                             for (eastl::pair<const int,ENetPeer *> &E : D()->peer_map) {
 
                                 if (uint32_t(E.first) == source || E.first == -target) // Do not resend to self, also do not send to excluded
                                     continue;
 
-                                ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
-
-                                enet_peer_send(E.second, event.channelID, packet2);
+                                D()->_relay_packet(E.second, event.channelID, enet_packet->flags, data, packet.size, packet_coalescing);
                             }
 
                             if (-target != 1) {
                                 // Server is not excluded
-                                D()->incoming_packets.push_back(packet);
-                            } else {
-                                // Server is excluded, erase packet
-                                enet_packet_destroy(packet.packet);
+                                D()->_queue_packet(packet);
                             }
-                        } else {
-                            // To someone else, specifically
-                            ERR_CONTINUE(!D()->peer_map.contains(target));
-                            enet_peer_send(D()->peer_map[target], event.channelID, packet.packet);
                         }
-                    } else {
-
-                        D()->incoming_packets.push_back(packet);
                     }
 
-                    // Destroy packet later
+                    // Queued packets destroy it later
+                    if (!forwarded && !enet_packet->userData) {
+                        enet_packet_destroy(enet_packet);
+                    }
                 } else {
                     ERR_CONTINUE(true);
                 }
@@ -495,6 +647,12 @@ void NetworkedMultiplayerENet::poll() {
             } break;
         }
     } while (enet_host_check_events(D()->host, &event) > 0);
+
+    if (packet_coalescing) {
+        // Don't hold relayed packets back until the next poll.
+        D()->_flush_frames();
+        enet_host_flush(D()->host);
+    }
 }
 
 bool NetworkedMultiplayerENet::is_server() const {
@@ -544,6 +702,7 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
             }
         }
         memdelete(id);
+        D()->_drop_frames(D()->peer_map[p_peer]);
 
         emit_signal("peer_disconnected", p_peer);
         D()->peer_map.erase(p_peer);
@@ -566,8 +725,8 @@ Error NetworkedMultiplayerENet::get_packet(const uint8_t **r_buffer, int &r_buff
     D()->current_packet = D()->incoming_packets.front();
     D()->incoming_packets.pop_front();
 
-    *r_buffer = (const uint8_t *)(&D()->current_packet.packet->data[8]);
-    r_buffer_size = D()->current_packet.packet->dataLength - 8;
+    *r_buffer = (const uint8_t *)(&D()->current_packet.packet->data[D()->current_packet.offset + 8]);
+    r_buffer_size = D()->current_packet.size - 8;
 
     return OK;
 }
@@ -618,6 +777,29 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
         ERR_FAIL_COND_V_MSG(E==D()->peer_map.end(), ERR_INVALID_PARAMETER, FormatVE("Invalid target peer '%d'.",target_peer));
     }
 
+    if (packet_coalescing) {
+        if (D()->_can_coalesce(p_buffer_size)) {
+            // Held back until the next poll(), sent as one frame per peer and channel.
+            if (!server) {
+                ERR_FAIL_COND_V(!D()->peer_map.contains(1), ERR_BUG);
+                D()->_coalesce(D()->peer_map[1], channel, packet_flags, unique_id, target_peer, p_buffer, p_buffer_size); // Send to server for broadcast
+            } else if (target_peer > 0) {
+                D()->_coalesce(E->second, channel, packet_flags, unique_id, target_peer, p_buffer, p_buffer_size);
+            } else {
+                for (eastl::pair<const int,ENetPeer *> &F : D()->peer_map) {
+
+                    if (F.first == -target_peer) // Exclude packet
+                        continue;
+
+                    D()->_coalesce(F.second, channel, packet_flags, unique_id, target_peer, p_buffer, p_buffer_size);
+                }
+            }
+            return OK;
+        }
+        // Too big to share a frame, keep it behind what was queued before.
+        D()->_flush_frames();
+    }
+
     ENetPacket *packet = enet_packet_create(nullptr, p_buffer_size + 8, packet_flags);
     encode_uint32(unique_id, &packet->data[0]); // Source ID
     encode_uint32(target_peer, &packet->data[4]); // Dest ID
@@ -894,6 +1076,26 @@ void NetworkedMultiplayerENet::set_server_relay_enabled(bool p_enabled) {
 bool NetworkedMultiplayerENet::is_server_relay_enabled() const {
     return server_relay;
 }
+
+void NetworkedMultiplayerENet::set_packet_coalescing_enabled(bool p_enabled) {
+    if (packet_coalescing && !p_enabled && active) {
+        D()->_flush_frames();
+        enet_host_flush(D()->host);
+    }
+    packet_coalescing = p_enabled;
+}
+
+bool NetworkedMultiplayerENet::is_packet_coalescing_enabled() const {
+    return packet_coalescing;
+}
+
+int64_t NetworkedMultiplayerENet::get_coalesced_packet_count() const {
+    return D()->coalesced_packets;
+}
+
+int64_t NetworkedMultiplayerENet::get_saved_packet_count() const {
+    return D()->coalesced_packets - D()->coalesced_frames;
+}
 void NetworkedMultiplayerENet::_bind_methods() {
 
     MethodBinder::bind_method(D_METHOD("create_server", {"port", "max_clients", "in_bandwidth", "out_bandwidth"}), &NetworkedMultiplayerENet::create_server, {DEFVAL(32), DEFVAL(0), DEFVAL(0)});
@@ -917,12 +1119,17 @@ void NetworkedMultiplayerENet::_bind_methods() {
     SE_BIND_METHOD(NetworkedMultiplayerENet,is_always_ordered);
     SE_BIND_METHOD(NetworkedMultiplayerENet,set_server_relay_enabled);
     SE_BIND_METHOD(NetworkedMultiplayerENet,is_server_relay_enabled);
+    SE_BIND_METHOD(NetworkedMultiplayerENet,set_packet_coalescing_enabled);
+    SE_BIND_METHOD(NetworkedMultiplayerENet,is_packet_coalescing_enabled);
+    SE_BIND_METHOD(NetworkedMultiplayerENet,get_coalesced_packet_count);
+    SE_BIND_METHOD(NetworkedMultiplayerENet,get_saved_packet_count);
 
     ADD_PROPERTY(PropertyInfo(VariantType::INT, "compression_mode", PropertyHint::Enum, "None,Range Coder,FastLZ,ZLib,ZStd"), "set_compression_mode", "get_compression_mode");
     ADD_PROPERTY(PropertyInfo(VariantType::INT, "transfer_channel"), "set_transfer_channel", "get_transfer_channel");
     ADD_PROPERTY(PropertyInfo(VariantType::INT, "channel_count"), "set_channel_count", "get_channel_count");
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "always_ordered"), "set_always_ordered", "is_always_ordered");
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+    ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "packet_coalescing"), "set_packet_coalescing_enabled", "is_packet_coalescing_enabled");
 
     BIND_ENUM_CONSTANT(COMPRESS_NONE);
     BIND_ENUM_CONSTANT(COMPRESS_RANGE_CODER);
@@ -937,6 +1144,7 @@ NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
     server = false;
     refuse_connections = false;
     server_relay = true;
+    packet_coalescing = false;
     unique_id = 0;
     target_peer = 0;
     transfer_mode = TRANSFER_MODE_RELIABLE;
@@ -76,6 +76,7 @@ private:
     bool always_ordered;
     bool refuse_connections;
     bool server_relay;
+    bool packet_coalescing;
 
 
     uint32_t _gen_unique_id() const;
@@ -133,6 +134,10 @@ public:
     bool is_always_ordered() const;
     void set_server_relay_enabled(bool p_enabled);
     bool is_server_relay_enabled() const;
+    void set_packet_coalescing_enabled(bool p_enabled);
+    bool is_packet_coalescing_enabled() const;
+    int64_t get_coalesced_packet_count() const;
+    int64_t get_saved_packet_count() const;
 
     NetworkedMultiplayerENet();
     ~NetworkedMultiplayerENet() override;
@@ -115,6 +115,7 @@ GodotNavigationServer::GodotNavigationServer() {}
 
 GodotNavigationServer::~GodotNavigationServer() {
     flush_queries();
+    SharedThreadWorkPool::end_background_work(path_query_work);
 }
 
 void GodotNavigationServer::add_command(SetCommand *command) const {
@@ -258,6 +259,125 @@ RID GodotNavigationServer::map_get_closest_point_owner(RID p_map, const Vector3
 
     return map->get_closest_point_owner(p_point);
 }
+uint32_t GodotNavigationServer::map_query_path_async(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Callable &&p_callback) const {
+    PathQuery query;
+    query.map = p_map;
+    query.origin = p_origin;
+    query.destination = p_destination;
+    query.optimize = p_optimize;
+    query.navigation_layers = p_navigation_layers;
+    query.callback = eastl::move(p_callback);
+
+    MutexLock lock(path_queries_mutex);
+    // Zero is never handed out, so it can be used as an invalid id.
+    if (++last_path_query_id == 0) {
+        ++last_path_query_id;
+    }
+    query.id = last_path_query_id;
+    queued_path_queries.emplace_back(eastl::move(query));
+    return last_path_query_id;
+}
+
+bool GodotNavigationServer::path_query_is_done(uint32_t p_query) const {
+    MutexLock lock(path_queries_mutex);
+    return finished_path_queries.contains(p_query);
+}
+
+Vector<Vector3> GodotNavigationServer::path_query_take_result(uint32_t p_query) const {
+    MutexLock lock(path_queries_mutex);
+    auto iter = finished_path_queries.find(p_query);
+    ERR_FAIL_COND_V_MSG(iter == finished_path_queries.end(), Vector<Vector3>(), "The path query is not done or its result was already taken.");
+    Vector<Vector3> result = eastl::move(iter->second.result);
+    finished_path_queries.erase(iter);
+    return result;
+}
+
+void GodotNavigationServer::path_query_free(uint32_t p_query) const {
+    MutexLock lock(path_queries_mutex);
+    if (finished_path_queries.erase(p_query)) {
+        return;
+    }
+    auto iter = eastl::find_if(queued_path_queries.begin(), queued_path_queries.end(), [p_query](const PathQuery &p_entry) { return p_entry.id == p_query; });
+    if (iter != queued_path_queries.end()) {
+        queued_path_queries.erase(iter);
+        return;
+    }
+    // Running, or already gone: the set is cleared when the running batch finishes.
+    freed_path_queries.insert(p_query);
+}
+
+void GodotNavigationServer::_compute_path_query(uint32_t p_index, PathQuery *p_queries) {
+    PathQuery &query = p_queries[p_index];
+    if (query.snapshot) {
+        query.result = query.snapshot->get_path(query.origin, query.destination, query.optimize, query.navigation_layers);
+    }
+}
+
+void GodotNavigationServer::_dispatch_path_queries() {
+    ERR_FAIL_COND(!running_path_queries.empty());
+    {
+        MutexLock lock(path_queries_mutex);
+        if (queued_path_queries.empty()) {
+            return;
+        }
+        running_path_queries.swap(queued_path_queries);
+    }
+
+    // The snapshots are taken here, so every query of a batch sees the maps as
+    // they were at the sync of this frame.
+    for (PathQuery &query : running_path_queries) {
+        const NavMap *map = map_owner.getornull(query.map);
+        if (map != nullptr) {
+            query.snapshot = map->get_snapshot();
+        }
+    }
+
+    SharedThreadWorkPool::begin_background_work(path_query_work, running_path_queries.size(), this, &GodotNavigationServer::_compute_path_query, running_path_queries.data());
+}
+
+void GodotNavigationServer::_finish_path_queries() {
+    if (running_path_queries.empty()) {
+        return;
+    }
+    SharedThreadWorkPool::end_background_work(path_query_work);
+
+    {
+        MutexLock lock(path_queries_mutex);
+        for (PathQuery &query : running_path_queries) {
+            if (freed_path_queries.contains(query.id)) {
+                query.id = 0; // Freed while running, neither stored nor called back.
+            } else if (!query.callback.is_valid()) {
+                finished_path_queries[query.id] = { eastl::move(query.result), path_query_frame };
+            }
+        }
+        freed_path_queries.clear();
+    }
+
+    for (PathQuery &query : running_path_queries) {
+        if (query.id == 0 || !query.callback.is_valid() || query.callback.get_object() == nullptr) {
+            continue;
+        }
+        Callable::CallError call_error;
+        Variant ret;
+        Variant query_id = query.id;
+        Variant path = query.result;
+        const Variant *args[2] = { &query_id, &path };
+        query.callback.call(args, 2, ret, call_error);
+    }
+    running_path_queries.clear();
+}
+
+void GodotNavigationServer::_expire_path_queries() {
+    MutexLock lock(path_queries_mutex);
+    for (auto iter = finished_path_queries.begin(); iter != finished_path_queries.end();) {
+        if (path_query_frame - iter->second.frame > PATH_QUERY_RESULT_FRAMES) {
+            iter = finished_path_queries.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
 Array GodotNavigationServer::map_get_regions(RID p_map) const {
     Array regions_rids;
     const NavMap *map = map_owner.getornull(p_map);
@@ -408,6 +528,15 @@ void GodotNavigationServer::region_bake_navmesh(Ref<NavigationMesh> r_mesh, Node
 #endif
 }
 
+void GodotNavigationServer::region_rebake_navmesh(Ref<NavigationMesh> r_mesh, Node *p_node, const AABB &p_region) const {
+    ERR_FAIL_COND(!r_mesh);
+    ERR_FAIL_COND(p_node == nullptr);
+
+#ifndef _3D_DISABLED
+    NavigationMeshGenerator::get_singleton()->rebake_region(r_mesh, p_node, p_region);
+#endif
+}
+
 int GodotNavigationServer::region_get_connections_count(RID p_region) const {
     NavRegion *region = region_owner.getornull(p_region);
     ERR_FAIL_COND_V(!region, 0);
@@ -647,24 +776,30 @@ void GodotNavigationServer::map_force_update(RID p_map) {
 
 void GodotNavigationServer::process(real_t p_delta_time) {
     SCOPE_AUTONAMED;
+    // Collect the path queries dispatched during the previous frame first, so
+    // the commands issued by their callbacks are applied in this frame.
+    path_query_frame++;
+    _finish_path_queries();
+    _expire_path_queries();
     flush_queries();
 
-    if (!active) {
-        return;
-    }
-
-    // With c++ we can't be 100% sure this is called in single thread so use the mutex.
-    MutexLock lock(operations_mutex);
-    for (uint32_t i(0); i < active_maps.size(); i++) {
-        active_maps[i]->sync();
-        active_maps[i]->step(p_delta_time);
-        active_maps[i]->dispatch_callbacks();
-        const uint32_t new_map_update_id = active_maps[i]->get_map_update_id();
-        if (new_map_update_id != active_maps_update_id[i]) {
-            emit_signal("map_changed", active_maps[i]->get_self());
-            active_maps_update_id[i] = new_map_update_id;
+    if (active) {
+        // With c++ we can't be 100% sure this is called in single thread so use the mutex.
+        MutexLock lock(operations_mutex);
+        for (uint32_t i(0); i < active_maps.size(); i++) {
+            active_maps[i]->sync();
+            active_maps[i]->step(p_delta_time);
+            active_maps[i]->dispatch_callbacks();
+            const uint32_t new_map_update_id = active_maps[i]->get_map_update_id();
+            if (new_map_update_id != active_maps_update_id[i]) {
+                emit_signal("map_changed", active_maps[i]->get_self());
+                active_maps_update_id[i] = new_map_update_id;
+            }
         }
     }
+
+    // Runs on the worker threads until the next call to `process`.
+    _dispatch_path_queries();
 }
 
 #undef COMMAND_1
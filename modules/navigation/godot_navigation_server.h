@@ -30,10 +30,13 @@
 
 #pragma once
 
+#include "core/hash_map.h"
+#include "core/hash_set.h"
 #include "core/rid.h"
 //#include "core/rid_owner.h"
 #include "servers/navigation_server.h"
 #include "core/os/mutex.h"
+#include "core/os/thread_work_pool.h"
 #include "core/rid.h"
 #include "nav_map.h"
 #include "nav_region.h"
@@ -64,6 +67,26 @@ struct SetCommand {
 };
 
 class GodotNavigationServer : public NavigationServer {
+    struct PathQuery {
+        uint32_t id = 0;
+        RID map;
+        eastl::shared_ptr<const NavMapSnapshot> snapshot;
+        Vector3 origin;
+        Vector3 destination;
+        bool optimize = true;
+        uint32_t navigation_layers = 1;
+        Callable callback;
+        Vector<Vector3> result;
+    };
+
+    struct FinishedPathQuery {
+        Vector<Vector3> result;
+        uint64_t frame; // path_query_frame when the query finished
+    };
+
+    /// Polled results that are not taken within this many frames are dropped.
+    static constexpr uint64_t PATH_QUERY_RESULT_FRAMES = 600;
+
     mutable Mutex commands_mutex;
     /// Mutex used to make any operation threadsafe.
     mutable Mutex operations_mutex;
@@ -78,6 +101,23 @@ class GodotNavigationServer : public NavigationServer {
     Vector<NavMap *> active_maps;
     Vector<uint32_t> active_maps_update_id;
 
+    /// Guards the queued and the finished path queries.
+    mutable Mutex path_queries_mutex;
+    mutable uint32_t last_path_query_id = 0;
+    mutable Vector<PathQuery> queued_path_queries;
+    mutable HashMap<uint32_t, FinishedPathQuery> finished_path_queries;
+    /// Ids freed while their query may be running, dropped when the batch finishes.
+    mutable HashSet<uint32_t> freed_path_queries;
+    /// Only accessed by the main thread and, until `path_query_work` ends, by the workers.
+    Vector<PathQuery> running_path_queries;
+    SharedThreadWorkPool::BackgroundWork path_query_work;
+    uint64_t path_query_frame = 0;
+
+    void _compute_path_query(uint32_t p_index, PathQuery *p_queries);
+    void _dispatch_path_queries();
+    void _finish_path_queries();
+    void _expire_path_queries();
+
 public:
     GodotNavigationServer();
     virtual ~GodotNavigationServer();
@@ -107,6 +147,11 @@ public:
     Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const override;
     RID map_get_closest_point_owner(RID p_map, const Vector3 &p_point) const override;
 
+    uint32_t map_query_path_async(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Callable &&p_callback) const override;
+    bool path_query_is_done(uint32_t p_query) const override;
+    Vector<Vector3> path_query_take_result(uint32_t p_query) const override;
+    void path_query_free(uint32_t p_query) const override;
+
     Array map_get_regions(RID p_map) const override;
     Array map_get_agents(RID p_map) const override;
 
@@ -127,6 +172,7 @@ public:
     COMMAND_2(region_set_transform, RID, p_region, Transform, p_transform);
     COMMAND_2(region_set_navmesh, RID, p_region, Ref<NavigationMesh>, p_nav_mesh);
     void region_bake_navmesh(Ref<NavigationMesh> r_mesh, Node *p_node) const override;
+    void region_rebake_navmesh(Ref<NavigationMesh> r_mesh, Node *p_node, const AABB &p_region) const override;
 
     int region_get_connections_count(RID p_region) const override;
     Vector3 region_get_connection_pathway_start(RID p_region, int p_connection_id) const override;
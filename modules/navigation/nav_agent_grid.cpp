@@ -0,0 +1,196 @@
+/*************************************************************************/
+/*  nav_agent_grid.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_agent_grid.h"
+
+#include "core/math/math_funcs.h"
+
+#include <rvo2/Agent.h>
+
+namespace {
+/// Number of candidates tested at once by the distance pass.
+constexpr uint32_t DISTANCE_BATCH = 64;
+/// 21 bits per axis, enough for a million cells in each direction.
+constexpr int64_t CELL_KEY_BIAS = 1 << 20;
+constexpr uint64_t CELL_KEY_MASK = (1 << 21) - 1;
+} // namespace
+
+uint64_t NavAgentGrid::get_cell_key(int p_x, int p_y, int p_z) const {
+    const uint64_t x = uint64_t(p_x + CELL_KEY_BIAS) & CELL_KEY_MASK;
+    const uint64_t y = uint64_t(p_y + CELL_KEY_BIAS) & CELL_KEY_MASK;
+    const uint64_t z = uint64_t(p_z + CELL_KEY_BIAS) & CELL_KEY_MASK;
+    return x | (y << 21) | (z << 42);
+}
+
+uint64_t NavAgentGrid::get_cell_key(float p_x, float p_y, float p_z) const {
+    return get_cell_key(
+            int(Math::floor(p_x / cell_size)),
+            int(Math::floor(p_y / cell_size)),
+            int(Math::floor(p_z / cell_size)));
+}
+
+float NavAgentGrid::get_max_neighbor_dist() const {
+    float max_dist = 0.0;
+    for (const RVO::Agent *agent : agents) {
+        if (agent->maxNeighbors_ > 0) {
+            max_dist = M_MAX(max_dist, agent->neighborDist_);
+        }
+    }
+    return max_dist;
+}
+
+void NavAgentGrid::insert(uint32_t p_slot, uint64_t p_key) {
+    const RVO::Vector3 &pos = agents[p_slot]->position_;
+    Cell &cell = cells[p_key];
+    entries[p_slot].cell = p_key;
+    entries[p_slot].index = cell.slots.size();
+    cell.x.push_back(pos.x());
+    cell.y.push_back(pos.y());
+    cell.z.push_back(pos.z());
+    cell.slots.push_back(p_slot);
+}
+
+void NavAgentGrid::remove(uint32_t p_slot) {
+    auto it = cells.find(entries[p_slot].cell);
+    Cell &cell = it->second;
+    const uint32_t index = entries[p_slot].index;
+    const uint32_t last = cell.slots.size() - 1;
+    if (index != last) {
+        cell.x[index] = cell.x[last];
+        cell.y[index] = cell.y[last];
+        cell.z[index] = cell.z[last];
+        cell.slots[index] = cell.slots[last];
+        entries[cell.slots[index]].index = index;
+    }
+    cell.x.pop_back();
+    cell.y.pop_back();
+    cell.z.pop_back();
+    cell.slots.pop_back();
+    if (cell.slots.empty()) {
+        cells.erase(it);
+    }
+}
+
+void NavAgentGrid::rebuild() {
+    const float max_dist = get_max_neighbor_dist();
+    cell_size = max_dist > CMP_EPSILON ? max_dist : 1.0f;
+
+    cells.clear();
+    entries.resize(agents.size());
+    for (uint32_t i = 0; i < agents.size(); i++) {
+        const RVO::Vector3 &pos = agents[i]->position_;
+        insert(i, get_cell_key(pos.x(), pos.y(), pos.z()));
+    }
+}
+
+void NavAgentGrid::set_agents(Vector<RVO::Agent *> &&p_agents) {
+    agents = eastl::move(p_agents);
+    rebuild();
+}
+
+void NavAgentGrid::update() {
+    // A cell must cover the biggest neighbor distance, while cells too big
+    // make each query test many far agents.
+    const float max_dist = get_max_neighbor_dist();
+    if (max_dist > cell_size || (max_dist > CMP_EPSILON && max_dist < cell_size * 0.5f)) {
+        rebuild();
+        return;
+    }
+
+    for (uint32_t i = 0; i < agents.size(); i++) {
+        const RVO::Vector3 &pos = agents[i]->position_;
+        const uint64_t key = get_cell_key(pos.x(), pos.y(), pos.z());
+        if (key == entries[i].cell) {
+            Cell &cell = cells.find(key)->second;
+            const uint32_t index = entries[i].index;
+            cell.x[index] = pos.x();
+            cell.y[index] = pos.y();
+            cell.z[index] = pos.z();
+        } else {
+            remove(i);
+            insert(i, key);
+        }
+    }
+}
+
+void NavAgentGrid::compute_agent_neighbors(RVO::Agent *p_agent) const {
+    p_agent->agentNeighbors_.clear();
+    if (p_agent->maxNeighbors_ == 0) {
+        return;
+    }
+
+    const RVO::Vector3 &pos = p_agent->position_;
+    const float range = p_agent->neighborDist_;
+    float range_sq = range * range;
+
+    const int from_x = int(Math::floor((pos.x() - range) / cell_size));
+    const int from_y = int(Math::floor((pos.y() - range) / cell_size));
+    const int from_z = int(Math::floor((pos.z() - range) / cell_size));
+    const int to_x = int(Math::floor((pos.x() + range) / cell_size));
+    const int to_y = int(Math::floor((pos.y() + range) / cell_size));
+    const int to_z = int(Math::floor((pos.z() + range) / cell_size));
+
+    float dist_sq[DISTANCE_BATCH];
+
+    for (int cx = from_x; cx <= to_x; cx++) {
+        for (int cy = from_y; cy <= to_y; cy++) {
+            for (int cz = from_z; cz <= to_z; cz++) {
+                auto it = cells.find(get_cell_key(cx, cy, cz));
+                if (it == cells.end()) {
+                    continue;
+                }
+                const Cell &cell = it->second;
+                const uint32_t count = cell.slots.size();
+                const float *xs = cell.x.data();
+                const float *ys = cell.y.data();
+                const float *zs = cell.z.data();
+
+                for (uint32_t begin = 0; begin < count; begin += DISTANCE_BATCH) {
+                    const uint32_t batch = MIN(DISTANCE_BATCH, count - begin);
+
+                    // Branchless, so the compiler can vectorize it.
+                    for (uint32_t i = 0; i < batch; i++) {
+                        const float dx = xs[begin + i] - pos.x();
+                        const float dy = ys[begin + i] - pos.y();
+                        const float dz = zs[begin + i] - pos.z();
+                        dist_sq[i] = dx * dx + dy * dy + dz * dz;
+                    }
+
+                    for (uint32_t i = 0; i < batch; i++) {
+                        if (dist_sq[i] < range_sq) {
+                            // Shrinks `range_sq` once the neighbor list is full.
+                            p_agent->insertAgentNeighbor(agents[cell.slots[begin + i]], range_sq);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/*************************************************************************/
+/*  nav_agent_grid.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/hash_map.h"
+#include "core/vector.h"
+
+namespace RVO {
+class Agent;
+}
+
+/// Uniform spatial hash used to find the avoidance neighbors of the agents.
+/// The cell size follows the biggest neighbor distance, so each query only
+/// visits the cells adjacent to the agent one.
+/// Each cell stores the positions of its agents in separated arrays so the
+/// distance test can run on the whole cell at once.
+class NavAgentGrid {
+    struct Cell {
+        Vector<float> x;
+        Vector<float> y;
+        Vector<float> z;
+        Vector<uint32_t> slots;
+    };
+
+    struct Entry {
+        uint64_t cell = 0;
+        uint32_t index = 0;
+    };
+
+    float cell_size = 1.0;
+    Vector<RVO::Agent *> agents;
+    Vector<Entry> entries;
+    HashMap<uint64_t, Cell> cells;
+
+    uint64_t get_cell_key(int p_x, int p_y, int p_z) const;
+    uint64_t get_cell_key(float p_x, float p_y, float p_z) const;
+    float get_max_neighbor_dist() const;
+    void insert(uint32_t p_slot, uint64_t p_key);
+    void remove(uint32_t p_slot);
+    void rebuild();
+
+public:
+    /// Replaces the tracked agents, all the cells are rebuilt.
+    void set_agents(Vector<RVO::Agent *> &&p_agents);
+
+    /// Moves the agents that changed cell since the last call, the others
+    /// only refresh their stored position.
+    void update();
+
+    /// Fills `agentNeighbors_` of the given agent, as `Agent::computeNeighbors` does.
+    /// Thread safe as long as `update` is not running.
+    void compute_agent_neighbors(RVO::Agent *p_agent) const;
+};
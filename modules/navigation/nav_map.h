@@ -33,9 +33,11 @@
 #include "nav_rid.h"
 
 #include "core/math/math_defs.h"
+#include "core/os/mutex.h"
 #include "core/os/thread_work_pool.h"
+#include "nav_agent_grid.h"
+#include "nav_map_snapshot.h"
 #include "nav_utils.h"
-#include <rvo2/KdTree.h>
 
 
 class NavRegion;
@@ -60,11 +62,13 @@ class NavMap : public NavRid {
 
     Vector<NavRegion *> regions;
 
-    /// Map polygons
-    Vector<gd::Polygon> polygons;
+    /// Read only view of the map used by the queries, replaced on each `sync`
+    /// that changes the polygons or the region properties.
+    eastl::shared_ptr<const NavMapSnapshot> snapshot;
+    mutable Mutex snapshot_mutex;
 
-    /// Rvo world
-    RVO::KdTree rvo;
+    /// Rvo world, the agents neighbors are searched in this grid
+    NavAgentGrid agent_grid;
 
     /// Is agent array modified?
     bool agents_dirty = false;
@@ -116,6 +120,9 @@ public:
     gd::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
     RID get_closest_point_owner(const Vector3 &p_point) const;
 
+    /// Thread safe, the returned snapshot stays valid after the map is synced again.
+    eastl::shared_ptr<const NavMapSnapshot> get_snapshot() const;
+
     void add_region(NavRegion *p_region);
     void remove_region(NavRegion *p_region);
     const Vector<NavRegion *> &get_regions() const {
@@ -142,6 +149,5 @@ public:
 
 private:
     void compute_single_step(uint32_t index, RvoAgent **agent);
-    void clip_path(const Vector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const;
 };
 
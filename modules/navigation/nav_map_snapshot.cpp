@@ -0,0 +1,466 @@
+/*************************************************************************/
+/*  nav_map_snapshot.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_map_snapshot.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry.h"
+#include "core/list.h"
+
+#define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
+
+NavMapSnapshot::NavMapSnapshot(Vector3 p_up, uint32_t p_map_update_id, eastl::shared_ptr<const PolygonSet> p_polygon_set, Vector<Region> &&p_regions) :
+        up(p_up),
+        map_update_id(p_map_update_id),
+        polygon_set(eastl::move(p_polygon_set)),
+        regions(eastl::move(p_regions)) {
+}
+
+Vector<Vector3> NavMapSnapshot::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const {
+
+    const gd::Polygon *begin_poly = nullptr;
+    const gd::Polygon *end_poly = nullptr;
+    Vector3 begin_point;
+    Vector3 end_point;
+    float begin_d = 1e20f;
+    float end_d = 1e20f;
+
+    if (!polygon_set) {
+        return {};
+    }
+    const Vector<gd::Polygon> &polygons = polygon_set->polygons;
+
+    // Find the initial poly and the end poly on this map.
+    for (size_t i(0); i < polygons.size(); i++) {
+        const gd::Polygon &p = polygons[i];
+        if ((p_navigation_layers & get_region(&p).navigation_layers) == 0) {
+            continue;
+        }
+
+        // For each face check the distance between the origin/destination
+        for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+            const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+
+            Vector3 point = face.get_closest_point_to(p_origin);
+            float distance_to_point = point.distance_to(p_origin);
+            if (distance_to_point < begin_d) {
+                begin_d = distance_to_point;
+                begin_poly = &p;
+                begin_point = point;
+            }
+
+            point = face.get_closest_point_to(p_destination);
+            distance_to_point = point.distance_to(p_destination);
+            if (distance_to_point < end_d) {
+                end_d = distance_to_point;
+                end_poly = &p;
+                end_point = point;
+            }
+        }
+    }
+
+    if (!begin_poly || !end_poly) {
+        // No path
+        return {};
+    }
+
+    if (begin_poly == end_poly) {
+        Vector<Vector3> path {
+            begin_point,
+            end_point
+        };
+        return path;
+    }
+
+    Vector<gd::NavigationPoly> navigation_polys;
+    navigation_polys.reserve(size_t(polygons.size() * 0.75f));
+
+    // Add the start polygon to the reachable navigation polygons.
+    gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
+    begin_navigation_poly.self_id = 0;
+    begin_navigation_poly.entry = begin_point;
+    begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
+    begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
+    navigation_polys.push_back(begin_navigation_poly);
+
+    // List of polygon IDs to visit.
+    List<uint32_t> to_visit;
+    to_visit.push_back(0);
+
+    // This is an implementation of the A* algorithm.
+    int least_cost_id = 0;
+    bool found_route = false;
+
+    const gd::Polygon *reachable_end = nullptr;
+    float reachable_d = 1e30f;
+    bool is_reachable = true;
+
+    gd::NavigationPoly *prev_least_cost_poly = nullptr;
+
+    while (true) {
+        // Takes the current least_cost_poly neighbors (iterating over its edges) and compute the traveled_distance.
+        for (size_t i = 0; i < navigation_polys[least_cost_id].poly->edges.size(); i++) {
+            gd::NavigationPoly *least_cost_poly = &navigation_polys[least_cost_id];
+
+            const gd::Edge &edge = least_cost_poly->poly->edges[i];
+            // Takes the current least_cost_poly neighbors and compute the traveled_distance of each
+
+            for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+                const gd::Edge::Connection &connection = edge.connections[connection_index];
+
+                // Only consider the connection to another polygon if this polygon is in a region with compatible layers.
+                if ((p_navigation_layers & get_region(connection.polygon).navigation_layers) == 0) {
+                    continue;
+                }
+
+                float region_enter_cost = 0.0;
+                float region_travel_cost = get_region(least_cost_poly->poly).travel_cost;
+
+                if (prev_least_cost_poly != nullptr && prev_least_cost_poly->poly->owner != least_cost_poly->poly->owner) {
+                    region_enter_cost = get_region(least_cost_poly->poly).enter_cost;
+                }
+                prev_least_cost_poly = least_cost_poly;
+
+                Vector3 pathway[2] = { connection.pathway_start, connection.pathway_end };
+                const Vector3 new_entry = Geometry::get_closest_point_to_segment(least_cost_poly->entry, pathway);
+                const float new_distance = (least_cost_poly->entry.distance_to(new_entry) * region_travel_cost) + region_enter_cost + least_cost_poly->traveled_distance;
+
+                auto already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+                    // Oh this was visited already, can we win the cost?
+                if (already_visited_polygon_index != navigation_polys.end()) {
+
+                    gd::NavigationPoly &avp = *already_visited_polygon_index;
+                    if (new_distance < avp.traveled_distance) {
+                        avp.back_navigation_poly_id = least_cost_id;
+                        avp.back_navigation_edge = connection.edge;
+                        avp.back_navigation_edge_pathway_start = connection.pathway_start;
+                        avp.back_navigation_edge_pathway_end = connection.pathway_end;
+                        avp.traveled_distance = new_distance;
+                        avp.entry = new_entry;
+                    }
+                } else {
+                    // Add to open neighbours
+                    gd::NavigationPoly new_navigation_poly = gd::NavigationPoly(connection.polygon);
+                    new_navigation_poly.self_id = navigation_polys.size();
+                    new_navigation_poly.back_navigation_poly_id = least_cost_id;
+                    new_navigation_poly.back_navigation_edge = connection.edge;
+                    new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+                    new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+                    new_navigation_poly.traveled_distance = new_distance;
+                    new_navigation_poly.entry = new_entry;
+                    navigation_polys.push_back(new_navigation_poly);
+
+
+                    to_visit.push_back(navigation_polys.size() - 1);
+                }
+            }
+        }
+
+        // Removes the least cost polygon from the open list so we can advance.
+        to_visit.remove(least_cost_id);
+
+        // When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
+        if (to_visit.empty()) {
+            // so use the further reachable polygon
+            ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
+            is_reachable = false;
+            if (reachable_end == nullptr) {
+                // The path is not found and there is not a way out.
+                break;
+            }
+
+            // Set as end point the furthest reachable point.
+            end_poly = reachable_end;
+            end_d = 1e20f;
+            for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
+                Face3 f(end_poly->points[0].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
+                Vector3 spoint = f.get_closest_point_to(p_destination);
+                float dpoint = spoint.distance_to(p_destination);
+                if (dpoint < end_d) {
+                    end_point = spoint;
+                    end_d = dpoint;
+                }
+            }
+
+            // Reset open and navigation_polys
+            gd::NavigationPoly np = navigation_polys[0];
+            navigation_polys.clear();
+            navigation_polys.push_back(np);
+            to_visit.clear();
+            to_visit.push_back(0);
+            least_cost_id = 0;
+
+            reachable_end = nullptr;
+
+            continue;
+        }
+
+        // Now take the new least_cost_poly from the open list.
+        least_cost_id = -1;
+        float least_cost = 1e30f;
+
+        for (uint32_t element : to_visit) {
+            gd::NavigationPoly *np = &navigation_polys[element];
+            float cost = np->traveled_distance;
+            cost += (np->entry.distance_to(end_point) * get_region(np->poly).travel_cost);
+            if (cost < least_cost) {
+                least_cost_id = np->self_id;
+                least_cost = cost;
+            }
+        }
+
+        ERR_BREAK(least_cost_id == -1);
+        // Stores the further reachable end polygon, in case our goal is not reachable.
+        if (is_reachable) {
+            float d = navigation_polys[least_cost_id].entry.distance_to(p_destination) * get_region(navigation_polys[least_cost_id].poly).travel_cost;
+            if (reachable_d > d) {
+                reachable_d = d;
+                reachable_end = navigation_polys[least_cost_id].poly;
+            }
+        }
+
+
+        // Check if we reached the end
+        if (navigation_polys[least_cost_id].poly == end_poly) {
+            // Yep, done!!
+            found_route = true;
+            break;
+        }
+    }
+
+    if (!found_route) {
+        return Vector<Vector3>();
+    }
+
+        Vector<Vector3> path;
+        if (p_optimize) {
+
+        // String pulling
+
+        gd::NavigationPoly *apex_poly = &navigation_polys[least_cost_id];
+        Vector3 apex_point = end_point;
+        gd::NavigationPoly *left_poly = apex_poly;
+        Vector3 left_portal = apex_point;
+        gd::NavigationPoly *right_poly = apex_poly;
+        Vector3 right_portal = apex_point;
+        gd::NavigationPoly *p = apex_poly;
+
+        path.push_back(end_point);
+
+            while (p) {
+
+            Vector3 left = p->back_navigation_edge_pathway_start;
+            Vector3 right = p->back_navigation_edge_pathway_end;
+            if (THREE_POINTS_CROSS_PRODUCT(apex_point, left, right).dot(up) < 0) {
+                        SWAP(left, right);
+                }
+
+                bool skip = false;
+            if (THREE_POINTS_CROSS_PRODUCT(apex_point, left_portal, left).dot(up) >= 0) {
+
+                if (left_portal == apex_point || THREE_POINTS_CROSS_PRODUCT(apex_point, left, right_portal).dot(up) > 0) {
+                        left_poly = p;
+                    left_portal = left;
+                    } else {
+                    clip_path(navigation_polys, path, apex_poly, right_portal, right_poly);
+
+                    apex_point = right_portal;
+                        p = right_poly;
+                        left_poly = p;
+                        apex_poly = p;
+                    left_portal = apex_point;
+                    right_portal = apex_point;
+                        path.push_back(apex_point);
+                        skip = true;
+                    }
+                }
+
+            if (!skip && THREE_POINTS_CROSS_PRODUCT(apex_point, right_portal, right).dot(up) <= 0) {
+                    //process
+                if (right_portal == apex_point || THREE_POINTS_CROSS_PRODUCT(apex_point, right, left_portal).dot(up) < 0) {
+                        right_poly = p;
+                    right_portal = right;
+                    } else {
+                    clip_path(navigation_polys, path, apex_poly, left_portal, left_poly);
+
+                    apex_point = left_portal;
+                        p = left_poly;
+                        right_poly = p;
+                        apex_poly = p;
+                    right_portal = apex_point;
+                    left_portal = apex_point;
+                        path.push_back(apex_point);
+                    }
+                }
+
+            if (p->back_navigation_poly_id != -1) {
+                p = &navigation_polys[p->back_navigation_poly_id];
+            } else {
+                    // The end
+                    p = nullptr;
+            }
+            }
+
+        if (path[path.size() - 1] != begin_point) {
+                path.push_back(begin_point);
+        }
+        } else {
+            path.push_back(end_point);
+
+            // Add mid points
+            int np_id = least_cost_id;
+        while (np_id != -1 && navigation_polys[np_id].back_navigation_poly_id != -1) {
+                int prev = navigation_polys[np_id].back_navigation_edge;
+                int prev_n = (navigation_polys[np_id].back_navigation_edge + 1) % navigation_polys[np_id].poly->points.size();
+                Vector3 point = (navigation_polys[np_id].poly->points[prev].pos + navigation_polys[np_id].poly->points[prev_n].pos) * 0.5;
+
+                path.push_back(point);
+            np_id = navigation_polys[np_id].back_navigation_poly_id;
+            }
+            path.push_back(begin_point);
+        }
+
+    eastl::reverse(path.begin(),path.end());
+    return path;
+}
+
+Vector3 NavMapSnapshot::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
+    bool use_collision = p_use_collision;
+    Vector3 closest_point;
+    real_t closest_point_d = 1e20f;
+    if (!polygon_set) {
+        return closest_point;
+    }
+    const Vector<gd::Polygon> &polygons = polygon_set->polygons;
+
+    for (size_t i(0); i < polygons.size(); i++) {
+        const gd::Polygon &p = polygons[i];
+
+        // For each face check the distance to the segment
+        for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+            const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+            Vector3 inters;
+            if (f.intersects_segment(p_from, p_to, &inters)) {
+                const real_t d = closest_point_d = p_from.distance_to(inters);
+                if (use_collision == false) {
+                    closest_point = inters;
+                    use_collision = true;
+                    closest_point_d = d;
+                } else if (closest_point_d > d) {
+                    closest_point = inters;
+                    closest_point_d = d;
+                }
+            }
+        }
+
+        if (use_collision == false) {
+            for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
+                Vector3 a, b;
+
+                Geometry::get_closest_points_between_segments(
+                        p_from,
+                        p_to,
+                        p.points[point_id].pos,
+                        p.points[(point_id + 1) % p.points.size()].pos,
+                        a,
+                        b);
+
+                const real_t d = a.distance_to(b);
+                if (d < closest_point_d) {
+                    closest_point_d = d;
+                    closest_point = b;
+                }
+            }
+        }
+    }
+
+    return closest_point;
+}
+
+gd::ClosestPointQueryResult NavMapSnapshot::get_closest_point_info(const Vector3 &p_point) const {
+    gd::ClosestPointQueryResult result;
+    real_t closest_point_ds = 1e20f;
+    if (!polygon_set) {
+        return result;
+    }
+    const Vector<gd::Polygon> &polygons = polygon_set->polygons;
+
+    for (size_t i(0); i < polygons.size(); i++) {
+        const gd::Polygon &p = polygons[i];
+
+        // For each face check the distance to the point
+        for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+            const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+            const Vector3 inters = f.get_closest_point_to(p_point);
+            const real_t ds = inters.distance_squared_to(p_point);
+            if (ds < closest_point_ds) {
+                result.point = inters;
+                result.normal = f.get_plane().normal;
+                result.owner = get_region(&p).self;
+                closest_point_ds = ds;
+            }
+        }
+    }
+
+    return result;
+}
+
+void NavMapSnapshot::clip_path(const Vector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const {
+    Vector3 from = path[path.size() - 1];
+
+    if (from.is_equal_approx(p_to_point)) {
+        return;
+    }
+    Plane cut_plane;
+    cut_plane.normal = (from - p_to_point).cross(up);
+    if (cut_plane.normal == Vector3()) {
+        return;
+    }
+    cut_plane.normal.normalize();
+    cut_plane.d = cut_plane.normal.dot(from);
+
+    while (from_poly != p_to_poly) {
+        Vector3 pathway_start = from_poly->back_navigation_edge_pathway_start;
+        Vector3 pathway_end = from_poly->back_navigation_edge_pathway_end;
+
+        ERR_FAIL_COND(from_poly->back_navigation_poly_id == -1);
+        from_poly = &p_navigation_polys[from_poly->back_navigation_poly_id];
+
+        if (!pathway_start.is_equal_approx(pathway_end)) {
+
+            Vector3 inters;
+            if (cut_plane.intersects_segment(pathway_start, pathway_end, &inters)) {
+                if (!inters.is_equal_approx(p_to_point) && !inters.is_equal_approx(path[path.size() - 1])) {
+                    path.push_back(inters);
+                }
+            }
+        }
+    }
+}
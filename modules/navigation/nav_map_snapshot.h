@@ -0,0 +1,84 @@
+/*************************************************************************/
+/*  nav_map_snapshot.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "nav_utils.h"
+
+#include <EASTL/shared_ptr.h>
+
+/// Immutable copy of the navigation data of a `NavMap`, taken during `NavMap::sync()`.
+/// Queries only read from it, so any number of them can run concurrently on worker
+/// threads while the map itself keeps being modified by the server commands.
+class NavMapSnapshot {
+public:
+    /// Region properties used by the path finding, copied out of `NavRegion`.
+    struct Region {
+        RID self;
+        uint32_t navigation_layers = 1;
+        float enter_cost = 0.0;
+        float travel_cost = 1.0;
+    };
+
+    /// Linked polygons of the map, shared between snapshots as long as the links
+    /// are not regenerated.
+    struct PolygonSet {
+        Vector<gd::Polygon> polygons;
+        /// Index in `NavMapSnapshot::regions` of every polygon owner.
+        Vector<uint32_t> polygon_regions;
+    };
+
+private:
+    Vector3 up = Vector3(0, 1, 0);
+    uint32_t map_update_id = 0;
+    eastl::shared_ptr<const PolygonSet> polygon_set;
+    Vector<Region> regions;
+
+public:
+    NavMapSnapshot(Vector3 p_up, uint32_t p_map_update_id, eastl::shared_ptr<const PolygonSet> p_polygon_set, Vector<Region> &&p_regions);
+
+    uint32_t get_map_update_id() const {
+        return map_update_id;
+    }
+
+    const eastl::shared_ptr<const PolygonSet> &get_polygon_set() const {
+        return polygon_set;
+    }
+
+    Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const;
+    Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
+    gd::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
+
+private:
+    const Region &get_region(const gd::Polygon *p_poly) const {
+        return regions[polygon_set->polygon_regions[p_poly - polygon_set->polygons.data()]];
+    }
+    void clip_path(const Vector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const;
+};
@@ -43,6 +43,7 @@ void NavRegion::set_map(NavMap *p_map) {
 
 void NavRegion::set_navigation_layers(uint32_t p_navigation_layers) {
     navigation_layers = p_navigation_layers;
+    properties_changed = true;
 }
 
 uint32_t NavRegion::get_navigation_layers() const {
@@ -51,6 +51,7 @@ class NavRegion : public NavRid {
     Vector<gd::Edge::Connection> connections;
 
     bool polygons_dirty = true;
+    bool properties_changed = true;
 
     /// Cache
     Vector<gd::Polygon> polygons;
@@ -67,10 +68,16 @@ public:
         return map;
     }
 
-    void set_enter_cost(float p_enter_cost) { enter_cost = M_MAX(p_enter_cost, 0.0); }
+    void set_enter_cost(float p_enter_cost) {
+        enter_cost = M_MAX(p_enter_cost, 0.0);
+        properties_changed = true;
+    }
     float get_enter_cost() const { return enter_cost; }
 
-    void set_travel_cost(float p_travel_cost) { travel_cost = M_MAX(p_travel_cost, 0.0); }
+    void set_travel_cost(float p_travel_cost) {
+        travel_cost = M_MAX(p_travel_cost, 0.0);
+        properties_changed = true;
+    }
     float get_travel_cost() const { return travel_cost; }
 
     void set_navigation_layers(uint32_t p_navigation_layers);
@@ -97,6 +104,12 @@ public:
     }
 
     bool sync();
+    /// Returns true once after the costs or the layers got changed.
+    bool consume_properties_changed() {
+        bool changed = properties_changed;
+        properties_changed = false;
+        return changed;
+    }
     NavRegion();
     ~NavRegion();
 private:
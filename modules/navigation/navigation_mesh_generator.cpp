@@ -35,6 +35,7 @@
 
 #include "core/math/quick_hull.h"
 #include "core/os/thread.h"
+#include "core/os/thread_work_pool.h"
 #include "core/math/geometry.h"
 #include "core/method_bind_interface.h"
 #include "core/method_bind.h"
@@ -101,6 +102,31 @@ void _add_mesh_array(const SurfaceArrays &p_array, const Transform &p_xform, Vec
     }
 }
 
+// Whether `p_aabb` moved by `p_xform` overlaps `p_bounds` on the XZ plane, everything does when there are no bounds.
+bool _overlaps_bounds(const AABB *p_bounds, const Transform &p_xform, const AABB &p_aabb) {
+    if (!p_bounds) {
+        return true;
+    }
+    const AABB aabb = p_xform.xform(p_aabb);
+    return aabb.position.x <= p_bounds->position.x + p_bounds->size.x && aabb.position.x + aabb.size.x >= p_bounds->position.x &&
+           aabb.position.z <= p_bounds->position.z + p_bounds->size.z && aabb.position.z + aabb.size.z >= p_bounds->position.z;
+}
+
+// Drops the geometry added after `p_vertex_count` and `p_index_count` when none of it overlaps `p_bounds`.
+void _discard_outside_bounds(const AABB *p_bounds, Vector<float> &r_vertices, Vector<int> &r_indices, int p_vertex_count, int p_index_count) {
+    if (!p_bounds || r_vertices.size() == p_vertex_count) {
+        return;
+    }
+    AABB added(Vector3(r_vertices[p_vertex_count], r_vertices[p_vertex_count + 1], r_vertices[p_vertex_count + 2]), Vector3());
+    for (int i = p_vertex_count + 3; i < r_vertices.size(); i += 3) {
+        added.expand_to(Vector3(r_vertices[i], r_vertices[i + 1], r_vertices[i + 2]));
+    }
+    if (!_overlaps_bounds(p_bounds, Transform(), added)) {
+        r_vertices.resize(p_vertex_count);
+        r_indices.resize(p_index_count);
+    }
+}
+
 void NavigationMeshGenerator::_add_mesh(const Ref<Mesh> &p_mesh, const Transform &p_xform, Vector<float> &p_vertices, Vector<int> &p_indices) {
     int current_vertex_count;
 
@@ -171,14 +197,18 @@ void NavigationMeshGenerator::_add_faces(const PoolVector3Array &p_faces, const
     }
 }
 
-void NavigationMeshGenerator::_parse_geometry(const Transform &p_navmesh_xform, Node *p_node, Vector<float> &p_vertices, Vector<int> &p_indices, int p_generate_from, uint32_t p_collision_mask, bool p_recurse_children) {
+void NavigationMeshGenerator::_parse_geometry(const Transform &p_navmesh_xform, Node *p_node, Vector<float> &p_vertices, Vector<int> &p_indices, int p_generate_from, uint32_t p_collision_mask, bool p_recurse_children, const AABB *p_bounds) {
+
+    const int vertex_count = p_vertices.size();
+    const int index_count = p_indices.size();
 
     if (object_cast<MeshInstance3D>(p_node) && p_generate_from != NavigationMesh::PARSED_GEOMETRY_STATIC_COLLIDERS) {
 
         MeshInstance3D *mesh_instance = object_cast<MeshInstance3D>(p_node);
         Ref<Mesh> mesh = mesh_instance->get_mesh();
-        if (mesh) {
-            _add_mesh(mesh, p_navmesh_xform * mesh_instance->get_global_transform(), p_vertices, p_indices);
+        const Transform xform = p_navmesh_xform * mesh_instance->get_global_transform();
+        if (mesh && _overlaps_bounds(p_bounds, xform, mesh->get_aabb())) {
+            _add_mesh(mesh, xform, p_vertices, p_indices);
         }
     }
 
@@ -191,8 +221,12 @@ void NavigationMeshGenerator::_parse_geometry(const Transform &p_navmesh_xform,
             if (n == -1) {
                 n = multimesh->get_instance_count();
             }
+            const AABB mesh_aabb = mesh->get_aabb();
             for (int i = 0; i < n; i++) {
-                _add_mesh(mesh, p_navmesh_xform * multimesh_instance->get_global_transform() * multimesh->get_instance_transform(i), p_vertices, p_indices);
+                const Transform xform = p_navmesh_xform * multimesh_instance->get_global_transform() * multimesh->get_instance_transform(i);
+                if (_overlaps_bounds(p_bounds, xform, mesh_aabb)) {
+                    _add_mesh(mesh, xform, p_vertices, p_indices);
+                }
             }
         }
     }
@@ -201,8 +235,9 @@ void NavigationMeshGenerator::_parse_geometry(const Transform &p_navmesh_xform,
 
         CSGShape *csg_shape = object_cast<CSGShape>(p_node);
         PositionedMeshInfo meshes(csg_shape->get_meshes_root());
-        if (meshes.root_mesh) {
-            _add_mesh(meshes.root_mesh, p_navmesh_xform * csg_shape->get_global_transform(), p_vertices, p_indices);
+        const Transform xform = p_navmesh_xform * csg_shape->get_global_transform();
+        if (meshes.root_mesh && _overlaps_bounds(p_bounds, xform, meshes.root_mesh->get_aabb())) {
+            _add_mesh(meshes.root_mesh, xform, p_vertices, p_indices);
         }
     }
 #endif
@@ -285,7 +320,7 @@ void NavigationMeshGenerator::_parse_geometry(const Transform &p_navmesh_xform,
         Vector<PositionedMeshInfo> meshes(gridmap->get_positioned_meshes());
         Transform xform = gridmap->get_transform();
         for (PositionedMeshInfo & m : meshes) {
-            if (m.root_mesh) {
+            if (m.root_mesh && _overlaps_bounds(p_bounds, p_navmesh_xform * xform * m.transform, m.root_mesh->get_aabb())) {
                 _add_mesh(m.root_mesh, p_navmesh_xform * xform * m.transform, p_vertices, p_indices);
             }
         }
@@ -360,9 +395,12 @@ void NavigationMeshGenerator::_parse_geometry(const Transform &p_navmesh_xform,
 
 #endif
 
+    // The collision shapes are cheap to build, they are only dropped once they are known to be out of bounds.
+    _discard_outside_bounds(p_bounds, p_vertices, p_indices, vertex_count, index_count);
+
     if (p_recurse_children) {
         for (int i = 0; i < p_node->get_child_count(); i++) {
-            _parse_geometry(p_navmesh_xform, p_node->get_child(i), p_vertices, p_indices, p_generate_from, p_collision_mask, p_recurse_children);
+            _parse_geometry(p_navmesh_xform, p_node->get_child(i), p_vertices, p_indices, p_generate_from, p_collision_mask, p_recurse_children, p_bounds);
         }
     }
 }
@@ -395,6 +433,24 @@ void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(con
     }
 }
 
+void NavigationMeshGenerator::_setup_recast_config(const Ref<NavigationMesh> &p_nav_mesh, rcConfig &r_cfg) {
+    memset(&r_cfg, 0, sizeof(r_cfg));
+
+    r_cfg.cs = p_nav_mesh->get_cell_size();
+    r_cfg.ch = p_nav_mesh->get_cell_height();
+    r_cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
+    r_cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / r_cfg.ch);
+    r_cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / r_cfg.ch);
+    r_cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / r_cfg.cs);
+    r_cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
+    r_cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
+    r_cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
+    r_cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
+    r_cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
+    r_cfg.detailSampleDist = p_nav_mesh->get_detail_sample_distance() < 0.9f ? 0 : p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance();
+    r_cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+}
+
 void NavigationMeshGenerator::_build_recast_navigation_mesh(
         Ref<NavigationMesh> p_nav_mesh,
 #ifdef TOOLS_ENABLED
@@ -423,21 +479,7 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
     rcCalcBounds(verts, nverts, bmin, bmax);
 
     rcConfig cfg;
-    memset(&cfg, 0, sizeof(cfg));
-
-    cfg.cs = p_nav_mesh->get_cell_size();
-    cfg.ch = p_nav_mesh->get_cell_height();
-    cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
-    cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / cfg.ch);
-    cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / cfg.ch);
-    cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / cfg.cs);
-    cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
-    cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
-    cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
-    cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
-    cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
-    cfg.detailSampleDist = p_nav_mesh->get_detail_sample_distance() < 0.9f ? 0 : p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance();
-    cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+    _setup_recast_config(p_nav_mesh, cfg);
 
     cfg.bmin[0] = bmin[0];
     cfg.bmin[1] = bmin[1];
@@ -562,6 +604,310 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
     detail_mesh = nullptr;
 }
 
+void NavigationMeshGenerator::_parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &r_vertices, Vector<int> &r_indices, const AABB *p_bounds) {
+    Dequeue<Node *> parse_nodes;
+
+    if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
+        parse_nodes.push_back(p_node);
+    } else {
+        p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
+    }
+
+    Transform navmesh_xform = object_cast<Node3D>(p_node)->get_global_transform().affine_inverse();
+    for (Node * E : parse_nodes) {
+        NavigationMesh::ParsedGeometryType geometry_type = p_nav_mesh->get_parsed_geometry_type();
+        uint32_t collision_mask = p_nav_mesh->get_collision_mask();
+        bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
+        _parse_geometry(navmesh_xform, E, r_vertices, r_indices, geometry_type, collision_mask, recurse_children, p_bounds);
+    }
+}
+
+/// Settings shared by all the tiles baked in one pass.
+struct NavigationMeshTileInput {
+    rcConfig cfg;
+    const float *verts = nullptr;
+    int nverts = 0;
+    const int *tris = nullptr;
+    bool filter_low_hanging_obstacles = false;
+    bool filter_ledge_spans = false;
+    bool filter_walkable_low_height_spans = false;
+    NavigationMesh::SamplePartitionType partition_type = NavigationMesh::SAMPLE_PARTITION_WATERSHED;
+};
+
+struct NavigationMeshTileJob {
+    const NavigationMeshTileInput *input = nullptr;
+    int x = 0;
+    int z = 0;
+    /// Source triangles overlapping the tile and its border.
+    Vector<int> triangles;
+
+    Vector<Vector3> vertices;
+    Vector<Vector<int>> polygons;
+};
+
+namespace {
+/// Releases the intermediate Recast data of a tile on every exit path.
+struct RecastTileData {
+    rcHeightfield *hf = nullptr;
+    rcCompactHeightfield *chf = nullptr;
+    rcContourSet *cset = nullptr;
+    rcPolyMesh *poly_mesh = nullptr;
+    rcPolyMeshDetail *detail_mesh = nullptr;
+
+    ~RecastTileData() {
+        rcFreeHeightField(hf);
+        rcFreeCompactHeightfield(chf);
+        rcFreeContourSet(cset);
+        rcFreePolyMesh(poly_mesh);
+        rcFreePolyMeshDetail(detail_mesh);
+    }
+};
+
+uint64_t _tile_key(int p_x, int p_z) {
+    return (uint64_t(uint32_t(p_x)) << 32) | uint64_t(uint32_t(p_z));
+}
+} // namespace
+
+AABB NavigationMeshGenerator::_get_tiles_bounds(const Ref<NavigationMesh> &p_nav_mesh, const AABB &p_region) {
+    rcConfig cfg;
+    _setup_recast_config(p_nav_mesh, cfg);
+    // Same grid and border as _bake_tiles().
+    const float tile_world_size = p_nav_mesh->get_tile_size() * cfg.cs;
+    const float border_world_size = (cfg.walkableRadius + 3) * cfg.cs;
+    const Vector3 region_end = p_region.position + p_region.size;
+
+    Vector3 from(Math::floor(p_region.position.x / tile_world_size) * tile_world_size - border_world_size, p_region.position.y,
+            Math::floor(p_region.position.z / tile_world_size) * tile_world_size - border_world_size);
+    Vector3 to((Math::floor(region_end.x / tile_world_size) + 1) * tile_world_size + border_world_size, region_end.y,
+            (Math::floor(region_end.z / tile_world_size) + 1) * tile_world_size + border_world_size);
+    return AABB(from, to - from);
+}
+
+void NavigationMeshGenerator::_bake_tile(uint32_t p_index, NavigationMeshTileJob *p_jobs) {
+    NavigationMeshTileJob &job = p_jobs[p_index];
+    const NavigationMeshTileInput &input = *job.input;
+    if (job.triangles.empty()) {
+        return;
+    }
+
+    rcContext ctx(false);
+    rcConfig cfg = input.cfg;
+    const float tile_world_size = cfg.tileSize * cfg.cs;
+    const float border_world_size = cfg.borderSize * cfg.cs;
+    cfg.bmin[0] = job.x * tile_world_size - border_world_size;
+    cfg.bmin[2] = job.z * tile_world_size - border_world_size;
+    cfg.bmax[0] = (job.x + 1) * tile_world_size + border_world_size;
+    cfg.bmax[2] = (job.z + 1) * tile_world_size + border_world_size;
+
+    RecastTileData data;
+    data.hf = rcAllocHeightfield();
+    ERR_FAIL_COND(!data.hf);
+    ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *data.hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+
+    {
+        const int ntris = job.triangles.size() / 3;
+        Vector<uint8_t> tri_areas;
+        tri_areas.resize(ntris, 0);
+        rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, input.verts, input.nverts, job.triangles.data(), ntris, tri_areas.data());
+        ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, input.verts, input.nverts, job.triangles.data(), tri_areas.data(), ntris, *data.hf, cfg.walkableClimb));
+    }
+
+    if (input.filter_low_hanging_obstacles) {
+        rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *data.hf);
+    }
+    if (input.filter_ledge_spans) {
+        rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *data.hf);
+    }
+    if (input.filter_walkable_low_height_spans) {
+        rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *data.hf);
+    }
+
+    data.chf = rcAllocCompactHeightfield();
+    ERR_FAIL_COND(!data.chf);
+    ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *data.hf, *data.chf));
+    rcFreeHeightField(data.hf);
+    data.hf = nullptr;
+
+    ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *data.chf));
+
+    // The border is used as context only, it doesn't produce polygons.
+    if (input.partition_type == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+        ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *data.chf));
+        ERR_FAIL_COND(!rcBuildRegions(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+    } else if (input.partition_type == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+        ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+    } else {
+        ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea));
+    }
+
+    data.cset = rcAllocContourSet();
+    ERR_FAIL_COND(!data.cset);
+    ERR_FAIL_COND(!rcBuildContours(&ctx, *data.chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *data.cset));
+    if (data.cset->nconts == 0) {
+        return;
+    }
+
+    data.poly_mesh = rcAllocPolyMesh();
+    ERR_FAIL_COND(!data.poly_mesh);
+    ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *data.cset, cfg.maxVertsPerPoly, *data.poly_mesh));
+
+    data.detail_mesh = rcAllocPolyMeshDetail();
+    ERR_FAIL_COND(!data.detail_mesh);
+    ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *data.poly_mesh, *data.chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *data.detail_mesh));
+
+    const rcPolyMeshDetail *detail_mesh = data.detail_mesh;
+    job.vertices.reserve(detail_mesh->nverts);
+    for (int i = 0; i < detail_mesh->nverts; i++) {
+        const float *v = &detail_mesh->verts[i * 3];
+        job.vertices.emplace_back(v[0], v[1], v[2]);
+    }
+    for (int i = 0; i < detail_mesh->nmeshes; i++) {
+        const unsigned int *m = &detail_mesh->meshes[i * 4];
+        const unsigned int bverts = m[0];
+        const unsigned int btris = m[2];
+        const unsigned int ntris = m[3];
+        const unsigned char *tris = &detail_mesh->tris[btris * 4];
+        for (unsigned int j = 0; j < ntris; j++) {
+            // Polygon order in recast is opposite than godot's
+            job.polygons.emplace_back(Vector<int> {
+                    (int)(bverts + tris[j * 4 + 0]),
+                    (int)(bverts + tris[j * 4 + 2]),
+                    (int)(bverts + tris[j * 4 + 1]),
+            });
+        }
+    }
+}
+
+void NavigationMeshGenerator::_bake_tiles(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices, const AABB *p_dirty_region) {
+    NavigationMeshTileInput input;
+    input.verts = p_vertices.data();
+    input.nverts = p_vertices.size() / 3;
+    input.tris = p_indices.data();
+    input.filter_low_hanging_obstacles = p_nav_mesh->get_filter_low_hanging_obstacles();
+    input.filter_ledge_spans = p_nav_mesh->get_filter_ledge_spans();
+    input.filter_walkable_low_height_spans = p_nav_mesh->get_filter_walkable_low_height_spans();
+    input.partition_type = p_nav_mesh->get_sample_partition_type();
+
+    rcConfig &cfg = input.cfg;
+    _setup_recast_config(p_nav_mesh, cfg);
+    cfg.tileSize = p_nav_mesh->get_tile_size();
+    cfg.borderSize = cfg.walkableRadius + 3;
+    cfg.width = cfg.tileSize + cfg.borderSize * 2;
+    cfg.height = cfg.tileSize + cfg.borderSize * 2;
+    rcCalcBounds(input.verts, input.nverts, cfg.bmin, cfg.bmax);
+    // Heights are quantized from a grid anchored at the origin too, a partial
+    // rebake parses less geometry than the full bake but must match its tiles.
+    cfg.bmin[1] = Math::floor(cfg.bmin[1] / cfg.ch) * cfg.ch;
+
+    // The tile grid is anchored at the navigation mesh origin, so a tile
+    // covers the same cells whatever the bounds of the source geometry are.
+    const float tile_world_size = cfg.tileSize * cfg.cs;
+    const float border_world_size = cfg.borderSize * cfg.cs;
+    auto tile_coord = [tile_world_size](float p_pos) {
+        return (int)Math::floor(p_pos / tile_world_size);
+    };
+
+    Vector<NavigationMeshTileJob> jobs;
+    HashMap<uint64_t, uint32_t> job_indices;
+    auto add_tiles = [&](float p_min_x, float p_min_z, float p_max_x, float p_max_z) {
+        for (int z = tile_coord(p_min_z); z <= tile_coord(p_max_z); z++) {
+            for (int x = tile_coord(p_min_x); x <= tile_coord(p_max_x); x++) {
+                if (job_indices.emplace(_tile_key(x, z), jobs.size()).second) {
+                    NavigationMeshTileJob job;
+                    job.input = &input;
+                    job.x = x;
+                    job.z = z;
+                    jobs.emplace_back(eastl::move(job));
+                }
+            }
+        }
+    };
+    if (p_dirty_region) {
+        const Vector3 dirty_end = p_dirty_region->position + p_dirty_region->size;
+        add_tiles(p_dirty_region->position.x, p_dirty_region->position.z, dirty_end.x, dirty_end.z);
+    } else {
+        add_tiles(cfg.bmin[0], cfg.bmin[2], cfg.bmax[0], cfg.bmax[2]);
+    }
+
+    // Dispatch every triangle to the tiles whose border it overlaps.
+    const int ntris = p_indices.size() / 3;
+    for (int i = 0; i < ntris; i++) {
+        const float *a = &input.verts[input.tris[i * 3 + 0] * 3];
+        const float *b = &input.verts[input.tris[i * 3 + 1] * 3];
+        const float *c = &input.verts[input.tris[i * 3 + 2] * 3];
+        const int min_x = tile_coord(MIN(MIN(a[0], b[0]), c[0]) - border_world_size);
+        const int max_x = tile_coord(M_MAX(M_MAX(a[0], b[0]), c[0]) + border_world_size);
+        const int min_z = tile_coord(MIN(MIN(a[2], b[2]), c[2]) - border_world_size);
+        const int max_z = tile_coord(M_MAX(M_MAX(a[2], b[2]), c[2]) + border_world_size);
+        for (int z = min_z; z <= max_z; z++) {
+            for (int x = min_x; x <= max_x; x++) {
+                auto iter = job_indices.find(_tile_key(x, z));
+                if (iter == job_indices.end()) {
+                    continue;
+                }
+                Vector<int> &triangles = jobs[iter->second].triangles;
+                triangles.push_back(input.tris[i * 3 + 0]);
+                triangles.push_back(input.tris[i * 3 + 1]);
+                triangles.push_back(input.tris[i * 3 + 2]);
+            }
+        }
+    }
+
+    SharedThreadWorkPool::do_work(jobs.size(), this, &NavigationMeshGenerator::_bake_tile, jobs.data());
+
+    // Keep the polygons of the tiles that were not rebaked, a polygon belongs
+    // to the tile containing its center.
+    Vector<Vector3> vertices;
+    Vector<Vector<int>> polygons;
+    if (p_dirty_region) {
+        const Vector<Vector3> &old_vertices = p_nav_mesh->get_vertices();
+        Vector<int> vertex_remap;
+        vertex_remap.resize(old_vertices.size(), -1);
+        for (int i = 0; i < p_nav_mesh->get_polygon_count(); i++) {
+            const Vector<int> &polygon = p_nav_mesh->get_polygon(i);
+            if (polygon.empty()) {
+                continue;
+            }
+            Vector3 center;
+            for (int index : polygon) {
+                center += old_vertices[index];
+            }
+            center /= float(polygon.size());
+            if (job_indices.contains(_tile_key(tile_coord(center.x), tile_coord(center.z)))) {
+                continue;
+            }
+
+            Vector<int> kept_polygon;
+            kept_polygon.reserve(polygon.size());
+            for (int index : polygon) {
+                if (vertex_remap[index] == -1) {
+                    vertex_remap[index] = vertices.size();
+                    vertices.push_back(old_vertices[index]);
+                }
+                kept_polygon.push_back(vertex_remap[index]);
+            }
+            polygons.emplace_back(eastl::move(kept_polygon));
+        }
+    }
+
+    for (NavigationMeshTileJob &job : jobs) {
+        const int vertex_offset = vertices.size();
+        vertices.insert(vertices.end(), job.vertices.begin(), job.vertices.end());
+        for (Vector<int> &polygon : job.polygons) {
+            for (int &index : polygon) {
+                index += vertex_offset;
+            }
+            polygons.emplace_back(eastl::move(polygon));
+        }
+    }
+
+    p_nav_mesh->clear_polygons();
+    p_nav_mesh->set_vertices(eastl::move(vertices));
+    for (Vector<int> &polygon : polygons) {
+        p_nav_mesh->add_polygon(eastl::move(polygon));
+    }
+}
+
 NavigationMeshGenerator *NavigationMeshGenerator::get_singleton() {
     return singleton;
 }
@@ -590,23 +936,15 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
     Vector<float> vertices;
     Vector<int> indices;
 
-    Dequeue<Node *> parse_nodes;
-
-    if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
-        parse_nodes.push_back(p_node);
-    } else {
-        p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
-    }
-
-    Transform navmesh_xform = object_cast<Node3D>(p_node)->get_global_transform().affine_inverse();
-    for (Node * E : parse_nodes) {
-        NavigationMesh::ParsedGeometryType geometry_type = p_nav_mesh->get_parsed_geometry_type();
-        uint32_t collision_mask = p_nav_mesh->get_collision_mask();
-        bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
-        _parse_geometry(navmesh_xform, E, vertices, indices, geometry_type, collision_mask, recurse_children);
-    }
+    _parse_source_geometry(p_nav_mesh, p_node, vertices, indices, nullptr);
 
-    if (vertices.size() > 0 && indices.size() > 0) {
+    if (vertices.size() > 0 && indices.size() > 0 && p_nav_mesh->get_tile_size() > 0) {
+#ifdef TOOLS_ENABLED
+        if (ep)
+            ep->step(TTR("Baking tiles..."), 1);
+#endif
+        _bake_tiles(p_nav_mesh, vertices, indices, nullptr);
+    } else if (vertices.size() > 0 && indices.size() > 0) {
 
         rcHeightfield *hf = nullptr;
         rcCompactHeightfield *chf = nullptr;
@@ -652,6 +990,23 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
     p_nav_mesh->property_list_changed_notify();
 }
 
+void NavigationMeshGenerator::rebake_region(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB &p_region) {
+    ERR_FAIL_COND_MSG(!p_nav_mesh, "Invalid Navigation Mesh");
+    ERR_FAIL_COND_MSG(p_nav_mesh->get_tile_size() <= 0, "Only navigation meshes baked with tiles can be partially rebaked.");
+
+    const AABB dirty_region = object_cast<Node3D>(p_node)->get_global_transform().affine_inverse().xform(p_region);
+    const AABB tiles_bounds = _get_tiles_bounds(p_nav_mesh, dirty_region);
+
+    Vector<float> vertices;
+    Vector<int> indices;
+
+    _parse_source_geometry(p_nav_mesh, p_node, vertices, indices, &tiles_bounds);
+
+    _bake_tiles(p_nav_mesh, vertices, indices, &dirty_region);
+
+    p_nav_mesh->property_list_changed_notify();
+}
+
 void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
     if (p_nav_mesh) {
         p_nav_mesh->clear_polygons();
@@ -661,6 +1016,7 @@ void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 
 void NavigationMeshGenerator::_bind_methods() {
     SE_BIND_METHOD(NavigationMeshGenerator,bake);
+    SE_BIND_METHOD(NavigationMeshGenerator,rebake_region);
     SE_BIND_METHOD(NavigationMeshGenerator,clear);
 }
 
@@ -44,6 +44,8 @@ struct rcCompactHeightfield;
 struct rcContourSet;
 struct rcPolyMesh;
 struct rcPolyMeshDetail;
+struct rcConfig;
+struct NavigationMeshTileJob;
 
 class GODOT_EXPORT NavigationMeshGenerator : public Object {
     GDCLASS(NavigationMeshGenerator, Object)
@@ -55,7 +57,12 @@ protected:
 
     static void _add_mesh(const Ref<Mesh> &p_mesh, const Transform &p_xform, Vector<float> &p_verticies, Vector<int> &p_indices);
     static void _add_faces(const PoolVector3Array &p_faces, const Transform &p_xform, Vector<float> &p_verticies, Vector<int> &p_indices);
-    static void _parse_geometry(const Transform &p_accumulated_transform, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices, int p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
+    static void _parse_geometry(const Transform &p_accumulated_transform, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices, int p_generate_from, uint32_t p_collision_mask, bool p_recurse_children, const AABB *p_bounds);
+
+    /// Only the geometry overlapping `p_bounds` (navigation mesh space, on the XZ plane) is parsed when it's set.
+    static void _parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &r_vertices, Vector<int> &r_indices, const AABB *p_bounds);
+    static AABB _get_tiles_bounds(const Ref<NavigationMesh> &p_nav_mesh, const AABB &p_region);
+    static void _setup_recast_config(const Ref<NavigationMesh> &p_nav_mesh, rcConfig &r_cfg);
 
     static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh);
     static void _build_recast_navigation_mesh(
@@ -71,6 +78,9 @@ protected:
             Vector<float> &vertices,
             Vector<int> &indices);
 
+    void _bake_tile(uint32_t p_index, NavigationMeshTileJob *p_jobs);
+    void _bake_tiles(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices, const AABB *p_dirty_region);
+
 public:
     static NavigationMeshGenerator *get_singleton();
 
@@ -78,6 +88,10 @@ public:
     ~NavigationMeshGenerator() override;
 
     void bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node);
+    /// Rebakes only the tiles of `p_nav_mesh` overlapping `p_region` (in global
+    /// space), keeping the polygons of every other tile.
+    /// The navigation mesh must use tiles, see `NavigationMesh::set_tile_size`.
+    void rebake_region(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB &p_region);
     void clear(Ref<NavigationMesh> p_nav_mesh);
 };
 
@@ -43,6 +43,13 @@ private:
 
     RingBuffer<_Packet> _packets;
     RingBuffer<uint8_t> _payload;
+    // Payload of the last packet returned by read_packet_view(), kept in the ring until the next read.
+    int _held = 0;
+
+    void _release_held() {
+        _payload.advance_read(_held);
+        _held = 0;
+    }
 
 public:
     Error write_packet(const uint8_t *p_payload, uint32_t p_size, const T *p_info) {
@@ -78,6 +85,7 @@ public:
     }
 
     Error read_packet(uint8_t *r_payload, int p_bytes, T *r_info, int &r_read) {
+        _release_held();
         ERR_FAIL_COND_V(_packets.data_left() < 1, ERR_UNAVAILABLE);
         _Packet p;
         _packets.read(&p, 1);
@@ -90,11 +98,35 @@ public:
         return OK;
     }
 
+    // Like read_packet(), but points r_payload into the ring instead of copying. The view stays valid until the
+    // next read. Only a packet that wraps around the end of the ring is copied, into p_scratch.
+    Error read_packet_view(const uint8_t **r_payload, T *r_info, int &r_read, uint8_t *p_scratch, int p_scratch_size) {
+        _release_held();
+        ERR_FAIL_COND_V(_packets.data_left() < 1, ERR_UNAVAILABLE);
+        _Packet p;
+        _packets.read(&p, 1);
+        ERR_FAIL_COND_V(_payload.data_left() < (int)p.size, ERR_BUG);
+
+        const uint8_t *view = _payload.read_ptr(p.size);
+        if (view) {
+            *r_payload = view;
+            _held = p.size;
+        } else {
+            ERR_FAIL_COND_V(p_scratch_size < (int)p.size, ERR_OUT_OF_MEMORY);
+            _payload.read(p_scratch, p.size);
+            *r_payload = p_scratch;
+        }
+        r_read = p.size;
+        memcpy(r_info, &p.info, sizeof(T));
+        return OK;
+    }
+
     void discard_payload(int p_size) {
         _packets.decrease_write(p_size);
     }
 
     void resize(int p_pkt_shift, int p_buf_shift) {
+        _release_held();
         _packets.resize(p_pkt_shift);
         _payload.resize(p_buf_shift);
     }
@@ -104,6 +136,7 @@ public:
     }
 
     void clear() {
+        _held = 0;
         _payload.resize(0);
         _packets.resize(0);
     }
@@ -251,17 +251,20 @@ Error WebSocketMultiplayerPeer::_server_relay(int32_t p_from, int32_t p_to, cons
 
     } else if (p_to == 0) {
 
+        // One copy of the payload, shared by the send queues of all peers.
+        Ref<WebSocketSharedPacket> packet(make_ref_counted<WebSocketSharedPacket>(p_buffer, p_buffer_size));
         for (eastl::pair<const int,Ref<WebSocketPeer> > &E : _peer_map) {
             if (E.first != p_from)
-                E.second->put_packet(p_buffer, p_buffer_size);
+                E.second->put_shared_packet(packet);
         }
         return OK; // Sent to all but sender
 
     } else if (p_to < 0) {
 
+        Ref<WebSocketSharedPacket> packet(make_ref_counted<WebSocketSharedPacket>(p_buffer, p_buffer_size));
         for (eastl::pair<const int,Ref<WebSocketPeer> > &E : _peer_map) {
             if (E.first != p_from && E.first != -p_to)
-                E.second->put_packet(p_buffer, p_buffer_size);
+                E.second->put_shared_packet(packet);
         }
         return OK; // Sent to all but sender and excluded
 
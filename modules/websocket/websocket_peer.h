@@ -36,6 +36,16 @@
 
 #include "websocket_macros.h"
 
+// A payload queued unchanged on many peers, like a broadcast. Peers that can send straight from it keep a
+// reference until it went out, instead of copying it into their own queue.
+class WebSocketSharedPacket : public RefCounted {
+public:
+    Vector<uint8_t> data;
+
+    WebSocketSharedPacket(const uint8_t *p_data, int p_size) :
+            data(p_data, p_data + p_size) {}
+};
+
 class GODOT_EXPORT WebSocketPeer : public PacketPeer {
 
     GDCLASS(WebSocketPeer,PacketPeer)
@@ -55,6 +65,9 @@ public:
     int get_available_packet_count() const override = 0;
     Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override = 0;
     Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override = 0;
+    virtual Error put_shared_packet(const Ref<WebSocketSharedPacket> &p_packet) {
+        return put_packet(p_packet->data.data(), int(p_packet->data.size()));
+    }
     int get_max_packet_size() const override = 0;
 
     virtual WriteMode get_write_mode() const = 0;
@@ -118,6 +118,32 @@ ssize_t wsl_send_callback(wslay_event_context_ptr ctx, const uint8_t *data, size
         wslay_event_set_error(ctx, WSLAY_ERR_CALLBACK_FAILURE);
         return -1;
     }
+    // wslay sends a frame header (flagged WSLAY_MSG_MORE) and its payload in two calls. Over plain TCP the header is
+    // reported as sent right away and written together with the payload, one syscall per frame instead of two.
+    if (peer_data->conn.get() == peer_data->tcp.get()) {
+        int held = peer_data->pending_header_len;
+        if ((flags & WSLAY_MSG_MORE) && held + len <= sizeof(peer_data->pending_header)) {
+            memcpy(peer_data->pending_header + held, data, len);
+            peer_data->pending_header_len += len;
+            return len;
+        }
+        if (held) {
+            int sent = 0;
+            Error err = peer_data->tcp->put_partial_data_vectored(peer_data->pending_header, held, data, len, sent);
+            if (err != OK) {
+                wslay_event_set_error(ctx, WSLAY_ERR_CALLBACK_FAILURE);
+                return -1;
+            }
+            int header_sent = MIN(sent, held);
+            memmove(peer_data->pending_header, peer_data->pending_header + header_sent, held - header_sent);
+            peer_data->pending_header_len -= header_sent;
+            if (sent <= held) {
+                wslay_event_set_error(ctx, WSLAY_ERR_WOULDBLOCK);
+                return -1;
+            }
+            return sent - held;
+        }
+    }
     Ref<StreamPeer> conn = peer_data->conn;
     int sent = 0;
     Error err = conn->put_partial_data(data, len, sent);
@@ -142,6 +168,13 @@ int wsl_genmask_callback(wslay_event_context_ptr ctx, uint8_t *buf, size_t len,
     return 0;
 }
 
+void wsl_shared_msg_free_callback(void *user_data) {
+    WebSocketSharedPacket *packet = (WebSocketSharedPacket *)user_data;
+    if (packet->unreference()) {
+        memdelete(packet);
+    }
+}
+
 void wsl_msg_recv_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_msg_recv_arg *arg, void *user_data) {
     struct WSLPeer::PeerData *peer_data = (struct WSLPeer::PeerData *)user_data;
     if (!peer_data->valid || peer_data->closing) {
@@ -235,6 +268,12 @@ void WSLPeer::poll() {
     }
 }
 
+bool WSLPeer::needs_poll() const {
+    if (!_data)
+        return false;
+    return _data->conn != _data->tcp || wslay_event_want_write(_data->ctx);
+}
+
 Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 
     ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
@@ -252,6 +291,31 @@ Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
     return OK;
 }
 
+Error WSLPeer::put_shared_packet(const Ref<WebSocketSharedPacket> &p_packet) {
+
+    ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
+    ERR_FAIL_COND_V(not p_packet, ERR_INVALID_PARAMETER);
+
+    struct wslay_event_shared_msg msg;
+    msg.opcode = write_mode == WRITE_MODE_TEXT ? WSLAY_TEXT_FRAME : WSLAY_BINARY_FRAME;
+    msg.msg = p_packet->data.data();
+    msg.msg_length = p_packet->data.size();
+    msg.free_callback = wsl_shared_msg_free_callback;
+    msg.free_user_data = p_packet.get();
+
+    // wslay holds this reference until the message went out, then drops it in wsl_shared_msg_free_callback.
+    p_packet->reference();
+    if (wslay_event_queue_shared_msg(_data->ctx, &msg) != 0) {
+        wsl_shared_msg_free_callback(p_packet.get());
+        return FAILED;
+    }
+    if (wslay_event_send(_data->ctx) < 0) {
+        close_now();
+        return FAILED;
+    }
+    return OK;
+}
+
 Error WSLPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 
     r_buffer_size = 0;
@@ -261,11 +325,12 @@ Error WSLPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
     if (_in_buffer.packets_left() == 0)
         return ERR_UNAVAILABLE;
 
+    // Points into the receive ring, _packet_buffer is only used for packets wrapping around its end.
     int read = 0;
     PoolVector<uint8_t>::Write rw = _packet_buffer.write();
-    _in_buffer.read_packet(rw.ptr(), _packet_buffer.size(), &_is_string, read);
+    Error err = _in_buffer.read_packet_view(r_buffer, &_is_string, read, rw.ptr(), _packet_buffer.size());
+    ERR_FAIL_COND_V(err != OK, err);
 
-    *r_buffer = rw.ptr();
     r_buffer_size = read;
 
     return OK;
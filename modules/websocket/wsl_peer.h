@@ -60,6 +60,9 @@ public:
         Ref<StreamPeerTCP> tcp;
         int id;
         wslay_event_context_ptr ctx;
+        // Frame header held back to go out in the same write as its payload, see wsl_send_callback.
+        uint8_t pending_header[14];
+        int pending_header_len = 0;
 
         PeerData() {
             polling = false;
@@ -94,10 +97,13 @@ public:
     int close_code;
     String close_reason;
     void poll(); // Used by client and server.
+    // True when poll() has work even if the socket is not readable: queued output, or SSL with buffered data.
+    bool needs_poll() const;
 
     int get_available_packet_count() const override;
     Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override;
     Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override;
+    Error put_shared_packet(const Ref<WebSocketSharedPacket> &p_packet) override;
     int get_max_packet_size() const override { return _packet_buffer.size(); }
 
     virtual void close_now();
@@ -172,15 +172,31 @@ Error WSLServer::listen(int p_port, const PoolVector<String> &p_protocols, bool
 
     _protocols.append_array(p_protocols);
 
-    return _server->listen(p_port, bind_ip);
+    Error err = _server->listen(p_port, bind_ip);
+    if (err != OK)
+        return err;
+    return _poller->add(POLLER_LISTEN_ID, _server->get_socket(), NetSocketPoller::EVENT_IN);
 }
 
 void WSLServer::poll() {
 
+    bool can_accept = false;
+    _events.clear();
+    _ready.clear();
+    _poller->wait(_events, 0);
+    for (const NetSocketPoller::Event &ev : _events) {
+        if (ev.id == POLLER_LISTEN_ID)
+            can_accept = true;
+        else
+            _ready.insert(int(ev.id));
+    }
+
     for (auto iter=_peer_map.begin(); iter!=_peer_map.end(); ) {
         Ref<WSLPeer> peer((WSLPeer *)iter->second.get());
-        peer->poll();
+        if (_ready.contains(iter->first) || peer->needs_poll())
+            peer->poll();
         if (!peer->is_connected_to_host()) {
+            _poller->remove(iter->first);
             _on_disconnect(iter->first, peer->close_code != -1);
             iter=_peer_map.erase(iter);
         }
@@ -192,6 +208,7 @@ void WSLServer::poll() {
         Ref<PendingPeer> ppeer = *iter;
         Error err = ppeer->do_handshake(_protocols);
         if (err == ERR_BUSY) {
+            ++iter;
             continue;
         }
         if (err != OK) {
@@ -213,11 +230,12 @@ void WSLServer::poll() {
         ws_peer->set_no_delay(true);
 
         _peer_map[id] = ws_peer;
+        _poller->add(id, ppeer->tcp->get_socket(), NetSocketPoller::EVENT_IN);
         iter = _pending.erase(iter);
         _on_connect(id, ppeer->protocol);
     }
 
-    if (!_server->is_listening())
+    if (!can_accept || !_server->is_listening())
         return;
 
     while (_server->is_connection_available()) {
@@ -250,6 +268,7 @@ int WSLServer::get_max_packet_size() const {
 }
 
 void WSLServer::stop() {
+    _poller->clear();
     _server->stop();
     for (eastl::pair<const int,Ref<WebSocketPeer> > &E : _peer_map) {
         Ref<WSLPeer> peer((WSLPeer *)E.second.get());
@@ -303,6 +322,7 @@ WSLServer::WSLServer() {
     _out_buf_size = nearest_shift(GLOBAL_GET(WSS_OUT_BUF).as<int>() - 1) + 10;
     _out_pkt_size = nearest_shift(GLOBAL_GET(WSS_OUT_PKT).as<int>() - 1);
     _server = make_ref_counted<TCP_Server>();
+    _poller = Ref<NetSocketPoller>(NetSocketPoller::create(), DoNotAddRef);
 }
 
 WSLServer::~WSLServer() {
@@ -35,6 +35,8 @@
 #include "websocket_server.h"
 #include "wsl_peer.h"
 
+#include "core/hash_set.h"
+#include "core/io/net_socket_poller.h"
 #include "core/io/stream_peer_ssl.h"
 #include "core/io/stream_peer_tcp.h"
 #include "core/io/tcp_server.h"
@@ -79,6 +81,15 @@ private:
     Ref<TCP_Server> _server;
     PoolVector<String> _protocols;
 
+    // Connected peers and the listening socket are registered here (peer ids are never 0), so poll() only
+    // touches the sockets that have something to do.
+    enum {
+        POLLER_LISTEN_ID = 0
+    };
+    Ref<NetSocketPoller> _poller;
+    Vector<NetSocketPoller::Event> _events;
+    HashSet<int> _ready;
+
 public:
     Error set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer, int p_out_packets) override;
     Error listen(int p_port, const PoolVector<String> &p_protocols = PoolVector<String>(), bool gd_mp_api = false) override;
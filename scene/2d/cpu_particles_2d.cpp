@@ -33,10 +33,12 @@
 #include "core/callable_method_pointer.h"
 #include "core/core_string_names.h"
 #include "core/math/basis.h"
+#include "core/math/random_pcg.h"
 #include "core/method_bind.h"
 #include "core/object_tooling.h"
 #include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 #include "core/translation_helpers.h"
 #include "EASTL/sort.h"
 #include "scene/2d/canvas_item.h"
@@ -78,6 +80,7 @@ void CPUParticles2D::set_amount(int p_amount) {
     }
 
     particle_data.resize((8 + 4 + 1) * p_amount);
+    particle_data_back.resize((8 + 4 + 1) * p_amount);
     RenderingServer::get_singleton()->multimesh_allocate(
             multimesh, p_amount, RS::MULTIMESH_TRANSFORM_2D, RS::MULTIMESH_COLOR_8BIT, RS::MULTIMESH_CUSTOM_DATA_FLOAT);
 
@@ -556,16 +559,70 @@ void CPUParticles2D::_particles_process(float p_delta) {
         velocity_xform[2] = Vector2();
     }
 
-    float system_phase = time / lifetime;
+    // Gradients sort their points on first use, which must not happen on the workers.
+    if (color_ramp) {
+        color_ramp->get_color_at_offset(0);
+    }
+    if (color_initial_ramp) {
+        color_initial_ramp->get_color_at_offset(0);
+    }
+
+    PoolVector<Vector2>::Read emission_points_r = emission_points.read();
+    PoolVector<Vector2>::Read emission_normals_r = emission_normals.read();
+    PoolVector<Color>::Read emission_colors_r = emission_colors.read();
+
+    ProcessState state;
+    state.particles = parray;
+    state.particle_count = pcount;
+    state.emission_xform = emission_xform;
+    state.velocity_xform = velocity_xform;
+    state.delta = p_delta;
+    state.prev_time = prev_time;
+    state.system_phase = time / lifetime;
+    state.emission_points = emission_points_r.ptr();
+    state.emission_normals = emission_normals_r.ptr();
+    state.emission_colors = emission_colors_r.ptr();
+    state.emission_point_count = emission_points.size();
+    state.emission_normal_count = emission_normals.size();
+    state.emission_color_count = emission_colors.size();
+
+    // Each chunk draws its random numbers from its own generator, seeded here.
+    const uint32_t chunk_count = (pcount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    state.chunk_seeds.resize(chunk_count);
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        state.chunk_seeds[i] = Math::rand();
+    }
 
-    for (int i = 0; i < pcount; i++) {
+    if (chunk_count > 1) {
+        SharedThreadWorkPool::do_work(chunk_count, this, &CPUParticles2D::_particles_process_chunk, &state);
+    } else if (chunk_count == 1) {
+        _particles_process_chunk(0, &state);
+    }
+}
+
+void CPUParticles2D::_particles_process_chunk(uint32_t p_chunk, ProcessState *p_state) {
+    using namespace ParticleUtils;
+
+    Particle *parray = p_state->particles;
+    const int pcount = p_state->particle_count;
+    const int from = p_chunk * CHUNK_SIZE;
+    const int to = MIN(pcount, from + CHUNK_SIZE);
+
+    RandomPCG rng(p_state->chunk_seeds[p_chunk]);
+
+    const Transform2D &emission_xform = p_state->emission_xform;
+    const Transform2D &velocity_xform = p_state->velocity_xform;
+    const float prev_time = p_state->prev_time;
+    const float system_phase = p_state->system_phase;
+
+    for (int i = from; i < to; i++) {
 
         Particle &p = parray[i];
 
         if (!emitting && !p.active)
             continue;
 
-        float local_delta = p_delta;
+        float local_delta = p_state->delta;
 
         // The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
         // While we use time in tests later on, for randomness we use the phase as done in the
@@ -636,24 +693,24 @@ void CPUParticles2D::_particles_process(float p_delta) {
                 tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate(tv);
             }
 
-            p.seed = Math::rand();
+            p.seed = rng.rand();
 
-            p.angle_rand = Math::randf();
-            p.scale_rand = Math::randf();
-            p.hue_rot_rand = Math::randf();
-            p.anim_offset_rand = Math::randf();
+            p.angle_rand = rng.randf();
+            p.scale_rand = rng.randf();
+            p.hue_rot_rand = rng.randf();
+            p.anim_offset_rand = rng.randf();
 
             if (color_initial_ramp) {
-                p.start_color_rand = color_initial_ramp->get_color_at_offset(Math::randf());
+                p.start_color_rand = color_initial_ramp->get_color_at_offset(rng.randf());
             } else {
                 p.start_color_rand = Color(1, 1, 1, 1);
             }
 
             float angle1_rad =
-                    Math::atan2(direction.y, direction.x) + (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+                    Math::atan2(direction.y, direction.x) + (rng.randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
             Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
             p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] *
-                         Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
+                         Math::lerp(1.0f, float(rng.randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
 
             float base_angle =
                     (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
@@ -666,7 +723,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
             p.custom[3] = 0.0;
             p.transform = Transform2D();
             p.time = 0;
-            p.lifetime = lifetime * (1.0 - Math::randf() * lifetime_randomness);
+            p.lifetime = lifetime * (1.0 - rng.randf() * lifetime_randomness);
             p.base_color = Color(1, 1, 1, 1);
 
             switch (emission_shape) {
@@ -674,35 +731,35 @@ void CPUParticles2D::_particles_process(float p_delta) {
                     //do none
                 } break;
                 case EMISSION_SHAPE_SPHERE: {
-                    float s = Math::randf(), t = 2.0 * Math_PI * Math::randf();
+                    float s = rng.randf(), t = 2.0 * Math_PI * rng.randf();
                     float radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
                     p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
                 } break;
                 case EMISSION_SHAPE_RECTANGLE: {
                     p.transform[2] =
-                            Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
+                            Vector2(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * emission_rect_extents;
                 } break;
                 case EMISSION_SHAPE_POINTS:
                 case EMISSION_SHAPE_DIRECTED_POINTS: {
 
-                    int pc = emission_points.size();
+                    int pc = p_state->emission_point_count;
                     if (pc == 0)
                         break;
 
-                    int random_idx = Math::rand() % pc;
+                    int random_idx = rng.rand() % pc;
 
-                    p.transform[2] = emission_points.get(random_idx);
+                    p.transform[2] = p_state->emission_points[random_idx];
 
-                    if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
-                        Vector2 normal = emission_normals.get(random_idx);
+                    if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && p_state->emission_normal_count == pc) {
+                        Vector2 normal = p_state->emission_normals[random_idx];
                         Transform2D m2;
                         m2.set_axis(0, normal);
                         m2.set_axis(1, normal.tangent());
                         p.velocity = m2.basis_xform(p.velocity);
                     }
 
-                    if (emission_colors.size() == pc) {
-                        p.base_color = emission_colors.get(random_idx);
+                    if (p_state->emission_color_count == pc) {
+                        p.base_color = p_state->emission_colors[random_idx];
                     }
                 } break;
                 case EMISSION_SHAPE_MAX: { // Max value for validity check.
@@ -906,32 +963,14 @@ void CPUParticles2D::_particles_process(float p_delta) {
     }
 }
 
-void CPUParticles2D::_update_particle_data_buffer() {
-
-    MutexGuard guard(update_mutex);
-
-    int pc = particles.size();
-
-    PoolVector<int>::Write ow;
-    int *order = nullptr;
+void CPUParticles2D::_pack_particles_chunk(uint32_t p_chunk, PackState *p_state) {
+    const Particle *r = p_state->particles;
+    const int *order = p_state->order;
+    const int from = p_chunk * ParticleUtils::CHUNK_SIZE;
+    const int to = MIN(p_state->particle_count, from + ParticleUtils::CHUNK_SIZE);
 
-    auto &w = particle_data;
-    PoolVector<Particle>::Read r = particles.read();
-    float *ptr = w.data();
-
-    if (draw_order != DRAW_ORDER_INDEX) {
-        ow = particle_order.write();
-        order = ow.ptr();
-
-        for (int i = 0; i < pc; i++) {
-            order[i] = i;
-        }
-        if (draw_order == DRAW_ORDER_LIFETIME) {
-            eastl::sort(order, order + pc, SortLifetime());
-        }
-    }
-
-    for (int i = 0; i < pc; i++, ptr += 13) {
+    float *ptr = p_state->dest + from * 13;
+    for (int i = from; i < to; i++, ptr += 13) {
 
         int idx = order ? order[i] : i;
         if (!r[idx].active) {
@@ -966,7 +1005,49 @@ void CPUParticles2D::_update_particle_data_buffer() {
         ptr[11] = r[idx].custom[2];
         ptr[12] = r[idx].custom[3];
     }
+}
 
+void CPUParticles2D::_update_particle_data_buffer() {
+    using namespace ParticleUtils;
+
+    int pc = particles.size();
+
+    PoolVector<int>::Write ow;
+    int *order = nullptr;
+
+    PoolVector<Particle>::Read r = particles.read();
+
+    if (draw_order != DRAW_ORDER_INDEX) {
+        ow = particle_order.write();
+        order = ow.ptr();
+
+        for (int i = 0; i < pc; i++) {
+            order[i] = i;
+        }
+        if (draw_order == DRAW_ORDER_LIFETIME) {
+            SortLifetime sorter;
+            sorter.particles = r.ptr();
+            eastl::sort(order, order + pc, sorter);
+        }
+    }
+
+    // Packed in the back buffer without the lock, the render thread may still
+    // be uploading the front one.
+    PackState state;
+    state.particles = r.ptr();
+    state.order = order;
+    state.dest = particle_data_back.data();
+    state.particle_count = pc;
+
+    const uint32_t chunk_count = (pc + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (chunk_count > 1) {
+        SharedThreadWorkPool::do_work(chunk_count, this, &CPUParticles2D::_pack_particles_chunk, &state);
+    } else if (chunk_count == 1) {
+        _pack_particles_chunk(0, &state);
+    }
+
+    MutexGuard guard(update_mutex);
+    particle_data.swap(particle_data_back);
 }
 
 void CPUParticles2D::_set_redraw(bool p_redraw) {
@@ -1037,6 +1118,7 @@ void CPUParticles2D::_notification(int p_what) {
 
         int pc = particles.size();
 
+        MutexGuard guard(update_mutex);
         auto &w = particle_data;
         PoolVector<Particle>::Read r = particles.read();
         float *ptr = w.data();
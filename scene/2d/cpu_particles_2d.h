@@ -112,9 +112,35 @@ private:
     RenderingEntity multimesh;
 
     PoolVector<Particle> particles;
-    Vector<float> particle_data;
+    Vector<float> particle_data; // uploaded by the render thread
+    Vector<float> particle_data_back;
     PoolVector<int> particle_order;
 
+    // State shared by the chunks of particles processed in parallel.
+    struct ProcessState {
+        Particle *particles;
+        int particle_count;
+        Transform2D emission_xform;
+        Transform2D velocity_xform;
+        float delta;
+        float prev_time;
+        float system_phase;
+        const Vector2 *emission_points;
+        const Vector2 *emission_normals;
+        const Color *emission_colors;
+        int emission_point_count;
+        int emission_normal_count;
+        int emission_color_count;
+        Vector<uint32_t> chunk_seeds;
+    };
+
+    struct PackState {
+        const Particle *particles;
+        const int *order;
+        float *dest;
+        int particle_count;
+    };
+
     struct SortLifetime {
         const Particle *particles;
 
@@ -181,6 +207,8 @@ private:
 
     void _update_internal();
     void _particles_process(float p_delta);
+    void _particles_process_chunk(uint32_t p_chunk, ProcessState *p_state);
+    void _pack_particles_chunk(uint32_t p_chunk, PackState *p_state);
     void _update_particle_data_buffer();
 
     void _update_render_thread();
@@ -31,10 +31,12 @@
 #include "cpu_particles_3d.h"
 
 #include "core/callable_method_pointer.h"
+#include "core/math/random_pcg.h"
 #include "core/method_bind.h"
 #include "core/object_tooling.h"
 #include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 #include "core/translation_helpers.h"
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
@@ -94,6 +96,7 @@ void CPUParticles3D::set_amount(int p_amount) {
     }
 
     particle_data.resize((12 + 4 + 1) * p_amount);
+    particle_data_back.resize((12 + 4 + 1) * p_amount);
     RenderingServer::get_singleton()->multimesh_allocate(
             multimesh, p_amount, RS::MULTIMESH_TRANSFORM_3D, RS::MULTIMESH_COLOR_8BIT, RS::MULTIMESH_CUSTOM_DATA_FLOAT);
 
@@ -723,8 +726,64 @@ void CPUParticles3D::_particles_process(float p_delta) {
         velocity_xform = emission_xform.basis;
     }
 
-    float system_phase = time / lifetime;
-    real_t physics_tick_delta = 1.0f / Engine::get_singleton()->get_iterations_per_second();
+    // Gradients sort their points on first use, which must not happen on the workers.
+    if (color_ramp) {
+        color_ramp->get_color_at_offset(0);
+    }
+    if (color_initial_ramp) {
+        color_initial_ramp->get_color_at_offset(0);
+    }
+
+    PoolVector<Vector3>::Read emission_points_r = emission_points.read();
+    PoolVector<Vector3>::Read emission_normals_r = emission_normals.read();
+    PoolVector<Color>::Read emission_colors_r = emission_colors.read();
+
+    ProcessState state;
+    state.particles = parray;
+    state.particle_count = pcount;
+    state.emission_xform = emission_xform;
+    state.velocity_xform = velocity_xform;
+    state.delta = p_delta;
+    state.prev_time = prev_time;
+    state.system_phase = time / lifetime;
+    state.physics_tick_delta = 1.0f / Engine::get_singleton()->get_iterations_per_second();
+    state.emission_points = emission_points_r.ptr();
+    state.emission_normals = emission_normals_r.ptr();
+    state.emission_colors = emission_colors_r.ptr();
+    state.emission_point_count = emission_points.size();
+    state.emission_normal_count = emission_normals.size();
+    state.emission_color_count = emission_colors.size();
+
+    // Each chunk draws its random numbers from its own generator, seeded here.
+    const uint32_t chunk_count = (pcount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    state.chunk_seeds.resize(chunk_count);
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        state.chunk_seeds[i] = Math::rand();
+    }
+
+    if (chunk_count > 1) {
+        SharedThreadWorkPool::do_work(chunk_count, this, &CPUParticles3D::_particles_process_chunk, &state);
+    } else if (chunk_count == 1) {
+        _particles_process_chunk(0, &state);
+    }
+}
+
+void CPUParticles3D::_particles_process_chunk(uint32_t p_chunk, ProcessState *p_state) {
+    using namespace ParticleUtils;
+
+    Particle *parray = p_state->particles;
+    const int pcount = p_state->particle_count;
+    const int from = p_chunk * CHUNK_SIZE;
+    const int to = MIN(pcount, from + CHUNK_SIZE);
+
+    RandomPCG rng(p_state->chunk_seeds[p_chunk]);
+
+    const Transform &emission_xform = p_state->emission_xform;
+    const Basis &velocity_xform = p_state->velocity_xform;
+    const float delta = p_state->delta;
+    const float prev_time = p_state->prev_time;
+    const float system_phase = p_state->system_phase;
+    const real_t physics_tick_delta = p_state->physics_tick_delta;
 
     // Streaky particles can "prime" started particles by placing them back in time
     // from the current physics tick, to place them in the position they would have reached
@@ -732,7 +791,7 @@ void CPUParticles3D::_particles_process(float p_delta) {
     bool streaky = _streaky && false && fractional_delta;
     real_t streak_fraction = 1.0f;
 
-    for (int i = 0; i < pcount; i++) {
+    for (int i = from; i < to; i++) {
         Particle &p = parray[i];
 
         if (!emitting && !p.active) {
@@ -740,7 +799,7 @@ void CPUParticles3D::_particles_process(float p_delta) {
         }
 
         // For interpolation we need to keep a record of previous particles
-        float local_delta = p_delta;
+        float local_delta = delta;
 
         // The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
         // While we use time in tests later on, for randomness we use the phase as done in the
@@ -823,28 +882,28 @@ void CPUParticles3D::_particles_process(float p_delta) {
                 tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate(tv);
             }
 
-            p.seed = Math::rand();
+            p.seed = rng.rand();
 
-            p.angle_rand = Math::randf();
-            p.scale_rand = Math::randf();
-            p.hue_rot_rand = Math::randf();
-            p.anim_offset_rand = Math::randf();
+            p.angle_rand = rng.randf();
+            p.scale_rand = rng.randf();
+            p.hue_rot_rand = rng.randf();
+            p.anim_offset_rand = rng.randf();
             if (color_initial_ramp) {
-                p.start_color_rand = color_initial_ramp->get_color_at_offset(Math::randf());
+                p.start_color_rand = color_initial_ramp->get_color_at_offset(rng.randf());
             } else {
                 p.start_color_rand = Color(1, 1, 1, 1);
             }
 
             if (flags[FLAG_DISABLE_Z]) {
                 float angle1_rad = Math::atan2(direction.y, direction.x) +
-                                   (Math::randf() * 2.0f - 1.0f) * Math_PI * spread / 180.0f;
+                                   (rng.randf() * 2.0f - 1.0f) * Math_PI * spread / 180.0f;
                 Vector3 rot = Vector3(Math::cos(angle1_rad), Math::sin(angle1_rad), 0.0);
                 p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] *
-                             Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
+                             Math::lerp(1.0f, float(rng.randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
             } else {
                 // initiate velocity spread in 3D
-                float angle1_rad = (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
-                float angle2_rad = (Math::randf() * 2.0 - 1.0) * (1.0 - flatness) * Math_PI * spread / 180.0;
+                float angle1_rad = (rng.randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+                float angle2_rad = (rng.randf() * 2.0 - 1.0) * (1.0 - flatness) * Math_PI * spread / 180.0;
 
                 Vector3 direction_xz = Vector3(Math::sin(angle1_rad), 0, Math::cos(angle1_rad));
                 Vector3 direction_yz = Vector3(0, Math::sin(angle2_rad), Math::cos(angle2_rad));
@@ -867,7 +926,7 @@ void CPUParticles3D::_particles_process(float p_delta) {
                 spread_direction = binormal * spread_direction.x + normal * spread_direction.y +
                                    direction_nrm * spread_direction.z;
                 p.velocity = spread_direction * parameters[PARAM_INITIAL_LINEAR_VELOCITY] *
-                             Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
+                             Math::lerp(1.0f, float(rng.randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
             }
 
             float base_angle =
@@ -878,7 +937,7 @@ void CPUParticles3D::_particles_process(float p_delta) {
                           Math::lerp(1.0f, p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]); // animation offset (0-1)
             p.transform = Transform();
             p.time = 0;
-            p.lifetime = lifetime * (1.0f - Math::randf() * lifetime_randomness);
+            p.lifetime = lifetime * (1.0f - rng.randf() * lifetime_randomness);
             p.base_color = Color(1, 1, 1, 1);
 
             switch (emission_shape) {
@@ -886,29 +945,29 @@ void CPUParticles3D::_particles_process(float p_delta) {
                     // do none
                 } break;
                 case EMISSION_SHAPE_SPHERE: {
-                    float s = 2.0 * Math::randf() - 1.0f, t = 2.0f * Math_PI * Math::randf();
+                    float s = 2.0 * rng.randf() - 1.0f, t = 2.0f * Math_PI * rng.randf();
                     float radius = emission_sphere_radius * Math::sqrt(1.0f - s * s);
                     p.transform.origin =
                             Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s);
                 } break;
                 case EMISSION_SHAPE_BOX: {
                     p.transform.origin =
-                            Vector3(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) *
+                            Vector3(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) *
                             emission_box_extents;
                 } break;
                 case EMISSION_SHAPE_POINTS:
                 case EMISSION_SHAPE_DIRECTED_POINTS: {
-                    int pc = emission_points.size();
+                    int pc = p_state->emission_point_count;
                     if (pc == 0)
                         break;
 
-                    int random_idx = Math::rand() % pc;
+                    int random_idx = rng.rand() % pc;
 
-                    p.transform.origin = emission_points.get(random_idx);
+                    p.transform.origin = p_state->emission_points[random_idx];
 
-                    if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
+                    if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && p_state->emission_normal_count == pc) {
                         if (flags[FLAG_DISABLE_Z]) {
-                            Vector3 normal = emission_normals.get(random_idx);
+                            Vector3 normal = p_state->emission_normals[random_idx];
                             Vector2 normal_2d(normal.x, normal.y);
                             Transform2D m2;
                             m2.set_axis(0, normal_2d);
@@ -918,7 +977,7 @@ void CPUParticles3D::_particles_process(float p_delta) {
                             p.velocity.x = velocity_2d.x;
                             p.velocity.y = velocity_2d.y;
                         } else {
-                            Vector3 normal = emission_normals.get(random_idx);
+                            Vector3 normal = p_state->emission_normals[random_idx];
                             Vector3 v0 = Math::abs(normal.z) < 0.999f ? Vector3(0.0, 0.0, 1.0) : Vector3(0, 1.0, 0.0);
                             Vector3 tangent = v0.cross(normal).normalized();
                             Vector3 bitangent = tangent.cross(normal).normalized();
@@ -930,13 +989,13 @@ void CPUParticles3D::_particles_process(float p_delta) {
                         }
                     }
 
-                    if (emission_colors.size() == pc) {
-                        p.base_color = emission_colors.get(random_idx);
+                    if (p_state->emission_color_count == pc) {
+                        p.base_color = p_state->emission_colors[random_idx];
                     }
                 } break;
                 case EMISSION_SHAPE_RING: {
-                    float ring_random_angle = Math::randf() * 2.0 * Math_PI;
-                    float ring_random_radius = Math::randf() * (emission_ring_radius - emission_ring_inner_radius) +
+                    float ring_random_angle = rng.randf() * 2.0 * Math_PI;
+                    float ring_random_radius = rng.randf() * (emission_ring_radius - emission_ring_inner_radius) +
                                                emission_ring_inner_radius;
                     Vector3 axis = emission_ring_axis.normalized();
                     Vector3 ortho_axis = Vector3();
@@ -949,7 +1008,7 @@ void CPUParticles3D::_particles_process(float p_delta) {
                     ortho_axis.rotate(axis, ring_random_angle);
                     ortho_axis = ortho_axis.normalized();
                     p.transform.origin = ortho_axis * ring_random_radius +
-                                         (Math::randf() * emission_ring_height - emission_ring_height / 2.0f) * axis;
+                                         (rng.randf() * emission_ring_height - emission_ring_height / 2.0f) * axis;
                 }
                 case EMISSION_SHAPE_MAX: { // Max value for validity check.
                     break;
@@ -961,8 +1020,6 @@ void CPUParticles3D::_particles_process(float p_delta) {
                 // Apply streaking interpolation of start positions between ticks
                 if (streaky) {
                     WARN_PRINT_ONCE("CPUParticle streaks require interpolation?");
-                    emission_xform = get_global_transform(); //_get_global_transform_interpolated(streak_fraction);
-                    velocity_xform = emission_xform.basis;
                     p.velocity = velocity_xform.xform(p.velocity);
                     // prime the particle by moving "backward" in time
                     real_t adjusted_delta = (1.0f - streak_fraction) * physics_tick_delta;
@@ -1129,20 +1186,32 @@ static void _fill_particle_data(const CpuParticleBase &p_source, float *r_dest,
     r_dest[16] = p_source.custom[3];
 }
 
+void CPUParticles3D::_pack_particles_chunk(uint32_t p_chunk, PackState *p_state) {
+    const Particle *r = p_state->particles;
+    const int *order = p_state->order;
+    const int from = p_chunk * ParticleUtils::CHUNK_SIZE;
+    const int to = MIN(p_state->particle_count, from + ParticleUtils::CHUNK_SIZE);
+
+    float *ptr = p_state->dest + from * 17;
+    for (int i = from; i < to; i++) {
+        int idx = order ? order[i] : i;
+        _fill_particle_data(r[idx], ptr, r[idx].active);
+        ptr += 17;
+    }
+}
+
 void CPUParticles3D::_update_particle_data_buffer() {
-    MutexLock guard(update_mutex);
+    using namespace ParticleUtils;
 
     int pc = particles.size();
 
     int *order = nullptr;
 
-    auto &w = particle_data;
     PoolVector<Particle>::Read r = particles.read();
-    float *ptr = w.data();
-    float *ptr_prev = nullptr;
+    PoolVector<int>::Write ow;
 
     if (draw_order != DRAW_ORDER_INDEX) {
-        PoolVector<int>::Write ow = particle_order.write();
+        ow = particle_order.write();
         order = ow.ptr();
 
         for (int i = 0; i < pc; i++) {
@@ -1173,12 +1242,23 @@ void CPUParticles3D::_update_particle_data_buffer() {
         }
     }
 
-
-    for (int i = 0; i < pc; i++) {
-        int idx = order ? order[i] : i;
-        _fill_particle_data(r[idx], ptr, r[idx].active);
-        ptr += 17;
+    // Packed in the back buffer without the lock, the render thread may still
+    // be uploading the front one.
+    PackState state;
+    state.particles = r.ptr();
+    state.order = order;
+    state.dest = particle_data_back.data();
+    state.particle_count = pc;
+
+    const uint32_t chunk_count = (pc + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (chunk_count > 1) {
+        SharedThreadWorkPool::do_work(chunk_count, this, &CPUParticles3D::_pack_particles_chunk, &state);
+    } else if (chunk_count == 1) {
+        _pack_particles_chunk(0, &state);
     }
+
+    MutexLock guard(update_mutex);
+    particle_data.swap(particle_data_back);
     can_update.set();
 }
 
@@ -1209,7 +1289,6 @@ void CPUParticles3D::_update_render_thread() {
     }
     MutexLock guard(update_mutex);
     if (can_update.is_set()) {
-        RenderingServer::get_singleton()->multimesh_set_as_bulk_array(multimesh, particle_data);
         RenderingServer::get_singleton()->multimesh_set_as_bulk_array(multimesh, particle_data);
         can_update.clear(); // wait for next time
     }
@@ -133,9 +133,36 @@ private:
     RenderingEntity multimesh;
 
     PoolVector<Particle> particles;
-    Vector<float> particle_data;
+    Vector<float> particle_data; // uploaded by the render thread
+    Vector<float> particle_data_back;
     PoolVector<int> particle_order;
 
+    // State shared by the chunks of particles processed in parallel.
+    struct ProcessState {
+        Particle *particles;
+        int particle_count;
+        Transform emission_xform;
+        Basis velocity_xform;
+        float delta;
+        float prev_time;
+        float system_phase;
+        real_t physics_tick_delta;
+        const Vector3 *emission_points;
+        const Vector3 *emission_normals;
+        const Color *emission_colors;
+        int emission_point_count;
+        int emission_normal_count;
+        int emission_color_count;
+        Vector<uint32_t> chunk_seeds;
+    };
+
+    struct PackState {
+        const Particle *particles;
+        const int *order;
+        float *dest;
+        int particle_count;
+    };
+
     struct SortLifetime {
         const Particle *particles;
 
@@ -203,6 +230,8 @@ private:
     void _update_internal(bool p_on_physics_tick);
     void _particle_process(const Transform &emission_xform, Particle &p, float local_delta, float &tv) const;
     void _particles_process(float p_delta);
+    void _particles_process_chunk(uint32_t p_chunk, ProcessState *p_state);
+    void _pack_particles_chunk(uint32_t p_chunk, PackState *p_state);
     void _update_particle_data_buffer();
 
     Mutex update_mutex;
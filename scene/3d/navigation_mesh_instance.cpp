@@ -211,6 +211,21 @@ void NavigationMeshInstance::_bake_finished(Ref<NavigationMesh> p_nav_mesh) {
     bake_thread.wait_to_finish();
 }
 
+void NavigationMeshInstance::rebake_navigation_mesh_region(const AABB &p_region) {
+    ERR_FAIL_COND_MSG(!navmesh, "Can't rebake the navigation mesh if the `NavigationMesh` resource doesn't exist");
+    ERR_FAIL_COND_MSG(bake_thread.is_started(), "Can't rebake the navigation mesh while it's being baked.");
+
+    NavigationServer::get_singleton()->region_rebake_navmesh(navmesh, this, p_region);
+    // The region copies the polygons when its mesh is set, set it again to swap in the new tiles.
+    NavigationServer::get_singleton()->region_set_navmesh(region, navmesh);
+
+    if (debug_view) {
+        object_cast<MeshInstance3D>(debug_view)->set_mesh(navmesh->get_debug_mesh());
+    }
+
+    emit_signal("bake_finished");
+}
+
 String NavigationMeshInstance::get_configuration_warning() const {
 
     if (!is_visible_in_tree() || !is_inside_tree())
@@ -255,6 +270,7 @@ void NavigationMeshInstance::_bind_methods() {
 
     SE_BIND_METHOD(NavigationMeshInstance,bake_navigation_mesh);
     SE_BIND_METHOD(NavigationMeshInstance,_bake_finished);
+    SE_BIND_METHOD(NavigationMeshInstance,rebake_navigation_mesh_region);
 
     ADD_PROPERTY(PropertyInfo(VariantType::OBJECT, "navmesh", PropertyHint::ResourceType, "NavigationMesh"), "set_navigation_mesh", "get_navigation_mesh");
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "enabled"), "set_enabled", "is_enabled");
@@ -65,6 +65,9 @@ public:
     /// sets the new navigation mesh and emits a signal
     void bake_navigation_mesh();
     void _bake_finished(Ref<NavigationMesh> p_nav_mesh);
+    /// Rebakes, on the calling thread, the tiles of the navigation mesh overlapping
+    /// `p_region` (in global space) and updates the navigation region right away.
+    void rebake_navigation_mesh_region(const AABB &p_region);
 
     String get_configuration_warning() const override;
 
@@ -96,6 +96,7 @@ bool Skeleton::_set(const StringName &p_path, const Variant &p_value) {
         Array children = p_value.as<Array>();
 
         if (is_inside_tree()) {
+            bound_node_count -= bones[which].nodes_bound.size();
             bones[which].nodes_bound.clear();
 
             for (int i = 0; i < children.size(); i++) {
@@ -216,105 +217,126 @@ void Skeleton::_update_process_order() {
         ERR_PRINT("Skeleton parenthood graph is cyclic");
     }
 
-    process_order_dirty = false;
-}
-
-void Skeleton::_notification(int p_what) {
+    // Move the pose data of every bone to the slot matching its process order.
+    auto reorder = [this, order, len](auto &r_slots, int p_offset) {
+        auto sorted = r_slots;
+        for (int i = 0; i < len; i++) {
+            sorted[p_offset + i] = r_slots[p_offset + bone_slots[order[i]]];
+        }
+        r_slots.swap(sorted);
+    };
+    reorder(slot_flags, 0);
+    reorder(slot_rests, 0);
+    reorder(slot_poses, 0);
+    reorder(slot_custom_poses, 0);
+    reorder(slot_global_poses, 1);
+    reorder(slot_global_poses_no_override, 1);
 
-    switch (p_what) {
+    for (int i = 0; i < len; i++) {
+        bone_slots[order[i]] = i;
+    }
+    for (int i = 0; i < len; i++) {
+        int parent = bonesptr[order[i]].parent;
+        slot_parents[i] = parent >= 0 ? bone_slots[parent] + 1 : 0;
+    }
 
-        case NOTIFICATION_UPDATE_SKELETON: {
+    process_order_dirty = false;
+}
 
-            RenderingServer *vs = RenderingServer::get_singleton();
-            Bone *bonesptr = bones.data();
-            int len = bones.size();
+void Skeleton::_update_local_poses() {
 
+    const int len = slot_flags.size();
+    const uint8_t *flags = slot_flags.data();
+    const Transform *rests = slot_rests.data();
+    const Transform *poses = slot_poses.data();
+    const Transform *custom_poses = slot_custom_poses.data();
+    Transform *local_poses = slot_local_poses.data();
 
-            _update_process_order();
+    for (int i = 0; i < len; i++) {
 
-            const int *order = process_order.data();
+        const uint8_t f = flags[i];
+        Transform local;
+        if (f & SLOT_ENABLED) {
+            local = (f & SLOT_CUSTOM_POSE) ? custom_poses[i] * poses[i] : poses[i];
+            if (!(f & SLOT_DISABLE_REST)) {
+                local = rests[i] * local;
+            }
+        } else if (!(f & SLOT_DISABLE_REST)) {
+            local = rests[i];
+        }
+        local_poses[i] = local;
+    }
+}
 
+void Skeleton::_update_global_poses() {
 
-            for (int i = 0; i < len; i++) {
+    const int len = slot_parents.size();
+    const int *parents = slot_parents.data();
+    const Transform *local_poses = slot_local_poses.data();
 
-                Bone &b = bonesptr[order[i]];
+    // Parents come first and the roots read the identity at index 0, so the
+    // chain needs no branch.
+    Transform *globals_no_override = slot_global_poses_no_override.data();
+    for (int i = 0; i < len; i++) {
+        globals_no_override[i + 1] = globals_no_override[parents[i]] * local_poses[i];
+    }
 
-                if (b.disable_rest) {
-                    if (b.enabled) {
+    if (!pose_overrides_used) {
+        slot_global_poses = slot_global_poses_no_override;
+        return;
+    }
 
-                        Transform pose = b.pose;
+    // Overridden parents move their children, so this chain is computed apart.
+    Bone *bonesptr = bones.data();
+    const int *order = process_order.data();
+    Transform *globals = slot_global_poses.data();
+    bool overrides_used = false;
 
-                            if (b.custom_pose_enable) {
-                                pose = b.custom_pose * pose;
-                            }
-                        if (b.parent >= 0) {
+    for (int i = 0; i < len; i++) {
 
-                            b.pose_global = bonesptr[b.parent].pose_global * pose;
-                            b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * pose;
-                        } else {
+        Bone &b = bonesptr[order[i]];
+        globals[i + 1] = globals[parents[i]] * local_poses[i];
 
-                            b.pose_global = pose;
-                            b.pose_global_no_override = pose;
-                        }
-                    } else {
-
-                        if (b.parent >= 0) {
+        if (b.global_pose_override_amount >= CMP_EPSILON) {
+            globals[i + 1] = globals[i + 1].interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+        }
 
-                            b.pose_global = bonesptr[b.parent].pose_global;
-                            b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override;
-                        } else {
+        if (b.global_pose_override_reset) {
+            b.global_pose_override_amount = 0.0;
+        }
 
-                            b.pose_global = Transform();
-                            b.pose_global_no_override = Transform();
-                        }
-                    }
+        overrides_used |= b.global_pose_override_amount >= CMP_EPSILON;
+    }
 
-                } else {
-                    if (b.enabled) {
+    pose_overrides_used = overrides_used;
+}
 
-                        Transform pose = b.pose;
+void Skeleton::_notification(int p_what) {
 
-                            if (b.custom_pose_enable) {
-                                pose = b.custom_pose * pose;
-                            }
-                        if (b.parent >= 0) {
+    switch (p_what) {
 
-                            b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
-                            b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * (b.rest * pose);
-                        } else {
+        case NOTIFICATION_UPDATE_SKELETON: {
 
-                            b.pose_global = b.rest * pose;
-                            b.pose_global_no_override = b.rest * pose;
-                        }
-                    } else {
+            RenderingServer *vs = RenderingServer::get_singleton();
+            const Bone *bonesptr = bones.data();
+            int len = bones.size();
 
-                        if (b.parent >= 0) {
+            _update_process_order();
+            _update_local_poses();
+            _update_global_poses();
 
-                            b.pose_global = bonesptr[b.parent].pose_global * b.rest;
-                            b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * b.rest;
-                        } else {
+            if (bound_node_count) {
+                const int *order = process_order.data();
+                for (int i = 0; i < len; i++) {
 
-                            b.pose_global = b.rest;
-                            b.pose_global_no_override = b.rest;
-                        }
-                    }
-                }
+                    for (GameEntity E : bonesptr[order[i]].nodes_bound) {
 
-                    if (b.global_pose_override_amount >= CMP_EPSILON) {
-                        b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+                        Object *obj = object_for_entity(E);
+                        ERR_CONTINUE(!obj);
+                        Node3D *sp = object_cast<Node3D>(obj);
+                        ERR_CONTINUE(!sp);
+                        sp->set_transform(slot_global_poses[i + 1]);
                     }
-
-                if (b.global_pose_override_reset) {
-                    b.global_pose_override_amount = 0.0;
-                }
-
-                for (GameEntity E : b.nodes_bound) {
-
-                    Object *obj = object_for_entity(E);
-                    ERR_CONTINUE(!obj);
-                    Node3D *sp = object_cast<Node3D>(obj);
-                    ERR_CONTINUE(!sp);
-                    sp->set_transform(b.pose_global);
                 }
             }
 
@@ -367,11 +389,19 @@ void Skeleton::_notification(int p_what) {
 
                     E->skeleton_version = version;
                 }
+                E->bone_transforms.resize(bind_count);
+                Transform *palette = E->bone_transforms.data();
                 for (uint32_t i = 0; i < bind_count; i++) {
                     uint32_t bone_index = E->skin_bone_indices_ptrs[i];
-                    ERR_CONTINUE(bone_index >= (uint32_t)len);
-                    vs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
+                    if (bone_index >= (uint32_t)len) {
+                        // Don't leave the transform of a previous update in the reused palette.
+                        palette[i] = Transform();
+                        ERR_PRINT("Skin bind #" + itos(i) + " uses bone index " + itos(bone_index) + ", which is out of range.");
+                        continue;
+                    }
+                    palette[i] = slot_global_poses[bone_slots[bone_index] + 1] * skin->get_bind_pose(i);
                 }
+                vs->skeleton_set_bone_transforms(skeleton, E->bone_transforms);
 
             }
             dirty = false;
@@ -397,6 +427,7 @@ void Skeleton::set_bone_global_pose_override(int p_bone, const Transform &p_pose
     val.global_pose_override_amount = p_amount;
     val.global_pose_override = p_pose;
     val.global_pose_override_reset = !p_persistent;
+    pose_overrides_used = true;
     _make_dirty();
 }
 
@@ -406,7 +437,7 @@ Transform Skeleton::get_bone_global_pose(int p_bone) const {
     if (dirty) {
         const_cast<Skeleton *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
     }
-    return bones[p_bone].pose_global;
+    return slot_global_poses[bone_slots[p_bone] + 1];
 }
 
 Transform Skeleton::get_bone_global_pose_no_override(int p_bone) const {
@@ -414,7 +445,7 @@ Transform Skeleton::get_bone_global_pose_no_override(int p_bone) const {
     if (dirty) {
         const_cast<Skeleton *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
     }
-    return bones[p_bone].pose_global_no_override;
+    return slot_global_poses_no_override[bone_slots[p_bone] + 1];
 }
 // skeleton creation api
 void Skeleton::add_bone(StringView p_name) {
@@ -428,6 +459,17 @@ void Skeleton::add_bone(StringView p_name) {
     Bone b;
     b.name = p_name;
     bones.push_back(b);
+
+    bone_slots.push_back(slot_flags.size());
+    slot_parents.push_back(0);
+    slot_flags.push_back(SLOT_ENABLED);
+    slot_rests.push_back(Transform());
+    slot_poses.push_back(Transform());
+    slot_custom_poses.push_back(Transform());
+    slot_local_poses.push_back(Transform());
+    slot_global_poses.push_back(Transform());
+    slot_global_poses_no_override.push_back(Transform());
+
     process_order_dirty = true;
     version++;
 
@@ -501,9 +543,10 @@ void Skeleton::unparent_bone_and_rest(int p_bone) {
 
     _update_process_order();
 
+    Transform &rest = slot_rests[bone_slots[p_bone]];
     int parent = bones[p_bone].parent;
     while (parent >= 0) {
-        bones[p_bone].rest = bones[parent].rest * bones[p_bone].rest;
+        rest = slot_rests[bone_slots[parent]] * rest;
         parent = bones[parent].parent;
     }
 
@@ -516,13 +559,15 @@ void Skeleton::unparent_bone_and_rest(int p_bone) {
 void Skeleton::set_bone_disable_rest(int p_bone, bool p_disable) {
 
     ERR_FAIL_INDEX(p_bone, bones.size());
-    bones[p_bone].disable_rest = p_disable;
+
+    uint8_t &flags = slot_flags[bone_slots[p_bone]];
+    flags = p_disable ? flags | SLOT_DISABLE_REST : flags & ~SLOT_DISABLE_REST;
 }
 
 bool Skeleton::is_bone_rest_disabled(int p_bone) const {
 
     ERR_FAIL_INDEX_V(p_bone, bones.size(), false);
-    return bones[p_bone].disable_rest;
+    return slot_flags[bone_slots[p_bone]] & SLOT_DISABLE_REST;
 }
 
 int Skeleton::get_bone_parent(int p_bone) const {
@@ -536,27 +581,28 @@ void Skeleton::set_bone_rest(int p_bone, const Transform &p_rest) {
 
     ERR_FAIL_INDEX(p_bone, bones.size());
 
-    bones[p_bone].rest = p_rest;
+    slot_rests[bone_slots[p_bone]] = p_rest;
     _make_dirty();
 }
 Transform Skeleton::get_bone_rest(int p_bone) const {
 
     ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
 
-    return bones[p_bone].rest;
+    return slot_rests[bone_slots[p_bone]];
 }
 
 void Skeleton::set_bone_enabled(int p_bone, bool p_enabled) {
 
     ERR_FAIL_INDEX(p_bone, bones.size());
 
-    bones[p_bone].enabled = p_enabled;
+    uint8_t &flags = slot_flags[bone_slots[p_bone]];
+    flags = p_enabled ? flags | SLOT_ENABLED : flags & ~SLOT_ENABLED;
     _make_dirty();
 }
 bool Skeleton::is_bone_enabled(int p_bone) const {
 
     ERR_FAIL_INDEX_V(p_bone, bones.size(), false);
-    return bones[p_bone].enabled;
+    return slot_flags[bone_slots[p_bone]] & SLOT_ENABLED;
 }
 
 void Skeleton::bind_child_node_to_bone(int p_bone, Node *p_node) {
@@ -571,6 +617,7 @@ void Skeleton::bind_child_node_to_bone(int p_bone, Node *p_node) {
     }
 
     bones[p_bone].nodes_bound.push_back(id);
+    bound_node_count++;
 }
 void Skeleton::unbind_child_node_from_bone(int p_bone, Node *p_node) {
 
@@ -578,7 +625,10 @@ void Skeleton::unbind_child_node_from_bone(int p_bone, Node *p_node) {
     ERR_FAIL_INDEX(p_bone, bones.size());
 
     auto id = p_node->get_instance_id();
-    bones[p_bone].nodes_bound.erase_first(id);
+    if (bones[p_bone].nodes_bound.contains(id)) {
+        bones[p_bone].nodes_bound.erase_first(id);
+        bound_node_count--;
+    }
 }
 void Skeleton::get_bound_child_nodes_to_bone(int p_bone, Vector<Node *> *p_bound) const {
 
@@ -595,6 +645,16 @@ void Skeleton::get_bound_child_nodes_to_bone(int p_bone, Vector<Node *> *p_bound
 void Skeleton::clear_bones() {
 
     bones.clear();
+    bone_slots.clear();
+    slot_parents.clear();
+    slot_flags.clear();
+    slot_rests.clear();
+    slot_poses.clear();
+    slot_custom_poses.clear();
+    slot_local_poses.clear();
+    slot_global_poses.resize(1);
+    slot_global_poses_no_override.resize(1);
+    bound_node_count = 0;
     process_order_dirty = true;
     version++;
 
@@ -607,7 +667,7 @@ void Skeleton::set_bone_pose(int p_bone, const Transform &p_pose) {
 
     ERR_FAIL_INDEX(p_bone, bones.size());
 
-    bones[p_bone].pose = p_pose;
+    slot_poses[bone_slots[p_bone]] = p_pose;
     if (is_inside_tree()) {
         _make_dirty();
     }
@@ -615,7 +675,7 @@ void Skeleton::set_bone_pose(int p_bone, const Transform &p_pose) {
 Transform Skeleton::get_bone_pose(int p_bone) const {
 
     ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
-    return bones[p_bone].pose;
+    return slot_poses[bone_slots[p_bone]];
 }
 
 void Skeleton::set_bone_custom_pose(int p_bone, const Transform &p_custom_pose) {
@@ -623,8 +683,9 @@ void Skeleton::set_bone_custom_pose(int p_bone, const Transform &p_custom_pose)
     ERR_FAIL_INDEX(p_bone, bones.size());
     //ERR_FAIL_COND( !is_inside_scene() );
 
-    bones[p_bone].custom_pose_enable = (p_custom_pose != Transform());
-    bones[p_bone].custom_pose = p_custom_pose;
+    const int slot = bone_slots[p_bone];
+    slot_flags[slot] = p_custom_pose != Transform() ? slot_flags[slot] | SLOT_CUSTOM_POSE : slot_flags[slot] & ~SLOT_CUSTOM_POSE;
+    slot_custom_poses[slot] = p_custom_pose;
 
     _make_dirty();
 }
@@ -632,7 +693,7 @@ void Skeleton::set_bone_custom_pose(int p_bone, const Transform &p_custom_pose)
 Transform Skeleton::get_bone_custom_pose(int p_bone) const {
 
     ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
-    return bones[p_bone].custom_pose;
+    return slot_custom_poses[bone_slots[p_bone]];
 }
 
 void Skeleton::_make_dirty() {
@@ -658,7 +719,7 @@ void Skeleton::localize_rests() {
     for (int i = bones.size() - 1; i >= 0; i--) {
         int idx = process_order[i];
         if (bones[idx].parent >= 0) {
-            set_bone_rest(idx, bones[bones[idx].parent].rest.affine_inverse() * bones[idx].rest);
+            set_bone_rest(idx, get_bone_rest(bones[idx].parent).affine_inverse() * get_bone_rest(idx));
         }
     }
 }
@@ -847,9 +908,9 @@ Ref<SkinReference> Skeleton::register_skin(const Ref<Skin> &p_skin) {
         for (int i = 0; i < len; i++) {
             const Bone &b = bonesptr[order[i]];
             if (b.parent >= 0) {
-                skin->set_bind_pose(order[i], skin->get_bind_pose(b.parent) * b.rest);
+                skin->set_bind_pose(order[i], skin->get_bind_pose(b.parent) * slot_rests[i]);
             } else {
-                skin->set_bind_pose(order[i], b.rest);
+                skin->set_bind_pose(order[i], slot_rests[i]);
             }
         }
 
@@ -935,6 +996,8 @@ Skeleton::Skeleton() {
     dirty = false;
     version = 1;
     process_order_dirty = true;
+    slot_global_poses.resize(1);
+    slot_global_poses_no_override.resize(1);
 }
 
 Skeleton::~Skeleton() {
@@ -48,6 +48,7 @@ class GODOT_EXPORT SkinReference : public RefCounted {
     friend class Skeleton;
 
     Vector<uint32_t> skin_bone_indices;
+    Vector<Transform> bone_transforms; // reused palette uploaded to the rendering server
     Skeleton *skeleton_node = nullptr;
     RenderingEntity skeleton;
     Ref<Skin> skin;
@@ -70,24 +71,14 @@ class GODOT_EXPORT Skeleton : public Node3D {
     GDCLASS(Skeleton,Node3D)
 private:
     friend class SkinReference;
+    // Cold per bone data, the transforms are stored in the slot arrays below.
     struct Bone {
 
         String name;
 
-        bool enabled;
         int parent;
         int sort_index; //used for re-sorting process order
 
-
-        bool disable_rest;
-        Transform rest;
-
-        Transform pose;
-        Transform pose_global;
-        Transform pose_global_no_override;
-
-        bool custom_pose_enable;
-        Transform custom_pose;
         float global_pose_override_amount;
         bool global_pose_override_reset;
         Transform global_pose_override;
@@ -101,9 +92,6 @@ private:
 
         Bone() {
             parent = -1;
-            enabled = true;
-            disable_rest = false;
-            custom_pose_enable = false;
             global_pose_override_amount = 0;
             global_pose_override_reset = false;
 #ifndef _3D_DISABLED
@@ -117,13 +105,37 @@ private:
     HashSet<SkinReference *> skin_bindings;
     Vector<Bone> bones;
     Vector<int> process_order;
+
+    enum {
+        SLOT_ENABLED = 1,
+        SLOT_DISABLE_REST = 2,
+        SLOT_CUSTOM_POSE = 4,
+    };
+
+    // Hot pose data, stored in process order so a parent always comes before
+    // its children. Slots are reordered when the process order is updated.
+    Vector<int> bone_slots; // bone index -> slot
+    Vector<int> slot_parents; // parent slot + 1, 0 for the root bones
+    Vector<uint8_t> slot_flags;
+    Vector<Transform> slot_rests;
+    Vector<Transform> slot_poses;
+    Vector<Transform> slot_custom_poses;
+    Vector<Transform> slot_local_poses;
+    // Indexed by slot + 1, entry 0 is the identity the root bones multiply with.
+    Vector<Transform> slot_global_poses;
+    Vector<Transform> slot_global_poses_no_override;
+
     bool process_order_dirty;
     bool dirty;
+    bool pose_overrides_used = false;
+    int bound_node_count = 0;
 
     uint64_t version;
 
     void _skin_changed();
     void _make_dirty();
+    void _update_local_poses();
+    void _update_global_poses();
 public:
     // bind helpers
     Array _get_bound_child_nodes_to_bone(int p_bone) const {
@@ -224,7 +224,7 @@ void AnimationPlayer::_notification(int p_what) {
                 break;
 
             if (processing)
-                _animation_process(get_process_delta_time());
+                _animation_process(get_process_delta_time(), parallel_evaluation);
         } break;
         case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 
@@ -232,7 +232,7 @@ void AnimationPlayer::_notification(int p_what) {
                 break;
 
             if (processing)
-                _animation_process(get_physics_process_delta_time());
+                _animation_process(get_physics_process_delta_time(), parallel_evaluation);
         } break;
         case NOTIFICATION_EXIT_TREE: {
 
@@ -241,6 +241,16 @@ void AnimationPlayer::_notification(int p_what) {
     }
 }
 
+void AnimationPlayer::evaluate_poses() {
+
+    _animation_evaluate_poses();
+}
+
+void AnimationPlayer::apply_poses() {
+
+    _animation_apply_poses();
+}
+
 void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_override) {
 
     // Already cached?
@@ -254,6 +264,8 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_ov
     const Animation *a = p_anim->animation.operator->();
 
     p_anim->node_cache.resize(a->get_track_count());
+    p_anim->key_cursors.clear();
+    p_anim->key_cursors.resize(a->get_track_count(), -1);
 
     for (int i = 0; i < a->get_track_count(); i++) {
 
@@ -325,6 +337,9 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_ov
                 TrackNodeCache::PropertyAnim pa;
                 pa.subpath = leftover_path;
                 pa.object = resource ? (Object *)resource.get() : (Object *)child;
+                if (!leftover_path.empty()) {
+                    pa.handle = pa.object->get_property_handle(leftover_path[0]);
+                }
                 pa.special = SP_NONE;
                 pa.owner = p_anim->node_cache[i];
                 if (false && p_anim->node_cache[i]->node_2d) {
@@ -347,6 +362,7 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_ov
                 TrackNodeCache::BezierAnim ba;
                 ba.bezier_property = leftover_path;
                 ba.object = resource ? (Object *)resource.get() : (Object *)child;
+                ba.handle = ba.object->get_property_handle(leftover_path[0]);
                 ba.owner = p_anim->node_cache[i];
 
                 p_anim->node_cache[i]->bezier_anim[a->track_get_path(i).get_concatenated_subnames()] = ba;
@@ -389,31 +405,21 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
                 if (!nc->spatial)
                     continue;
 
-                Vector3 loc;
-                Quat rot;
-                Vector3 scale;
-
-                Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
-                //ERR_CONTINUE(err!=OK); //used for testing, should be removed
-
-                if (err != OK)
-                    continue;
-
                 if (nc->accum_pass != accum_pass) {
                     ERR_CONTINUE(cache_update_size >= NODE_CACHE_UPDATE_MAX);
                     cache_update[cache_update_size++] = nc;
                     nc->accum_pass = accum_pass;
-                    nc->loc_accum = loc;
-                    nc->rot_accum = rot;
-                    nc->scale_accum = scale;
-
-                } else {
-
-                    nc->loc_accum = nc->loc_accum.linear_interpolate(loc, p_interp);
-                    nc->rot_accum = nc->rot_accum.slerp(rot, p_interp);
-                    nc->scale_accum = nc->scale_accum.linear_interpolate(scale, p_interp);
                 }
 
+                PoseJob job;
+                job.animation = a;
+                job.cache = nc;
+                job.key_cursor = &p_anim->key_cursors[i];
+                job.track = i;
+                job.time = p_time;
+                job.interp = p_interp;
+                pose_jobs.push_back(job);
+
             } break;
             case Animation::TYPE_VALUE: {
 
@@ -432,7 +438,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
                 if (update_mode == Animation::UPDATE_CAPTURE) {
 
                     if (p_started) {
-                        pa->capture = pa->object->get_indexed(pa->subpath);
+                        pa->capture = pa->object->get_indexed(pa->handle, pa->subpath);
                     }
 
                     int key_count = a->track_get_key_count(i);
@@ -504,7 +510,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
                             case SP_NONE: {
                                 bool valid;
-                                pa->object->set_indexed(pa->subpath, value, &valid); //you are not speshul
+                                pa->object->set_indexed(pa->handle, pa->subpath, value, &valid); //you are not speshul
 #ifdef DEBUG_ENABLED
                                 if (!valid) {
                                     ERR_PRINT("Failed setting track value '" + String(pa->owner->path) + "'. Check if property exists or the type of key is valid. Animation '" + a->get_name() + "' at node '" + (String)get_path() + "'.");
@@ -861,7 +867,43 @@ void AnimationPlayer::_animation_process2(float p_delta, bool p_started) {
     }
 }
 
-void AnimationPlayer::_animation_update_transforms() {
+void AnimationPlayer::_animation_evaluate_poses() {
+
+    for (const PoseJob &job : pose_jobs) {
+
+        Vector3 loc;
+        Quat rot;
+        Vector3 scale;
+
+        Error err = job.animation->transform_track_interpolate(job.track, job.time, &loc, &rot, &scale, job.key_cursor);
+        //ERR_CONTINUE(err!=OK); //used for testing, should be removed
+
+        if (err != OK)
+            continue;
+
+        TrackNodeCache *nc = job.cache;
+        if (nc->pose_pass != accum_pass) {
+            nc->pose_pass = accum_pass;
+            nc->loc_accum = loc;
+            nc->rot_accum = rot;
+            nc->scale_accum = scale;
+
+        } else {
+
+            nc->loc_accum = nc->loc_accum.linear_interpolate(loc, job.interp);
+            nc->rot_accum = nc->rot_accum.slerp(rot, job.interp);
+            nc->scale_accum = nc->scale_accum.linear_interpolate(scale, job.interp);
+        }
+    }
+
+    pose_jobs.clear();
+}
+
+void AnimationPlayer::_animation_apply_poses() {
+
+    // Sampled here when nobody evaluated them yet.
+    _animation_evaluate_poses();
+
     {
         for (int i = 0; i < cache_update_size; i++) {
             Transform t;
@@ -869,6 +911,8 @@ void AnimationPlayer::_animation_update_transforms() {
             TrackNodeCache *nc = cache_update[i];
 
             ERR_CONTINUE(nc->accum_pass != accum_pass);
+            if (nc->pose_pass != accum_pass)
+                continue; // no key could be sampled
 
             t.origin = nc->loc_accum;
             t.basis.set_quat_scale(nc->rot_accum, nc->scale_accum);
@@ -884,6 +928,9 @@ void AnimationPlayer::_animation_update_transforms() {
     }
 
     cache_update_size = 0;
+}
+
+void AnimationPlayer::_animation_update_properties() {
 
     for (int i = 0; i < cache_update_prop_size; i++) {
 
@@ -895,7 +942,7 @@ void AnimationPlayer::_animation_update_transforms() {
 
             case SP_NONE: {
                 bool valid;
-                pa->object->set_indexed(pa->subpath, pa->value_accum, &valid); //you are not speshul
+                pa->object->set_indexed(pa->handle, pa->subpath, pa->value_accum, &valid); //you are not speshul
 #ifdef DEBUG_ENABLED
                 if (!valid) {
                     ERR_PRINT("Failed setting key at time " + rtos(playback.current.pos) + " in Animation '" + get_current_animation() + "' at Node '" + (String)get_path() + "', Track '" + String(pa->owner->path) + "'. Check if property exists or the type of key is right for the property");
@@ -939,25 +986,41 @@ void AnimationPlayer::_animation_update_transforms() {
         TrackNodeCache::BezierAnim *ba = cache_update_bezier[i];
 
         ERR_CONTINUE(ba->accum_pass != accum_pass);
-        ba->object->set_indexed(ba->bezier_property, ba->bezier_accum);
+        ba->object->set_indexed(ba->handle, ba->bezier_property, ba->bezier_accum);
     }
 
     cache_update_bezier_size = 0;
 }
 
-void AnimationPlayer::_animation_process(float p_delta) {
+void AnimationPlayer::_animation_update_transforms() {
+
+    _animation_apply_poses();
+    _animation_update_properties();
+}
+
+void AnimationPlayer::_animation_process(float p_delta, bool p_parallel) {
 
     if (playback.current.from) {
 
         end_reached = false;
         end_notify = false;
+        if (!pose_jobs.empty()) {
+            // Still queued from a previous pass, they must be applied first.
+            AnimationPoseBatch::get_singleton()->remove(this);
+            _animation_apply_poses();
+        }
         _animation_process2(p_delta, playback.started);
 
         if (playback.started) {
             playback.started = false;
         }
 
-        _animation_update_transforms();
+        if (p_parallel && is_inside_tree()) {
+            _animation_update_properties();
+            AnimationPoseBatch::get_singleton()->queue(this, get_tree());
+        } else {
+            _animation_update_transforms();
+        }
         if (end_reached) {
             if (!queued.empty()) {
                 const StringName old = playback.assigned;
@@ -1412,6 +1475,12 @@ void AnimationPlayer::clear_caches() {
 
     _stop_playing_caches();
 
+    // Pending jobs point to the caches and may point to removed animations.
+    if (AnimationPoseBatch::get_singleton()) {
+        AnimationPoseBatch::get_singleton()->remove(this);
+    }
+    pose_jobs.clear();
+
     node_cache_map.clear();
 
     for (eastl::pair<const StringName,AnimationData> &E : animation_set) {
@@ -1498,6 +1567,16 @@ AnimationPlayer::AnimationMethodCallMode AnimationPlayer::get_method_call_mode()
     return method_call_mode;
 }
 
+void AnimationPlayer::set_parallel_evaluation(bool p_enabled) {
+
+    parallel_evaluation = p_enabled;
+}
+
+bool AnimationPlayer::is_parallel_evaluation_enabled() const {
+
+    return parallel_evaluation;
+}
+
 void AnimationPlayer::_set_process(bool p_process, bool p_force) {
 
     if (processing == p_process && !p_force)
@@ -1719,6 +1798,9 @@ void AnimationPlayer::_bind_methods() {
     SE_BIND_METHOD(AnimationPlayer,set_method_call_mode);
     SE_BIND_METHOD(AnimationPlayer,get_method_call_mode);
 
+    SE_BIND_METHOD(AnimationPlayer,set_parallel_evaluation);
+    SE_BIND_METHOD(AnimationPlayer,is_parallel_evaluation_enabled);
+
     SE_BIND_METHOD(AnimationPlayer,get_current_animation_position);
     SE_BIND_METHOD(AnimationPlayer,get_current_animation_length);
 
@@ -1739,6 +1821,7 @@ void AnimationPlayer::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "playback_active", PropertyHint::None, "", 0), "set_active", "is_active");
     ADD_PROPERTY(PropertyInfo(VariantType::FLOAT, "playback_speed", PropertyHint::Range, "-64,64,0.01"), "set_speed_scale", "get_speed_scale");
     ADD_PROPERTY(PropertyInfo(VariantType::INT, "method_call_mode", PropertyHint::Enum, "Deferred,Immediate"), "set_method_call_mode", "get_method_call_mode");
+    ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "parallel_evaluation"), "set_parallel_evaluation", "is_parallel_evaluation_enabled");
 
     ADD_SIGNAL(MethodInfo("animation_finished", PropertyInfo(VariantType::STRING, "anim_name")));
     ADD_SIGNAL(MethodInfo("animation_changed", PropertyInfo(VariantType::STRING, "old_name"), PropertyInfo(VariantType::STRING, "new_name")));
@@ -1761,4 +1844,8 @@ AnimationPlayer::AnimationPlayer() :
 }
 
 AnimationPlayer::~AnimationPlayer() {
+
+    if (AnimationPoseBatch::get_singleton()) {
+        AnimationPoseBatch::get_singleton()->remove(this);
+    }
 }
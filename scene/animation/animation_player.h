@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "scene/animation/animation_pose_batch.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
 #include "core/map.h"
@@ -61,7 +62,7 @@ class Node2D;
 class Node3D;
 class Skeleton;
 
-class GODOT_EXPORT AnimationPlayer : public Node {
+class GODOT_EXPORT AnimationPlayer : public Node, private AnimationPoseBatchClient {
     GDCLASS(AnimationPlayer,Node)
 
     OBJ_CATEGORY("Animation Nodes")
@@ -108,6 +109,7 @@ private:
         Quat rot_accum;
         Vector3 scale_accum;
         uint64_t accum_pass;
+        uint64_t pose_pass = 0; // accum_pass of the last sampled transform
 
         bool audio_playing;
         float audio_start;
@@ -120,6 +122,7 @@ private:
             TrackNodeCache *owner = nullptr;
             SpecialProperty special = SP_NONE; // small optimization
             Vector<StringName> subpath;
+            PropertyHandle handle; // resolved subpath[0]
             Object *object = nullptr;
             Variant value_accum;
             uint64_t accum_pass=0;
@@ -131,6 +134,7 @@ private:
         struct BezierAnim {
 
             Vector<StringName> bezier_property;
+            PropertyHandle handle; // resolved bezier_property[0]
             TrackNodeCache *owner = nullptr;
             float bezier_accum = 0.0f;
             Object *object = nullptr;
@@ -176,6 +180,19 @@ private:
     int cache_update_bezier_size = 0;
     HashSet<TrackNodeCache *> playing_caches;
 
+    // Transform tracks are sampled after the other tracks were processed,
+    // on a worker thread when the evaluation is parallel.
+    struct PoseJob {
+        const Animation *animation;
+        TrackNodeCache *cache;
+        int *key_cursor;
+        int track;
+        float time;
+        float interp;
+    };
+
+    Vector<PoseJob> pose_jobs;
+
     uint64_t accum_pass = 1;
     float speed_scale = 1;
     float default_blend_time = 0;
@@ -184,6 +201,7 @@ private:
         String name;
         StringName next;
         Vector<TrackNodeCache *> node_cache;
+        Vector<int> key_cursors; // last key sampled on each track
         Ref<Animation> animation;
     };
 
@@ -235,6 +253,7 @@ private:
     AnimationMethodCallMode method_call_mode = ANIMATION_METHOD_CALL_DEFERRED;
     bool processing = false;
     bool active = true;
+    bool parallel_evaluation = false;
 
     NodePath root;
 
@@ -243,8 +262,14 @@ private:
     void _ensure_node_caches(AnimationData *p_anim, Node *p_root_override = nullptr);
     void _animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started);
     void _animation_process2(float p_delta, bool p_started);
+    void _animation_evaluate_poses();
+    void _animation_apply_poses();
+    void _animation_update_properties();
     void _animation_update_transforms();
-    void _animation_process(float p_delta);
+    void _animation_process(float p_delta, bool p_parallel = false);
+
+    void evaluate_poses() override;
+    void apply_poses() override;
 
     void _node_removed(Node *p_node);
     void _stop_playing_caches();
@@ -316,6 +341,11 @@ public:
     void set_method_call_mode(AnimationMethodCallMode p_mode);
     AnimationMethodCallMode get_method_call_mode() const;
 
+    /// Samples the transform tracks of the players processed in the same
+    /// frame in parallel. The poses are applied at the end of the frame.
+    void set_parallel_evaluation(bool p_enabled);
+    bool is_parallel_evaluation_enabled() const;
+
     void seek(float p_time, bool p_update = false);
     void seek_delta(float p_time, float p_delta);
     float get_current_animation_position() const;
@@ -0,0 +1,92 @@
+/*************************************************************************/
+/*  animation_pose_batch.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "animation_pose_batch.h"
+
+#include "core/os/thread_work_pool.h"
+#include "scene/main/scene_tree.h"
+
+AnimationPoseBatch *AnimationPoseBatch::singleton = nullptr;
+
+void AnimationPoseBatch::_evaluate_client(uint32_t p_index, AnimationPoseBatchClient **p_clients) {
+    p_clients[p_index]->evaluate_poses();
+}
+
+void AnimationPoseBatch::queue(AnimationPoseBatchClient *p_client, SceneTree *p_tree) {
+    ERR_FAIL_COND(!p_tree);
+
+    if (!clients.contains(p_client)) {
+        clients.push_back(p_client);
+    }
+
+    if (!flush_queued) {
+        flush_queued = true;
+        p_tree->call_deferred([]() { AnimationPoseBatch::get_singleton()->flush(); });
+    }
+}
+
+void AnimationPoseBatch::remove(AnimationPoseBatchClient *p_client) {
+    auto it = eastl::find(clients.begin(), clients.end(), p_client);
+    if (it != clients.end()) {
+        clients.erase(it);
+    }
+    // Applying a pose may free another client of the batch.
+    for (AnimationPoseBatchClient *&client : applying) {
+        if (client == p_client) {
+            client = nullptr;
+        }
+    }
+}
+
+void AnimationPoseBatch::flush() {
+    flush_queued = false;
+    if (clients.empty()) {
+        return;
+    }
+
+    SharedThreadWorkPool::do_work(clients.size(), this, &AnimationPoseBatch::_evaluate_client, clients.data());
+
+    // Applying may queue clients again, they will be part of the next flush.
+    applying.swap(clients);
+    for (size_t i = 0; i < applying.size(); i++) {
+        if (applying[i]) {
+            applying[i]->apply_poses();
+        }
+    }
+    applying.clear();
+}
+
+AnimationPoseBatch::AnimationPoseBatch() {
+    singleton = this;
+}
+
+AnimationPoseBatch::~AnimationPoseBatch() {
+    singleton = nullptr;
+}
@@ -0,0 +1,71 @@
+/*************************************************************************/
+/*  animation_pose_batch.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/vector.h"
+
+class SceneTree;
+
+/// Implemented by the nodes that can evaluate their poses in a batch.
+class AnimationPoseBatchClient {
+public:
+    /// Runs on a worker thread, only the client own pose buffers may be touched.
+    virtual void evaluate_poses() = 0;
+    /// Runs on the main thread once every queued client was evaluated.
+    virtual void apply_poses() = 0;
+
+    virtual ~AnimationPoseBatchClient() = default;
+};
+
+/// Collects the animation nodes processed during a frame and evaluates their
+/// poses on the shared work pool when the message queue is flushed, after all the nodes
+/// got their process notification. The poses are then applied serially.
+class AnimationPoseBatch {
+    static AnimationPoseBatch *singleton;
+
+    Vector<AnimationPoseBatchClient *> clients;
+    Vector<AnimationPoseBatchClient *> applying;
+    bool flush_queued = false;
+
+    void _evaluate_client(uint32_t p_index, AnimationPoseBatchClient **p_clients);
+
+public:
+    static AnimationPoseBatch *get_singleton() { return singleton; }
+
+    /// Queues `p_client` until the end of the frame of `p_tree`.
+    void queue(AnimationPoseBatchClient *p_client, SceneTree *p_tree);
+    /// Must be called when a queued client is about to be destroyed.
+    void remove(AnimationPoseBatchClient *p_client);
+    void flush();
+
+    AnimationPoseBatch();
+    ~AnimationPoseBatch();
+};
@@ -552,6 +552,16 @@ AnimationTree::AnimationProcessMode AnimationTree::get_process_mode() const {
     return process_mode;
 }
 
+void AnimationTree::set_parallel_evaluation(bool p_enabled) {
+
+    parallel_evaluation = p_enabled;
+}
+
+bool AnimationTree::is_parallel_evaluation_enabled() const {
+
+    return parallel_evaluation;
+}
+
 void AnimationTree::_node_removed(Node *p_node) {
     cache_valid = false;
 }
@@ -749,6 +759,13 @@ bool AnimationTree::_update_caches(AnimationPlayer *player) {
 
 void AnimationTree::_clear_caches() {
 
+    // Pending jobs point to the caches.
+    if (AnimationPoseBatch::get_singleton()) {
+        AnimationPoseBatch::get_singleton()->remove(this);
+    }
+    pose_jobs.clear();
+    poses_evaluated = false;
+
     for(const auto &e : track_cache) {
         memdelete(e.second);
     }
@@ -758,7 +775,13 @@ void AnimationTree::_clear_caches() {
     cache_valid = false;
 }
 
-void AnimationTree::_process_graph(float p_delta) {
+void AnimationTree::_process_graph(float p_delta, bool p_parallel) {
+
+    if (!pose_jobs.empty()) {
+        // Still queued from a previous pass, they must be applied first.
+        AnimationPoseBatch::get_singleton()->remove(this);
+        _apply_tracks();
+    }
 
     _update_properties(); //if properties need updating, update them
 
@@ -953,35 +976,17 @@ void AnimationTree::_process_graph(float p_delta) {
                             prev_time = 0;
 
                         } else {
-                            Vector3 loc;
-                            Quat rot;
-                            Vector3 scale;
-
-                            Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale);
-                            //ERR_CONTINUE(err!=OK); //used for testing, should be removed
-
-                            if (t->process_pass != process_pass) {
 
-                                t->process_pass = process_pass;
-                                t->loc = loc;
-                                t->rot = rot;
-                                t->rot_blend_accum = 0;
-                                t->scale = scale;
-                            }
+                            PoseJob job;
+                            job.animation = a;
+                            job.cache = t;
+                            job.track = i;
+                            job.time = time;
+                            job.blend = blend;
+                            job.first = t->process_pass != process_pass;
+                            pose_jobs.push_back(job);
 
-                            if (err != OK)
-                                continue;
-
-                            t->loc = t->loc.linear_interpolate(loc, blend);
-                            if (t->rot_blend_accum == 0) {
-                                t->rot = rot;
-                                t->rot_blend_accum = blend;
-                            } else {
-                                float rot_total = t->rot_blend_accum + blend;
-                                t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
-                                t->rot_blend_accum = rot_total;
-                            }
-                            t->scale = t->scale.linear_interpolate(scale, blend);
+                            t->process_pass = process_pass;
                         }
 
                     } break;
@@ -1236,6 +1241,62 @@ void AnimationTree::_process_graph(float p_delta) {
         }
     }
 
+    if (p_parallel && is_inside_tree()) {
+        AnimationPoseBatch::get_singleton()->queue(this, get_tree());
+    } else {
+        _apply_tracks();
+    }
+}
+
+void AnimationTree::_evaluate_poses() {
+
+    for (const PoseJob &job : pose_jobs) {
+
+        TrackCacheTransform *t = job.cache;
+
+        Vector3 loc;
+        Quat rot;
+        Vector3 scale;
+
+        Error err = job.animation->transform_track_interpolate(job.track, job.time, &loc, &rot, &scale);
+        //ERR_CONTINUE(err!=OK); //used for testing, should be removed
+
+        if (job.first) {
+
+            t->loc = loc;
+            t->rot = rot;
+            t->rot_blend_accum = 0;
+            t->scale = scale;
+        }
+
+        if (err != OK)
+            continue;
+
+        t->loc = t->loc.linear_interpolate(loc, job.blend);
+        if (t->rot_blend_accum == 0) {
+            t->rot = rot;
+            t->rot_blend_accum = job.blend;
+        } else {
+            float rot_total = t->rot_blend_accum + job.blend;
+            t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
+            t->rot_blend_accum = rot_total;
+        }
+        t->scale = t->scale.linear_interpolate(scale, job.blend);
+    }
+
+    // The jobs are released by _apply_tracks(), so the animations are never unreferenced on a worker thread.
+    poses_evaluated = true;
+}
+
+void AnimationTree::_apply_tracks() {
+
+    // Sampled here when nobody evaluated them yet.
+    if (!poses_evaluated) {
+        _evaluate_poses();
+    }
+    pose_jobs.clear();
+    poses_evaluated = false;
+
     {
         // finally, set the tracks
         for(const auto &e : track_cache) {
@@ -1292,6 +1353,16 @@ void AnimationTree::_process_graph(float p_delta) {
     }
 }
 
+void AnimationTree::evaluate_poses() {
+
+    _evaluate_poses();
+}
+
+void AnimationTree::apply_poses() {
+
+    _apply_tracks();
+}
+
 void AnimationTree::advance(float p_time) {
 
     _process_graph(p_time);
@@ -1301,11 +1372,11 @@ void AnimationTree::_notification(int p_what) {
 
     if (active && OS::get_singleton()->is_update_pending()) {
         if (p_what == NOTIFICATION_INTERNAL_PHYSICS_PROCESS && process_mode == ANIMATION_PROCESS_PHYSICS) {
-        _process_graph(get_physics_process_delta_time());
+        _process_graph(get_physics_process_delta_time(), parallel_evaluation);
     }
 
         if (p_what == NOTIFICATION_INTERNAL_PROCESS && process_mode == ANIMATION_PROCESS_IDLE) {
-        _process_graph(get_process_delta_time());
+        _process_graph(get_process_delta_time(), parallel_evaluation);
     }
 
     }
@@ -1554,6 +1625,9 @@ void AnimationTree::_bind_methods() {
     SE_BIND_METHOD(AnimationTree,set_process_mode);
     SE_BIND_METHOD(AnimationTree,get_process_mode);
 
+    SE_BIND_METHOD(AnimationTree,set_parallel_evaluation);
+    SE_BIND_METHOD(AnimationTree,is_parallel_evaluation_enabled);
+
     SE_BIND_METHOD(AnimationTree,set_animation_player);
     SE_BIND_METHOD(AnimationTree,get_animation_player);
 
@@ -1570,6 +1644,7 @@ void AnimationTree::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(VariantType::NODE_PATH, "anim_player", PropertyHint::NodePathValidTypes, "AnimationPlayer"), "set_animation_player", "get_animation_player");
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "active"), "set_active", "is_active");
     ADD_PROPERTY(PropertyInfo(VariantType::INT, "process_mode", PropertyHint::Enum, "Physics,Idle,Manual"), "set_process_mode", "get_process_mode");
+    ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "parallel_evaluation"), "set_parallel_evaluation", "is_parallel_evaluation_enabled");
     ADD_GROUP("Root Motion", "root_motion_");
     ADD_PROPERTY(PropertyInfo(VariantType::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
 
@@ -1584,4 +1659,8 @@ AnimationTree::AnimationTree() {
 }
 
 AnimationTree::~AnimationTree() {
+
+    if (AnimationPoseBatch::get_singleton()) {
+        AnimationPoseBatch::get_singleton()->remove(this);
+    }
 }
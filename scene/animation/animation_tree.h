@@ -31,6 +31,7 @@
 #pragma once
 
 #include "scene/animation/animation_player.h"
+#include "scene/animation/animation_pose_batch.h"
 #include "core/hash_map.h"
 #include "core/hash_set.h"
 #include "scene/3d/skeleton_3d.h"
@@ -158,7 +159,7 @@ public:
     AnimationRootNode() {}
 };
 
-class GODOT_EXPORT AnimationTree : public Node {
+class GODOT_EXPORT AnimationTree : public Node, private AnimationPoseBatchClient {
     GDCLASS(AnimationTree,Node)
 
 public:
@@ -251,6 +252,21 @@ private:
     HashMap<NodePath, TrackCache *> track_cache;
     HashSet<TrackCache *> playing_caches;
 
+    // Transform tracks are sampled and blended after the graph was processed,
+    // on a worker thread when the evaluation is parallel. The jobs keep their
+    // animation alive, the player may drop or replace it before the batch flush.
+    struct PoseJob {
+        Ref<Animation> animation;
+        TrackCacheTransform *cache;
+        int track;
+        float time;
+        float blend;
+        bool first;
+    };
+
+    Vector<PoseJob> pose_jobs;
+    bool poses_evaluated = false;
+
     Ref<AnimationNode> root;
 
     AnimationProcessMode process_mode=ANIMATION_PROCESS_IDLE;
@@ -275,6 +291,7 @@ private:
     bool cache_valid = false;
     bool started = true;
     bool properties_dirty=true;
+    bool parallel_evaluation = false;
 
     friend class AnimationNode;
 
@@ -282,11 +299,15 @@ private:
 
     void _clear_caches();
     bool _update_caches(AnimationPlayer *player);
-    void _process_graph(float p_delta);
+    void _process_graph(float p_delta, bool p_parallel = false);
+    void _evaluate_poses();
+    void _apply_tracks();
     void _tree_changed();
     void _update_properties();
     void _update_properties_for_node(const StringName &p_base_path, Ref<AnimationNode> node);
 
+    void evaluate_poses() override;
+    void apply_poses() override;
 
 protected:
     bool _set(const StringName &p_name, const Variant &p_value);
@@ -306,6 +327,11 @@ public:
     void set_process_mode(AnimationProcessMode p_mode);
     AnimationProcessMode get_process_mode() const;
 
+    /// Samples and blends the transform tracks of the trees processed in the
+    /// same frame in parallel. The tracks are applied at the end of the frame.
+    void set_parallel_evaluation(bool p_enabled);
+    bool is_parallel_evaluation_enabled() const;
+
     void set_animation_player(const NodePath &p_player);
     NodePath get_animation_player() const;
 
@@ -320,7 +320,7 @@ Variant Tween::_get_initial_val(const InterpolateData &p_data) const {
             if (p_data.type == TARGETING_PROPERTY) {
                 // Get the property from the target object
                 bool valid = false;
-                initial_val = object->get_indexed(p_data.target_key, &valid);
+                initial_val = object->get_indexed(p_data.target_key_handle, p_data.target_key, &valid);
                 ERR_FAIL_COND_V(!valid, p_data.initial_val);
             } else {
                 // Call the method and get the initial value from it
@@ -352,7 +352,7 @@ Variant Tween::_get_final_val(const InterpolateData &p_data) const {
             if (p_data.type == FOLLOW_PROPERTY) {
                 // Read the property as-is
                 bool valid = false;
-                final_val = target->get_indexed(p_data.target_key, &valid);
+                final_val = target->get_indexed(p_data.target_key_handle, p_data.target_key, &valid);
                 ERR_FAIL_COND_V(!valid, p_data.initial_val);
             } else {
                 // We're looking at a method. Call the method on the target object
@@ -393,7 +393,7 @@ const Variant &Tween::_get_delta_val(InterpolateData &p_data) {
             if (p_data.type == FOLLOW_PROPERTY) {
                 // Read the property as-is
                 bool valid = false;
-                final_val = target->get_indexed(p_data.target_key, &valid);
+                final_val = target->get_indexed(p_data.target_key_handle, p_data.target_key, &valid);
                 ERR_FAIL_COND_V(!valid, p_data.initial_val);
             } else {
                 // We're looking at a method. Call the method on the target object
@@ -632,7 +632,7 @@ bool Tween::_apply_tween_value(InterpolateData &p_data, Variant &value) {
         case TARGETING_PROPERTY: {
             // Simply set the property on the object
             bool valid = false;
-            object->set_indexed(p_data.key, value, &valid);
+            object->set_indexed(p_data.key_handle, p_data.key, value, &valid);
             return valid;
         }
 
@@ -1317,6 +1317,7 @@ bool Tween::_build_interpolation(InterpolateType p_interpolation_type, Object *p
         ERR_FAIL_COND_V_MSG(!prop_valid, false, String("Tween target object has no property named: ") + p_property->get_concatenated_subnames() + ".");
 
         data.key = p_property->get_subnames();
+        data.key_handle = p_object->get_property_handle(data.key[0]);
         data.concatenated_key = p_property->get_concatenated_subnames();
     }
 
@@ -1574,10 +1575,12 @@ bool Tween::follow_property(Object *p_object, NodePath p_property, Variant p_ini
     // Give the InterpolateData it's configuration
     data.id = p_object->get_instance_id();
     data.key = p_property.get_subnames();
+    data.key_handle = p_object->get_property_handle(data.key[0]);
     data.concatenated_key = p_property.get_concatenated_subnames();
     data.initial_val = p_initial_val;
     data.target_id = p_target->get_instance_id();
     data.target_key = p_target_property.get_subnames();
+    data.target_key_handle = p_target->get_property_handle(data.target_key[0]);
     data.duration = p_duration;
     data.trans_type = p_trans_type;
     data.ease_type = p_ease_type;
@@ -1713,9 +1716,11 @@ bool Tween::targeting_property(Object *p_object, NodePath p_property, Object *p_
     // Give the data it's configuration
     data.id = p_object->get_instance_id();
     data.key = p_property.get_subnames();
+    data.key_handle = p_object->get_property_handle(data.key[0]);
     data.concatenated_key = p_property.get_concatenated_subnames();
     data.target_id = p_initial->get_instance_id();
     data.target_key = p_initial_property.get_subnames();
+    data.target_key_handle = p_initial->get_property_handle(data.target_key[0]);
     data.initial_val = initial_val;
     data.final_val = p_final_val;
     data.duration = p_duration;
@@ -88,12 +88,14 @@ private:
         real_t elapsed;
         GameEntity id;
         Vector<StringName> key;
+        PropertyHandle key_handle; // resolved key[0] for property tweens
         StringName concatenated_key;
         Variant initial_val;
         Variant delta_val;
         Variant final_val;
         GameEntity target_id;
         Vector<StringName> target_key;
+        PropertyHandle target_key_handle; // resolved target_key[0] for property targets
         real_t duration;
         TransitionType trans_type;
         EaseType ease_type;
@@ -76,6 +76,7 @@
 #include "scene/animation/animation_blend_tree.h"
 #include "scene/animation/animation_node_state_machine.h"
 #include "scene/animation/animation_player.h"
+#include "scene/animation/animation_pose_batch.h"
 #include "scene/animation/animation_tree.h"
 #include "scene/animation/animation_tree_player.h"
 #include "scene/animation/root_motion_view.h"
@@ -246,10 +247,14 @@ static Ref<ResourceFormatLoaderBMFont> resource_loader_bmfont;
 static Ref<ResourceFormatSaverShader> resource_saver_shader;
 static Ref<ResourceFormatLoaderShader> resource_loader_shader;
 
+static AnimationPoseBatch *animation_pose_batch = nullptr;
+
 void register_scene_types() {
 
     SceneStringNames::create();
 
+    animation_pose_batch = memnew(AnimationPoseBatch);
+
     OS::get_singleton()->yield(); //may take time to init
 
     Node::init_node_hrcr();
@@ -1206,5 +1211,6 @@ void unregister_scene_types() {
 
     ParticlesMaterial::finish_shaders();
     CanvasItemMaterial::finish_shaders();
+    memdelete(animation_pose_batch);
     SceneStringNames::free();
 }
@@ -45,7 +45,17 @@ RES_BASE_EXTENSION_IMPL(Animation,"anim")
 
 namespace {
     template <class K>
-    inline int _key_find(const Vector<K> &p_keys, float p_time) {
+    inline float _key_time(const Vector<K> &p_keys, int p_idx) {
+        return p_keys[p_idx].time;
+    }
+
+    template <class C>
+    inline float _key_time(const C &p_keys, int p_idx) {
+        return p_keys.get_time(p_idx);
+    }
+
+    template <class C>
+    inline int _key_find(const C &p_keys, float p_time) {
 
         int len = p_keys.size();
         if (len == 0)
@@ -61,25 +71,194 @@ namespace {
         }
     #endif
 
-        const K *keys = &p_keys[0];
-
         while (low <= high) {
 
             middle = (low + high) / 2;
+            const float middle_time = _key_time(p_keys, middle);
 
-            if (Math::is_equal_approx(p_time, keys[middle].time)) { //match
+            if (Math::is_equal_approx(p_time, middle_time)) { //match
                 return middle;
-            } else if (p_time < keys[middle].time)
+            } else if (p_time < middle_time)
                 high = middle - 1; //search low end of array
             else
                 low = middle + 1; //search high end of array
         }
 
-        if (keys[middle].time > p_time)
+        if (_key_time(p_keys, middle) > p_time)
             middle--;
 
         return middle;
     }
+
+    template <class C>
+    inline int _key_find(const C &p_keys, float p_time, int *r_cursor) {
+
+        if (!r_cursor)
+            return _key_find(p_keys, p_time);
+
+        // While playing, the time usually stays on the cached key or moves to the next one.
+        const int len = p_keys.size();
+        const int cursor = *r_cursor;
+        if (cursor >= 0 && cursor < len && _key_time(p_keys, cursor) <= p_time) {
+            if (cursor + 1 == len || p_time < _key_time(p_keys, cursor + 1))
+                return cursor;
+            if (cursor + 2 == len || p_time < _key_time(p_keys, cursor + 2)) {
+                *r_cursor = cursor + 1;
+                return cursor + 1;
+            }
+        }
+
+        *r_cursor = _key_find(p_keys, p_time);
+        return *r_cursor;
+    }
+
+    inline uint16_t _quantize_unit(float p_value) {
+        return uint16_t(CLAMP(p_value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    }
+
+    inline float _dequantize_unit(uint16_t p_value) {
+        return p_value * (1.0f / 65535.0f);
+    }
+
+    inline void _quantize_range(const Vector3 &p_value, const Vector3 &p_min, const Vector3 &p_range, uint16_t *r_out) {
+        for (int i = 0; i < 3; i++) {
+            r_out[i] = p_range[i] > 0.0f ? _quantize_unit((p_value[i] - p_min[i]) / p_range[i]) : 0;
+        }
+    }
+
+    inline Vector3 _dequantize_range(const uint16_t *p_in, const Vector3 &p_min, const Vector3 &p_range) {
+        return Vector3(
+                p_min.x + _dequantize_unit(p_in[0]) * p_range.x,
+                p_min.y + _dequantize_unit(p_in[1]) * p_range.y,
+                p_min.z + _dequantize_unit(p_in[2]) * p_range.z);
+    }
+
+    // Smallest three: the biggest component is dropped and rebuilt from the
+    // others, which then fit in [-sqrt(1/2), sqrt(1/2)]. They use 15 bits each,
+    // the index of the dropped one is kept in the top bits of the first two.
+    inline void _quantize_quat(const Quat &p_rot, uint16_t *r_out) {
+        const Quat rot = p_rot.normalized();
+        const float q[4] = { rot.x, rot.y, rot.z, rot.w };
+
+        int largest = 0;
+        for (int i = 1; i < 4; i++) {
+            if (Math::abs(q[i]) > Math::abs(q[largest]))
+                largest = i;
+        }
+        // q and -q are the same rotation, keep the dropped component positive.
+        const float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+        int o = 0;
+        for (int i = 0; i < 4; i++) {
+            if (i == largest)
+                continue;
+            const float unit = CLAMP(q[i] * sign * Math_SQRT2 * 0.5f + 0.5f, 0.0f, 1.0f);
+            r_out[o++] = uint16_t(unit * 32767.0f + 0.5f);
+        }
+        r_out[0] |= uint16_t((largest & 1) << 15);
+        r_out[1] |= uint16_t((largest >> 1) << 15);
+    }
+
+    inline Quat _dequantize_quat(const uint16_t *p_in) {
+        const int largest = (p_in[0] >> 15) | ((p_in[1] >> 15) << 1);
+
+        float c[3];
+        float sum = 0.0f;
+        for (int i = 0; i < 3; i++) {
+            c[i] = ((p_in[i] & 0x7FFF) * (2.0f / 32767.0f) - 1.0f) * Math_SQRT12;
+            sum += c[i] * c[i];
+        }
+
+        float q[4];
+        int o = 0;
+        for (int i = 0; i < 4; i++) {
+            q[i] = i == largest ? Math::sqrt(M_MAX(0.0f, 1.0f - sum)) : c[o++];
+        }
+        return Quat(q[0], q[1], q[2], q[3]);
+    }
+}
+
+Animation::TKey<Animation::TransformKey> Animation::CompressedTransformKeys::operator[](int p_idx) const {
+
+    TKey<TransformKey> key;
+    key.time = times[p_idx];
+    key.transition = transitions.empty() ? 1.0f : transitions[p_idx];
+
+    const uint16_t *c = &components[p_idx * COMPONENTS];
+    key.value.loc = _dequantize_range(c, loc_min, loc_range);
+    key.value.rot = _dequantize_quat(c + 3);
+    key.value.scale = _dequantize_range(c + 6, scale_min, scale_range);
+    return key;
+}
+
+void Animation::CompressedTransformKeys::compress(const Vector<TKey<TransformKey> > &p_keys) {
+
+    const int key_count = p_keys.size();
+
+    times.resize(key_count);
+    components.resize(key_count * COMPONENTS);
+    transitions.clear();
+
+    if (key_count == 0) {
+        return;
+    }
+
+    Vector3 loc_max = p_keys[0].value.loc;
+    Vector3 scale_max = p_keys[0].value.scale;
+    loc_min = loc_max;
+    scale_min = scale_max;
+    bool default_transitions = true;
+    for (const TKey<TransformKey> &key : p_keys) {
+        for (int i = 0; i < 3; i++) {
+            loc_min[i] = MIN(loc_min[i], key.value.loc[i]);
+            loc_max[i] = M_MAX(loc_max[i], key.value.loc[i]);
+            scale_min[i] = MIN(scale_min[i], key.value.scale[i]);
+            scale_max[i] = M_MAX(scale_max[i], key.value.scale[i]);
+        }
+        default_transitions = default_transitions && key.transition == 1.0f;
+    }
+    loc_range = loc_max - loc_min;
+    scale_range = scale_max - scale_min;
+
+    for (int i = 0; i < key_count; i++) {
+        times[i] = p_keys[i].time;
+        uint16_t *c = &components[i * COMPONENTS];
+        _quantize_range(p_keys[i].value.loc, loc_min, loc_range, c);
+        _quantize_quat(p_keys[i].value.rot, c + 3);
+        _quantize_range(p_keys[i].value.scale, scale_min, scale_range, c + 6);
+    }
+
+    if (!default_transitions) {
+        transitions.resize(key_count);
+        for (int i = 0; i < key_count; i++) {
+            transitions[i] = p_keys[i].transition;
+        }
+    }
+}
+
+void Animation::CompressedTransformKeys::decompress(Vector<TKey<TransformKey> > &r_keys) const {
+
+    r_keys.resize(size());
+    for (int i = 0; i < size(); i++) {
+        r_keys[i] = (*this)[i];
+    }
+}
+
+void Animation::_transform_track_decompress(TransformTrack *p_track) {
+
+    if (!p_track->compressed)
+        return;
+
+    p_track->compressed_keys.decompress(p_track->transforms);
+    p_track->compressed_keys = CompressedTransformKeys();
+    p_track->compressed = false;
+}
+
+Animation::TKey<Animation::TransformKey> Animation::_transform_track_get_tkey(const TransformTrack *p_track, int p_key) const {
+
+    if (p_track->compressed)
+        return p_track->compressed_keys[p_key];
+    return p_track->transforms[p_key];
 }
 bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 
@@ -130,11 +309,61 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
             track_set_imported(track, p_value.as<bool>());
         else if (what == "enabled")
             track_set_enabled(track, p_value.as<bool>());
-        else if (what == "keys" || what == "key_values") {
+        else if (what == "compressed") {
+            ERR_FAIL_COND_V(track_get_type(track) != TYPE_TRANSFORM, false);
+            // Saved after the keys, so they are already loaded here, and already compressed when saved as compressed_keys.
+            if (p_value.as<bool>())
+                transform_track_compress(track);
+            else
+                _transform_track_decompress(static_cast<TransformTrack *>(tracks[track]));
+        } else if (what == "compressed_keys") {
+            ERR_FAIL_COND_V(track_get_type(track) != TYPE_TRANSFORM, false);
+            // The quantized words as saved, compressing the dequantized keys again would make them drift.
+            Dictionary d = p_value.as<Dictionary>();
+            ERR_FAIL_COND_V(!d.has("times"), false);
+            ERR_FAIL_COND_V(!d.has("components"), false);
+
+            PoolVector<float> times = d["times"].as<PoolVector<float>>();
+            PoolVector<int> components = d["components"].as<PoolVector<int>>();
+            const int key_count = times.size();
+            ERR_FAIL_COND_V(components.size() != key_count * CompressedTransformKeys::COMPONENTS, false);
+
+            CompressedTransformKeys ck;
+            ck.times.resize(key_count);
+            PoolVector<float>::Read rt = times.read();
+            for (int i = 0; i < key_count; i++) {
+                ck.times[i] = rt[i];
+            }
+            ck.components.resize(components.size());
+            PoolVector<int>::Read rc = components.read();
+            for (int i = 0; i < components.size(); i++) {
+                ck.components[i] = uint16_t(rc[i]);
+            }
+            if (d.has("transitions")) {
+                PoolVector<float> transitions = d["transitions"].as<PoolVector<float>>();
+                ERR_FAIL_COND_V(transitions.size() != key_count, false);
+                ck.transitions.resize(key_count);
+                PoolVector<float>::Read rtr = transitions.read();
+                for (int i = 0; i < key_count; i++) {
+                    ck.transitions[i] = rtr[i];
+                }
+            }
+            ck.loc_min = d["loc_min"].as<Vector3>();
+            ck.loc_range = d["loc_range"].as<Vector3>();
+            ck.scale_min = d["scale_min"].as<Vector3>();
+            ck.scale_range = d["scale_range"].as<Vector3>();
+
+            TransformTrack *tt = static_cast<TransformTrack *>(tracks[track]);
+            tt->transforms.clear();
+            tt->compressed_keys = eastl::move(ck);
+            tt->compressed = true;
+        } else if (what == "keys" || what == "key_values") {
 
             if (track_get_type(track) == TYPE_TRANSFORM) {
 
                 TransformTrack *tt = static_cast<TransformTrack *>(tracks[track]);
+                tt->compressed_keys = CompressedTransformKeys();
+                tt->compressed = false;
                 PoolVector<float> values = p_value.as<PoolVector<float>>();
                 int vcount = values.size();
                 ERR_FAIL_COND_V(vcount % 12, false); // should be multiple of 11
@@ -430,7 +659,53 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
         r_ret = track_is_imported(track);
     else if (what == "enabled")
         r_ret = track_is_enabled(track);
-    else if (what == "keys") {
+    else if (what == "compressed")
+        r_ret = transform_track_is_compressed(track);
+    else if (what == "compressed_keys") {
+
+        if (track_get_type(track) != TYPE_TRANSFORM || !static_cast<const TransformTrack *>(tracks[track])->compressed)
+            return false;
+
+        const CompressedTransformKeys &ck = static_cast<const TransformTrack *>(tracks[track])->compressed_keys;
+
+        PoolVector<float> times;
+        times.resize(ck.times.size());
+        PoolVector<float>::Write wt = times.write();
+        for (int i = 0; i < ck.times.size(); i++) {
+            wt[i] = ck.times[i];
+        }
+        wt.release();
+
+        PoolVector<int> components;
+        components.resize(ck.components.size());
+        PoolVector<int>::Write wc = components.write();
+        for (int i = 0; i < ck.components.size(); i++) {
+            wc[i] = ck.components[i];
+        }
+        wc.release();
+
+        Dictionary d;
+        d["times"] = times;
+        d["components"] = components;
+        if (!ck.transitions.empty()) {
+            PoolVector<float> transitions;
+            transitions.resize(ck.transitions.size());
+            PoolVector<float>::Write wtr = transitions.write();
+            for (int i = 0; i < ck.transitions.size(); i++) {
+                wtr[i] = ck.transitions[i];
+            }
+            wtr.release();
+            d["transitions"] = transitions;
+        }
+        d["loc_min"] = ck.loc_min;
+        d["loc_range"] = ck.loc_range;
+        d["scale_min"] = ck.scale_min;
+        d["scale_range"] = ck.scale_range;
+
+        r_ret = d;
+        return true;
+
+    } else if (what == "keys") {
 
         if (track_get_type(track) == TYPE_TRANSFORM) {
 
@@ -681,7 +956,15 @@ void Animation::_get_property_list(Vector<PropertyInfo> *p_list) const {
         p_list->push_back(PropertyInfo(VariantType::BOOL, StringName("tracks/" + itos(i) + "/loop_wrap"), PropertyHint::None, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
         p_list->push_back(PropertyInfo(VariantType::BOOL, StringName("tracks/" + itos(i) + "/imported"), PropertyHint::None, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
         p_list->push_back(PropertyInfo(VariantType::BOOL, StringName("tracks/" + itos(i) + "/enabled"), PropertyHint::None, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
-        p_list->push_back(PropertyInfo(VariantType::ARRAY, StringName("tracks/" + itos(i) + "/keys"), PropertyHint::None, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+        // Compressed transform tracks store their quantized keys, "compressed" stays for files saved with plain keys.
+        if (tracks[i]->type == TYPE_TRANSFORM && static_cast<const TransformTrack *>(tracks[i])->compressed) {
+            p_list->push_back(PropertyInfo(VariantType::DICTIONARY, StringName("tracks/" + itos(i) + "/compressed_keys"), PropertyHint::None, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+        } else {
+            p_list->push_back(PropertyInfo(VariantType::ARRAY, StringName("tracks/" + itos(i) + "/keys"), PropertyHint::None, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+        }
+        if (tracks[i]->type == TYPE_TRANSFORM) {
+            p_list->push_back(PropertyInfo(VariantType::BOOL, StringName("tracks/" + itos(i) + "/compressed"), PropertyHint::None, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+        }
     }
 }
 
@@ -913,14 +1196,15 @@ Error Animation::transform_track_get_key(int p_track, int p_key, Vector3 *r_loc,
 
     TransformTrack *tt = static_cast<TransformTrack *>(t);
     ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
-    ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+    ERR_FAIL_INDEX_V(p_key, track_get_key_count(p_track), ERR_INVALID_PARAMETER);
 
+    const TKey<TransformKey> key = _transform_track_get_tkey(tt, p_key);
     if (r_loc)
-        *r_loc = tt->transforms[p_key].value.loc;
+        *r_loc = key.value.loc;
     if (r_rot)
-        *r_rot = tt->transforms[p_key].value.rot;
+        *r_rot = key.value.rot;
     if (r_scale)
-        *r_scale = tt->transforms[p_key].value.scale;
+        *r_scale = key.value.scale;
 
     return OK;
 }
@@ -932,6 +1216,7 @@ int Animation::transform_track_insert_key(int p_track, float p_time, const Vecto
     ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, -1);
 
     TransformTrack *tt = static_cast<TransformTrack *>(t);
+    _transform_track_decompress(tt);
 
     TKey<TransformKey> tkey;
     tkey.time = p_time;
@@ -960,6 +1245,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
         case TYPE_TRANSFORM: {
 
             TransformTrack *tt = static_cast<TransformTrack *>(t);
+            _transform_track_decompress(tt);
             ERR_FAIL_INDEX(p_idx, tt->transforms.size());
             tt->transforms.erase_at(p_idx);
 
@@ -1013,6 +1299,14 @@ int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
         case TYPE_TRANSFORM: {
 
             TransformTrack *tt = static_cast<TransformTrack *>(t);
+            if (tt->compressed) {
+                int k = _key_find(tt->compressed_keys, p_time);
+                if (k < 0 || k >= tt->compressed_keys.size())
+                    return -1;
+                if (tt->compressed_keys.get_time(k) != p_time && p_exact)
+                    return -1;
+                return k;
+            }
             int k = _key_find(tt->transforms, p_time);
             if (k < 0 || k >= tt->transforms.size())
                 return -1;
@@ -1198,7 +1492,7 @@ int Animation::track_get_key_count(int p_track) const {
         case TYPE_TRANSFORM: {
 
             TransformTrack *tt = static_cast<TransformTrack *>(t);
-            return tt->transforms.size();
+            return tt->compressed ? tt->compressed_keys.size() : tt->transforms.size();
         } break;
         case TYPE_VALUE: {
 
@@ -1241,12 +1535,13 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
         case TYPE_TRANSFORM: {
 
             TransformTrack *tt = static_cast<TransformTrack *>(t);
-            ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
+            ERR_FAIL_INDEX_V(p_key_idx, track_get_key_count(p_track), Variant());
 
+            const TKey<TransformKey> key = _transform_track_get_tkey(tt, p_key_idx);
             Dictionary d;
-            d["location"] = tt->transforms[p_key_idx].value.loc;
-            d["rotation"] = tt->transforms[p_key_idx].value.rot;
-            d["scale"] = tt->transforms[p_key_idx].value.scale;
+            d["location"] = key.value.loc;
+            d["rotation"] = key.value.rot;
+            d["scale"] = key.value.scale;
 
             return d;
         }
@@ -1316,6 +1611,10 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
         case TYPE_TRANSFORM: {
 
             TransformTrack *tt = static_cast<TransformTrack *>(t);
+            if (tt->compressed) {
+                ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_keys.size(), -1);
+                return tt->compressed_keys.get_time(p_key_idx);
+            }
             ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
             return tt->transforms[p_key_idx].time;
         }
@@ -1369,6 +1668,7 @@ void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
         case TYPE_TRANSFORM: {
 
             TransformTrack *tt = static_cast<TransformTrack *>(t);
+            _transform_track_decompress(tt);
             ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
             TKey<TransformKey> key = tt->transforms[p_key_idx];
             key.time = p_time;
@@ -1441,8 +1741,8 @@ float Animation::track_get_key_transition(int p_track, int p_key_idx) const {
         case TYPE_TRANSFORM: {
 
             TransformTrack *tt = static_cast<TransformTrack *>(t);
-            ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
-            return tt->transforms[p_key_idx].transition;
+            ERR_FAIL_INDEX_V(p_key_idx, track_get_key_count(p_track), -1);
+            return _transform_track_get_tkey(tt, p_key_idx).transition;
         } break;
         case TYPE_VALUE: {
 
@@ -1485,6 +1785,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
         case TYPE_TRANSFORM: {
 
             TransformTrack *tt = static_cast<TransformTrack *>(t);
+            _transform_track_decompress(tt);
             ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 
             Dictionary d = p_value.as<Dictionary>();
@@ -1571,6 +1872,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
         case TYPE_TRANSFORM: {
 
             TransformTrack *tt = static_cast<TransformTrack *>(t);
+            _transform_track_decompress(tt);
             ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
             tt->transforms[p_key_idx].transition = p_transition;
         } break;
@@ -1766,10 +2068,14 @@ PoolVector<int> Animation::method_track_get_key_indices(int p_track, float p_tim
     return idxr;
 }
 
-template <class T>
-T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const {
+template <class K>
+decltype(K::value_type::value) Animation::_interpolate(const K &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor) const {
+
+    using T = decltype(K::value_type::value);
 
-    int len = _key_find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+    int len = p_keys.size();
+    if (len > 0 && _key_time(p_keys, len - 1) > length)
+        len = _key_find(p_keys, length) + 1; // try to find last key (there may be more past the end)
 
     if (len <= 0) {
         // (-1 or -2 returned originally) (plus one above)
@@ -1784,7 +2090,7 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
         return p_keys[0].value;
     }
 
-    int idx = _key_find(p_keys, p_time);
+    int idx = _key_find(p_keys, p_time, r_cursor);
 
     ERR_FAIL_COND_V(idx == -2, T());
 
@@ -1800,8 +2106,8 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
             if ((idx + 1) < len) {
 
                 next = idx + 1;
-                float delta = p_keys[next].time - p_keys[idx].time;
-                float from = p_time - p_keys[idx].time;
+                float delta = _key_time(p_keys, next) - _key_time(p_keys, idx);
+                float from = p_time - _key_time(p_keys, idx);
 
                 if (Math::is_zero_approx(delta))
                     c = 0;
@@ -1811,8 +2117,8 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
             } else {
 
                 next = 0;
-                float delta = (length - p_keys[idx].time) + p_keys[next].time;
-                float from = p_time - p_keys[idx].time;
+                float delta = (length - _key_time(p_keys, idx)) + _key_time(p_keys, next);
+                float from = p_time - _key_time(p_keys, idx);
 
                 if (Math::is_zero_approx(delta))
                     c = 0;
@@ -1824,10 +2130,10 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
             // on loop, behind first key
             idx = len - 1;
             next = 0;
-            float endtime = (length - p_keys[idx].time);
+            float endtime = (length - _key_time(p_keys, idx));
             if (endtime < 0) // may be keys past the end
                 endtime = 0;
-            float delta = endtime + p_keys[next].time;
+            float delta = endtime + _key_time(p_keys, next);
             float from = endtime + p_time;
 
             if (Math::is_zero_approx(delta))
@@ -1843,8 +2149,8 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
             if ((idx + 1) < len) {
 
                 next = idx + 1;
-                float delta = p_keys[next].time - p_keys[idx].time;
-                float from = p_time - p_keys[idx].time;
+                float delta = _key_time(p_keys, next) - _key_time(p_keys, idx);
+                float from = p_time - _key_time(p_keys, idx);
 
                 if (Math::is_zero_approx(delta))
                     c = 0;
@@ -1871,11 +2177,13 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
     if (!result)
         return T();
 
-    float tr = p_keys[idx].transition;
+    // A reference for stored keys, a decoded copy for compressed ones.
+    const auto &from_key = p_keys[idx];
+    float tr = from_key.transition;
 
     if (tr == 0 || idx == next) {
         // don't interpolate if not needed
-        return p_keys[idx].value;
+        return from_key.value;
     }
 
     if (tr != 1.0f) {
@@ -1887,11 +2195,11 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 
         case INTERPOLATION_NEAREST: {
 
-            return p_keys[idx].value;
+            return from_key.value;
         } break;
         case INTERPOLATION_LINEAR: {
 
-            return _interpolate(p_keys[idx].value, p_keys[next].value, c);
+            return _interpolate(from_key.value, p_keys[next].value, c);
         } break;
         case INTERPOLATION_CUBIC: {
             int pre = idx - 1;
@@ -1911,16 +2219,16 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
                 }
             }
 
-            return _cubic_interpolate(p_keys[pre].value, p_keys[idx].value, p_keys[next].value, p_keys[post].value, c);
+            return _cubic_interpolate(p_keys[pre].value, from_key.value, p_keys[next].value, p_keys[post].value, c);
 
         } break;
-        default: return p_keys[idx].value;
+        default: return from_key.value;
     }
 
     // do a barrel roll
 }
 
-Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const {
+Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor) const {
 
     ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
     Track *t = tracks[p_track];
@@ -1930,7 +2238,9 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 
     bool ok = false;
 
-    TransformKey tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok);
+    TransformKey tk = tt->compressed ?
+            _interpolate(tt->compressed_keys, p_time, tt->interpolation, tt->loop_wrap, &ok, r_cursor) :
+            _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok, r_cursor);
 
     if (!ok)
         return ERR_UNAVAILABLE;
@@ -1947,6 +2257,32 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
     return OK;
 }
 
+void Animation::transform_track_compress(int p_track) {
+
+    ERR_FAIL_INDEX(p_track, tracks.size());
+    Track *t = tracks[p_track];
+    ERR_FAIL_COND(t->type != TYPE_TRANSFORM);
+
+    TransformTrack *tt = static_cast<TransformTrack *>(t);
+    if (tt->compressed)
+        return;
+
+    tt->compressed_keys.compress(tt->transforms);
+    tt->compressed = true;
+    tt->transforms.clear();
+    tt->transforms.shrink_to_fit();
+    emit_changed();
+}
+
+bool Animation::transform_track_is_compressed(int p_track) const {
+
+    ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+    const Track *t = tracks[p_track];
+    ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, false);
+
+    return static_cast<const TransformTrack *>(t)->compressed;
+}
+
 Variant Animation::value_track_interpolate(int p_track, float p_time) const {
 
     ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
@@ -2064,8 +2400,8 @@ Animation::UpdateMode Animation::value_track_get_update_mode(int p_track) const
     return vt->update_mode;
 }
 
-template <class T>
-void Animation::_track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, Vector<int> *p_indices) const {
+template <class K>
+void Animation::_track_get_key_indices_in_range(const K &p_array, float from_time, float to_time, Vector<int> *p_indices) const {
 
     if (from_time != length && to_time == length)
         to_time = length * 1.01; //include a little more if at the end
@@ -2075,7 +2411,7 @@ void Animation::_track_get_key_indices_in_range(const Vector<T> &p_array, float
     // can't really send the events == time, will be sent in the next frame.
     // if event>=len then it will probably never be requested by the anim player.
 
-    if (to >= 0 && p_array[to].time >= to_time)
+    if (to >= 0 && _key_time(p_array, to) >= to_time)
         to--;
 
     if (to < 0)
@@ -2084,7 +2420,7 @@ void Animation::_track_get_key_indices_in_range(const Vector<T> &p_array, float
     int from = _key_find(p_array, from_time);
 
     // position in the right first event.+
-    if (from < 0 || p_array[from].time < from_time)
+    if (from < 0 || _key_time(p_array, from) < from_time)
         from++;
 
     int max = p_array.size();
@@ -2123,8 +2459,13 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
                 case TYPE_TRANSFORM: {
 
                     const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-                    _track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
-                    _track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+                    if (tt->compressed) {
+                        _track_get_key_indices_in_range(tt->compressed_keys, from_time, length, p_indices);
+                        _track_get_key_indices_in_range(tt->compressed_keys, 0, to_time, p_indices);
+                    } else {
+                        _track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
+                        _track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+                    }
 
                 } break;
                 case TYPE_VALUE: {
@@ -2183,7 +2524,10 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
         case TYPE_TRANSFORM: {
 
             const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-            _track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+            if (tt->compressed)
+                _track_get_key_indices_in_range(tt->compressed_keys, from_time, to_time, p_indices);
+            else
+                _track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
 
         } break;
         case TYPE_VALUE: {
@@ -2840,6 +3184,8 @@ void Animation::_bind_methods() {
     SE_BIND_METHOD(Animation,track_get_interpolation_loop_wrap);
 
     MethodBinder::bind_method(D_METHOD("transform_track_interpolate", {"track_idx", "time_sec"}), (Array(Animation::*)(int , float ) const)&Animation::transform_track_interpolate);
+    SE_BIND_METHOD(Animation,transform_track_compress);
+    SE_BIND_METHOD(Animation,transform_track_is_compressed);
     SE_BIND_METHOD(Animation,value_track_set_update_mode);
     SE_BIND_METHOD(Animation,value_track_get_update_mode);
 
@@ -2885,6 +3231,7 @@ void Animation::_bind_methods() {
 
     SE_BIND_METHOD(Animation,clear);
     SE_BIND_METHOD(Animation,copy_track);
+    SE_BIND_METHOD(Animation,compress);
 
     ADD_PROPERTY(PropertyInfo(VariantType::FLOAT, "length", PropertyHint::Range, "0.001,99999,0.001"), "set_length", "get_length");
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "loop"), "set_loop", "has_loop");
@@ -3095,6 +3442,7 @@ void Animation::_transform_track_optimize(int p_idx, float p_allowed_linear_err,
     ERR_FAIL_INDEX(p_idx, tracks.size());
     ERR_FAIL_COND(tracks[p_idx]->type != TYPE_TRANSFORM);
     TransformTrack *tt = static_cast<TransformTrack *>(tracks[p_idx]);
+    _transform_track_decompress(tt);
     bool prev_erased = false;
     TKey<TransformKey> first_erased;
 
@@ -3142,6 +3490,15 @@ void Animation::optimize(float p_allowed_linear_err, float p_allowed_angular_err
     }
 }
 
+void Animation::compress() {
+
+    for (int i = 0; i < tracks.size(); i++) {
+
+        if (tracks[i]->type == TYPE_TRANSFORM)
+            transform_track_compress(i);
+    }
+}
+
 Animation::Animation() {
 
     step = 0.1f;
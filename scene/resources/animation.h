@@ -104,11 +104,43 @@ private:
         Vector3 scale;
     };
 
+    /* COMPRESSED TRANSFORM KEYS */
+
+    // Lossy storage built by `compress`, around 22 bytes per key instead of 48.
+    // Key times are kept as they are, so looking keys up by time stays exact.
+    // Locations and scales are normalized to the range of the track on 16 bits
+    // per component, rotations use the smallest three encoding on 15 bits.
+    struct CompressedTransformKeys {
+        using value_type = TKey<TransformKey>;
+
+        enum {
+            COMPONENTS = 9, // loc, rot, scale
+        };
+
+        Vector<float> times;
+        Vector<uint16_t> components;
+        Vector<float> transitions; // empty when all the keys use 1.0
+        Vector3 loc_min;
+        Vector3 loc_range;
+        Vector3 scale_min;
+        Vector3 scale_range;
+
+        int size() const { return times.size(); }
+        float get_time(int p_idx) const { return times[p_idx]; }
+        TKey<TransformKey> operator[](int p_idx) const;
+
+        void compress(const Vector<TKey<TransformKey> > &p_keys);
+        void decompress(Vector<TKey<TransformKey> > &r_keys) const;
+    };
+
     /* TRANSFORM TRACK */
 
     struct TransformTrack : public Track {
 
         Vector<TKey<TransformKey> > transforms;
+        // When `compressed` is set `transforms` is empty and the keys live here.
+        CompressedTransformKeys compressed_keys;
+        bool compressed = false;
 
         TransformTrack() : Track(TYPE_TRANSFORM) {}
     };
@@ -208,11 +240,15 @@ private:
     _FORCE_INLINE_ Variant _cubic_interpolate(const Variant &p_pre_a, const Variant &p_a, const Variant &p_b, const Variant &p_post_b, float p_c) const;
     _FORCE_INLINE_ float _cubic_interpolate(const float &p_pre_a, const float &p_a, const float &p_b, const float &p_post_b, float p_c) const;
 
-    template <class T>
-    _FORCE_INLINE_ T _interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const;
+    // `r_cursor` caches the key found by the previous call, so sequential sampling skips the search.
+    template <class K>
+    _FORCE_INLINE_ decltype(K::value_type::value) _interpolate(const K &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor = nullptr) const;
 
-    template <class T>
-    _FORCE_INLINE_ void _track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, Vector<int> *p_indices) const;
+    template <class K>
+    _FORCE_INLINE_ void _track_get_key_indices_in_range(const K &p_array, float from_time, float to_time, Vector<int> *p_indices) const;
+
+    void _transform_track_decompress(TransformTrack *p_track);
+    TKey<TransformKey> _transform_track_get_tkey(const TransformTrack *p_track, int p_key) const;
 
     _FORCE_INLINE_ void _value_track_get_key_indices_in_range(const ValueTrack *vt, float from_time, float to_time, Vector<int> *p_indices) const;
     _FORCE_INLINE_ void _method_track_get_key_indices_in_range(const MethodTrack *mt, float from_time, float to_time, Vector<int> *p_indices) const;
@@ -313,7 +349,11 @@ public:
     void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
     bool track_get_interpolation_loop_wrap(int p_track) const;
 
-    Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const;
+    /// `r_cursor` is an optional key index kept by the caller between calls,
+    /// when the time moves forward it avoids searching the keys again.
+    Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor = nullptr) const;
+    void transform_track_compress(int p_track);
+    bool transform_track_is_compressed(int p_track) const;
 
     Variant value_track_interpolate(int p_track, float p_time) const;
     void value_track_get_key_indices(int p_track, float p_time, float p_delta, Vector<int> *p_indices) const;
@@ -340,6 +380,9 @@ public:
     void clear();
 
     void optimize(float p_allowed_linear_err = 0.05f, float p_allowed_angular_err = 0.01f, float p_max_optimizable_angle = Math_PI * 0.125f);
+    /// Compresses all the transform tracks, usually after `optimize`.
+    /// Editing a key of a compressed track decompresses it.
+    void compress();
 
     Animation();
     ~Animation() override;
@@ -253,6 +253,15 @@ float NavigationMesh::get_detail_sample_max_error() const {
     return detail_sample_max_error;
 }
 
+void NavigationMesh::set_tile_size(int p_value) {
+    ERR_FAIL_COND(p_value < 0);
+    tile_size = p_value;
+}
+
+int NavigationMesh::get_tile_size() const {
+    return tile_size;
+}
+
 void NavigationMesh::set_filter_low_hanging_obstacles(bool p_value) {
     filter_low_hanging_obstacles = p_value;
 }
@@ -327,6 +336,7 @@ const Vector<int> &NavigationMesh::get_polygon(int p_idx) {
 void NavigationMesh::clear_polygons() {
 
     polygons.clear();
+    debug_mesh.unref();
 }
 
 Ref<Mesh> NavigationMesh::get_debug_mesh() {
@@ -462,6 +472,9 @@ void NavigationMesh::_bind_methods() {
     SE_BIND_METHOD(NavigationMesh,set_detail_sample_max_error);
     SE_BIND_METHOD(NavigationMesh,get_detail_sample_max_error);
 
+    SE_BIND_METHOD(NavigationMesh,set_tile_size);
+    SE_BIND_METHOD(NavigationMesh,get_tile_size);
+
     SE_BIND_METHOD(NavigationMesh,set_filter_low_hanging_obstacles);
     SE_BIND_METHOD(NavigationMesh,get_filter_low_hanging_obstacles);
 
@@ -508,6 +521,8 @@ void NavigationMesh::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(VariantType::FLOAT, "detail/sample_distance", PropertyHint::Range, "0.0,16.0,0.01,or_greater"), "set_detail_sample_distance", "get_detail_sample_distance");
     ADD_PROPERTY(PropertyInfo(VariantType::FLOAT, "detail/sample_max_error", PropertyHint::Range, "0.0,16.0,0.01,or_greater"), "set_detail_sample_max_error", "get_detail_sample_max_error");
 
+    ADD_PROPERTY(PropertyInfo(VariantType::INT, "tile/size", PropertyHint::Range, "0,1024,1,or_greater"), "set_tile_size", "get_tile_size");
+
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "filter/low_hanging_obstacles"), "set_filter_low_hanging_obstacles", "get_filter_low_hanging_obstacles");
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "filter/ledge_spans"), "set_filter_ledge_spans", "get_filter_ledge_spans");
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "filter/filter_walkable_low_height_spans"), "set_filter_walkable_low_height_spans", "get_filter_walkable_low_height_spans");
@@ -557,6 +572,7 @@ NavigationMesh::NavigationMesh() {
     verts_per_poly = 6.0f;
     detail_sample_distance = 6.0f;
     detail_sample_max_error = 5.0f;
+    tile_size = 0;
 
     partition_type = SAMPLE_PARTITION_WATERSHED;
     parsed_geometry_type = PARSED_GEOMETRY_MESH_INSTANCES;
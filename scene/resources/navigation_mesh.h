@@ -101,6 +101,7 @@ protected:
     float detail_sample_max_error;
 
     uint32_t collision_mask;
+    int tile_size;
 
     SamplePartitionType partition_type;
     ParsedGeometryType parsed_geometry_type;
@@ -169,6 +170,11 @@ public:
     void set_detail_sample_max_error(float p_value);
     float get_detail_sample_max_error() const;
 
+    /// Size of the baked tiles, in cells. Tiles are baked in parallel and can be
+    /// rebaked independently; 0 bakes the whole mesh in a single pass.
+    void set_tile_size(int p_value);
+    int get_tile_size() const;
+
     void set_filter_low_hanging_obstacles(bool p_value);
     bool get_filter_low_hanging_obstacles() const;
 
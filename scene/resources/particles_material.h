@@ -312,4 +312,7 @@ constexpr inline float rand_from_seed(uint32_t &seed) {
     seed = uint32_t(s);
     return float(seed % uint32_t(65536)) / 65535.0f;
 }
+
+/// Particles simulated or packed by a single job of the shared work pool.
+constexpr int CHUNK_SIZE = 512;
 }
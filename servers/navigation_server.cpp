@@ -61,6 +61,10 @@ void NavigationServer::_bind_methods() {
     SE_BIND_METHOD(NavigationServer,map_get_closest_point);
     SE_BIND_METHOD(NavigationServer,map_get_closest_point_normal);
     SE_BIND_METHOD(NavigationServer,map_get_closest_point_owner);
+    SE_BIND_METHOD(NavigationServer,map_query_path_async);
+    SE_BIND_METHOD(NavigationServer,path_query_is_done);
+    SE_BIND_METHOD(NavigationServer,path_query_take_result);
+    SE_BIND_METHOD(NavigationServer,path_query_free);
 
     SE_BIND_METHOD(NavigationServer,map_get_regions);
     SE_BIND_METHOD(NavigationServer,map_get_agents);
@@ -82,6 +86,7 @@ void NavigationServer::_bind_methods() {
     SE_BIND_METHOD(NavigationServer,region_set_transform);
     SE_BIND_METHOD(NavigationServer,region_set_navmesh);
     SE_BIND_METHOD(NavigationServer,region_bake_navmesh);
+    SE_BIND_METHOD(NavigationServer,region_rebake_navmesh);
     SE_BIND_METHOD(NavigationServer,region_get_connections_count);
     SE_BIND_METHOD(NavigationServer,region_get_connection_pathway_start);
     SE_BIND_METHOD(NavigationServer,region_get_connection_pathway_end);
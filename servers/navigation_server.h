@@ -100,6 +100,23 @@ public:
     virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
     virtual RID map_get_closest_point_owner(RID p_map, const Vector3 &p_point) const = 0;
 
+    /// Queues a path query that is computed on a worker thread, against the
+    /// state of the map at its last sync. Returns the id of the query.
+    /// When `p_callback` is valid it's called on the main thread, during `process`,
+    /// with the query id and the path; otherwise the result must be polled.
+    virtual uint32_t map_query_path_async(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Callable &&p_callback) const = 0;
+
+    /// Returns true when the result of a polled path query is available.
+    virtual bool path_query_is_done(uint32_t p_query) const = 0;
+
+    /// Returns the path found by a polled query and releases it.
+    /// Results that are not taken are dropped after a few seconds worth of frames.
+    virtual Vector<Vector3> path_query_take_result(uint32_t p_query) const = 0;
+
+    /// Drops a query whose result is no longer needed, whether it's queued,
+    /// running or done. Its callback, if any, won't be called.
+    virtual void path_query_free(uint32_t p_query) const = 0;
+
     virtual Array map_get_regions(RID p_map) const = 0;
     virtual Array map_get_agents(RID p_map) const = 0;
 
@@ -136,6 +153,9 @@ public:
     /// Bake the navigation mesh.
     virtual void region_bake_navmesh(Ref<NavigationMesh> r_mesh, Node *p_node) const = 0;
 
+    /// Rebake the tiles of a tiled navigation mesh overlapping `p_region`.
+    virtual void region_rebake_navmesh(Ref<NavigationMesh> r_mesh, Node *p_node, const AABB &p_region) const = 0;
+
     /// Get a list of a region's connection to other regions.
     virtual int region_get_connections_count(RID p_region) const = 0;
     virtual Vector3 region_get_connection_pathway_start(RID p_region, int p_connection_id) const = 0;
@@ -35,6 +35,7 @@
 #include "servers/rendering/rendering_server_globals.h"
 #include "core/os/os.h"
 #include "core/print_string.h"
+#include "core/safe_refcount.h"
 
 Rasterizer *(*Rasterizer::_create_func)() = nullptr;
 
@@ -52,6 +53,11 @@ RasterizerStorage::RasterizerStorage() {
 
 RasterizerScene::~RasterizerScene() {}
 
+uint64_t RasterizerCanvas::Item::next_commands_version() {
+    static SafeNumeric<uint64_t> last_version;
+    return last_version.increment();
+}
+
 const Rect2 &RasterizerCanvas::Item::get_rect() const {
     if (custom_rect) {
         return rect;
@@ -310,6 +310,7 @@ public:
     virtual void skeleton_allocate(RenderingEntity p_skeleton, int p_bones, bool p_2d_skeleton = false) = 0;
     virtual int skeleton_get_bone_count(RenderingEntity p_skeleton) const = 0;
     virtual void skeleton_bone_set_transform(RenderingEntity p_skeleton, int p_bone, const Transform &p_transform) = 0;
+    virtual void skeleton_set_bone_transforms(RenderingEntity p_skeleton, Span<const Transform> p_transforms) = 0;
     virtual Transform skeleton_bone_get_transform(RenderingEntity p_skeleton, int p_bone) const = 0;
     virtual void skeleton_bone_set_transform_2d(RenderingEntity p_skeleton, int p_bone, const Transform2D &p_transform) = 0;
     virtual Transform2D skeleton_bone_get_transform_2d(RenderingEntity p_skeleton, int p_bone) const = 0;
@@ -822,6 +823,9 @@ public:
         MoveOnlyPointer<CopyBackBuffer> copy_back_buffer;
         int light_mask=1;
         mutable uint32_t skeleton_revision=0;
+        // changes each time the command list is cleared, never repeats across items,
+        // so renderers can keep data derived from the commands while it matches
+        uint64_t commands_version = next_commands_version();
         bool clip=false;
         bool visible=true;
         bool behind=false;
@@ -843,7 +847,10 @@ public:
             material_owner = nullptr;
             light_masked = false;
             skeleton_revision = 0;
+            commands_version = next_commands_version();
         }
+        static uint64_t next_commands_version();
+
         Item(const Item &) = delete;
         Item &operator=(const Item &) = delete;
 
@@ -865,6 +872,7 @@ public:
             copy_back_buffer = eastl::move(oth.copy_back_buffer);
             light_mask = eastl::move(oth.light_mask);
             skeleton_revision = eastl::move(oth.skeleton_revision);
+            commands_version = oth.commands_version;
             clip = eastl::move(oth.clip);
             visible = eastl::move(oth.visible);
             behind = eastl::move(oth.behind);
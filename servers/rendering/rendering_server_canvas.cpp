@@ -35,6 +35,8 @@
 #include "servers/rendering/render_entity_getter.h"
 
 #include "core/ecs_registry.h"
+#include "core/radix_sort.h"
+#include "core/os/thread_work_pool.h"
 
 #include "entt/entity/helper.hpp"
 #include "EASTL/sort.h"
@@ -94,8 +96,141 @@ static void _collect_ysort_children(RenderingCanvasItemComponent *p_canvas_item,
         }
     }
 }
+
+// Output of a traversal of a canvas item tree.
+struct CanvasCullContext {
+    Vector<CanvasCulledItem> *items;
+    bool parallel; // false on the worker threads, traversals are only split once
+    bool redraw_requested = false;
+};
+
+// Items with at least this many children have them traversed in parallel,
+// in chunks of CULL_CHUNK_SIZE children.
+constexpr int PARALLEL_CULL_MIN_CHILDREN = 256;
+constexpr int CULL_CHUNK_SIZE = 64;
+
 void _render_canvas_item(RenderingEntity p_canvas_item, const Transform2D &p_transform,
-        const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, Span<Dequeue<RasterizerCanvas::Item *>> z_list,
+        const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, CanvasCullContext &r_ctx,
+        RenderingCanvasItemComponent *p_canvas_clip,
+        RenderingCanvasItemComponent *p_material_owner);
+
+/// Sort key of a y-sort position. Positions that Math::is_equal_approx() considers equal get the same key in most
+/// cases, so float noise doesn't swap items from one frame to the next. Below 1 the position is snapped to
+/// CMP_EPSILON steps, above it the low mantissa bits are dropped, which leaves steps of about CMP_EPSILON * |y|.
+uint32_t _ysort_key(float p_y) {
+    constexpr int DROPPED_MANTISSA_BITS = 7;
+    if (Math::abs(p_y) < 1.0f) {
+        // Adding 0 turns -0 into 0, they must share a key.
+        p_y = Math::round(p_y / CMP_EPSILON) * CMP_EPSILON + 0.0f;
+    }
+    return RadixSort::float_to_key(p_y) >> DROPPED_MANTISSA_BITS;
+}
+
+/// Sorts y-sorted items by their position, ties keep the collection order.
+void _ysort_items(RenderingEntity *r_items, int p_count) {
+    thread_local Vector<RadixSortPair> pairs;
+    thread_local Vector<RadixSortPair> scratch;
+    thread_local Vector<RenderingEntity> sorted;
+
+    auto canvas_items_view(VSG::ecs->registry.view<RenderingCanvasItemComponent>());
+
+    pairs.resize(p_count);
+    scratch.resize(p_count);
+    for (int i = 0; i < p_count; i++) {
+        const auto &item(canvas_items_view.get<RenderingCanvasItemComponent>(r_items[i]));
+        pairs[i].key = (uint64_t(_ysort_key(item.ysort_pos.y)) << 32) | uint32_t(item.ysort_index);
+        pairs[i].value = i;
+    }
+
+    const RadixSortPair *result = RadixSort::sort(pairs.data(), scratch.data(), p_count);
+
+    sorted.resize(p_count);
+    for (int i = 0; i < p_count; i++) {
+        sorted[i] = r_items[result[i].value];
+    }
+    memcpy(r_items, sorted.data(), p_count * sizeof(RenderingEntity));
+}
+
+void _render_canvas_item_children(RenderingCanvasItemComponent *ci, const RenderingEntity *p_children, int p_from,
+        int p_to, bool p_behind, const Transform2D &p_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z,
+        RenderingCanvasItemComponent *p_material_owner, CanvasCullContext &r_ctx) {
+    auto canvas_items_view(VSG::ecs->registry.view<RenderingCanvasItemComponent>());
+
+    for (int i = p_from; i < p_to; i++) {
+
+        auto &child(canvas_items_view.get<RenderingCanvasItemComponent>(p_children[i]));
+        if (child.behind != p_behind || (ci->sort_y && child.sort_y))
+            continue;
+        if (ci->sort_y) {
+            _render_canvas_item(p_children[i], p_xform * child.ysort_xform, p_clip_rect, p_modulate * child.ysort_modulate, p_z, r_ctx,
+                    ci->final_clip_owner, child.material_owner);
+        } else {
+            _render_canvas_item(p_children[i], p_xform, p_clip_rect, p_modulate, p_z, r_ctx, ci->final_clip_owner, p_material_owner);
+        }
+    }
+}
+
+// Children of one item traversed in chunks, each chunk collects its items
+// on its own and the lists are appended in order once all are done.
+struct CanvasCullJob {
+    RenderingCanvasItemComponent *ci;
+    const RenderingEntity *children;
+    int child_count;
+    bool behind;
+    Transform2D xform;
+    Rect2 clip_rect;
+    Color modulate;
+    int z;
+    RenderingCanvasItemComponent *material_owner;
+    Vector<Vector<CanvasCulledItem>> chunk_items;
+    Vector<uint8_t> chunk_redraw;
+
+    void cull_chunk(uint32_t p_chunk, void *p_unused) {
+        CanvasCullContext ctx;
+        ctx.items = &chunk_items[p_chunk];
+        ctx.parallel = false;
+        const int from = p_chunk * CULL_CHUNK_SIZE;
+        _render_canvas_item_children(ci, children, from, MIN(child_count, from + CULL_CHUNK_SIZE), behind, xform,
+                clip_rect, modulate, z, material_owner, ctx);
+        chunk_redraw[p_chunk] = ctx.redraw_requested;
+    }
+};
+
+void _render_canvas_item_children_parallel(RenderingCanvasItemComponent *ci, const RenderingEntity *p_children,
+        int p_count, bool p_behind, const Transform2D &p_xform, const Rect2 &p_clip_rect, const Color &p_modulate,
+        int p_z, RenderingCanvasItemComponent *p_material_owner, CanvasCullContext &r_ctx) {
+
+    if (!r_ctx.parallel || p_count < PARALLEL_CULL_MIN_CHILDREN) {
+        _render_canvas_item_children(ci, p_children, 0, p_count, p_behind, p_xform, p_clip_rect, p_modulate, p_z,
+                p_material_owner, r_ctx);
+        return;
+    }
+
+    const uint32_t chunk_count = (p_count + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE;
+
+    CanvasCullJob job;
+    job.ci = ci;
+    job.children = p_children;
+    job.child_count = p_count;
+    job.behind = p_behind;
+    job.xform = p_xform;
+    job.clip_rect = p_clip_rect;
+    job.modulate = p_modulate;
+    job.z = p_z;
+    job.material_owner = p_material_owner;
+    job.chunk_items.resize(chunk_count);
+    job.chunk_redraw.resize(chunk_count, 0);
+
+    SharedThreadWorkPool::do_work(chunk_count, &job, &CanvasCullJob::cull_chunk, (void *)nullptr);
+
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        r_ctx.items->insert(r_ctx.items->end(), job.chunk_items[i].begin(), job.chunk_items[i].end());
+        r_ctx.redraw_requested |= job.chunk_redraw[i] != 0;
+    }
+}
+
+void _render_canvas_item(RenderingEntity p_canvas_item, const Transform2D &p_transform,
+        const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, CanvasCullContext &r_ctx,
         RenderingCanvasItemComponent *p_canvas_clip,
         RenderingCanvasItemComponent *p_material_owner) {
     auto canvas_items_view(VSG::ecs->registry.view<RenderingCanvasItemComponent>());
@@ -147,6 +282,7 @@ void _render_canvas_item(RenderingEntity p_canvas_item, const Transform2D &p_tra
         ci->final_clip_owner = p_canvas_clip;
     }
 
+    Vector<RenderingEntity> ysort_items;
     if (ci->sort_y) {
 
         if (ci->ysort_children_count == -1) {
@@ -155,20 +291,13 @@ void _render_canvas_item(RenderingEntity p_canvas_item, const Transform2D &p_tra
         }
 
         child_item_count = ci->ysort_children_count;
-        child_items = (RenderingEntity *)alloca(child_item_count * sizeof(RenderingEntity));
+        ysort_items.resize(child_item_count);
+        child_items = ysort_items.data();
 
         int i = 0;
         _collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), child_items, i);
 
-        eastl::sort(child_items,child_items+child_item_count,[&](RenderingEntity a,RenderingEntity b)->bool {
-            auto & item_a(canvas_items_view.get<RenderingCanvasItemComponent>(a));
-            auto & item_b(canvas_items_view.get<RenderingCanvasItemComponent>(b));
-            if (Math::is_equal_approx(item_a.ysort_pos.y, item_b.ysort_pos.y)) {
-                return item_a.ysort_index < item_b.ysort_index;
-            }
-
-            return item_a.ysort_pos.y < item_b.ysort_pos.y;
-        });
+        _ysort_items(child_items, child_item_count);
     }
 
     if (ci->z_relative)
@@ -176,24 +305,15 @@ void _render_canvas_item(RenderingEntity p_canvas_item, const Transform2D &p_tra
     else
         p_z = ci->z_index;
 
-    for (int i = 0; i < child_item_count; i++) {
-
-        auto & child(canvas_items_view.get<RenderingCanvasItemComponent>(child_items[i]));
-        if (!child.behind || (ci->sort_y && child.sort_y))
-            continue;
-        if (ci->sort_y) {
-            _render_canvas_item(child_items[i], xform * child.ysort_xform, p_clip_rect, modulate * child.ysort_modulate, p_z, z_list, (RenderingCanvasItemComponent *)ci->final_clip_owner, (RenderingCanvasItemComponent *)child.material_owner);
-        } else {
-            _render_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, (RenderingCanvasItemComponent *)ci->final_clip_owner, p_material_owner);
-        }
-    }
+    _render_canvas_item_children_parallel(ci, child_items, child_item_count, true, xform, p_clip_rect, modulate, p_z,
+            p_material_owner, r_ctx);
 
     if (ci->copy_back_buffer) {
         ci->copy_back_buffer->screen_rect = xform.xform(ci->copy_back_buffer->rect).clip(p_clip_rect);
     }
 
     if (ci->update_when_visible) {
-        RenderingServerRaster::redraw_request(false);
+        r_ctx.redraw_requested = true;
     }
 
     if ((!ci->commands.empty() && p_clip_rect.intersects(global_rect,true)) || ci->vp_render || ci->copy_back_buffer) {
@@ -204,56 +324,68 @@ void _render_canvas_item(RenderingEntity p_canvas_item, const Transform2D &p_tra
         ci->global_rect_cache.position -= p_clip_rect.position;
         ci->light_masked = false;
 
-        int zidx = p_z - RS::CANVAS_ITEM_Z_MIN;
-
-        z_list[zidx].emplace_back(ci);
+        r_ctx.items->push_back({ p_z - RS::CANVAS_ITEM_Z_MIN, ci });
     }
 
-    for (int i = 0; i < child_item_count; i++) {
-        auto & child(canvas_items_view.get<RenderingCanvasItemComponent>(child_items[i]));
+    _render_canvas_item_children_parallel(ci, child_items, child_item_count, false, xform, p_clip_rect, modulate, p_z,
+            p_material_owner, r_ctx);
+}
 
-        if (child.behind || (ci->sort_y && child.sort_y)) {
-            continue;
-        }
-        if (ci->sort_y) {
-            _render_canvas_item(child_items[i], xform * child.ysort_xform, p_clip_rect, modulate * child.ysort_modulate, p_z, z_list,
-                    ci->final_clip_owner, child.material_owner);
-        } else {
-            _render_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, (RenderingCanvasItemComponent *)ci->final_clip_owner, p_material_owner);
+void _light_mask_canvas_items(int p_z, const Dequeue<RasterizerCanvas::Item *> &p_canvas_item, Span<RasterizerCanvasLight3DComponent *> p_masked_lights) {
+
+    if (p_masked_lights.empty())
+        return;
+
+    for(RasterizerCanvas::Item *ci : p_canvas_item) {
+        for(RasterizerCanvasLight3DComponent *light : p_masked_lights) {
+            if (ci->light_mask & light->item_mask && p_z >= light->z_min && p_z <= light->z_max && ci->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache)) {
+                ci->light_masked = true;
+            }
         }
+
     }
 }
 }
 
-void RenderingServerCanvas::_render_canvas_item_tree(RenderingEntity p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, Span<RasterizerCanvasLight3DComponent *> p_lights) {
-    z_sort_arr.clear();
-    z_sort_arr.resize(z_range);
+void RenderingServerCanvas::_render_culled_items(const Color &p_modulate, Span<RasterizerCanvasLight3DComponent *> p_lights,
+        Span<RasterizerCanvasLight3DComponent *> p_masked_lights, const Transform2D &p_transform) {
 
-    _render_canvas_item(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_sort_arr, nullptr, nullptr);
+    // bucketing keeps the traversal order within each z layer
+    int z_first = z_range;
+    int z_last = -1;
+    for (const CanvasCulledItem &E : culled_items) {
+        z_sort_arr[E.z_index].push_back(E.item);
+        z_first = MIN(z_first, E.z_index);
+        z_last = M_MAX(z_last, E.z_index);
+    }
+    culled_items.clear();
 
     VSG::canvas_render->canvas_render_items_begin(p_modulate, p_lights, p_transform);
-    for (int i = 0; i < z_range; i++) {
+    for (int i = z_first; i <= z_last; i++) {
         if (z_sort_arr[i].empty())
             continue;
+
+        if (!p_masked_lights.empty()) {
+            _light_mask_canvas_items(RS::CANVAS_ITEM_Z_MIN + i, z_sort_arr[i], p_masked_lights);
+        }
+
         VSG::canvas_render->canvas_render_items(z_sort_arr[i], RS::CANVAS_ITEM_Z_MIN + i, p_modulate, p_lights, p_transform);
+        z_sort_arr[i].clear();
     }
     VSG::canvas_render->canvas_render_items_end();
 }
 
+void RenderingServerCanvas::_render_canvas_item_tree(RenderingEntity p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, Span<RasterizerCanvasLight3DComponent *> p_lights) {
 
-void _light_mask_canvas_items(int p_z, const Dequeue<RasterizerCanvas::Item *> &p_canvas_item, Span<RasterizerCanvasLight3DComponent *> p_masked_lights) {
-
-    if (p_masked_lights.empty())
-        return;
-
-    for(RasterizerCanvas::Item *ci : p_canvas_item) {
-        for(RasterizerCanvasLight3DComponent *light : p_masked_lights) {
-            if (ci->light_mask & light->item_mask && p_z >= light->z_min && p_z <= light->z_max && ci->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache)) {
-                ci->light_masked = true;
-            }
-        }
-
+    CanvasCullContext ctx;
+    ctx.items = &culled_items;
+    ctx.parallel = true;
+    _render_canvas_item(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, ctx, nullptr, nullptr);
+    if (ctx.redraw_requested) {
+        RenderingServerRaster::redraw_request(false);
     }
+
+    _render_culled_items(p_modulate, p_lights, {}, p_transform);
 }
 
 void RenderingServerCanvas::render_canvas(RenderingCanvasComponent *p_canvas, const Transform2D &p_transform,
@@ -281,24 +413,17 @@ void RenderingServerCanvas::render_canvas(RenderingCanvasComponent *p_canvas, co
 
     if (!has_mirror) {
 
-        constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
-        Dequeue<RasterizerCanvas::Item *> z_list[z_range];
-
+        CanvasCullContext ctx;
+        ctx.items = &culled_items;
+        ctx.parallel = true;
         for (int i = 0; i < l; i++) {
-            _render_canvas_item(ci[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, nullptr, nullptr);
+            _render_canvas_item(ci[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, ctx, nullptr, nullptr);
         }
-        VSG::canvas_render->canvas_render_items_begin(p_canvas->modulate, p_lights, p_transform);
-        for (int i = 0; i < z_range; i++) {
-            if (z_list[i].empty())
-                continue;
-
-            if (!p_masked_lights.empty()) {
-                _light_mask_canvas_items(RS::CANVAS_ITEM_Z_MIN + i, z_list[i], p_masked_lights);
-            }
-
-            VSG::canvas_render->canvas_render_items(z_list[i], RS::CANVAS_ITEM_Z_MIN + i, p_canvas->modulate, p_lights, p_transform);
+        if (ctx.redraw_requested) {
+            RenderingServerRaster::redraw_request(false);
         }
-        VSG::canvas_render->canvas_render_items_end();
+
+        _render_culled_items(p_canvas->modulate, p_lights, p_masked_lights, p_transform);
     } else {
 
         for (int i = 0; i < l; i++) {
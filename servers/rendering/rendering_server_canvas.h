@@ -140,6 +140,12 @@ struct LightOccluderPolygonComponent {
     ~LightOccluderPolygonComponent();
 };
 
+// Canvas item that passed culling, with the z layer it is drawn in.
+struct CanvasCulledItem {
+    int z_index; // offset from RS::CANVAS_ITEM_Z_MIN
+    RasterizerCanvas::Item *item;
+};
+
 class RenderingServerCanvas {
 public:
 
@@ -154,7 +160,11 @@ public:
 private:
     void _render_canvas_item_tree(RenderingEntity p_canvas_item, const Transform2D &p_transform,
             const Rect2 &p_clip_rect, const Color &p_modulate, Span<RasterizerCanvasLight3DComponent *> p_lights);
+    void _render_culled_items(const Color &p_modulate, Span<RasterizerCanvasLight3DComponent *> p_lights,
+            Span<RasterizerCanvasLight3DComponent *> p_masked_lights, const Transform2D &p_transform);
 
+    // Items in traversal order, bucketed by z before they are drawn.
+    Vector<CanvasCulledItem> culled_items;
     Vector<Dequeue<RasterizerCanvas::Item *>> z_sort_arr;
 
 public:
@@ -110,7 +110,9 @@ void RenderingServerRaster::draw(bool p_swap_buffers, double frame_step) {
     VSG::rasterizer->begin_frame(frame_step);
     PROFILER_STARTFRAME("viewport");
 
+    VSG::scene->instance_updates_in_frame = 0;
     VSG::scene->update_dirty_instances(); //update scene stuff
+    VSG::scene->update_pending_instances();
 
     VSG::viewport->draw_viewports();
     VSG::scene->render_probes();
@@ -160,7 +162,14 @@ void RenderingServerRaster::finish() {
 
 uint64_t RenderingServerRaster::get_render_info(RS::RenderInfo p_info) {
 
-    return VSG::storage->get_render_info(p_info);
+    switch (p_info) {
+        case RS::INFO_INSTANCE_UPDATES_IN_FRAME:
+            return VSG::scene->get_instance_updates_in_frame();
+        case RS::INFO_PENDING_INSTANCE_UPDATES:
+            return VSG::scene->get_pending_instance_update_count();
+        default:
+            return VSG::storage->get_render_info(p_info);
+    }
 }
 const char *RenderingServerRaster::get_video_adapter_name() const {
 
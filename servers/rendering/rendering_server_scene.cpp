@@ -77,6 +77,14 @@ struct Dirty {
 
 };
 
+// Work left over by a budgeted update_dirty_instances, done by update_pending_instances
+struct PendingInstanceUpdate {
+    bool update_materials : 1;
+    bool update_lightmap_captures : 1;
+
+    constexpr PendingInstanceUpdate() : update_materials(false), update_lightmap_captures(false) { }
+};
+
 struct InstanceBoundsComponent {
 
     AABB aabb;
@@ -603,6 +611,17 @@ int SpatialPartitioningScene_BVH::cull_convex(Span<const Plane> p_convex, Span<R
     return _bvh.cull_convex(p_convex, p_result_array, _dummy_cull_object);
 }
 
+void SpatialPartitioningScene_BVH::prepare_concurrent_cull(uint32_t p_mask) {
+    check_bvh_userdata();
+    auto &ric = VSG::ecs->registry.get<RenderingInstanceComponent>(_dummy_cull_object);
+    ric.bvh_pairable_mask = p_mask;
+    ric.bvh_pairable_type = 0;
+}
+
+int SpatialPartitioningScene_BVH::cull_convex_concurrent(Span<const Plane> p_convex, Span<RenderingEntity> p_result_array) {
+    return _bvh.cull_convex_concurrent(p_convex, p_result_array, _dummy_cull_object);
+}
+
 int SpatialPartitioningScene_BVH::cull_aabb(const AABB &p_aabb, Span<RenderingEntity> p_result_array, int *p_subindex_array, uint32_t p_mask) {
     check_bvh_userdata();
     auto &ric = VSG::ecs->registry.get<RenderingInstanceComponent>(_dummy_cull_object);
@@ -1812,7 +1831,11 @@ void VisualServerScene::_update_instance(RenderingInstanceComponent *p_instance)
 
         if (p_instance->lightmap_capture == entt::null && !geom->lightmap_captures.empty()) {
             //affected by lightmap captures, must update capture info!
-            _update_instance_lightmap_captures(p_instance);
+            if (defer_instance_updates) {
+                _queue_pending_instance_update(p_instance, false, true);
+            } else {
+                _update_instance_lightmap_captures(p_instance);
+            }
         } else {
             if (!p_instance->lightmap_capture_data.empty()) {
                 p_instance->lightmap_capture_data.clear(); //not in use, clear capture data
@@ -2184,15 +2207,34 @@ void VisualServerScene::_update_instance_lightmap_captures(RenderingInstanceComp
     }
 }
 
-bool VisualServerScene::_light_instance_update_shadow(RenderingInstanceComponent *p_instance, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RenderingEntity p_shadow_atlas, RenderingScenarioComponent *p_scenario) {
+VisualServerScene::ShadowPass &VisualServerScene::_push_shadow_pass(RenderingInstanceComponent *p_light, int p_pass) {
+    // passes are kept between frames so their caster buffers don't need to be reallocated
+    if (shadow_pass_count == (int)shadow_passes.size()) {
+        shadow_passes.emplace_back();
+    }
+    ShadowPass &pass = shadow_passes[shadow_pass_count++];
+    pass.light = p_light;
+    pass.pass = p_pass;
+    pass.projection = CameraMatrix();
+    pass.far = 0;
+    pass.split = 0;
+    pass.bias_scale = 1.0f;
+    pass.directional = false;
+    pass.cull_from_point = false;
+    pass.room_id_hint = nullptr;
+    pass.restore_paraboloid = false;
+    pass.caster_count = 0;
+    pass.animated_material_found = false;
+    return pass;
+}
+
+void VisualServerScene::_light_instance_setup_shadow(RenderingInstanceComponent *p_instance, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RenderingScenarioComponent *p_scenario) {
 
     InstanceLightData *light = getUnchecked<InstanceLightData>(p_instance->self);
 
     Transform light_transform = p_instance->transform;
     light_transform.orthonormalize(); //scale does not count on lights
 
-    bool animated_material_found = false;
-
     auto instance_view(VSG::ecs->registry.view<RenderingInstanceComponent>());
     switch (VSG::storage->light_get_type(p_instance->base)) {
 
@@ -2212,7 +2254,6 @@ bool VisualServerScene::_light_instance_update_shadow(RenderingInstanceComponent
                 //optimize min/max
                 Frustum planes = p_cam_projection.get_projection_planes(p_cam_transform);
                 int cull_count = p_scenario->sps.cull_convex(planes, instance_shadow_cull_result, RS::INSTANCE_GEOMETRY_MASK);
-                int room_hint=0;//light->previous_room_id_hint
                 Plane base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
                 //check distance max and min
 
@@ -2233,10 +2274,6 @@ bool VisualServerScene::_light_instance_update_shadow(RenderingInstanceComponent
                     if(!cm_geom.can_cast_shadows)
                         continue;
 
-                    if (cm_geom.material_is_animated) {
-                        animated_material_found = true;
-                    }
-
                     float max, min;
                     get_component<InstanceBoundsComponent>(instance.self).transformed_aabb.project_range_in_plane(base, min, max);
 
@@ -2403,60 +2440,30 @@ bool VisualServerScene::_light_instance_update_shadow(RenderingInstanceComponent
 
                 //now that we now all ranges, we can proceed to make the light frustum planes, for culling octree
 
-                Frustum light_frustum_planes;
+                ShadowPass &pass = _push_shadow_pass(p_instance, i);
 
                 //right/left
-                light_frustum_planes[0] = Plane(x_vec, x_max);
-                light_frustum_planes[1] = Plane(-x_vec, -x_min);
+                pass.planes[0] = Plane(x_vec, x_max);
+                pass.planes[1] = Plane(-x_vec, -x_min);
                 //top/bottom
-                light_frustum_planes[2] = Plane(y_vec, y_max);
-                light_frustum_planes[3] = Plane(-y_vec, -y_min);
+                pass.planes[2] = Plane(y_vec, y_max);
+                pass.planes[3] = Plane(-y_vec, -y_min);
                 //near/far
-                light_frustum_planes[4] = Plane(z_vec, z_max + 1e6f);
-                light_frustum_planes[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
-
-                int cull_count = p_scenario->sps.cull_convex(light_frustum_planes, instance_shadow_cull_result, RS::INSTANCE_GEOMETRY_MASK);
-
-                // a pre pass will need to be needed to determine the actual z-near to be used
-
-                Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-
-                for (int j = 0; j < cull_count; j++) {
-
-                    float min, max;
-                    auto &instance = instance_view.get<RenderingInstanceComponent>(instance_shadow_cull_result[j]);
-
-                    if (!instance.visible || !has_component<GeometryComponent>(instance.self) ||
-                            !get_component<GeometryComponent>(instance.self).can_cast_shadows) {
-                        cull_count--;
-                        SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-                        j--;
-                        continue;
-                    }
-
-                    get_component<InstanceBoundsComponent>(instance.self).transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
-                    instance.depth = near_plane.distance_to(instance.transform.origin);
-                    instance.depth_layer = 0;
-                    if (max > z_max)
-                        z_max = max;
-                }
-
-                {
-
-                    CameraMatrix ortho_camera;
-                    real_t half_x = (x_max_cam - x_min_cam) * 0.5f;
-                    real_t half_y = (y_max_cam - y_min_cam) * 0.5f;
-
-                    ortho_camera.set_orthogonal(-half_x, half_x, -half_y, half_y, 0, (z_max - z_min_cam));
-
-                    Transform ortho_transform;
-                    ortho_transform.basis = transform.basis;
-                    ortho_transform.origin = x_vec * (x_min_cam + half_x) + y_vec * (y_min_cam + half_y) + z_vec * z_max;
-
-                    VSG::scene_render->light_instance_set_shadow_transform(light->instance, ortho_camera, ortho_transform, 0, distances[i + 1], i, bias_scale);
-                }
-
-                VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, Span<RenderingEntity>(instance_shadow_cull_result, cull_count));
+                pass.planes[4] = Plane(z_vec, z_max + 1e6f);
+                pass.planes[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
+
+                // the ortho camera is set up once the casters are known, as they can extend z_max
+                pass.directional = true;
+                pass.transform = transform;
+                pass.near_plane = Plane(light_transform.origin, -light_transform.basis.get_axis(2));
+                pass.split = distances[i + 1];
+                pass.bias_scale = bias_scale;
+                pass.x_min_cam = x_min_cam;
+                pass.x_max_cam = x_max_cam;
+                pass.y_min_cam = y_min_cam;
+                pass.y_max_cam = y_max_cam;
+                pass.z_min_cam = z_min_cam;
+                pass.z_max = z_max;
             }
 
         } break;
@@ -2473,38 +2480,17 @@ bool VisualServerScene::_light_instance_update_shadow(RenderingInstanceComponent
                     float radius = VSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
                     float z = i == 0 ? -1 : 1;
-                    Plane planes[6] = {
-                        light_transform.xform(Plane(Vector3(0, 0, z), radius)),
-                        light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius)),
-                        light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius)),
-                        light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius)),
-                        light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius)),
-                        light_transform.xform(Plane(Vector3(0, 0, -z).normalized(), radius)),
-                    };
-
-                    int cull_count = p_scenario->sps.cull_convex(planes, instance_shadow_cull_result, RS::INSTANCE_GEOMETRY_MASK);
-                    Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
-
-                    for (int j = 0; j < cull_count; j++) {
-
-                        auto *instance = getUnchecked<RenderingInstanceComponent>(instance_shadow_cull_result[j]);
-                        if (!instance->visible || !has_component<GeometryComponent>(instance->self) ||
-                                !get_component<GeometryComponent>(instance->self).can_cast_shadows) {
-                            cull_count--;
-                            SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-                            j--;
-                        } else {
-                            if (get_component<GeometryComponent>(instance->self).material_is_animated) {
-                                animated_material_found = true;
-                            }
-
-                            instance->depth = near_plane.distance_to(instance->transform.origin);
-                            instance->depth_layer = 0;
-                        }
-                    }
-
-                    VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i);
-                    VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, Span<RenderingEntity>(instance_shadow_cull_result, cull_count));
+                    ShadowPass &pass = _push_shadow_pass(p_instance, i);
+                    pass.planes[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
+                    pass.planes[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
+                    pass.planes[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
+                    pass.planes[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
+                    pass.planes[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
+                    pass.planes[5] = light_transform.xform(Plane(Vector3(0, 0, -z).normalized(), radius));
+
+                    pass.near_plane = Plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
+                    pass.transform = light_transform;
+                    pass.far = radius;
                 }
             } else { //shadow cube
 
@@ -2535,36 +2521,20 @@ bool VisualServerScene::_light_instance_update_shadow(RenderingInstanceComponent
 
                     Transform xform = light_transform * Transform().looking_at(view_normals[i], view_up[i]);
 
-                    Frustum planes = cm.get_projection_planes(xform);
-
-                    int cull_count = _cull_convex_from_point(p_scenario, light_transform, cm, planes,
-                            instance_shadow_cull_result, light->previous_room_id_hint,
-                            RS::INSTANCE_GEOMETRY_MASK);
+                    ShadowPass &pass = _push_shadow_pass(p_instance, i);
+                    pass.planes = cm.get_projection_planes(xform);
+                    pass.cull_from_point = true;
+                    pass.cull_transform = light_transform;
+                    pass.room_id_hint = &light->previous_room_id_hint;
 
-                    Plane near_plane(xform.origin, -xform.basis.get_axis(2));
-                    for (int j = 0; j < cull_count; j++) {
-
-                        auto &instance = instance_view.get<RenderingInstanceComponent>(instance_shadow_cull_result[j]);
-                        if (!instance.visible || !has_component<GeometryComponent>(instance.self) ||
-                                !get_component<GeometryComponent>(instance.self).can_cast_shadows) {
-                            cull_count--;
-                            SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-                            j--;
-                        } else {
-                            if (get_component<GeometryComponent>(instance.self).material_is_animated) {
-                                animated_material_found = true;
-                            }
-                            instance.depth = near_plane.distance_to(instance.transform.origin);
-                            instance.depth_layer = 0;
-                        }
-                    }
+                    pass.near_plane = Plane(xform.origin, -xform.basis.get_axis(2));
+                    pass.projection = cm;
+                    pass.transform = xform;
+                    pass.far = radius;
 
-                    VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i);
-                    VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, Span<RenderingEntity>(instance_shadow_cull_result, cull_count));
+                    //restore the regular DP matrix after the last face
+                    pass.restore_paraboloid = i == 5;
                 }
-
-                //restore the regular DP matrix
-                VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, 0);
             }
 
         } break;
@@ -2576,35 +2546,138 @@ bool VisualServerScene::_light_instance_update_shadow(RenderingInstanceComponent
             CameraMatrix cm;
             cm.set_perspective(angle * 2.0f, 1.0, 0.01f, radius);
 
-            Frustum planes = cm.get_projection_planes(light_transform);
-            int room_hint = 0; // light->previous_room_id_hint;
-            int cull_count = _cull_convex_from_point(p_scenario, light_transform, cm, planes,
-                    instance_shadow_cull_result, room_hint, RS::INSTANCE_GEOMETRY_MASK);
-            Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-            for (int j = 0; j < cull_count; j++) {
-
-                RenderingInstanceComponent *instance = getUnchecked<RenderingInstanceComponent>(instance_shadow_cull_result[j]);
-                if (!instance->visible || !has_component<GeometryComponent>(instance->self) ||
-                        !get_component<GeometryComponent>(instance->self).can_cast_shadows) {
-                    cull_count--;
-                    SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-                    j--;
-                } else {
-                    if (get_component<GeometryComponent>(instance->self).material_is_animated) {
-                        animated_material_found = true;
-                    }
-                    instance->depth = near_plane.distance_to(instance->transform.origin);
-                    instance->depth_layer = 0;
-                }
-            }
+            ShadowPass &pass = _push_shadow_pass(p_instance, 0);
+            pass.planes = cm.get_projection_planes(light_transform);
+            pass.cull_from_point = true;
+            pass.cull_transform = light_transform;
 
-            VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0);
-            VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, Span<RenderingEntity>(instance_shadow_cull_result, cull_count));
+            pass.near_plane = Plane(light_transform.origin, -light_transform.basis.get_axis(2));
+            pass.projection = cm;
+            pass.transform = light_transform;
+            pass.far = radius;
 
         } break;
     }
+}
+
+void VisualServerScene::_shadow_pass_cull(uint32_t p_index, RenderingScenarioComponent *p_scenario) {
+    ShadowPass &pass = shadow_passes[p_index];
+
+    thread_local Vector<RenderingEntity> cull_result;
+    cull_result.resize(MAX_INSTANCE_CULL);
+
+    int cull_count;
+    if (!shadow_cull_concurrent) {
+        if (pass.cull_from_point) {
+            int32_t room_hint = 0;
+            cull_count = _cull_convex_from_point(p_scenario, pass.cull_transform, pass.projection, pass.planes,
+                    cull_result, pass.room_id_hint ? *pass.room_id_hint : room_hint, RS::INSTANCE_GEOMETRY_MASK);
+        } else {
+            cull_count = p_scenario->sps.cull_convex(pass.planes, cull_result, RS::INSTANCE_GEOMETRY_MASK);
+        }
+    } else {
+        cull_count = p_scenario->sps.cull_convex_concurrent(pass.planes, cull_result);
+    }
+
+    // only reads here, the instance depths are written when the pass is rendered
+    auto instance_view(VSG::ecs->registry.view<RenderingInstanceComponent>());
+    const Plane depth_plane(pass.transform.basis.get_axis(Vector3::AXIS_Z).normalized(), 0);
+
+    pass.casters.resize(cull_count);
+    int caster_count = 0;
+    for (int j = 0; j < cull_count; j++) {
+
+        auto &instance = instance_view.get<RenderingInstanceComponent>(cull_result[j]);
+        if (!instance.visible || !has_component<GeometryComponent>(instance.self) ||
+                !get_component<GeometryComponent>(instance.self).can_cast_shadows) {
+            continue;
+        }
+
+        if (get_component<GeometryComponent>(instance.self).material_is_animated) {
+            pass.animated_material_found = true;
+        }
+
+        if (pass.directional) {
+            float min, max;
+            get_component<InstanceBoundsComponent>(instance.self).transformed_aabb.project_range_in_plane(depth_plane, min, max);
+            if (max > pass.z_max)
+                pass.z_max = max;
+        }
+
+        pass.casters[caster_count++] = cull_result[j];
+    }
+    pass.caster_count = caster_count;
+}
+
+void VisualServerScene::_cull_shadow_passes(RenderingScenarioComponent *p_scenario) {
+    if (shadow_pass_count == 0) {
+        return;
+    }
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+    // the portal renderer keeps state while culling, so with rooms or occluders the passes go one by one
+    shadow_cull_concurrent = !p_scenario->_portal_renderer.is_active() && !p_scenario->_portal_renderer.occlusion_is_active();
+
+    if (shadow_cull_concurrent) {
+        p_scenario->sps.prepare_concurrent_cull(RS::INSTANCE_GEOMETRY_MASK);
+        SharedThreadWorkPool::do_work(shadow_pass_count, this, &VisualServerScene::_shadow_pass_cull, p_scenario);
+    } else {
+        for (int i = 0; i < shadow_pass_count; i++) {
+            _shadow_pass_cull(i, p_scenario);
+        }
+    }
+
+    last_shadow_cull_usec += OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+void VisualServerScene::_render_shadow_passes(RenderingEntity p_shadow_atlas) {
+
+    auto instance_view(VSG::ecs->registry.view<RenderingInstanceComponent>());
+
+    for (int i = 0; i < shadow_pass_count; i++) {
+        ShadowPass &pass = shadow_passes[i];
+        InstanceLightData *light = getUnchecked<InstanceLightData>(pass.light->self);
+
+        for (int j = 0; j < pass.caster_count; j++) {
+            auto &instance = instance_view.get<RenderingInstanceComponent>(pass.casters[j]);
+            instance.depth = pass.near_plane.distance_to(instance.transform.origin);
+            instance.depth_layer = 0;
+        }
+
+        if (pass.directional) {
+
+            Vector3 x_vec = pass.transform.basis.get_axis(Vector3::AXIS_X).normalized();
+            Vector3 y_vec = pass.transform.basis.get_axis(Vector3::AXIS_Y).normalized();
+            Vector3 z_vec = pass.transform.basis.get_axis(Vector3::AXIS_Z).normalized();
+
+            CameraMatrix ortho_camera;
+            real_t half_x = (pass.x_max_cam - pass.x_min_cam) * 0.5f;
+            real_t half_y = (pass.y_max_cam - pass.y_min_cam) * 0.5f;
+
+            ortho_camera.set_orthogonal(-half_x, half_x, -half_y, half_y, 0, (pass.z_max - pass.z_min_cam));
+
+            Transform ortho_transform;
+            ortho_transform.basis = pass.transform.basis;
+            ortho_transform.origin = x_vec * (pass.x_min_cam + half_x) + y_vec * (pass.y_min_cam + half_y) + z_vec * pass.z_max;
+
+            VSG::scene_render->light_instance_set_shadow_transform(light->instance, ortho_camera, ortho_transform, 0, pass.split, pass.pass, pass.bias_scale);
+        } else {
+            VSG::scene_render->light_instance_set_shadow_transform(light->instance, pass.projection, pass.transform, pass.far, pass.split, pass.pass);
+
+            if (pass.animated_material_found) {
+                light->shadow_dirty = true;
+            }
+        }
+
+        VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, pass.pass, Span<RenderingEntity>(pass.casters.data(), pass.caster_count));
+
+        if (pass.restore_paraboloid) {
+            VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), pass.cull_transform, pass.far, 0, 0);
+        }
+    }
 
-    return animated_material_found;
+    shadow_pass_count = 0;
 }
 
 void VisualServerScene::render_camera(RenderingEntity p_camera, RenderingEntity p_scenario, Size2 p_viewport_size, RenderingEntity p_shadow_atlas) {
@@ -2995,7 +3068,7 @@ void VisualServerScene::_prepare_scene(const Transform &p_cam_transform, const C
 
         for (int i = 0; i < directional_shadow_count; i++) {
 
-            _light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+            _light_instance_setup_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario);
         }
     }
 
@@ -3094,9 +3167,13 @@ void VisualServerScene::_prepare_scene(const Transform &p_cam_transform, const C
 
             if (redraw) {
                 //must redraw!
-                light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+                _light_instance_setup_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario);
             }
         }
+
+        // lights with animated materials are marked dirty again when their passes are rendered
+        _cull_shadow_passes(scenario);
+        _render_shadow_passes(p_shadow_atlas);
     }
 
     // Calculate instance->depth from the camera, after shadow calculation has stopped overwriting instance->depth
@@ -3766,6 +3843,18 @@ _FORCE_INLINE_ void VisualServerScene::_update_dirty_instance(RenderingInstanceC
 
 void VisualServerScene::_update_instance_material(RenderingInstanceComponent *p_instance) {
 
+    _update_instance_material_slots(p_instance);
+    _update_instance_material_flags(p_instance);
+
+    clear_component<Dirty>(p_instance->self);
+
+    _update_instance(p_instance);
+
+}
+
+// The material slots must match the mesh surfaces before the instance is drawn, so this part is never deferred.
+void VisualServerScene::_update_instance_material_slots(RenderingInstanceComponent *p_instance) {
+
     if (p_instance->base_type == RS::INSTANCE_MESH) {
         //remove materials no longer used and un-own them
 
@@ -3785,6 +3874,10 @@ void VisualServerScene::_update_instance_material(RenderingInstanceComponent *p_
             }
         }
     }
+}
+
+void VisualServerScene::_update_instance_material_flags(RenderingInstanceComponent *p_instance) {
+
     if (has_component<GeometryComponent>(p_instance->self)) {
 
         InstanceGeometryData *geom = get_instance_geometry(p_instance->self);
@@ -3922,11 +4015,21 @@ void VisualServerScene::_update_instance_material(RenderingInstanceComponent *p_
 
         gcomp.material_is_animated = is_animated;
     }
+}
 
-    clear_component<Dirty>(p_instance->self);
+void VisualServerScene::_update_dirty_aabb(uint32_t p_index, void *p_userdata) {
+    _update_instance_aabb(dirty_aabb_list[p_index]);
+}
 
-    _update_instance(p_instance);
+void VisualServerScene::_queue_pending_instance_update(RenderingInstanceComponent *p_instance, bool p_materials, bool p_lightmap_captures) {
 
+    if (!has_component<PendingInstanceUpdate>(p_instance->self)) {
+        VSG::ecs->registry.emplace<PendingInstanceUpdate>(p_instance->self);
+        pending_instance_updates.push_back(p_instance->self);
+    }
+    PendingInstanceUpdate &pending = get_component<PendingInstanceUpdate>(p_instance->self);
+    pending.update_materials = pending.update_materials || p_materials;
+    pending.update_lightmap_captures = pending.update_lightmap_captures || p_lightmap_captures;
 }
 
 void VisualServerScene::update_dirty_instances() {
@@ -3939,15 +4042,44 @@ void VisualServerScene::update_dirty_instances() {
     }
 
     auto view = VSG::ecs->registry.view<RenderingInstanceComponent, Dirty>();
-    FixedVector<RenderingScenarioComponent *,16,true> scenarios_to_update;
+    dirty_instance_list.clear();
+    dirty_aabb_list.clear();
     for (auto entity : view) {
-        RenderingInstanceComponent *p_instance = &view.get<RenderingInstanceComponent>(entity);
-        const Dirty & dt = view.get<Dirty>(entity);
-        if (dt.update_aabb) {
+        dirty_instance_list.push_back(&view.get<RenderingInstanceComponent>(entity));
+    }
+    if (dirty_instance_list.empty()) {
+        return;
+    }
+    instance_updates_in_frame += dirty_instance_list.size();
+
+    // Mesh AABBs only read the storage, so a large batch of them is recomputed on the shared work pool.
+    // The other base types can update storage state while being queried and stay on this thread.
+    constexpr int PARALLEL_AABB_THRESHOLD = 256;
+    const bool parallel_aabb = dirty_instance_list.size() >= PARALLEL_AABB_THRESHOLD;
+    for (RenderingInstanceComponent *p_instance : dirty_instance_list) {
+        if (!view.get<Dirty>(p_instance->self).update_aabb) {
+            continue;
+        }
+        if (parallel_aabb && p_instance->base_type == RS::INSTANCE_MESH) {
+            dirty_aabb_list.push_back(p_instance);
+        } else {
             _update_instance_aabb(p_instance);
         }
-        if (dt.update_materials) {
-            _update_instance_material(p_instance);
+    }
+    if (!dirty_aabb_list.empty()) {
+        SharedThreadWorkPool::do_work(dirty_aabb_list.size(), this, &VisualServerScene::_update_dirty_aabb, nullptr);
+    }
+
+    defer_instance_updates = instance_update_budget_usec > 0;
+    FixedVector<RenderingScenarioComponent *,16,true> scenarios_to_update;
+    for (RenderingInstanceComponent *p_instance : dirty_instance_list) {
+        if (view.get<Dirty>(p_instance->self).update_materials) {
+            _update_instance_material_slots(p_instance);
+            if (defer_instance_updates) {
+                _queue_pending_instance_update(p_instance, true, false);
+            } else {
+                _update_instance_material_flags(p_instance);
+            }
         }
         _update_instance(p_instance);
         auto *scenario = get<RenderingScenarioComponent>(p_instance->scenario);
@@ -3955,6 +4087,8 @@ void VisualServerScene::update_dirty_instances() {
             scenarios_to_update.emplace_back(scenario);
         }
     }
+    defer_instance_updates = false;
+
     //remove dirty for everything
     VSG::ecs->registry.clear<Dirty>();
     for(auto scn : scenarios_to_update) {
@@ -3962,6 +4096,42 @@ void VisualServerScene::update_dirty_instances() {
     }
 }
 
+void VisualServerScene::update_pending_instances() {
+
+    SCOPE_AUTONAMED
+
+    if (pending_instance_updates.empty()) {
+        return;
+    }
+
+    // at least one instance is updated per call, so a tiny budget still makes progress
+    const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    do {
+        RenderingEntity entity = pending_instance_updates.front();
+        pending_instance_updates.pop_front();
+
+        // the instance may have been freed since it was queued
+        RenderingInstanceComponent *instance = get<RenderingInstanceComponent>(entity);
+        if (!instance || !has_component<PendingInstanceUpdate>(entity)) {
+            continue;
+        }
+        const PendingInstanceUpdate pending = get_component<PendingInstanceUpdate>(entity);
+        VSG::ecs->registry.remove<PendingInstanceUpdate>(entity);
+
+        if (pending.update_materials) {
+            _update_instance_material_flags(instance);
+        }
+        if (pending.update_lightmap_captures && instance->lightmap_capture == entt::null &&
+                has_component<GeometryComponent>(entity) && !get_instance_geometry(entity)->lightmap_captures.empty()) {
+            _update_instance_lightmap_captures(instance);
+        }
+    } while (!pending_instance_updates.empty() && OS::get_singleton()->get_ticks_usec() - begin < instance_update_budget_usec);
+}
+
+int VisualServerScene::get_pending_instance_update_count() const {
+    return VSG::ecs->registry.view<PendingInstanceUpdate>().size();
+}
+
 
 VisualServerScene *VisualServerScene::singleton = nullptr;
 
@@ -3974,6 +4144,9 @@ VisualServerScene::VisualServerScene() {
             "rendering/quality/spatial_partitioning/bvh_collision_margin",
             PropertyInfo(VariantType::FLOAT, "rendering/quality/spatial_partitioning/bvh_collision_margin",
                     PropertyHint::Range, "0.0,2.0,0.01"));
+    instance_update_budget_usec = uint64_t(T_GLOBAL_DEF("rendering/limits/time/instance_update_budget_msec", 0.0f) * 1000.0f);
+    ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/time/instance_update_budget_msec",
+            PropertyInfo(VariantType::FLOAT, "rendering/limits/time/instance_update_budget_msec", PropertyHint::Range, "0.0,16.0,0.1"));
 }
 
 VisualServerScene::~VisualServerScene() {
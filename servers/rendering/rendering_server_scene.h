@@ -36,6 +36,7 @@
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/os/mutex.h"
+#include "core/os/thread_work_pool.h"
 #include "core/list.h"
 #include "core/self_list.h"
 #include "core/deque.h"
@@ -139,6 +140,10 @@ public:
     void update_collisions() { _bvh.update_collisions(); check_bvh_userdata(); }
     void set_pairable(RenderingInstanceComponent *p_instance, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask);
     int cull_convex(Span<const Plane> p_convex, Span<RenderingEntity> p_result_array, uint32_t p_mask = 0xFFFFFFFF);
+    // Culling from several threads at once. The mask is set once up front, and the tree
+    // must not change until all the culls are done.
+    void prepare_concurrent_cull(uint32_t p_mask);
+    int cull_convex_concurrent(Span<const Plane> p_convex, Span<RenderingEntity> p_result_array);
     int cull_aabb(const AABB &p_aabb, Span<RenderingEntity> p_result_array, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF);
     int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Span<RenderingEntity> p_result_array, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF);
     void set_pair_callback(PairCallback p_callback, void *p_userdata) {
@@ -476,10 +481,65 @@ public:
     _FORCE_INLINE_ void _update_instance_aabb(RenderingInstanceComponent *p_instance);
     _FORCE_INLINE_ void _update_dirty_instance(RenderingInstanceComponent *p_instance);
     void _update_instance_material(RenderingInstanceComponent *p_instance);
+    void _update_instance_material_slots(RenderingInstanceComponent *p_instance);
+    void _update_instance_material_flags(RenderingInstanceComponent *p_instance);
+    void _update_dirty_aabb(uint32_t p_index, void *p_userdata);
+    void _queue_pending_instance_update(RenderingInstanceComponent *p_instance, bool p_materials, bool p_lightmap_captures);
     _FORCE_INLINE_ void _update_instance_lightmap_captures(RenderingInstanceComponent *p_instance);
 
-    _FORCE_INLINE_ bool _light_instance_update_shadow(RenderingInstanceComponent *p_instance, const Transform &p_cam_transform,
-            const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RenderingEntity p_shadow_atlas, RenderingScenarioComponent *p_scenario);
+    // Shadow rendering is split in three steps: the passes of every light that needs a redraw are set up, then all of
+    // them are culled (concurrently when the scenario allows it), and finally they are rendered in order.
+    struct ShadowPass {
+        RenderingInstanceComponent *light = nullptr;
+        int pass = 0;
+        Frustum planes;
+        CameraMatrix projection;
+        Transform transform;
+        Transform cull_transform;
+        Plane near_plane;
+        float far = 0;
+        float split = 0;
+        float bias_scale = 1.0f;
+        int32_t *room_id_hint = nullptr;
+        bool cull_from_point = false;
+        bool directional = false;
+        bool restore_paraboloid = false;
+        // directional only, the ortho camera is built from these once the casters are known
+        float x_min_cam = 0, x_max_cam = 0;
+        float y_min_cam = 0, y_max_cam = 0;
+        float z_min_cam = 0, z_max = 0;
+
+        Vector<RenderingEntity> casters;
+        int caster_count = 0;
+        bool animated_material_found = false;
+    };
+    // Transforms and AABBs of dirty instances are always updated before culling. With a time budget set, the
+    // material flags and lightmap capture data are refreshed later, within the budget of each frame.
+    Dequeue<RenderingEntity> pending_instance_updates;
+    Vector<RenderingInstanceComponent *> dirty_instance_list;
+    Vector<RenderingInstanceComponent *> dirty_aabb_list;
+    uint64_t instance_update_budget_usec = 0;
+    bool defer_instance_updates = false;
+    int instance_updates_in_frame = 0;
+
+    Vector<ShadowPass> shadow_passes;
+    int shadow_pass_count = 0;
+    bool shadow_cull_concurrent = false;
+    uint64_t last_shadow_cull_usec = 0;
+
+    ShadowPass &_push_shadow_pass(RenderingInstanceComponent *p_light, int p_pass);
+    void _light_instance_setup_shadow(RenderingInstanceComponent *p_instance, const Transform &p_cam_transform,
+            const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RenderingScenarioComponent *p_scenario);
+    void _shadow_pass_cull(uint32_t p_index, RenderingScenarioComponent *p_scenario);
+    void _cull_shadow_passes(RenderingScenarioComponent *p_scenario);
+    void _render_shadow_passes(RenderingEntity p_shadow_atlas);
+
+    // time spent culling shadow casters since the last call, for benchmarking
+    uint64_t take_shadow_cull_usec() {
+        uint64_t res = last_shadow_cull_usec;
+        last_shadow_cull_usec = 0;
+        return res;
+    }
 
     void _prepare_scene(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal,
             RenderingEntity p_force_environment, uint32_t p_visible_layers, RenderingEntity p_scenario, RenderingEntity p_shadow_atlas,
@@ -493,6 +553,9 @@ public:
     void render_camera(Ref<ARVRInterface> &p_interface, ARVREyes p_eye, RenderingEntity p_camera, RenderingEntity p_scenario,
             Size2 p_viewport_size, RenderingEntity p_shadow_atlas);
     void update_dirty_instances();
+    void update_pending_instances();
+    int get_pending_instance_update_count() const;
+    int get_instance_updates_in_frame() const { return instance_updates_in_frame; }
 
     //probes
     struct GIProbeDataHeader {
@@ -244,6 +244,14 @@ public:
     FUNC3(skeleton_allocate, RenderingEntity, int, bool)
     FUNC1RC(int, skeleton_get_bone_count, RenderingEntity)
     FUNC3(skeleton_bone_set_transform, RenderingEntity, int, const Transform &)
+    void skeleton_set_bone_transforms(RenderingEntity p1, Span<const Transform> p2) override {
+        assert(Thread::get_caller_id() != server_thread);
+        // The span is not owned, the whole palette is copied in a single command.
+        Vector<Transform> by_val(p2.begin(), p2.end());
+        command_queue.push([p1, by_val = eastl::move(by_val)]() {
+            submission_thread_singleton->skeleton_set_bone_transforms(p1, by_val);
+        });
+    }
     FUNC2RC(Transform, skeleton_bone_get_transform, RenderingEntity, int)
     FUNC3(skeleton_bone_set_transform_2d, RenderingEntity, int, const Transform2D &)
     FUNC2RC(Transform2D, skeleton_bone_get_transform_2d, RenderingEntity, int)
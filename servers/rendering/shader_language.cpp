@@ -885,8 +885,28 @@ void ShaderLanguage::clear() {
     while (nodes) {
         Node *n = nodes;
         nodes = nodes->next;
-        memdelete(n);
+        n->~Node();
     }
+
+    // keep one block around for the next compile
+    for (size_t i = 1; i < node_arena_blocks.size(); i++) {
+        memfree(node_arena_blocks[i]);
+    }
+    if (node_arena_blocks.size() > 1) {
+        node_arena_blocks.resize(1);
+    }
+    node_arena_offset = 0;
+}
+
+void *ShaderLanguage::_alloc_node_memory(uint32_t p_size) {
+    p_size = (p_size + NODE_ARENA_ALIGN - 1) & ~uint32_t(NODE_ARENA_ALIGN - 1);
+    if (node_arena_blocks.empty() || node_arena_offset + p_size > NODE_ARENA_BLOCK_SIZE) {
+        node_arena_blocks.push_back((uint8_t *)memalloc(NODE_ARENA_BLOCK_SIZE));
+        node_arena_offset = 0;
+    }
+    void *mem = node_arena_blocks.back() + node_arena_offset;
+    node_arena_offset += p_size;
+    return mem;
 }
 
 bool ShaderLanguage::_find_identifier(const BlockNode *p_block, const HashMap<StringName, BuiltInInfo> &p_builtin_types,
@@ -6466,7 +6486,7 @@ Error ShaderLanguage::_parse_shader(const HashMap<StringName, FunctionInfo> &p_f
                                         return ERR_PARSE_ERROR;
                                     }
                                 }
-                                ConstantNode *expr = memnew(ConstantNode);
+                                ConstantNode *expr = alloc_node<ConstantNode>();
 
                                 expr->datatype = constant.type;
 
@@ -7289,4 +7309,7 @@ ShaderLanguage::ShaderLanguage() {}
 ShaderLanguage::~ShaderLanguage() {
 
     clear();
+    for (uint8_t *block : node_arena_blocks) {
+        memfree(block);
+    }
 }
@@ -349,9 +349,22 @@ public:
         virtual ~Node() = default;
     };
 
+    // Nodes of a compile live in a bump arena, clear() runs their destructors
+    // and releases the memory in one go.
+    enum {
+        NODE_ARENA_BLOCK_SIZE = 64 * 1024,
+        NODE_ARENA_ALIGN = 16
+    };
+
+    Vector<uint8_t *> node_arena_blocks;
+    uint32_t node_arena_offset = 0;
+
+    void *_alloc_node_memory(uint32_t p_size);
+
     template <class T>
     T *alloc_node() {
-        T *node = memnew(T);
+        static_assert(sizeof(T) <= NODE_ARENA_BLOCK_SIZE, "Node type too large for the arena.");
+        T *node = memnew_placement(_alloc_node_memory(sizeof(T)), T);
         node->next = nodes;
         nodes = node;
         return node;
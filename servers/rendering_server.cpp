@@ -2194,6 +2194,8 @@ void RenderingServer::_bind_methods() {
     BIND_NS_ENUM_CONSTANT(RenderingServerEnums, INFO_VIDEO_MEM_USED);
     BIND_NS_ENUM_CONSTANT(RenderingServerEnums, INFO_TEXTURE_MEM_USED);
     BIND_NS_ENUM_CONSTANT(RenderingServerEnums, INFO_VERTEX_MEM_USED);
+    BIND_NS_ENUM_CONSTANT(RenderingServerEnums, INFO_INSTANCE_UPDATES_IN_FRAME);
+    BIND_NS_ENUM_CONSTANT(RenderingServerEnums, INFO_PENDING_INSTANCE_UPDATES);
 
     BIND_NS_ENUM_CONSTANT(RenderingServerEnums, FEATURE_SHADERS);
     BIND_NS_ENUM_CONSTANT(RenderingServerEnums, FEATURE_MULTITHREADED);
@@ -2412,6 +2414,7 @@ RenderingServer::RenderingServer() {
     GLOBAL_DEF("rendering/batching/options/use_batching", true);
     GLOBAL_DEF_RST("rendering/batching/options/use_batching_in_editor", true);
     GLOBAL_DEF("rendering/batching/options/single_rect_fallback", false);
+    GLOBAL_DEF("rendering/batching/options/cache_static_items", true);
     GLOBAL_DEF("rendering/batching/parameters/max_join_item_commands", 16);
     GLOBAL_DEF("rendering/batching/parameters/colored_vertex_format_threshold", 0.25f);
     GLOBAL_DEF("rendering/batching/lights/scissor_area_threshold", 1.0f);
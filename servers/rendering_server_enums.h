@@ -386,6 +386,8 @@ enum RenderInfo : int8_t {
     INFO_VIDEO_MEM_USED,
     INFO_TEXTURE_MEM_USED,
     INFO_VERTEX_MEM_USED,
+    INFO_INSTANCE_UPDATES_IN_FRAME,
+    INFO_PENDING_INSTANCE_UPDATES,
 };
 
 /* TESTING */
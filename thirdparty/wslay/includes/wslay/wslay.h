@@ -648,6 +648,31 @@ int wslay_event_queue_msg(wslay_event_context_ptr ctx,
 int wslay_event_queue_msg_ex(wslay_event_context_ptr ctx,
                              const struct wslay_event_msg *arg, uint8_t rsv);
 
+/* GODOT ADDITION */
+/*
+ * Called once a message queued with wslay_event_queue_shared_msg() has
+ * been sent or dropped, and its buffer is no longer referenced.
+ */
+typedef void (*wslay_event_msg_free_callback)(void *user_data);
+
+struct wslay_event_shared_msg {
+  uint8_t opcode;
+  const uint8_t *msg;
+  size_t msg_length;
+  wslay_event_msg_free_callback free_callback;
+  void *free_user_data;
+};
+
+/*
+ * Like wslay_event_queue_msg(), but the message buffer is referenced
+ * instead of copied, so the same buffer can be queued on many contexts.
+ * It must stay valid and unchanged until free_callback is called.
+ * On failure free_callback is not called.
+ */
+int wslay_event_queue_shared_msg(wslay_event_context_ptr ctx,
+                                 const struct wslay_event_shared_msg *arg);
+/* GODOT END */
+
 /*
  * Specify "source" to generate message.
  */
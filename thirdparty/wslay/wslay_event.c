@@ -221,7 +221,17 @@ static int wslay_event_omsg_fragmented_init(
   return 0;
 }
 
-static void wslay_event_omsg_free(struct wslay_event_omsg *m) { free(m); }
+static void wslay_event_omsg_free(struct wslay_event_omsg *m) {
+  /* GODOT ADDITION */
+  if (!m) {
+    return;
+  }
+  if (m->free_callback) {
+    m->free_callback(m->free_user_data);
+  }
+  /* GODOT END */
+  free(m);
+}
 
 static uint8_t *wslay_event_flatten_queue(struct wslay_queue *queue,
                                           size_t len) {
@@ -334,6 +344,35 @@ int wslay_event_queue_msg_ex(wslay_event_context_ptr ctx,
   return 0;
 }
 
+/* GODOT ADDITION */
+int wslay_event_queue_shared_msg(wslay_event_context_ptr ctx,
+                                 const struct wslay_event_shared_msg *arg) {
+  struct wslay_event_omsg *omsg;
+  if (!wslay_event_is_msg_queueable(ctx)) {
+    return WSLAY_ERR_NO_MORE_MSG;
+  }
+  if (wslay_is_ctrl_frame(arg->opcode)) {
+    return WSLAY_ERR_INVALID_ARGUMENT;
+  }
+  omsg = calloc(1, sizeof(struct wslay_event_omsg));
+  if (!omsg) {
+    return WSLAY_ERR_NOMEM;
+  }
+  omsg->fin = 1;
+  omsg->opcode = arg->opcode;
+  omsg->type = WSLAY_NON_FRAGMENTED;
+  /* Only ever read from, masking goes through a separate buffer. */
+  omsg->data = (uint8_t *)arg->msg;
+  omsg->data_length = arg->msg_length;
+  omsg->free_callback = arg->free_callback;
+  omsg->free_user_data = arg->free_user_data;
+  wslay_queue_push(&ctx->send_queue, &omsg->qe);
+  ++ctx->queued_msg_count;
+  ctx->queued_msg_length += arg->msg_length;
+  return 0;
+}
+/* GODOT END */
+
 int wslay_event_queue_fragmented_msg(
     wslay_event_context_ptr ctx, const struct wslay_event_fragmented_msg *arg) {
   return wslay_event_queue_fragmented_msg_ex(ctx, arg, WSLAY_RSV_NONE);
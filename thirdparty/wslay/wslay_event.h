@@ -62,6 +62,11 @@ struct wslay_event_omsg {
 
   union wslay_event_msg_source source;
   wslay_event_fragmented_msg_callback read_callback;
+
+  /* GODOT ADDITION */
+  wslay_event_msg_free_callback free_callback;
+  void *free_user_data;
+  /* GODOT END */
 };
 
 struct wslay_event_frame_user_data {